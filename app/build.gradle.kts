@@ -45,6 +45,11 @@ android {
     kotlinOptions {
         jvmTarget = "11"
     }
+    // ADDED: keep the model uncompressed in the APK so the native side can
+    // mmap it in place (see ModelBuffer::openAsset)
+    androidResources {
+        noCompress += "tflite"
+    }
     externalNativeBuild {
         cmake {
             path = file("src/main/cpp/CMakeLists.txt")
@@ -0,0 +1,102 @@
+// ============================================================================
+// ACTIVITY DETECTOR - IMPLEMENTATION
+// ============================================================================
+
+#include "activity_detector.h"
+#include "audio_kernels.h"
+#include "ml_log.h"
+
+#include <cmath>
+
+// Noise floor tracking per window: follow quieter windows quickly, louder
+// ones slowly (about 500 windows, a few seconds at typical hops), and
+// detected windows slower still (about 2000 windows), so a sustained sound
+// is absorbed into the floor only after many seconds while steady noise
+// that passes the detector still is eventually
+static const float kFloorFall = 0.2f;
+static const float kFloorRise = 0.002f;
+static const float kFloorRiseDetected = 0.0005f;
+
+// Lowest floor (mean square of RMS 1e-4), so digital silence still leaves
+// a meaningful threshold
+static const float kMinNoiseFloor = 1e-8f;
+
+// ============================================================================
+// ACTIVITY DETECTOR CLASS IMPLEMENTATION
+// ============================================================================
+
+bool ActivityDetector::configure(float snrDb, float minRate, float maxRate,
+                                 int hangoverWindows) {
+    if (!(snrDb >= 0.0f) || minRate < 0.0f || maxRate > 1.0f || minRate > maxRate ||
+        hangoverWindows < 0) {
+        LOG_ERROR("Invalid activity detector (%.1f dB, crossings %.2f..%.2f, hangover %d)",
+                  snrDb, minRate, maxRate, hangoverWindows);
+        return false;
+    }
+
+    snrRatio = std::pow(10.0f, snrDb / 10.0f);
+    minCrossingRate = minRate;
+    maxCrossingRate = maxRate;
+    hangover = hangoverWindows;
+    configured = true;
+    reset();
+    return true;
+}
+
+void ActivityDetector::reset() {
+    noiseFloor = kMinNoiseFloor;
+    hangoverLeft = 0;
+}
+
+/**
+ * Decide on one window.
+ *
+ * This method:
+ * 1. Computes the window's mean square and zero-crossing rate
+ * 2. Accepts it if it is snrRatio above the noise floor and its crossing
+ *    rate is in range, or while the hangover lasts
+ * 3. Moves the noise floor towards the window's energy
+ */
+bool ActivityDetector::accept(const int16_t* samples, int count) {
+    if (!configured || count <= 1) {
+        return true;
+    }
+
+    // ====================================================================
+    // STEP 1: Window Features
+    // ====================================================================
+    int64_t sumSquares = 0;
+    peakAndEnergyInt16(samples, count, &sumSquares);
+    const float energy = static_cast<float>(
+            static_cast<double>(sumSquares) / count / (32768.0 * 32768.0));
+    const float crossingRate =
+            static_cast<float>(countZeroCrossingsInt16(samples, count)) / (count - 1);
+
+    // ====================================================================
+    // STEP 2: Decide
+    // ====================================================================
+    const bool detected = energy > noiseFloor * snrRatio &&
+                          crossingRate >= minCrossingRate && crossingRate <= maxCrossingRate;
+    bool accepted = detected;
+    if (detected) {
+        hangoverLeft = hangover;
+    } else if (hangoverLeft > 0) {
+        hangoverLeft--;
+        accepted = true;
+    }
+
+    // ====================================================================
+    // STEP 3: Track the Noise Floor
+    // ====================================================================
+    const float rate = energy < noiseFloor ? kFloorFall
+                     : detected ? kFloorRiseDetected : kFloorRise;
+    noiseFloor += rate * (energy - noiseFloor);
+    if (noiseFloor < kMinNoiseFloor) {
+        noiseFloor = kMinNoiseFloor;
+    }
+    return accepted;
+}
+
+float ActivityDetector::getNoiseFloorRms() const {
+    return std::sqrt(noiseFloor);
+}
@@ -0,0 +1,93 @@
+// ============================================================================
+// ACTIVITY DETECTOR - HEADER
+// ============================================================================
+//
+// First stage of the classification cascade: a cheap per-window test that
+// decides whether a window is worth a model invoke.
+//
+// Key characteristics:
+// - Adaptive: Energy is compared against a tracked noise floor instead of a
+//   fixed RMS threshold, so steady background noise (fans, traffic) stops
+//   triggering the model after a few seconds (tens of seconds if it passes
+//   the detector), while the same level after silence still does
+// - Spectral shape: The zero-crossing rate rejects broadband noise (rate
+//   near 0.5) and rumble, keeping tonal / voiced windows
+// - Hangover: A window after an accepted one is accepted for a few more
+//   windows, so sound tails and event smoothing are not cut short
+// - Cheap: Two NEON passes over the window (energy, zero crossings) and a
+//   handful of scalar operations; no allocation
+//
+// Not thread-safe: owned by the consumer (inference) thread.
+//
+// =============================================================================
+
+#ifndef ACTIVITY_DETECTOR_H
+#define ACTIVITY_DETECTOR_H
+
+#include <cstdint>
+
+// ============================================================================
+// ACTIVITY DETECTOR CLASS
+// ============================================================================
+class ActivityDetector {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    bool configured = false;
+
+    // Acceptance thresholds (see configure)
+    float snrRatio = 1.0f;
+    float minCrossingRate = 0.0f;
+    float maxCrossingRate = 1.0f;
+    int hangover = 0;
+
+    // Mean square of the background (samples scaled by 1/32768), and the
+    // windows still accepted after the last detection
+    float noiseFloor = 0.0f;
+    int hangoverLeft = 0;
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    /**
+     * Set the thresholds and forget the noise floor.
+     *
+     * @param snrDb Energy above the noise floor a window needs (dB, >= 0)
+     * @param minCrossingRate Lowest zero crossings per sample accepted
+     * @param maxCrossingRate Highest zero crossings per sample accepted
+     * @param hangoverWindows Windows accepted after each detection
+     * @return false if the parameters are invalid
+     */
+    bool configure(float snrDb, float minCrossingRate, float maxCrossingRate,
+                   int hangoverWindows);
+
+    bool isConfigured() const { return configured; }
+
+    /**
+     * Forget the noise floor and the hangover.
+     */
+    void reset();
+
+    /**
+     * End the hangover (e.g. at a stream gap); the noise floor is kept,
+     * as the environment usually outlasts a gap.
+     */
+    void endSegment() { hangoverLeft = 0; }
+
+    /**
+     * Decide on one window and update the noise floor.
+     *
+     * @param samples Window samples (16-bit PCM)
+     * @param count Number of samples
+     * @return true if the window should be classified
+     */
+    bool accept(const int16_t* samples, int count);
+
+    /** Current noise floor as an RMS in [0, 1]. */
+    float getNoiseFloorRms() const;
+};
+
+#endif // ACTIVITY_DETECTOR_H
@@ -0,0 +1,200 @@
+// ============================================================================
+// ASYNCHRONOUS CLASSIFIER - IMPLEMENTATION
+// ============================================================================
+
+#include "async_classifier.h"
+#include "ml_log.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <pthread.h>
+
+// Slots accepted by start(): one in inference, the rest being filled
+static const int kMinSlots = 2;
+static const int kMaxSlots = 16;
+
+// ============================================================================
+// ASYNC CLASSIFIER CLASS IMPLEMENTATION
+// ============================================================================
+
+AsyncClassifier::AsyncClassifier(MLProcessor& processor)
+    : processor(processor) {
+    sem_init(&wake, 0, 0);
+}
+
+AsyncClassifier::~AsyncClassifier() {
+    stop();
+    sem_destroy(&wake);
+}
+
+void AsyncClassifier::setCallback(AsyncResultCallback cb, void* user) {
+    if (isRunning()) {
+        LOG_ERROR("Async callback must be set before start()");
+        return;
+    }
+    callback = cb;
+    callbackUser = user;
+}
+
+/**
+ * Allocate the slots and start the worker.
+ *
+ * This method:
+ * 1. Validates the slot layout
+ * 2. Allocates all sample and result storage (none is allocated later)
+ * 3. Resets the ring positions and starts the worker
+ */
+bool AsyncClassifier::start(int count, int samplesPerSlot) {
+    if (isRunning()) {
+        LOG_ERROR("Async classifier already running");
+        return false;
+    }
+    if (count < kMinSlots || count > kMaxSlots || samplesPerSlot <= 0) {
+        LOG_ERROR("Invalid async slots (%d x %d samples)", count, samplesPerSlot);
+        return false;
+    }
+
+    slotCount = count;
+    slotSamples = samplesPerSlot;
+    samples.assign(static_cast<size_t>(slotCount) * slotSamples, 0);
+    slots.assign(static_cast<size_t>(slotCount), Slot());
+
+    submitted.store(0, std::memory_order_relaxed);
+    completed.store(0, std::memory_order_relaxed);
+    released.store(0, std::memory_order_relaxed);
+    rejected.store(0, std::memory_order_relaxed);
+    while (sem_trywait(&wake) == 0) {
+        // Drop wake-ups left over from a previous run
+    }
+
+    running.store(true, std::memory_order_release);
+    worker = std::thread(&AsyncClassifier::runWorker, this);
+    LOG_INFO("Async classifier started (%d slots x %d samples)", slotCount, slotSamples);
+    return true;
+}
+
+void AsyncClassifier::stop() {
+    if (running.exchange(false, std::memory_order_acq_rel)) {
+        sem_post(&wake);
+        {
+            // Wake a wait() caller; it sees running == false
+            std::lock_guard<std::mutex> lock(doneMutex);
+        }
+        done.notify_all();
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+int64_t AsyncClassifier::submit(const int16_t* data, int count, bool stream) {
+    if (!isRunning() || data == nullptr || count <= 0 || count > slotSamples) {
+        LOG_EVERY_MS(ML_LOG_LEVEL_ERROR, 1000, "Invalid async submit (%d samples, slot %d)",
+                     count, slotSamples);
+        return -1;
+    }
+
+    // Only this thread writes `submitted`; `released` tells which slots
+    // the consumer has given back
+    const int64_t ticket = submitted.load(std::memory_order_relaxed);
+    if (ticket - released.load(std::memory_order_acquire) >= slotCount) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    const int index = static_cast<int>(ticket % slotCount);
+    Slot& slot = slots[index];
+    std::memcpy(samples.data() + static_cast<size_t>(index) * slotSamples, data,
+                static_cast<size_t>(count) * sizeof(int16_t));
+    slot.count = count;
+    slot.stream = stream;
+
+    submitted.store(ticket + 1, std::memory_order_release);
+    sem_post(&wake);
+    return ticket;
+}
+
+bool AsyncClassifier::poll(AsyncResult* out) {
+    if (callback != nullptr || out == nullptr) {
+        return false;
+    }
+    const int64_t next = released.load(std::memory_order_relaxed);
+    if (next == completed.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *out = slots[static_cast<size_t>(next % slotCount)].outcome;
+    released.store(next + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncClassifier::wait(AsyncResult* out, int timeoutMs) {
+    if (callback != nullptr || out == nullptr) {
+        return false;
+    }
+    const int64_t next = released.load(std::memory_order_relaxed);
+    if (next == submitted.load(std::memory_order_relaxed)) {
+        return false;  // Nothing in flight
+    }
+    {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        done.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, next] {
+            return completed.load(std::memory_order_acquire) > next ||
+                   !running.load(std::memory_order_acquire);
+        });
+    }
+    return poll(out);
+}
+
+/**
+ * Worker loop: process submitted slots in order.
+ *
+ * The processor sees the same call sequence as a synchronous caller, so
+ * streaming state (window overlap, event clock) carries across blocks.
+ * Events beyond AsyncResult::kMaxEvents are delivered with the next block.
+ */
+void AsyncClassifier::runWorker() {
+    pthread_setname_np(pthread_self(), "ml_async");
+    processor.prepareStreamThread();  // Placement and priority per the thread policy
+    int64_t next = 0;
+
+    while (running.load(std::memory_order_acquire)) {
+        if (next == submitted.load(std::memory_order_acquire)) {
+            if (sem_wait(&wake) != 0 && errno != EINTR) {
+                LOG_ERROR("Async worker wait failed (errno %d)", errno);
+                break;
+            }
+            continue;
+        }
+
+        const int index = static_cast<int>(next % slotCount);
+        Slot& slot = slots[index];
+        const int16_t* data = samples.data() + static_cast<size_t>(index) * slotSamples;
+
+        AsyncResult& outcome = slot.outcome;
+        outcome.ticket = next;
+        outcome.result = slot.stream ? processor.classifyStream(data, slot.count)
+                                     : processor.classify(data, slot.count);
+        outcome.eventCount = processor.hasEvents()
+            ? processor.popEvents(outcome.events, AsyncResult::kMaxEvents)
+            : 0;
+
+        next++;
+        completed.store(next, std::memory_order_release);
+        if (callback != nullptr) {
+            callback(callbackUser, outcome);
+            released.store(next, std::memory_order_release);
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(doneMutex);
+            }
+            done.notify_all();
+        }
+    }
+
+    running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(doneMutex);
+    }
+    done.notify_all();
+}
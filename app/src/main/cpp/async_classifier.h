@@ -0,0 +1,182 @@
+// ============================================================================
+// ASYNCHRONOUS CLASSIFIER - HEADER
+// ============================================================================
+//
+// Submit / poll front end for an MLProcessor, so a capture thread never
+// waits for the interpreter.
+//
+// Key characteristics:
+// - Overlap: submit() copies a block into a free slot and returns at once;
+//   a native worker runs the processor on it, so block N+1 is captured
+//   while block N is inferred
+// - Pre-allocated slots (double / triple buffering): Slots are used in
+//   ring order. The caller owns free slots, the worker owns submitted ones;
+//   ownership moves through two monotonic atomic counters (an SPSC queue),
+//   so submit() and poll() take no lock and never allocate
+// - Completion: poll() (non-blocking), wait() (future-like: blocks for the
+//   oldest outstanding ticket) or a callback on the worker thread
+//
+// The processor belongs to the worker between start() and stop(): do not
+// call it from other threads meanwhile.
+//
+// =============================================================================
+
+#ifndef ASYNC_CLASSIFIER_H
+#define ASYNC_CLASSIFIER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <semaphore.h>
+#include "ml_processor.h"
+
+// ============================================================================
+// ASYNC RESULT
+// ============================================================================
+/**
+ * Outcome of one submitted block.
+ */
+struct AsyncResult {
+    // Class events queued per block at most (see MLProcessor::configureEvents)
+    static const int kMaxEvents = 8;
+
+    int64_t ticket = -1;           // Value submit() returned for the block
+    ClassificationResult result;   // windows == -1 if inference failed
+    int eventCount = 0;            // Class events the block caused
+    ClassEvent events[kMaxEvents];
+};
+
+/**
+ * Completion callback, called on the worker thread right after a block is
+ * processed. The result is only valid during the call.
+ */
+typedef void (*AsyncResultCallback)(void* user, const AsyncResult& result);
+
+// ============================================================================
+// ASYNC CLASSIFIER CLASS
+// ============================================================================
+class AsyncClassifier {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    MLProcessor& processor;
+
+    // Slot storage: slotCount blocks of slotSamples samples, plus the
+    // metadata and result of each block
+    struct Slot {
+        int count = 0;
+        bool stream = true;
+        AsyncResult outcome;
+    };
+    int slotCount = 0;
+    int slotSamples = 0;
+    std::vector<int16_t> samples;
+    std::vector<Slot> slots;
+
+    // Ring positions (monotonic; slot = value % slotCount):
+    //   submitted: written by submit(), blocks handed to the worker
+    //   completed: written by the worker, blocks with a result
+    //   released:  written by poll()/wait() (or the worker in callback
+    //              mode), blocks whose slot is free again
+    alignas(64) std::atomic<int64_t> submitted{0};
+    alignas(64) std::atomic<int64_t> completed{0};
+    alignas(64) std::atomic<int64_t> released{0};
+
+    AsyncResultCallback callback = nullptr;
+    void* callbackUser = nullptr;
+
+    sem_t wake;
+    std::atomic<bool> running{false};
+    std::atomic<int64_t> rejected{0};
+    std::thread worker;
+
+    // Only used to block in wait(); the worker takes it briefly after
+    // each block
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    void runWorker();
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    explicit AsyncClassifier(MLProcessor& processor);
+
+    /**
+     * Destructor: Stops the worker.
+     */
+    ~AsyncClassifier();
+
+    AsyncClassifier(const AsyncClassifier&) = delete;
+    AsyncClassifier& operator=(const AsyncClassifier&) = delete;
+
+    /**
+     * Deliver results through a callback instead of poll()/wait().
+     * Must be set before start(); nullptr restores polling.
+     */
+    void setCallback(AsyncResultCallback cb, void* user);
+
+    /**
+     * Allocate the slots and start the worker.
+     *
+     * @param slotCount Blocks in flight at most (2 = double buffering, 2..16)
+     * @param slotSamples Largest block submit() accepts
+     * @return false if already running or the parameters are invalid
+     */
+    bool start(int slotCount, int slotSamples);
+
+    /**
+     * Stop the worker. Blocks not started yet are discarded; the processor
+     * can be used directly again afterwards. Safe to call when not running.
+     */
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * Hand a block to the worker (producer side; lock- and allocation-free).
+     *
+     * @param data Raw audio samples (16-bit PCM), copied into the slot
+     * @param count Number of samples (at most slotSamples)
+     * @param stream true: MLProcessor::classifyStream (needs a configured
+     *               stream); false: MLProcessor::classify of one window
+     * @return Ticket of the block (increasing from 0), or -1 if every slot
+     *         is in flight or the arguments are invalid
+     */
+    int64_t submit(const int16_t* data, int count, bool stream);
+
+    /**
+     * Take the oldest completed result without blocking. Results arrive in
+     * submission order. Not available in callback mode.
+     *
+     * @param out Receives the result; its slot is free again afterwards
+     * @return false if the oldest block is still being processed
+     */
+    bool poll(AsyncResult* out);
+
+    /**
+     * Block until the oldest outstanding block completes.
+     *
+     * @param out Receives the result
+     * @param timeoutMs Longest wait
+     * @return false on timeout, or if nothing is in flight
+     */
+    bool wait(AsyncResult* out, int timeoutMs);
+
+    /** Blocks submitted and not yet released. */
+    int inFlight() const {
+        return static_cast<int>(submitted.load(std::memory_order_relaxed) -
+                                released.load(std::memory_order_acquire));
+    }
+
+    /** submit() calls refused because every slot was in flight. */
+    int64_t getRejected() const { return rejected.load(std::memory_order_relaxed); }
+};
+
+#endif // ASYNC_CLASSIFIER_H
@@ -0,0 +1,487 @@
+// ============================================================================
+// NATIVE AUDIO CAPTURE - IMPLEMENTATION
+// ============================================================================
+//
+// AAudio is resolved with dlsym instead of being linked: the app's minSdk
+// predates it (API 26), the same way optional delegates are loaded in
+// ml_delegates.cpp.
+//
+// =============================================================================
+
+#include "audio_capture.h"
+#include "audio_kernels.h"
+#include "ml_log.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <dlfcn.h>
+#include <pthread.h>
+
+// How long the worker sleeps without callbacks before rechecking its state
+static const int kWorkerWakeMs = 100;
+
+// ============================================================================
+// AAUDIO ENTRY POINTS
+// ============================================================================
+
+/**
+ * The AAudio functions used by AudioCapture, resolved from libaaudio.so.
+ */
+struct AAudioApi {
+    aaudio_result_t (*createStreamBuilder)(AAudioStreamBuilder** builder);
+    void (*setDirection)(AAudioStreamBuilder* builder, aaudio_direction_t direction);
+    void (*setSharingMode)(AAudioStreamBuilder* builder, aaudio_sharing_mode_t mode);
+    void (*setPerformanceMode)(AAudioStreamBuilder* builder, aaudio_performance_mode_t mode);
+    void (*setFormat)(AAudioStreamBuilder* builder, aaudio_format_t format);
+    void (*setChannelCount)(AAudioStreamBuilder* builder, int32_t channelCount);
+    void (*setSampleRate)(AAudioStreamBuilder* builder, int32_t sampleRate);
+    void (*setDataCallback)(AAudioStreamBuilder* builder, AAudioStream_dataCallback callback,
+                            void* userData);
+    void (*setErrorCallback)(AAudioStreamBuilder* builder, AAudioStream_errorCallback callback,
+                             void* userData);
+    aaudio_result_t (*openStream)(AAudioStreamBuilder* builder, AAudioStream** stream);
+    aaudio_result_t (*deleteBuilder)(AAudioStreamBuilder* builder);
+    aaudio_result_t (*requestStart)(AAudioStream* stream);
+    aaudio_result_t (*requestStop)(AAudioStream* stream);
+    aaudio_result_t (*close)(AAudioStream* stream);
+    int32_t (*getSampleRate)(AAudioStream* stream);
+    int32_t (*getFramesPerBurst)(AAudioStream* stream);
+    int32_t (*getXRunCount)(AAudioStream* stream);
+    aaudio_sharing_mode_t (*getSharingMode)(AAudioStream* stream);
+    const char* (*convertResultToText)(aaudio_result_t result);
+};
+
+template <typename Fn>
+static bool loadFunction(void* library, const char* name, Fn* fn) {
+    *fn = reinterpret_cast<Fn>(dlsym(library, name));
+    return *fn != nullptr;
+}
+
+/**
+ * Resolve AAudio once per process.
+ *
+ * @return Entry points, or nullptr if libaaudio.so is missing or incomplete
+ */
+static const AAudioApi* aaudio() {
+    static const AAudioApi* api = []() -> const AAudioApi* {
+        // Never closed: streams may live as long as the process
+        void* library = dlopen("libaaudio.so", RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            LOG_INFO("AAudio not available on this device");
+            return nullptr;
+        }
+
+        static AAudioApi table;
+        const bool ok =
+            loadFunction(library, "AAudio_createStreamBuilder", &table.createStreamBuilder) &&
+            loadFunction(library, "AAudioStreamBuilder_setDirection", &table.setDirection) &&
+            loadFunction(library, "AAudioStreamBuilder_setSharingMode", &table.setSharingMode) &&
+            loadFunction(library, "AAudioStreamBuilder_setPerformanceMode",
+                         &table.setPerformanceMode) &&
+            loadFunction(library, "AAudioStreamBuilder_setFormat", &table.setFormat) &&
+            loadFunction(library, "AAudioStreamBuilder_setChannelCount", &table.setChannelCount) &&
+            loadFunction(library, "AAudioStreamBuilder_setSampleRate", &table.setSampleRate) &&
+            loadFunction(library, "AAudioStreamBuilder_setDataCallback", &table.setDataCallback) &&
+            loadFunction(library, "AAudioStreamBuilder_setErrorCallback",
+                         &table.setErrorCallback) &&
+            loadFunction(library, "AAudioStreamBuilder_openStream", &table.openStream) &&
+            loadFunction(library, "AAudioStreamBuilder_delete", &table.deleteBuilder) &&
+            loadFunction(library, "AAudioStream_requestStart", &table.requestStart) &&
+            loadFunction(library, "AAudioStream_requestStop", &table.requestStop) &&
+            loadFunction(library, "AAudioStream_close", &table.close) &&
+            loadFunction(library, "AAudioStream_getSampleRate", &table.getSampleRate) &&
+            loadFunction(library, "AAudioStream_getFramesPerBurst", &table.getFramesPerBurst) &&
+            loadFunction(library, "AAudioStream_getXRunCount", &table.getXRunCount) &&
+            loadFunction(library, "AAudioStream_getSharingMode", &table.getSharingMode) &&
+            loadFunction(library, "AAudio_convertResultToText", &table.convertResultToText);
+        if (!ok) {
+            LOG_ERROR("libaaudio.so is missing required functions");
+            return nullptr;
+        }
+        return &table;
+    }();
+    return api;
+}
+
+static float floatFromBits(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint32_t bitsFromFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// ============================================================================
+// AUDIO CAPTURE CLASS IMPLEMENTATION
+// ============================================================================
+
+AudioCapture::AudioCapture(MLProcessor& mlProcessor) : processor(mlProcessor) {
+    sem_init(&wake, 0, 0);
+}
+
+AudioCapture::~AudioCapture() {
+    stop();
+    sem_destroy(&wake);
+}
+
+bool AudioCapture::isAvailable() {
+    return aaudio() != nullptr;
+}
+
+/**
+ * Open the stream and start the worker.
+ *
+ * This method:
+ * 1. Checks AAudio and the processor stream are usable
+ * 2. Copies the silence gate and resets the counters
+ * 3. Opens and starts the input stream
+ * 4. Starts the classification worker
+ */
+bool AudioCapture::start(int sampleRate, bool exclusive) {
+    stop();
+
+    if (!aaudio()) {
+        return false;
+    }
+    if (processor.getStreamHopSize() <= 0) {
+        LOG_ERROR("Stream not configured");
+        return false;
+    }
+    if (sampleRate <= 0 && processor.getModelSampleRate() <= 0) {
+        LOG_ERROR("Native-rate capture needs the model sample rate (FrontEndConfig)");
+        return false;
+    }
+
+    requestedSampleRate = sampleRate;
+    requestExclusive = exclusive;
+    minRms = processor.getMinRms();
+    callbackSilent = true;
+    gapPending.store(false, std::memory_order_relaxed);
+    disconnected.store(false, std::memory_order_relaxed);
+    droppedSamples.store(0, std::memory_order_relaxed);
+    gatedFrames.store(0, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        eventHead = 0;
+        eventCount = 0;
+    }
+    lastRmsBits.store(bitsFromFloat(0.0f), std::memory_order_relaxed);
+    while (sem_trywait(&wake) == 0) {
+        // Drain posts left from a previous run
+    }
+    processor.resetStream();
+
+    if (!openStream()) {
+        return false;
+    }
+
+    running.store(true, std::memory_order_release);
+    worker = std::thread(&AudioCapture::runWorker, this);
+    return true;
+}
+
+void AudioCapture::stop() {
+    if (running.exchange(false, std::memory_order_acq_rel)) {
+        sem_post(&wake);
+        {
+            // Wake a waitForResult caller; it sees running == false
+            std::lock_guard<std::mutex> lock(resultMutex);
+        }
+        resultReady.notify_all();
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+    // Only after the join: the worker reopens the stream on disconnects
+    closeStream();
+}
+
+bool AudioCapture::openStream() {
+    const AAudioApi* api = aaudio();
+
+    AAudioStreamBuilder* builder = nullptr;
+    aaudio_result_t result = api->createStreamBuilder(&builder);
+    if (result != AAUDIO_OK) {
+        LOG_ERROR("AAudio builder creation failed: %s", api->convertResultToText(result));
+        return false;
+    }
+
+    api->setDirection(builder, AAUDIO_DIRECTION_INPUT);
+    api->setSharingMode(builder, requestExclusive ? AAUDIO_SHARING_MODE_EXCLUSIVE
+                                                  : AAUDIO_SHARING_MODE_SHARED);
+    api->setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    api->setFormat(builder, AAUDIO_FORMAT_PCM_I16);
+    api->setChannelCount(builder, 1);
+    if (requestedSampleRate > 0) {
+        api->setSampleRate(builder, requestedSampleRate);
+    }
+    api->setDataCallback(builder, &AudioCapture::onAudio, this);
+    api->setErrorCallback(builder, &AudioCapture::onError, this);
+
+    AAudioStream* opened = nullptr;
+    result = api->openStream(builder, &opened);
+    api->deleteBuilder(builder);
+    if (result != AAUDIO_OK) {
+        LOG_ERROR("AAudio input stream failed to open: %s", api->convertResultToText(result));
+        return false;
+    }
+
+    // An explicit rate must be honoured. When the processor knows its
+    // model rate, the stream resamples whatever the device delivers (at
+    // its native rate, AAudio itself does not resample).
+    const int32_t actualRate = api->getSampleRate(opened);
+    if (requestedSampleRate > 0 && actualRate != requestedSampleRate) {
+        LOG_ERROR("AAudio opened at %d Hz instead of %d Hz", actualRate, requestedSampleRate);
+        api->close(opened);
+        return false;
+    }
+    if (processor.getModelSampleRate() > 0 && !processor.setStreamInputRate(actualRate)) {
+        api->close(opened);
+        return false;
+    }
+
+    result = api->requestStart(opened);
+    if (result != AAUDIO_OK) {
+        LOG_ERROR("AAudio input stream failed to start: %s", api->convertResultToText(result));
+        api->close(opened);
+        if (processor.getModelSampleRate() > 0) {
+            // Leave the stream at the model rate for other producers
+            processor.setStreamInputRate(processor.getModelSampleRate());
+        }
+        return false;
+    }
+
+    LOG_INFO("AAudio capture: %d Hz, %s, %d frames per burst", actualRate,
+             api->getSharingMode(opened) == AAUDIO_SHARING_MODE_EXCLUSIVE ? "exclusive" : "shared",
+             api->getFramesPerBurst(opened));
+
+    std::lock_guard<std::mutex> lock(streamMutex);
+    stream = opened;
+    return true;
+}
+
+void AudioCapture::closeStream() {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (stream) {
+        const AAudioApi* api = aaudio();
+        api->requestStop(stream);
+        api->close(stream);
+        stream = nullptr;
+    }
+}
+
+/**
+ * AAudio data callback (real-time audio thread).
+ *
+ * Gates the burst on its RMS and pushes loud audio into the processor's
+ * ring buffer. Silent bursts are not pushed; the first one of a gap asks
+ * the worker to reset the stream so no window straddles the gap.
+ */
+aaudio_data_callback_result_t AudioCapture::onAudio(AAudioStream* /* stream */, void* user,
+                                                    void* audioData, int32_t numFrames) {
+    auto* self = static_cast<AudioCapture*>(user);
+    const auto* samples = static_cast<const int16_t*>(audioData);
+
+    int64_t sumSquares = 0;
+    peakAndEnergyInt16(samples, numFrames, &sumSquares);
+    const float rms = rmsFromEnergyInt16(sumSquares, numFrames);
+    self->lastRmsBits.store(bitsFromFloat(rms), std::memory_order_relaxed);
+
+    if (!(rms > self->minRms)) {
+        self->gatedFrames.fetch_add(numFrames, std::memory_order_relaxed);
+        if (!self->callbackSilent) {
+            self->callbackSilent = true;
+            self->gapPending.store(true, std::memory_order_release);
+            sem_post(&self->wake);
+        }
+        return AAUDIO_CALLBACK_RESULT_CONTINUE;
+    }
+
+    self->callbackSilent = false;
+    const int pushed = self->processor.pushAudio(samples, numFrames);
+    if (pushed < numFrames) {
+        self->droppedSamples.fetch_add(numFrames - pushed, std::memory_order_relaxed);
+    }
+    sem_post(&self->wake);
+    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+/**
+ * AAudio error callback: defer the reopen to the worker (a stream must not
+ * be closed from its own callback thread).
+ */
+void AudioCapture::onError(AAudioStream* /* stream */, void* user, aaudio_result_t error) {
+    auto* self = static_cast<AudioCapture*>(user);
+    if (error == AAUDIO_ERROR_DISCONNECTED) {
+        self->disconnected.store(true, std::memory_order_release);
+        sem_post(&self->wake);
+    }
+}
+
+/**
+ * Worker loop: the consumer side of the processor stream.
+ *
+ * Every wake-up (one per pushed burst) classifies the windows completed so
+ * far. A reset for a silent gap may also drop a burst pushed right after
+ * the gap; it is at most one burst and only at the edge of a sound.
+ */
+void AudioCapture::runWorker() {
+    pthread_setname_np(pthread_self(), "ml_capture");
+    processor.prepareStreamThread();  // Placement and priority per the thread policy
+    bool silencePublished = false;
+
+    while (running.load(std::memory_order_acquire)) {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += kWorkerWakeMs * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        if (sem_timedwait(&wake, &deadline) != 0 && errno != ETIMEDOUT && errno != EINTR) {
+            LOG_ERROR("Capture worker wait failed (errno %d)", errno);
+            break;
+        }
+        if (!running.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        // ================================================================
+        // STEP 1: Recover from a Disconnected Device (e.g. headset change)
+        // ================================================================
+        if (disconnected.exchange(false, std::memory_order_acq_rel)) {
+            LOG_WARN("Audio input disconnected, reopening the stream");
+            closeStream();
+            processor.resetStream();
+            callbackSilent = true;  // No callback runs until the reopen
+            if (!openStream()) {
+                LOG_ERROR("Audio input could not be reopened");
+                break;
+            }
+            continue;
+        }
+
+        // ================================================================
+        // STEP 2: Silent Gap
+        // ================================================================
+        const float rms = floatFromBits(lastRmsBits.load(std::memory_order_relaxed));
+        if (gapPending.exchange(false, std::memory_order_acq_rel)) {
+            processor.resetStream();
+            if (!silencePublished) {
+                ClassificationResult silence;
+                silence.rms = rms;
+                publish(silence);
+                silencePublished = true;
+            }
+        }
+        // Keep the event clock running through gated-out silence
+        processor.skipStream(gatedFrames.exchange(0, std::memory_order_relaxed));
+
+        // ================================================================
+        // STEP 3: Classify Completed Windows
+        // ================================================================
+        const ClassificationResult result = processor.classifyPending(rms);
+        if (result.windows != 0) {
+            publish(result);
+            silencePublished = false;
+        }
+        if (processor.hasEvents()) {
+            publishEvents();
+        }
+    }
+
+    // End the class that was on, so its offset event is delivered
+    if (processor.hasEvents()) {
+        processor.resetStream();
+        publishEvents();
+    }
+
+    // Stopped, or the stream is gone: release a waiting reader
+    running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+    }
+    resultReady.notify_all();
+}
+
+void AudioCapture::publish(const ClassificationResult& result) {
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        latest = result;
+        resultSequence++;
+    }
+    resultReady.notify_all();
+}
+
+/**
+ * Move the processor's queued events (worker-side) into the capture queue.
+ */
+void AudioCapture::publishEvents() {
+    ClassEvent batch[8];
+    int count;
+    bool published = false;
+    while ((count = processor.popEvents(batch, 8)) > 0) {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        for (int i = 0; i < count; i++) {
+            if (eventCount == kEventCapacity) {
+                eventHead = (eventHead + 1) % kEventCapacity;
+                eventCount--;
+            }
+            events[(eventHead + eventCount) % kEventCapacity] = batch[i];
+            eventCount++;
+        }
+        published = true;
+    }
+    if (published) {
+        resultReady.notify_all();
+    }
+}
+
+int AudioCapture::waitForEvents(ClassEvent* out, int maxEvents, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(resultMutex);
+    resultReady.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return eventCount > 0 || !running.load(std::memory_order_acquire);
+    });
+    int count = 0;
+    while (count < maxEvents && eventCount > 0) {
+        out[count++] = events[eventHead];
+        eventHead = (eventHead + 1) % kEventCapacity;
+        eventCount--;
+    }
+    return count;
+}
+
+bool AudioCapture::waitForResult(ClassificationResult* out, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(resultMutex);
+    const bool ready = resultReady.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return resultSequence != deliveredSequence ||
+               !running.load(std::memory_order_acquire);
+    });
+    if (!ready || resultSequence == deliveredSequence) {
+        return false;
+    }
+    *out = latest;
+    deliveredSequence = resultSequence;
+    return true;
+}
+
+int32_t AudioCapture::getXRunCount() const {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    return stream ? aaudio()->getXRunCount(stream) : 0;
+}
+
+int32_t AudioCapture::getFramesPerBurst() const {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    return stream ? aaudio()->getFramesPerBurst(stream) : 0;
+}
+
+bool AudioCapture::isExclusive() const {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    return stream && aaudio()->getSharingMode(stream) == AAUDIO_SHARING_MODE_EXCLUSIVE;
+}
@@ -0,0 +1,203 @@
+// ============================================================================
+// NATIVE AUDIO CAPTURE - HEADER
+// ============================================================================
+//
+// Microphone capture with AAudio, feeding an MLProcessor stream directly.
+//
+// Key characteristics:
+// - No managed audio: The AAudio data callback writes captured samples
+//   straight into the processor's lock-free streaming ring buffer
+//   (MLProcessor::pushAudio); Java only receives decisions
+// - Real-time safe callback: One fused RMS pass for the silence gate, one
+//   ring-buffer write and a semaphore post; no locks, allocations or logs
+// - Dedicated worker: A native thread classifies the pending windows
+//   (MLProcessor::classifyPending) and publishes each decision, plus the
+//   class events of the processor's event stage. It is pinned and
+//   prioritized per the processor's thread policy (prepareStreamThread)
+// - Low latency: Exclusive, low-latency input stream when the device
+//   allows it (AAudio falls back to a shared stream otherwise)
+// - Optional: AAudio (API 26) is loaded at runtime, so on older devices
+//   start() fails cleanly and the caller can fall back to AudioRecord
+//
+// =============================================================================
+
+#ifndef AUDIO_CAPTURE_H
+#define AUDIO_CAPTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <semaphore.h>
+#include <aaudio/AAudio.h>
+#include "ml_processor.h"
+
+// ============================================================================
+// AUDIO CAPTURE CLASS
+// ============================================================================
+/**
+ * Captures mono 16-bit audio into an MLProcessor stream and classifies it
+ * on a native worker thread.
+ *
+ * The processor's stream must be configured (configureStream) before
+ * start(), and nothing else may use the processor's stream while capture
+ * runs: the AAudio callback is its producer and the worker its consumer.
+ * The processor must outlive the capture.
+ */
+class AudioCapture {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    MLProcessor& processor;
+
+    // Stream settings (see start)
+    int requestedSampleRate = 0;
+    bool requestExclusive = true;
+
+    // Current input stream. Guarded by streamMutex (never taken by the
+    // callback) so stream queries do not race a reopen on the worker.
+    mutable std::mutex streamMutex;
+    AAudioStream* stream = nullptr;
+
+    // Silence gate copied from the processor at start()
+    float minRms = 0.0f;
+
+    // Callback -> worker signals. The semaphore is posted after every push
+    // (sem_post never blocks, so it is safe on the audio thread).
+    sem_t wake;
+    std::atomic<bool> running{false};
+    std::atomic<bool> gapPending{false};
+    std::atomic<bool> disconnected{false};
+    std::atomic<uint32_t> lastRmsBits{0};
+    std::atomic<int64_t> droppedSamples{0};
+
+    // Only touched by the callback
+    bool callbackSilent = true;
+
+    std::thread worker;
+
+    // Latest decision (worker -> waitForResult)
+    std::mutex resultMutex;
+    std::condition_variable resultReady;
+    ClassificationResult latest;
+    uint64_t resultSequence = 0;
+    uint64_t deliveredSequence = 0;
+
+    // Class events (worker -> waitForEvents), when the processor has
+    // events configured. Guarded by resultMutex; the oldest is overwritten
+    // if the reader falls behind.
+    static const int kEventCapacity = 64;
+    ClassEvent events[kEventCapacity];
+    int eventHead = 0;
+    int eventCount = 0;
+
+    // Frames gated out as silence by the callback, not yet accounted to
+    // the processor's event clock (MLProcessor::skipStream)
+    std::atomic<int64_t> gatedFrames{0};
+
+    bool openStream();
+    void closeStream();
+    void runWorker();
+    void publish(const ClassificationResult& result);
+    void publishEvents();
+
+    static aaudio_data_callback_result_t onAudio(AAudioStream* stream, void* user,
+                                                 void* audioData, int32_t numFrames);
+    static void onError(AAudioStream* stream, void* user, aaudio_result_t error);
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    explicit AudioCapture(MLProcessor& processor);
+
+    /**
+     * Destructor: Stops capture.
+     */
+    ~AudioCapture();
+
+    AudioCapture(const AudioCapture&) = delete;
+    AudioCapture& operator=(const AudioCapture&) = delete;
+
+    /**
+     * True if AAudio is available on this device (API 26+).
+     */
+    static bool isAvailable();
+
+    /**
+     * Open the input stream and start capturing and classifying.
+     *
+     * The silence gate and confidence threshold are the processor's
+     * (setDecisionThresholds); set them before starting.
+     *
+     * @param sampleRate Capture rate; the stream fails to start if the
+     *                   device cannot provide it. 0 captures at the
+     *                   device's native rate (lowest latency), which needs
+     *                   the processor's model sample rate: the stream then
+     *                   resamples to it (MLProcessor::setStreamInputRate)
+     * @param exclusive Request an exclusive (lowest latency) stream
+     * @return false if AAudio is unavailable, the stream cannot be opened
+     *         at this rate, or the processor stream is not configured
+     */
+    bool start(int sampleRate = 0, bool exclusive = true);
+
+    /**
+     * Stop the stream and the worker. Safe to call when not running.
+     */
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * Wait for the next decision.
+     *
+     * Decisions are published for every worker pass that classified at
+     * least one window (or failed), and once when the audio goes silent
+     * (windows == 0). Only the latest one is kept; a slow reader skips
+     * intermediate decisions. Call from one thread at a time.
+     *
+     * @param out Receives the decision
+     * @param timeoutMs Longest wait
+     * @return false on timeout or if capture stopped
+     */
+    bool waitForResult(ClassificationResult* out, int timeoutMs);
+
+    /**
+     * Wait for class events (see MLProcessor::configureEvents, which must
+     * be called before start()). Unlike decisions, events are queued, so
+     * none is skipped unless more than 64 pile up. Call from one thread
+     * at a time.
+     *
+     * @param out Receives up to maxEvents events, oldest first
+     * @param maxEvents Capacity of out
+     * @param timeoutMs Longest wait
+     * @return Number of events written, 0 on timeout or if capture stopped
+     */
+    int waitForEvents(ClassEvent* out, int maxEvents, int timeoutMs);
+
+    /**
+     * Samples dropped because the ring buffer was full (the worker fell
+     * behind), since start().
+     */
+    int64_t getDroppedSamples() const { return droppedSamples.load(std::memory_order_relaxed); }
+
+    /**
+     * Under-/overruns reported by AAudio for the current stream.
+     */
+    int32_t getXRunCount() const;
+
+    /**
+     * Frames per callback burst of the current stream (0 if not running).
+     */
+    int32_t getFramesPerBurst() const;
+
+    /**
+     * True if the current stream runs in exclusive mode.
+     */
+    bool isExclusive() const;
+};
+
+#endif // AUDIO_CAPTURE_H
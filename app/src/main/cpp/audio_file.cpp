@@ -0,0 +1,157 @@
+// ============================================================================
+// MEMORY-MAPPED AUDIO FILE - IMPLEMENTATION
+// ============================================================================
+
+#include "audio_file.h"
+#include "ml_log.h"
+
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// WAVE_FORMAT_PCM and WAVE_FORMAT_EXTENSIBLE (PCM subformat assumed)
+static const uint16_t kWavFormatPcm = 1;
+static const uint16_t kWavFormatExtensible = 0xFFFE;
+
+static uint32_t readLE32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+// ============================================================================
+// AUDIO FILE CLASS IMPLEMENTATION
+// ============================================================================
+
+bool AudioFile::open(const char* path, int rawSampleRate, int rawChannels) {
+#if defined(_WIN32)
+    LOG_ERROR("Audio file mapping is not supported on this platform (%s)", path);
+    return false;
+#else
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open audio file %s", path);
+        return false;
+    }
+
+    struct stat info;
+    const bool ok = fstat(fd, &info) == 0 &&
+                    openFd(fd, 0, static_cast<int64_t>(info.st_size), rawSampleRate, rawChannels);
+    close(fd);  // The mapping keeps the file alive
+    if (!ok) {
+        LOG_ERROR("Failed to map audio file %s", path);
+    }
+    return ok;
+#endif
+}
+
+/**
+ * Map an audio file region and locate its samples.
+ *
+ * This method:
+ * 1. Maps the region read-only
+ * 2. Parses the RIFF header if there is one
+ * 3. Otherwise treats the whole region as raw interleaved int16 PCM
+ */
+bool AudioFile::openFd(int fd, int64_t offset, int64_t length, int rawSampleRate,
+                       int rawChannels) {
+    samples = nullptr;
+    frameCount = 0;
+
+    if (!mapping.mapFile(fd, offset, length)) {
+        return false;
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(mapping.data());
+    if (mapping.size() >= 12 && std::memcmp(bytes, "RIFF", 4) == 0) {
+        if (!parseWav()) {
+            mapping.release();
+            return false;
+        }
+        return true;
+    }
+
+    if (rawSampleRate <= 0 || rawChannels <= 0) {
+        LOG_ERROR("Invalid raw PCM layout (%d Hz, %d channels)", rawSampleRate, rawChannels);
+        mapping.release();
+        return false;
+    }
+    samples = bytes;
+    channelCount = rawChannels;
+    rate = rawSampleRate;
+    frameCount = static_cast<int64_t>(mapping.size() / (2 * rawChannels));
+    return true;
+}
+
+/**
+ * Walk the RIFF chunks for "fmt " and "data".
+ */
+bool AudioFile::parseWav() {
+    const auto* bytes = static_cast<const uint8_t*>(mapping.data());
+    const size_t size = mapping.size();
+    if (std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+        LOG_ERROR("RIFF file is not WAVE");
+        return false;
+    }
+
+    size_t pos = 12;
+    while (pos + 8 <= size) {
+        const uint8_t* chunk = bytes + pos;
+        const size_t chunkSize = readLE32(chunk + 4);
+        const size_t body = pos + 8;
+        const size_t available = chunkSize < size - body ? chunkSize : size - body;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            const uint16_t format = readLE16(chunk + 8);
+            channelCount = readLE16(chunk + 10);
+            rate = static_cast<int>(readLE32(chunk + 12));
+            const uint16_t bitsPerSample = readLE16(chunk + 22);
+            if ((format != kWavFormatPcm && format != kWavFormatExtensible) ||
+                bitsPerSample != 16 || channelCount < 1 || rate <= 0) {
+                LOG_ERROR("Unsupported WAV format %u (%u bits, %d channels)",
+                          format, bitsPerSample, channelCount);
+                return false;
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (channelCount < 1) {
+                LOG_ERROR("WAV data chunk before fmt chunk");
+                return false;
+            }
+            samples = bytes + body;
+            frameCount = static_cast<int64_t>(available / (2 * channelCount));
+            return true;
+        }
+
+        // Chunks are padded to an even size
+        pos = body + chunkSize + (chunkSize & 1);
+    }
+
+    LOG_ERROR("WAV file has no data chunk");
+    return false;
+}
+
+const int16_t* AudioFile::monoData() const {
+    if (channelCount != 1 || (reinterpret_cast<uintptr_t>(samples) & 1) != 0) {
+        return nullptr;
+    }
+    // Samples are little-endian, as are all Android ABIs
+    return reinterpret_cast<const int16_t*>(samples);
+}
+
+void AudioFile::copyFrames(int64_t frame, int count, int channel, int16_t* dst) const {
+    int i = 0;
+    const size_t stride = 2 * static_cast<size_t>(channelCount);
+    const uint8_t* src = samples + frame * stride + 2 * channel;
+    for (; i < count && frame + i < frameCount; i++) {
+        dst[i] = static_cast<int16_t>(readLE16(src + i * stride));
+    }
+    for (; i < count; i++) {
+        dst[i] = 0;
+    }
+}
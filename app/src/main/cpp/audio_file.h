@@ -0,0 +1,111 @@
+// ============================================================================
+// MEMORY-MAPPED AUDIO FILE - HEADER
+// ============================================================================
+//
+// Read-only view of a recorded WAV / raw PCM file for offline
+// classification.
+//
+// Key characteristics:
+// - Zero-copy: The file is mmapped (see ModelBuffer::mapFile) and samples
+//   are read straight from the page cache, so hours of audio never pass
+//   through the JVM or a heap buffer
+// - Formats: 16-bit PCM WAV (any channel count, RIFF chunks walked), or
+//   headerless little-endian int16 PCM with a caller-given layout
+// - Thread-safe reads: Once opened the file is immutable, so any number of
+//   worker threads may copy windows out of it concurrently
+//
+// =============================================================================
+
+#ifndef AUDIO_FILE_H
+#define AUDIO_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "model_buffer.h"
+
+// ============================================================================
+// AUDIO FILE CLASS
+// ============================================================================
+/**
+ * Memory-mapped 16-bit PCM audio.
+ *
+ * Movable, not copyable. Use isOpen() after open / openFd.
+ */
+class AudioFile {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // Mapping of the whole file (or file region)
+    ModelBuffer mapping;
+
+    // First sample byte and number of interleaved frames
+    const uint8_t* samples = nullptr;
+    int64_t frameCount = 0;
+    int channelCount = 0;
+    int rate = 0;
+
+    bool parseWav();
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    AudioFile() = default;
+
+    AudioFile(AudioFile&&) noexcept = default;
+    AudioFile& operator=(AudioFile&&) noexcept = default;
+
+    AudioFile(const AudioFile&) = delete;
+    AudioFile& operator=(const AudioFile&) = delete;
+
+    /**
+     * Map an audio file from disk.
+     *
+     * @param path File path (.wav with a RIFF header, anything else raw PCM)
+     * @param rawSampleRate Sample rate assumed for raw PCM
+     * @param rawChannels Interleaved channels assumed for raw PCM
+     * @return false if the file cannot be mapped or is not 16-bit PCM
+     */
+    bool open(const char* path, int rawSampleRate, int rawChannels = 1);
+
+    /**
+     * Map an audio file region, e.g. an uncompressed APK asset or a file
+     * handed over as a ParcelFileDescriptor. The descriptor may be closed
+     * afterwards.
+     *
+     * @param fd Open, readable file descriptor
+     * @param offset Start of the file inside fd
+     * @param length File size in bytes
+     * @see open for the remaining parameters
+     */
+    bool openFd(int fd, int64_t offset, int64_t length, int rawSampleRate,
+                int rawChannels = 1);
+
+    bool isOpen() const { return samples != nullptr; }
+    int64_t frames() const { return frameCount; }
+    int channels() const { return channelCount; }
+    int sampleRate() const { return rate; }
+
+    /**
+     * Direct pointer to channel-0 samples, only available when the file is
+     * mono and 2-byte aligned in memory (the common case).
+     *
+     * @return Frame 0 of the audio, or nullptr if copyFrames must be used
+     */
+    const int16_t* monoData() const;
+
+    /**
+     * Copy `count` frames of one channel, starting at `frame`. Frames past
+     * the end of the file are zero-filled.
+     *
+     * @param frame First frame
+     * @param count Number of frames
+     * @param channel Channel to extract (0..channels()-1)
+     * @param dst Receives `count` samples
+     */
+    void copyFrames(int64_t frame, int count, int channel, int16_t* dst) const;
+};
+
+#endif // AUDIO_FILE_H
@@ -0,0 +1,749 @@
+// ============================================================================
+// AUDIO KERNELS - IMPLEMENTATION
+// ============================================================================
+//
+// NEON and scalar implementations of the sample conversion kernels.
+//
+// Both paths multiply by a precomputed reciprocal instead of dividing, so
+// they produce bit-identical floats and a model sees the same input on
+// every ABI.
+//
+// =============================================================================
+
+#include "audio_kernels.h"
+
+#include <cmath>
+#include <cstddef>
+
+#if AUDIO_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+// ============================================================================
+// NEON HELPERS
+// ============================================================================
+
+#if AUDIO_KERNELS_NEON
+/**
+ * Horizontal maximum of eight unsigned 16-bit lanes.
+ *
+ * AArch64 has a single across-vector instruction; ARMv7 needs a pairwise
+ * reduction tree.
+ */
+static inline uint16_t horizontalMaxU16(uint16x8_t v) {
+#if defined(__aarch64__)
+    return vmaxvq_u16(v);
+#else
+    uint16x4_t m = vmax_u16(vget_low_u16(v), vget_high_u16(v));
+    m = vpmax_u16(m, m);
+    m = vpmax_u16(m, m);
+    return vget_lane_u16(m, 0);
+#endif
+}
+
+/**
+ * Scale, round half away from zero and add the zero point, for eight
+ * samples. Returns the values saturated to int16 (the int8 / uint8 store
+ * narrows them once more with saturation).
+ *
+ * Rounding adds copysign(0.5, x) and truncates, exactly like the scalar
+ * path; vcvtnq (round-to-nearest-even) does not exist on ARMv7.
+ */
+static inline int16x8_t quantizeScaledLanes(float32x4_t lo, float32x4_t hi,
+                                            int32x4_t zeroPoint) {
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+    const uint32x4_t half = vreinterpretq_u32_f32(vdupq_n_f32(0.5f));
+
+    lo = vaddq_f32(lo, vreinterpretq_f32_u32(vbslq_u32(signMask, vreinterpretq_u32_f32(lo), half)));
+    hi = vaddq_f32(hi, vreinterpretq_f32_u32(vbslq_u32(signMask, vreinterpretq_u32_f32(hi), half)));
+
+    int32x4_t qlo = vaddq_s32(vcvtq_s32_f32(lo), zeroPoint);
+    int32x4_t qhi = vaddq_s32(vcvtq_s32_f32(hi), zeroPoint);
+    return vcombine_s16(vqmovn_s32(qlo), vqmovn_s32(qhi));
+}
+
+static inline int16x8_t quantizeLanes(int16x8_t s, float scale, int32x4_t zeroPoint) {
+    return quantizeScaledLanes(
+            vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale),
+            vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale), zeroPoint);
+}
+
+/**
+ * Four samples as floats (the 32-bit source kernels share one template).
+ */
+static inline float32x4_t loadLanes(const float* src) {
+    return vld1q_f32(src);
+}
+
+static inline float32x4_t loadLanes(const int32_t* src) {
+    return vcvtq_f32_s32(vld1q_s32(src));
+}
+#endif
+
+/**
+ * Scalar quantization of one sample, matching quantizeLanes.
+ */
+template <typename Sample>
+static inline int32_t quantizeSample(Sample sample, float scale, int32_t zeroPoint) {
+    const float x = static_cast<float>(sample) * scale;
+    return static_cast<int32_t>(x + (x < 0.0f ? -0.5f : 0.5f)) + zeroPoint;
+}
+
+// ============================================================================
+// KERNEL IMPLEMENTATIONS
+// ============================================================================
+
+/**
+ * Peak absolute value of a block of 16-bit samples.
+ *
+ * NEON: vabsq_s16 wraps -32768 to 0x8000, which reinterpreted as uint16 is
+ * exactly 32768, so the unsigned max is correct for the full int16 range.
+ */
+int32_t peakAbsInt16(const int16_t* src, int count) {
+    int i = 0;
+    int32_t peak = 0;
+
+#if AUDIO_KERNELS_NEON
+    uint16x8_t vpeak0 = vdupq_n_u16(0);
+    uint16x8_t vpeak1 = vdupq_n_u16(0);
+    for (; i + 16 <= count; i += 16) {
+        int16x8_t a = vld1q_s16(src + i);
+        int16x8_t b = vld1q_s16(src + i + 8);
+        vpeak0 = vmaxq_u16(vpeak0, vreinterpretq_u16_s16(vabsq_s16(a)));
+        vpeak1 = vmaxq_u16(vpeak1, vreinterpretq_u16_s16(vabsq_s16(b)));
+    }
+    peak = horizontalMaxU16(vmaxq_u16(vpeak0, vpeak1));
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        int32_t absValue = src[i] < 0 ? -static_cast<int32_t>(src[i]) : src[i];
+        if (absValue > peak) {
+            peak = absValue;
+        }
+    }
+
+    return peak;
+}
+
+/**
+ * Peak absolute value and energy of a block of 16-bit samples, in one pass.
+ *
+ * NEON: vmull_s16 squares into 32-bit lanes (at most 2^30, no overflow),
+ * and vpadalq_s32 pairwise-accumulates them into 64-bit lanes.
+ */
+int32_t peakAndEnergyInt16(const int16_t* src, int count, int64_t* sumSquares) {
+    int i = 0;
+    int32_t peak = 0;
+    int64_t sum = 0;
+
+#if AUDIO_KERNELS_NEON
+    uint16x8_t vpeak = vdupq_n_u16(0);
+    int64x2_t vsum0 = vdupq_n_s64(0);
+    int64x2_t vsum1 = vdupq_n_s64(0);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        int16x4_t lo = vget_low_s16(s);
+        int16x4_t hi = vget_high_s16(s);
+        vpeak = vmaxq_u16(vpeak, vreinterpretq_u16_s16(vabsq_s16(s)));
+        vsum0 = vpadalq_s32(vsum0, vmull_s16(lo, lo));
+        vsum1 = vpadalq_s32(vsum1, vmull_s16(hi, hi));
+    }
+    peak = horizontalMaxU16(vpeak);
+    int64x2_t vsum = vaddq_s64(vsum0, vsum1);
+    sum = vgetq_lane_s64(vsum, 0) + vgetq_lane_s64(vsum, 1);
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const int32_t value = src[i];
+        const int32_t absValue = value < 0 ? -value : value;
+        if (absValue > peak) {
+            peak = absValue;
+        }
+        sum += value * value;
+    }
+
+    *sumSquares = sum;
+    return peak;
+}
+
+float rmsFromEnergyInt16(int64_t sumSquares, int count) {
+    if (count <= 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(
+            std::sqrt(static_cast<double>(sumSquares) / count) / 32768.0);
+}
+
+/**
+ * Number of sign changes between consecutive 16-bit samples.
+ *
+ * NEON: the arithmetic shift by 15 turns each sample into its sign mask
+ * (0 or -1); XOR with the mask of the previous sample (an unaligned load
+ * one element back) is -1 at every crossing, and subtracting it counts.
+ * 16-bit lane counters are flushed every 4096 iterations at the latest.
+ */
+int countZeroCrossingsInt16(const int16_t* src, int count) {
+    int crossings = 0;
+    int i = 1;
+
+#if AUDIO_KERNELS_NEON
+    while (i + 8 <= count) {
+        int16x8_t lanes = vdupq_n_s16(0);
+        for (int n = 0; n < 4096 && i + 8 <= count; n++, i += 8) {
+            int16x8_t current = vshrq_n_s16(vld1q_s16(src + i), 15);
+            int16x8_t previous = vshrq_n_s16(vld1q_s16(src + i - 1), 15);
+            lanes = vsubq_s16(lanes, veorq_s16(current, previous));
+        }
+        int32x4_t wide = vpaddlq_s16(lanes);
+        crossings += vgetq_lane_s32(wide, 0) + vgetq_lane_s32(wide, 1) +
+                     vgetq_lane_s32(wide, 2) + vgetq_lane_s32(wide, 3);
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        crossings += (src[i] < 0) != (src[i - 1] < 0);
+    }
+    return crossings;
+}
+
+/**
+ * Widen 16-bit samples to float and multiply by a scale factor.
+ */
+void convertInt16ToFloat(const int16_t* src, float* dst, int count, float scale) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(dst + i, vmulq_n_f32(lo, scale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(hi, scale));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        dst[i] = static_cast<float>(src[i]) * scale;
+    }
+}
+
+/**
+ * Quantize 16-bit samples straight to int8 tensor values.
+ */
+void quantizeInt16ToInt8(const int16_t* src, int8_t* dst, int count,
+                         float scale, int32_t zeroPoint) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    const int32x4_t vzero = vdupq_n_s32(zeroPoint);
+    for (; i + 8 <= count; i += 8) {
+        vst1_s8(dst + i, vqmovn_s16(quantizeLanes(vld1q_s16(src + i), scale, vzero)));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const int32_t q = quantizeSample(src[i], scale, zeroPoint);
+        dst[i] = static_cast<int8_t>(q < -128 ? -128 : (q > 127 ? 127 : q));
+    }
+}
+
+/**
+ * Quantize 16-bit samples straight to uint8 tensor values.
+ */
+void quantizeInt16ToUint8(const int16_t* src, uint8_t* dst, int count,
+                          float scale, int32_t zeroPoint) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    const int32x4_t vzero = vdupq_n_s32(zeroPoint);
+    for (; i + 8 <= count; i += 8) {
+        vst1_u8(dst + i, vqmovun_s16(quantizeLanes(vld1q_s16(src + i), scale, vzero)));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const int32_t q = quantizeSample(src[i], scale, zeroPoint);
+        dst[i] = static_cast<uint8_t>(q < 0 ? 0 : (q > 255 ? 255 : q));
+    }
+}
+
+/**
+ * Dot product of two float vectors.
+ *
+ * vmlaq_f32 is a separate multiply and add (not fused), matching the
+ * scalar lanes bit for bit.
+ */
+float dotProductFloat(const float* a, const float* b, int count) {
+    int i = 0;
+    float lanes[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+#if AUDIO_KERNELS_NEON
+    float32x4_t vsum = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        vsum = vmlaq_f32(vsum, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    vst1q_f32(lanes, vsum);
+#else
+    for (; i + 4 <= count; i += 4) {
+        for (int lane = 0; lane < 4; lane++) {
+            const float product = a[i + lane] * b[i + lane];
+            lanes[lane] += product;
+        }
+    }
+#endif
+
+    float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < count; i++) {
+        const float product = a[i] * b[i];
+        sum += product;
+    }
+    return sum;
+}
+
+/**
+ * Widen 16-bit samples to float and multiply by per-sample gains.
+ */
+void multiplyInt16ByFloat(const int16_t* src, const float* gains, float* dst, int count) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(dst + i, vmulq_f32(lo, vld1q_f32(gains + i)));
+        vst1q_f32(dst + i + 4, vmulq_f32(hi, vld1q_f32(gains + i + 4)));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        dst[i] = static_cast<float>(src[i]) * gains[i];
+    }
+}
+
+/**
+ * One radix-2 FFT stage on split-complex data.
+ *
+ * Split (not interleaved) real / imaginary arrays let four butterflies run
+ * per NEON instruction without shuffles.
+ */
+void fftRadix2Stage(float* re, float* im, const float* wr, const float* wi,
+                    int count, int half) {
+    for (int group = 0; group < count; group += 2 * half) {
+        float* aRe = re + group;
+        float* aIm = im + group;
+        float* bRe = aRe + half;
+        float* bIm = aIm + half;
+        int j = 0;
+
+#if AUDIO_KERNELS_NEON
+        for (; j + 4 <= half; j += 4) {
+            const float32x4_t vwr = vld1q_f32(wr + j);
+            const float32x4_t vwi = vld1q_f32(wi + j);
+            const float32x4_t xr = vld1q_f32(bRe + j);
+            const float32x4_t xi = vld1q_f32(bIm + j);
+            const float32x4_t tr = vsubq_f32(vmulq_f32(vwr, xr), vmulq_f32(vwi, xi));
+            const float32x4_t ti = vaddq_f32(vmulq_f32(vwr, xi), vmulq_f32(vwi, xr));
+            const float32x4_t ar = vld1q_f32(aRe + j);
+            const float32x4_t ai = vld1q_f32(aIm + j);
+            vst1q_f32(bRe + j, vsubq_f32(ar, tr));
+            vst1q_f32(bIm + j, vsubq_f32(ai, ti));
+            vst1q_f32(aRe + j, vaddq_f32(ar, tr));
+            vst1q_f32(aIm + j, vaddq_f32(ai, ti));
+        }
+#endif
+
+        // Scalar butterflies (short stages, tails, non-NEON targets)
+        for (; j < half; j++) {
+            const float rr = wr[j] * bRe[j];
+            const float ii = wi[j] * bIm[j];
+            const float ri = wr[j] * bIm[j];
+            const float ir = wi[j] * bRe[j];
+            const float tr = rr - ii;
+            const float ti = ri + ir;
+            bRe[j] = aRe[j] - tr;
+            bIm[j] = aIm[j] - ti;
+            aRe[j] += tr;
+            aIm[j] += ti;
+        }
+    }
+}
+
+/**
+ * Peak-normalize 16-bit samples to floats in [-1.0, 1.0].
+ *
+ * The peak is found on the narrow int16 data (eight lanes per vector),
+ * then a single widen + multiply pass writes the output.
+ */
+float normalizeInt16ToFloat(const int16_t* src, float* dst, int count) {
+    const int32_t peak = peakAbsInt16(src, count);
+    const float maxAmplitude = static_cast<float>(peak);
+
+    // A silent block is all zeros: scaling by 1.0 keeps it that way
+    const float scale = peak > 0 ? 1.0f / maxAmplitude : 1.0f;
+    convertInt16ToFloat(src, dst, count, scale);
+
+    return maxAmplitude;
+}
+
+// ============================================================================
+// 32-BIT SOURCE KERNELS
+// ============================================================================
+
+/**
+ * Peak absolute value of float samples.
+ */
+float peakAbsFloat(const float* src, int count) {
+    int i = 0;
+    float peak = 0.0f;
+
+#if AUDIO_KERNELS_NEON
+    float32x4_t vpeak0 = vdupq_n_f32(0.0f);
+    float32x4_t vpeak1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= count; i += 8) {
+        vpeak0 = vmaxq_f32(vpeak0, vabsq_f32(vld1q_f32(src + i)));
+        vpeak1 = vmaxq_f32(vpeak1, vabsq_f32(vld1q_f32(src + i + 4)));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, vmaxq_f32(vpeak0, vpeak1));
+    for (float lane : lanes) {
+        if (lane > peak) peak = lane;
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const float absValue = std::fabs(src[i]);
+        if (absValue > peak) {
+            peak = absValue;
+        }
+    }
+    return peak;
+}
+
+/**
+ * Peak absolute value of 32-bit samples.
+ *
+ * NEON: vabsq_s32 wraps -2^31 to 0x80000000, which reinterpreted as
+ * uint32 is exactly 2^31 (as for int16).
+ */
+uint32_t peakAbsInt32(const int32_t* src, int count) {
+    int i = 0;
+    uint32_t peak = 0;
+
+#if AUDIO_KERNELS_NEON
+    uint32x4_t vpeak0 = vdupq_n_u32(0);
+    uint32x4_t vpeak1 = vdupq_n_u32(0);
+    for (; i + 8 <= count; i += 8) {
+        vpeak0 = vmaxq_u32(vpeak0, vreinterpretq_u32_s32(vabsq_s32(vld1q_s32(src + i))));
+        vpeak1 = vmaxq_u32(vpeak1, vreinterpretq_u32_s32(vabsq_s32(vld1q_s32(src + i + 4))));
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, vmaxq_u32(vpeak0, vpeak1));
+    for (uint32_t lane : lanes) {
+        if (lane > peak) peak = lane;
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const uint32_t absValue = src[i] < 0 ? 0u - static_cast<uint32_t>(src[i])
+                                             : static_cast<uint32_t>(src[i]);
+        if (absValue > peak) {
+            peak = absValue;
+        }
+    }
+    return peak;
+}
+
+/**
+ * Energy of float samples scaled by `gain`, in four interleaved partial
+ * sums (lane i takes elements i, i+4, ...) on both implementations.
+ */
+template <typename Sample>
+static float energyOf(const Sample* src, int count, float gain) {
+    int i = 0;
+    float lanes[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+#if AUDIO_KERNELS_NEON
+    float32x4_t vsum = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t x = vmulq_n_f32(loadLanes(src + i), gain);
+        vsum = vmlaq_f32(vsum, x, x);
+    }
+    vst1q_f32(lanes, vsum);
+#else
+    for (; i + 4 <= count; i += 4) {
+        for (int lane = 0; lane < 4; lane++) {
+            const float x = static_cast<float>(src[i + lane]) * gain;
+            const float square = x * x;
+            lanes[lane] += square;
+        }
+    }
+#endif
+
+    float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < count; i++) {
+        const float x = static_cast<float>(src[i]) * gain;
+        const float square = x * x;
+        sum += square;
+    }
+    return sum;
+}
+
+/**
+ * Peak absolute value and energy of float samples.
+ *
+ * Two passes over the block (peak, then energy): float samples come from
+ * a capture buffer that is still in cache.
+ */
+float peakAndEnergyFloat(const float* src, int count, float* sumSquares) {
+    *sumSquares = energyOf(src, count, 1.0f);
+    return peakAbsFloat(src, count);
+}
+
+uint32_t peakAndEnergyInt32(const int32_t* src, int count, float* sumSquares) {
+    *sumSquares = energyOf(src, count, 1.0f / 2147483648.0f);
+    return peakAbsInt32(src, count);
+}
+
+/**
+ * Convert and scale four samples per vector.
+ */
+template <typename Sample>
+static void convertToFloat(const Sample* src, float* dst, int count, float scale) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(dst + i, vmulq_n_f32(loadLanes(src + i), scale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(loadLanes(src + i + 4), scale));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        dst[i] = static_cast<float>(src[i]) * scale;
+    }
+}
+
+void convertFloatToFloat(const float* src, float* dst, int count, float scale) {
+    convertToFloat(src, dst, count, scale);
+}
+
+void convertInt32ToFloat(const int32_t* src, float* dst, int count, float scale) {
+    convertToFloat(src, dst, count, scale);
+}
+
+/**
+ * Quantize eight samples per iteration (see quantizeInt16ToInt8).
+ */
+template <typename Sample>
+static void quantizeToInt8(const Sample* src, int8_t* dst, int count,
+                           float scale, int32_t zeroPoint) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    const int32x4_t vzero = vdupq_n_s32(zeroPoint);
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t q = quantizeScaledLanes(vmulq_n_f32(loadLanes(src + i), scale),
+                                                vmulq_n_f32(loadLanes(src + i + 4), scale),
+                                                vzero);
+        vst1_s8(dst + i, vqmovn_s16(q));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const int32_t q = quantizeSample(src[i], scale, zeroPoint);
+        dst[i] = static_cast<int8_t>(q < -128 ? -128 : (q > 127 ? 127 : q));
+    }
+}
+
+template <typename Sample>
+static void quantizeToUint8(const Sample* src, uint8_t* dst, int count,
+                            float scale, int32_t zeroPoint) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    const int32x4_t vzero = vdupq_n_s32(zeroPoint);
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t q = quantizeScaledLanes(vmulq_n_f32(loadLanes(src + i), scale),
+                                                vmulq_n_f32(loadLanes(src + i + 4), scale),
+                                                vzero);
+        vst1_u8(dst + i, vqmovun_s16(q));
+    }
+#endif
+
+    // Scalar tail (and the whole block on non-NEON targets)
+    for (; i < count; i++) {
+        const int32_t q = quantizeSample(src[i], scale, zeroPoint);
+        dst[i] = static_cast<uint8_t>(q < 0 ? 0 : (q > 255 ? 255 : q));
+    }
+}
+
+void quantizeFloatToInt8(const float* src, int8_t* dst, int count,
+                         float scale, int32_t zeroPoint) {
+    quantizeToInt8(src, dst, count, scale, zeroPoint);
+}
+
+void quantizeFloatToUint8(const float* src, uint8_t* dst, int count,
+                          float scale, int32_t zeroPoint) {
+    quantizeToUint8(src, dst, count, scale, zeroPoint);
+}
+
+void quantizeInt32ToInt8(const int32_t* src, int8_t* dst, int count,
+                         float scale, int32_t zeroPoint) {
+    quantizeToInt8(src, dst, count, scale, zeroPoint);
+}
+
+void quantizeInt32ToUint8(const int32_t* src, uint8_t* dst, int count,
+                          float scale, int32_t zeroPoint) {
+    quantizeToUint8(src, dst, count, scale, zeroPoint);
+}
+
+// ============================================================================
+// CHANNEL KERNELS
+// ============================================================================
+
+/**
+ * Split interleaved 16-bit frames into one block per channel.
+ */
+void deinterleaveInt16(const int16_t* src, int16_t* dst, int frames, int channels,
+                       int dstStride) {
+    int i = 0;
+
+#if AUDIO_KERNELS_NEON
+    // Structure loads split eight frames into one register per channel
+    if (channels == 2) {
+        for (; i + 8 <= frames; i += 8) {
+            int16x8x2_t s = vld2q_s16(src + i * 2);
+            vst1q_s16(dst + i, s.val[0]);
+            vst1q_s16(dst + dstStride + i, s.val[1]);
+        }
+    } else if (channels == 3) {
+        for (; i + 8 <= frames; i += 8) {
+            int16x8x3_t s = vld3q_s16(src + i * 3);
+            vst1q_s16(dst + i, s.val[0]);
+            vst1q_s16(dst + dstStride + i, s.val[1]);
+            vst1q_s16(dst + 2 * dstStride + i, s.val[2]);
+        }
+    } else if (channels == 4) {
+        for (; i + 8 <= frames; i += 8) {
+            int16x8x4_t s = vld4q_s16(src + i * 4);
+            vst1q_s16(dst + i, s.val[0]);
+            vst1q_s16(dst + dstStride + i, s.val[1]);
+            vst1q_s16(dst + 2 * dstStride + i, s.val[2]);
+            vst1q_s16(dst + 3 * dstStride + i, s.val[3]);
+        }
+    }
+#endif
+
+    // Scalar tail (and the whole block for other channel counts / targets)
+    for (; i < frames; i++) {
+        const int16_t* frame = src + static_cast<size_t>(i) * channels;
+        for (int c = 0; c < channels; c++) {
+            dst[static_cast<size_t>(c) * dstStride + i] = frame[c];
+        }
+    }
+}
+
+// ============================================================================
+// SAMPLE FORMAT TRAITS
+// ============================================================================
+
+float SampleKernels<int32_t>::peakAndRms(const int32_t* src, int count, float* rms) {
+    float sumSquares = 0.0f;
+    const uint32_t peak = peakAndEnergyInt32(src, count, &sumSquares);
+    *rms = count > 0 ? std::sqrt(sumSquares / count) : 0.0f;
+    return static_cast<float>(peak);
+}
+
+float SampleKernels<float>::peakAndRms(const float* src, int count, float* rms) {
+    float sumSquares = 0.0f;
+    const float peak = peakAndEnergyFloat(src, count, &sumSquares);
+    *rms = count > 0 ? std::sqrt(sumSquares / count) : 0.0f;
+    return peak;
+}
+
+// ============================================================================
+// WINDOW KERNELS
+// ============================================================================
+
+/**
+ * Peak absolute value of exactly N samples (see peakAbsInt16).
+ */
+template <int N>
+static int32_t peakAbsFixed(const int16_t* src, int /* count */) {
+    static_assert(N % 16 == 0, "Fixed window lengths are whole NEON blocks");
+
+#if AUDIO_KERNELS_NEON
+    uint16x8_t vpeak0 = vdupq_n_u16(0);
+    uint16x8_t vpeak1 = vdupq_n_u16(0);
+    for (int i = 0; i < N; i += 16) {
+        int16x8_t a = vld1q_s16(src + i);
+        int16x8_t b = vld1q_s16(src + i + 8);
+        vpeak0 = vmaxq_u16(vpeak0, vreinterpretq_u16_s16(vabsq_s16(a)));
+        vpeak1 = vmaxq_u16(vpeak1, vreinterpretq_u16_s16(vabsq_s16(b)));
+    }
+    return horizontalMaxU16(vmaxq_u16(vpeak0, vpeak1));
+#else
+    int32_t peak = 0;
+    for (int i = 0; i < N; i++) {
+        int32_t absValue = src[i] < 0 ? -static_cast<int32_t>(src[i]) : src[i];
+        if (absValue > peak) {
+            peak = absValue;
+        }
+    }
+    return peak;
+#endif
+}
+
+/**
+ * Widen and scale exactly N samples (see convertInt16ToFloat).
+ */
+template <int N>
+static void convertFixed(const int16_t* src, float* dst, int /* count */, float scale) {
+    static_assert(N % 16 == 0, "Fixed window lengths are whole NEON blocks");
+
+#if AUDIO_KERNELS_NEON
+    for (int i = 0; i < N; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(dst + i, vmulq_n_f32(lo, scale));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(hi, scale));
+    }
+#else
+    for (int i = 0; i < N; i++) {
+        dst[i] = static_cast<float>(src[i]) * scale;
+    }
+#endif
+}
+
+PeakKernel peakKernelFor(int length) {
+    switch (length) {
+        case 256: return peakAbsFixed<256>;
+        case 512: return peakAbsFixed<512>;
+        case 1024: return peakAbsFixed<1024>;
+        case 2048: return peakAbsFixed<2048>;
+        default: return peakAbsInt16;
+    }
+}
+
+ConvertKernel convertKernelFor(int length) {
+    switch (length) {
+        case 256: return convertFixed<256>;
+        case 512: return convertFixed<512>;
+        case 1024: return convertFixed<1024>;
+        case 2048: return convertFixed<2048>;
+        default: return convertInt16ToFloat;
+    }
+}
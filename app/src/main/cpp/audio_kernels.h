@@ -0,0 +1,366 @@
+// ============================================================================
+// AUDIO KERNELS - HEADER
+// ============================================================================
+//
+// Low-level sample conversion kernels used on the inference hot path.
+//
+// Key characteristics:
+// - Vectorized: NEON implementation on the ARM ABIs (arm64-v8a, armeabi-v7a)
+// - Portable: Scalar fallback on every other target (host builds, x86)
+// - Deterministic: Both implementations produce bit-identical results
+//
+// The implementation is selected at compile time. CMakeLists.txt defines
+// ML_ENABLE_NEON for the ARM ABIs; the NEON code is only compiled when the
+// compiler also reports NEON support (__ARM_NEON).
+//
+// =============================================================================
+
+#ifndef AUDIO_KERNELS_H
+#define AUDIO_KERNELS_H
+
+#include <cstdint>
+
+// ============================================================================
+// IMPLEMENTATION SELECTION
+// ============================================================================
+
+#if defined(ML_ENABLE_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define AUDIO_KERNELS_NEON 1
+#else
+#define AUDIO_KERNELS_NEON 0
+#endif
+
+// ============================================================================
+// KERNEL FUNCTIONS
+// ============================================================================
+
+/**
+ * Peak absolute value of a block of 16-bit samples.
+ *
+ * Returned as int32 so that |-32768| = 32768 is represented exactly.
+ *
+ * @param src Source samples
+ * @param count Number of samples
+ * @return max(|src[i]|), or 0 for an empty block
+ */
+int32_t peakAbsInt16(const int16_t* src, int count);
+
+/**
+ * Peak absolute value and energy of a block of 16-bit samples, in one pass.
+ *
+ * Lets a caller gate on loudness (RMS = sqrt(sumSquares / count)) and then
+ * normalize with the same peak without reading the samples twice.
+ *
+ * @param src Source samples
+ * @param count Number of samples
+ * @param sumSquares Receives sum(src[i]^2) (exact, 64-bit)
+ * @return max(|src[i]|), or 0 for an empty block
+ */
+int32_t peakAndEnergyInt16(const int16_t* src, int count, int64_t* sumSquares);
+
+/**
+ * RMS in [0, 1] (samples scaled by 1/32768) from a peakAndEnergyInt16 sum.
+ *
+ * @param sumSquares Sum of squared samples
+ * @param count Number of samples
+ * @return RMS, or 0 for an empty block
+ */
+float rmsFromEnergyInt16(int64_t sumSquares, int count);
+
+/**
+ * Number of sign changes between consecutive 16-bit samples (zero counts
+ * as positive), the time-domain zero-crossing count.
+ *
+ * @param src Source samples
+ * @param count Number of samples
+ * @return Crossings between src[i - 1] and src[i], i = 1..count-1
+ */
+int countZeroCrossingsInt16(const int16_t* src, int count);
+
+/**
+ * Widen 16-bit samples to float and multiply by a scale factor.
+ *
+ * dst[i] = static_cast<float>(src[i]) * scale
+ *
+ * @param src Source samples
+ * @param dst Destination floats (may be a tensor buffer)
+ * @param count Number of samples
+ * @param scale Factor applied to every sample
+ */
+void convertInt16ToFloat(const int16_t* src, float* dst, int count, float scale);
+
+/**
+ * Quantize 16-bit samples straight to int8 / uint8 tensor values.
+ *
+ * dst[i] = clamp(round(src[i] * scale) + zeroPoint)
+ *
+ * With scale = 1 / (peak * tensorScale) this peak-normalizes and quantizes
+ * in a single pass, without an intermediate float buffer. Rounding is half
+ * away from zero on every implementation, so results are bit-identical with
+ * and without NEON.
+ *
+ * @param src Source samples
+ * @param dst Destination tensor values
+ * @param count Number of samples
+ * @param scale Factor applied to every sample before rounding
+ * @param zeroPoint Quantization zero point added after rounding
+ */
+void quantizeInt16ToInt8(const int16_t* src, int8_t* dst, int count,
+                         float scale, int32_t zeroPoint);
+void quantizeInt16ToUint8(const int16_t* src, uint8_t* dst, int count,
+                          float scale, int32_t zeroPoint);
+
+/**
+ * Dot product of two float vectors.
+ *
+ * Accumulates in four interleaved partial sums (lane i takes elements
+ * i, i+4, ...) on both implementations, so NEON and scalar results match.
+ *
+ * @param a First vector
+ * @param b Second vector
+ * @param count Number of elements
+ * @return sum(a[i] * b[i])
+ */
+float dotProductFloat(const float* a, const float* b, int count);
+
+/**
+ * Widen 16-bit samples to float and multiply by per-sample gains
+ * (e.g. an analysis window with the 1/32768 scale folded in).
+ *
+ * dst[i] = static_cast<float>(src[i]) * gains[i]
+ *
+ * @param src Source samples
+ * @param gains Per-sample factors
+ * @param dst Destination floats
+ * @param count Number of samples
+ */
+void multiplyInt16ByFloat(const int16_t* src, const float* gains, float* dst, int count);
+
+/**
+ * One radix-2 decimation-in-time FFT stage on split-complex data.
+ *
+ * For every group of 2 * half points, butterflies point j with point
+ * j + half using twiddle (wr[j], wi[j]). Vectorized over j when half >= 4.
+ *
+ * @param re Real parts (count values, bit-reversed order on the first stage)
+ * @param im Imaginary parts
+ * @param wr Real parts of this stage's twiddles (half values)
+ * @param wi Imaginary parts of this stage's twiddles
+ * @param count FFT size
+ * @param half Butterfly span of this stage (1, 2, 4, ... count / 2)
+ */
+void fftRadix2Stage(float* re, float* im, const float* wr, const float* wi,
+                    int count, int half);
+
+/**
+ * Peak-normalize 16-bit samples to floats in [-1.0, 1.0].
+ *
+ * Fused kernel: one pass over the int16 input computes the peak, then a
+ * single store pass widens and multiplies by the reciprocal of the peak.
+ * A silent block (peak 0) is written as zeros.
+ *
+ * @param src Source samples
+ * @param dst Destination floats (may be a tensor buffer)
+ * @param count Number of samples
+ * @return The peak amplitude used for normalization
+ */
+float normalizeInt16ToFloat(const int16_t* src, float* dst, int count);
+
+// ============================================================================
+// 32-BIT SOURCE KERNELS
+// ============================================================================
+// The same peak / conversion / quantization steps for 32-bit integer PCM
+// (PCM_32BIT, or 24-bit audio in 32-bit containers) and float PCM
+// (PCM_FLOAT, full scale 1.0). Samples are processed four per vector;
+// results are bit-identical with and without NEON, like the int16 kernels.
+// Float samples are expected to be finite.
+
+/**
+ * Peak absolute value of a block of float / 32-bit samples.
+ *
+ * The int32 variant returns |-2^31| = 2^31 exactly (as uint32).
+ *
+ * @param src Source samples
+ * @param count Number of samples
+ * @return max(|src[i]|), or 0 for an empty block
+ */
+float peakAbsFloat(const float* src, int count);
+uint32_t peakAbsInt32(const int32_t* src, int count);
+
+/**
+ * Peak absolute value and energy of a block of float / 32-bit samples, in
+ * one pass.
+ *
+ * The energy is accumulated in four interleaved float partial sums (see
+ * dotProductFloat), over samples scaled to full scale 1.0 (int32 samples
+ * are multiplied by 2^-31 first), so RMS = sqrt(sumSquares / count).
+ *
+ * @param src Source samples
+ * @param count Number of samples
+ * @param sumSquares Receives sum((src[i] / fullScale)^2)
+ * @return max(|src[i]|), or 0 for an empty block
+ */
+float peakAndEnergyFloat(const float* src, int count, float* sumSquares);
+uint32_t peakAndEnergyInt32(const int32_t* src, int count, float* sumSquares);
+
+/**
+ * Convert float / 32-bit samples to float and multiply by a scale factor.
+ *
+ * dst[i] = static_cast<float>(src[i]) * scale
+ *
+ * @param src Source samples
+ * @param dst Destination floats (may be a tensor buffer)
+ * @param count Number of samples
+ * @param scale Factor applied to every sample
+ */
+void convertFloatToFloat(const float* src, float* dst, int count, float scale);
+void convertInt32ToFloat(const int32_t* src, float* dst, int count, float scale);
+
+/**
+ * Quantize float / 32-bit samples straight to int8 / uint8 tensor values.
+ *
+ * dst[i] = clamp(round(static_cast<float>(src[i]) * scale) + zeroPoint),
+ * rounding half away from zero (see quantizeInt16ToInt8).
+ *
+ * @param src Source samples
+ * @param dst Destination tensor values
+ * @param count Number of samples
+ * @param scale Factor applied to every sample before rounding
+ * @param zeroPoint Quantization zero point added after rounding
+ */
+void quantizeFloatToInt8(const float* src, int8_t* dst, int count,
+                         float scale, int32_t zeroPoint);
+void quantizeFloatToUint8(const float* src, uint8_t* dst, int count,
+                          float scale, int32_t zeroPoint);
+void quantizeInt32ToInt8(const int32_t* src, int8_t* dst, int count,
+                         float scale, int32_t zeroPoint);
+void quantizeInt32ToUint8(const int32_t* src, uint8_t* dst, int count,
+                          float scale, int32_t zeroPoint);
+
+// ============================================================================
+// CHANNEL KERNELS
+// ============================================================================
+
+/**
+ * Split interleaved 16-bit frames into one contiguous block per channel.
+ *
+ * dst[c * dstStride + i] = src[i * channels + c]
+ *
+ * Single pass over the interleaved input: 2, 3 and 4 channels use the
+ * NEON structure loads (vld2q / vld3q / vld4q, eight frames per load),
+ * other channel counts copy frame by frame.
+ *
+ * @param src Interleaved samples (frames * channels)
+ * @param dst Destination, channel c starting at dst + c * dstStride
+ * @param frames Number of frames
+ * @param channels Samples per frame
+ * @param dstStride Distance between the channel blocks (>= frames)
+ */
+void deinterleaveInt16(const int16_t* src, int16_t* dst, int frames, int channels,
+                       int dstStride);
+
+// ============================================================================
+// SAMPLE FORMAT TRAITS
+// ============================================================================
+// SampleKernels<Sample> maps a source sample type (int16_t, int32_t or
+// float) to its kernels, so a conversion pipeline can be written once as
+// a template over the source type and the destination tensor type: every
+// <Sample, float / int8_t / uint8_t> pair resolves at compile time to its
+// own single-pass kernel, with no per-sample branches.
+// fullScale() is the magnitude that maps to 1.0 (normalization that does
+// not depend on the signal).
+
+template <typename Sample>
+struct SampleKernels;
+
+template <>
+struct SampleKernels<int16_t> {
+    static float fullScale() { return 32768.0f; }
+    static float peak(const int16_t* src, int count) {
+        return static_cast<float>(peakAbsInt16(src, count));
+    }
+    static float peakAndRms(const int16_t* src, int count, float* rms) {
+        int64_t sumSquares = 0;
+        const int32_t peak = peakAndEnergyInt16(src, count, &sumSquares);
+        *rms = rmsFromEnergyInt16(sumSquares, count);
+        return static_cast<float>(peak);
+    }
+    static void store(const int16_t* src, float* dst, int count, float scale, int32_t) {
+        convertInt16ToFloat(src, dst, count, scale);
+    }
+    static void store(const int16_t* src, int8_t* dst, int count, float scale, int32_t zp) {
+        quantizeInt16ToInt8(src, dst, count, scale, zp);
+    }
+    static void store(const int16_t* src, uint8_t* dst, int count, float scale, int32_t zp) {
+        quantizeInt16ToUint8(src, dst, count, scale, zp);
+    }
+};
+
+template <>
+struct SampleKernels<int32_t> {
+    static float fullScale() { return 2147483648.0f; }
+    static float peak(const int32_t* src, int count) {
+        return static_cast<float>(peakAbsInt32(src, count));
+    }
+    static float peakAndRms(const int32_t* src, int count, float* rms);
+    static void store(const int32_t* src, float* dst, int count, float scale, int32_t) {
+        convertInt32ToFloat(src, dst, count, scale);
+    }
+    static void store(const int32_t* src, int8_t* dst, int count, float scale, int32_t zp) {
+        quantizeInt32ToInt8(src, dst, count, scale, zp);
+    }
+    static void store(const int32_t* src, uint8_t* dst, int count, float scale, int32_t zp) {
+        quantizeInt32ToUint8(src, dst, count, scale, zp);
+    }
+};
+
+template <>
+struct SampleKernels<float> {
+    static float fullScale() { return 1.0f; }
+    static float peak(const float* src, int count) {
+        return peakAbsFloat(src, count);
+    }
+    static float peakAndRms(const float* src, int count, float* rms);
+    static void store(const float* src, float* dst, int count, float scale, int32_t) {
+        convertFloatToFloat(src, dst, count, scale);
+    }
+    static void store(const float* src, int8_t* dst, int count, float scale, int32_t zp) {
+        quantizeFloatToInt8(src, dst, count, scale, zp);
+    }
+    static void store(const float* src, uint8_t* dst, int count, float scale, int32_t zp) {
+        quantizeFloatToUint8(src, dst, count, scale, zp);
+    }
+};
+
+// ============================================================================
+// WINDOW KERNELS
+// ============================================================================
+// The window length is only known once the model is loaded (see
+// MLProcessor::getWindowLength), so the per-window kernels are selected at
+// load time. The common lengths 256, 512, 1024 and 2048 get variants
+// compiled for that exact length (templates instantiated in
+// audio_kernels.cpp): a constant trip count lets the compiler fully unroll
+// the vector loop and drop the scalar tail. Every other length uses the
+// generic kernels above. Both are bit-identical.
+
+// Same signatures as peakAbsInt16 / convertInt16ToFloat
+typedef int32_t (*PeakKernel)(const int16_t* src, int count);
+typedef void (*ConvertKernel)(const int16_t* src, float* dst, int count, float scale);
+
+/**
+ * Peak kernel for windows of exactly `length` samples.
+ *
+ * @param length Window length the kernel will be called with
+ * @return A fixed-length variant if one exists, otherwise peakAbsInt16
+ */
+PeakKernel peakKernelFor(int length);
+
+/**
+ * Float conversion kernel for windows of exactly `length` samples.
+ *
+ * @param length Window length the kernel will be called with
+ * @return A fixed-length variant if one exists, otherwise convertInt16ToFloat
+ */
+ConvertKernel convertKernelFor(int length);
+
+#endif // AUDIO_KERNELS_H
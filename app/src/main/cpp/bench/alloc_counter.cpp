@@ -0,0 +1,49 @@
+// ============================================================================
+// HEAP ALLOCATION COUNTER - IMPLEMENTATION
+// ============================================================================
+
+#include "alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> totalAllocations{0};
+static std::atomic<uint64_t> totalBytes{0};
+
+uint64_t allocationCount() {
+    return totalAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t allocationBytes() {
+    return totalBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
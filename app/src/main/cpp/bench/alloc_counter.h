@@ -0,0 +1,27 @@
+// ============================================================================
+// HEAP ALLOCATION COUNTER - HEADER
+// ============================================================================
+//
+// Counts every C++ heap allocation in the process (MLProcessor and the
+// TensorFlow Lite runtime alike) by replacing the global operator new.
+// Linked into the benchmark and test executables that report allocations
+// per window; never into the app library.
+//
+// =============================================================================
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * Number of operator new calls since process start.
+ */
+uint64_t allocationCount();
+
+/**
+ * Bytes requested from operator new since process start.
+ */
+uint64_t allocationBytes();
+
+#endif // ALLOC_COUNTER_H
@@ -0,0 +1,781 @@
+// ============================================================================
+// GOLDEN-OUTPUT REGRESSION TEST
+// ============================================================================
+//
+// Replays a fixed set of labelled clips through every MLProcessor inference
+// path and checks, for each path, that:
+// - every window's scores match the stored golden vectors within a
+//   tolerance, and the top class is the same (unless the golden top two
+//   are closer than the tolerance)
+// - the p95 latency and the heap allocations per window stay within the
+//   committed budget
+// so a performance change (kernels, quantization, delegates, batching, the
+// stream) cannot silently change what the model outputs.
+//
+// Usage: golden_test [options] model.tflite golden.txt [clip ...]
+//
+//   golden.txt        golden vectors, written by --record
+//   clip              extra 16-bit PCM .wav / raw int16 clips (first
+//                     channel), labelled by their file name
+//   --record          write golden.txt from the reference path (processAudio
+//                     on 16-bit PCM, CPU) instead of checking
+//   --budget FILE     per-path latency / allocation budget (none: not checked)
+//   --tolerance T     largest absolute score difference (default 1e-4)
+//   --delegate D      cpu | xnnpack | gpu | nnapi (default cpu)
+//   --threads N       interpreter threads (default 2)
+//   --repeat N        timed passes over the clips (default 3)
+//   --rate HZ         sample rate of raw PCM clips (default 44100)
+//
+// The built-in clips are synthesized (DTMF keys, a quiet tone, a clipped
+// tone, noise and silence), so no audio has to be committed next to the
+// golden file. Golden files are per model: record one for each model the
+// app ships, on the CPU reference, and check delegates or a quantized build
+// against it with a wider --tolerance.
+//
+// Exit status: 0 if every path passes, 1 on a mismatch or a budget
+// regression, 2 on a usage error.
+//
+// =============================================================================
+
+#include "ml_processor.h"
+#include "alloc_counter.h"
+#include "audio_file.h"
+#include "audio_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Windows per invoke on the batch and stream paths
+static const int kBatchWindows = 4;
+
+// Channels of the multi-channel path (the clip, and its inverse)
+static const int kChannels = 2;
+
+// Length of each synthesized clip
+static const double kClipSeconds = 0.25;
+
+// ============================================================================
+// CLIPS
+// ============================================================================
+
+/**
+ * One labelled clip, as mono 16-bit samples, and its reference scores
+ * (windows() x classes, row-major).
+ */
+struct Clip {
+    std::string label;
+    std::vector<int16_t> samples;
+    std::vector<float> reference;
+    int windowLength = 0;
+
+    int windows() const { return static_cast<int>(samples.size()) / windowLength; }
+    const int16_t* window(int w) const { return samples.data() + w * windowLength; }
+};
+
+/**
+ * Sum of two sines at the given amplitude (a DTMF key, or a single tone
+ * with f2 = 0), hard-clipped to 16 bits.
+ */
+static std::vector<int16_t> synthesizeTone(double f1, double f2, double amplitude,
+                                           int sampleRate) {
+    const double kTwoPi = 6.283185307179586;
+    std::vector<int16_t> samples(static_cast<size_t>(kClipSeconds * sampleRate));
+    for (size_t i = 0; i < samples.size(); i++) {
+        const double t = static_cast<double>(i) / sampleRate;
+        double value = std::sin(kTwoPi * f1 * t);
+        if (f2 > 0.0) {
+            value = 0.5 * (value + std::sin(kTwoPi * f2 * t));
+        }
+        value = std::max(-32768.0, std::min(32767.0, std::round(value * amplitude)));
+        samples[i] = static_cast<int16_t>(value);
+    }
+    return samples;
+}
+
+/**
+ * White noise from a fixed linear congruential generator (the same samples
+ * on every platform and standard library).
+ */
+static std::vector<int16_t> synthesizeNoise(double amplitude, int sampleRate) {
+    std::vector<int16_t> samples(static_cast<size_t>(kClipSeconds * sampleRate));
+    uint32_t state = 0x12345678u;
+    for (size_t i = 0; i < samples.size(); i++) {
+        state = state * 1664525u + 1013904223u;
+        const double uniform = static_cast<double>(state >> 8) / (1 << 24) * 2.0 - 1.0;
+        samples[i] = static_cast<int16_t>(std::round(uniform * amplitude));
+    }
+    return samples;
+}
+
+/**
+ * The built-in clip set.
+ *
+ * This method:
+ * 1. Adds the twelve DTMF keys of a telephone keypad
+ * 2. Adds edge cases of the normalization: a quiet tone (small peak), a
+ *    tone clipped at full scale (peak -32768), noise and digital silence
+ */
+static std::vector<Clip> builtInClips(int sampleRate) {
+    static const struct { const char* key; double low; double high; } kKeys[] = {
+        {"1", 697, 1209}, {"2", 697, 1336}, {"3", 697, 1477},
+        {"4", 770, 1209}, {"5", 770, 1336}, {"6", 770, 1477},
+        {"7", 852, 1209}, {"8", 852, 1336}, {"9", 852, 1477},
+        {"star", 941, 1209}, {"0", 941, 1336}, {"hash", 941, 1477},
+    };
+
+    std::vector<Clip> clips;
+    for (const auto& key : kKeys) {
+        Clip clip;
+        clip.label = std::string("dtmf_") + key.key;
+        clip.samples = synthesizeTone(key.low, key.high, 16000.0, sampleRate);
+        clips.push_back(std::move(clip));
+    }
+
+    Clip quiet;
+    quiet.label = "tone_quiet";
+    quiet.samples = synthesizeTone(440.0, 0.0, 40.0, sampleRate);
+    clips.push_back(std::move(quiet));
+
+    Clip clipped;
+    clipped.label = "dtmf_5_clipped";
+    clipped.samples = synthesizeTone(770.0, 1336.0, 65536.0, sampleRate);
+    clips.push_back(std::move(clipped));
+
+    Clip noise;
+    noise.label = "noise";
+    noise.samples = synthesizeNoise(8000.0, sampleRate);
+    clips.push_back(std::move(noise));
+
+    Clip silence;
+    silence.label = "silence";
+    silence.samples.assign(static_cast<size_t>(kClipSeconds * sampleRate), 0);
+    clips.push_back(std::move(silence));
+    return clips;
+}
+
+/**
+ * Load an extra clip (first channel), labelled by its file name.
+ */
+static bool loadClip(const char* path, int rawSampleRate, Clip* clip) {
+    AudioFile file;
+    if (!file.open(path, rawSampleRate)) {
+        std::fprintf(stderr, "%s: not a 16-bit PCM clip\n", path);
+        return false;
+    }
+    const char* name = std::strrchr(path, '/');
+    clip->label = name ? name + 1 : path;
+    clip->samples.resize(static_cast<size_t>(file.frames()));
+    file.copyFrames(0, static_cast<int>(file.frames()), 0, clip->samples.data());
+    return true;
+}
+
+// ============================================================================
+// GOLDEN FILE
+// ============================================================================
+// Text, so a re-recorded model shows up as a readable diff:
+//   golden_test 1
+//   window <samples> classes <n>
+//   clip <label> <windows>
+//   <n scores of window 0>
+//   ...
+
+static bool writeGolden(const char* path, const std::vector<Clip>& clips, int classes) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::fprintf(stderr, "%s: cannot write\n", path);
+        return false;
+    }
+    std::fprintf(f, "golden_test 1\n");
+    std::fprintf(f, "window %d classes %d\n", clips.front().windowLength, classes);
+    for (const Clip& clip : clips) {
+        std::fprintf(f, "clip %s %d\n", clip.label.c_str(), clip.windows());
+        for (int w = 0; w < clip.windows(); w++) {
+            for (int c = 0; c < classes; c++) {
+                std::fprintf(f, c ? " %.8g" : "%.8g", clip.reference[w * classes + c]);
+            }
+            std::fprintf(f, "\n");
+        }
+    }
+    return std::fclose(f) == 0;
+}
+
+/**
+ * Read golden vectors for the given clips, which must match the recorded
+ * set (same labels, windows and classes, in order).
+ *
+ * @param golden Receives one score matrix per clip
+ */
+static bool readGolden(const char* path, const std::vector<Clip>& clips, int classes,
+                       std::vector<std::vector<float>>* golden) {
+    FILE* f = std::fopen(path, "r");
+    if (!f) {
+        std::fprintf(stderr, "%s: cannot open (record it with --record)\n", path);
+        return false;
+    }
+
+    bool ok = true;
+    int version = 0;
+    int window = 0;
+    int recordedClasses = 0;
+    if (std::fscanf(f, "golden_test %d window %d classes %d", &version, &window,
+                    &recordedClasses) != 3 || version != 1) {
+        std::fprintf(stderr, "%s: not a golden_test file\n", path);
+        ok = false;
+    } else if (window != clips.front().windowLength || recordedClasses != classes) {
+        std::fprintf(stderr, "%s: recorded for %d-sample windows and %d classes, model has %d "
+                     "and %d\n", path, window, recordedClasses, clips.front().windowLength,
+                     classes);
+        ok = false;
+    }
+
+    golden->assign(clips.size(), std::vector<float>());
+    for (size_t i = 0; ok && i < clips.size(); i++) {
+        char label[256];
+        int windows = 0;
+        if (std::fscanf(f, " clip %255s %d", label, &windows) != 2 ||
+            clips[i].label != label || windows != clips[i].windows()) {
+            std::fprintf(stderr, "%s: clip %zu is not %s (%d windows); record it again\n",
+                         path, i, clips[i].label.c_str(), clips[i].windows());
+            ok = false;
+            break;
+        }
+        std::vector<float>& scores = (*golden)[i];
+        scores.resize(static_cast<size_t>(windows) * classes);
+        for (float& score : scores) {
+            if (std::fscanf(f, "%f", &score) != 1) {
+                std::fprintf(stderr, "%s: truncated at clip %s\n", path, label);
+                ok = false;
+                break;
+            }
+        }
+    }
+    std::fclose(f);
+    return ok;
+}
+
+// ============================================================================
+// BUDGET FILE
+// ============================================================================
+// One line per path: <path> <p95 latency us per window> <allocations per
+// window>; '#' starts a comment. Paths not listed are not budgeted.
+
+struct Budget {
+    std::string path;
+    double p95Us = 0.0;
+    double allocationsPerWindow = 0.0;
+};
+
+static bool readBudget(const char* path, std::vector<Budget>* budgets) {
+    FILE* f = std::fopen(path, "r");
+    if (!f) {
+        std::fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    char line[256];
+    while (std::fgets(line, sizeof(line), f)) {
+        if (char* comment = std::strchr(line, '#')) {
+            *comment = '\0';
+        }
+        char name[64];
+        Budget budget;
+        const int fields = std::sscanf(line, "%63s %lf %lf", name, &budget.p95Us,
+                                       &budget.allocationsPerWindow);
+        if (fields <= 0) {
+            continue;
+        }
+        if (fields != 3) {
+            std::fprintf(stderr, "%s: malformed line: %s", path, line);
+            std::fclose(f);
+            return false;
+        }
+        budget.path = name;
+        budgets->push_back(budget);
+    }
+    std::fclose(f);
+    return true;
+}
+
+// ============================================================================
+// INFERENCE PATHS
+// ============================================================================
+
+/**
+ * Inputs every path can run on without converting inside the timed loop.
+ */
+struct ClipInputs {
+    std::vector<int32_t> pcm32;      // samples << 16, as a 32-bit capture
+    std::vector<float> pcmFloat;     // samples / 32768, as a float capture
+    std::vector<int16_t> interleaved;  // kChannels frames: clip, inverse
+};
+
+static ClipInputs prepareInputs(const Clip& clip) {
+    ClipInputs inputs;
+    inputs.pcm32.resize(clip.samples.size());
+    inputs.pcmFloat.resize(clip.samples.size());
+    inputs.interleaved.resize(clip.samples.size() * kChannels);
+    for (size_t i = 0; i < clip.samples.size(); i++) {
+        const int16_t sample = clip.samples[i];
+        inputs.pcm32[i] = static_cast<int32_t>(sample) * 65536;
+        inputs.pcmFloat[i] = sample / 32768.0f;
+        inputs.interleaved[i * kChannels] = sample;
+        inputs.interleaved[i * kChannels + 1] =
+                static_cast<int16_t>(sample == -32768 ? 32767 : -sample);
+    }
+    return inputs;
+}
+
+enum class Path { Vector, Into, View, Pcm32, Float, Batch, Stream, Channels };
+
+static const Path kPaths[] = {
+    Path::Vector, Path::Into, Path::View, Path::Pcm32, Path::Float, Path::Batch,
+    Path::Stream, Path::Channels,
+};
+
+static const char* pathName(Path path) {
+    switch (path) {
+        case Path::Vector: return "vector";
+        case Path::Into: return "into";
+        case Path::View: return "view";
+        case Path::Pcm32: return "pcm32";
+        case Path::Float: return "float";
+        case Path::Batch: return "batch";
+        case Path::Stream: return "stream";
+        case Path::Channels: return "channels";
+    }
+    return "unknown";
+}
+
+/**
+ * The multi-channel path only reports decisions: its best score and class
+ * are compared, not the full vector.
+ */
+static bool topOnly(Path path) {
+    return path == Path::Channels;
+}
+
+/**
+ * Scratch buffers of one run, sized once so the timed loop does not
+ * allocate.
+ */
+struct RunContext {
+    MLProcessor& processor;
+    int classes;
+    std::vector<float> scores;
+    std::vector<int64_t> windowStarts;
+    std::vector<int16_t> padding;
+    ClassificationResult channelResults[kChannels];
+};
+
+/**
+ * Classify the windows [first, first + count) of a clip on one path and
+ * write their scores to out (count x classes). Channels writes the best
+ * score at the reported class and zero elsewhere.
+ *
+ * @return Windows produced (count), or -1 on failure
+ */
+static int runPath(RunContext& ctx, Path path, const Clip& clip, const ClipInputs& inputs,
+                   int first, int count, float* out) {
+    MLProcessor& processor = ctx.processor;
+    const int window = clip.windowLength;
+    const int classes = ctx.classes;
+    const size_t offset = static_cast<size_t>(first) * window;
+
+    switch (path) {
+        case Path::Vector: {
+            std::vector<float> scores = processor.processAudio(clip.window(first), window);
+            if (static_cast<int>(scores.size()) != classes) return -1;
+            std::copy(scores.begin(), scores.end(), out);
+            return 1;
+        }
+        case Path::Into:
+            return processor.processAudioInto(clip.window(first), window, out, classes) ==
+                   classes ? 1 : -1;
+        case Path::View:
+        case Path::Pcm32:
+        case Path::Float: {
+            int length = 0;
+            const float* scores =
+                    path == Path::View ? processor.processAudioView(clip.window(first), window,
+                                                                    &length) :
+                    path == Path::Pcm32 ? processor.processAudioView(inputs.pcm32.data() + offset,
+                                                                     window, &length) :
+                    processor.processAudioView(inputs.pcmFloat.data() + offset, window, &length);
+            if (!scores || length != classes) return -1;
+            std::copy(scores, scores + classes, out);
+            return 1;
+        }
+        case Path::Batch:
+            return processor.processAudioBatchInto(clip.window(first), count, out,
+                                                   count * classes) == count * classes ?
+                   count : -1;
+        case Path::Stream: {
+            // Whole batches only: the tail is padded with silence and its
+            // rows dropped
+            processor.resetStream();
+            processor.pushAudio(clip.window(first), count * window);
+            const int padded = (count + kBatchWindows - 1) / kBatchWindows * kBatchWindows;
+            processor.pushAudio(ctx.padding.data(), (padded - count) * window);
+            const int produced = processor.processStream(ctx.scores.data(),
+                                                         ctx.windowStarts.data(), padded);
+            if (produced != padded) return -1;
+            const int64_t base = ctx.windowStarts[0];
+            for (int w = 0; w < count; w++) {
+                if (ctx.windowStarts[w] - base != static_cast<int64_t>(w) * window) return -1;
+            }
+            std::copy(ctx.scores.begin(), ctx.scores.begin() + count * classes, out);
+            return count;
+        }
+        case Path::Channels: {
+            const int16_t* frames = inputs.interleaved.data() + offset * kChannels;
+            processor.classifyChannels(frames, window, kChannels, ctx.channelResults);
+            const ClassificationResult& result = ctx.channelResults[0];
+            if (result.windows < 0 || result.classIndex < 0 || result.classIndex >= classes) {
+                return -1;
+            }
+            std::fill(out, out + classes, 0.0f);
+            out[result.classIndex] = result.score;
+            return 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Windows one call of a path classifies.
+ */
+static int windowsPerCall(Path path) {
+    return path == Path::Batch || path == Path::Stream ? kBatchWindows : 1;
+}
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+
+static int topClass(const float* scores, int classes, float* margin) {
+    int best = 0;
+    float second = -INFINITY;
+    for (int c = 1; c < classes; c++) {
+        if (scores[c] > scores[best]) {
+            second = scores[best];
+            best = c;
+        } else if (scores[c] > second) {
+            second = scores[c];
+        }
+    }
+    *margin = scores[best] - second;
+    return best;
+}
+
+/**
+ * Outcome of one path over all clips.
+ */
+struct PathResult {
+    int windows = 0;
+    float maxError = 0.0f;
+    int topMismatches = 0;
+    std::string worstWindow;  // "<clip>:<window>" of maxError
+    bool failed = false;      // Inference failed
+    double p95Us = 0.0;
+    double allocationsPerWindow = 0.0;
+};
+
+/**
+ * Compare one window's scores with its golden vector.
+ */
+static void compareWindow(Path path, const float* scores, const float* golden, int classes,
+                          float tolerance, const std::string& where, PathResult* result) {
+    float margin = 0.0f;
+    const int expected = topClass(golden, classes, &margin);
+    float error = 0.0f;
+    if (topOnly(path)) {
+        error = std::fabs(scores[expected] - golden[expected]);
+    } else {
+        for (int c = 0; c < classes; c++) {
+            error = std::max(error, std::fabs(scores[c] - golden[c]));
+        }
+    }
+    float unused = 0.0f;
+    if (margin > tolerance && topClass(scores, classes, &unused) != expected) {
+        result->topMismatches++;
+    }
+    if (error > result->maxError || std::isnan(error)) {
+        result->maxError = std::isnan(error) ? INFINITY : error;
+        result->worstWindow = where;
+    }
+    result->windows++;
+}
+
+/**
+ * Value at quantile q (0..1) of an ascending-sorted sample, nearest rank.
+ */
+static double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(q * sorted.size() + 0.5);
+    rank = rank < 1 ? 1 : (rank > sorted.size() ? sorted.size() : rank);
+    return sorted[rank - 1];
+}
+
+/**
+ * Check one path: an untimed pass compared with the golden vectors, then
+ * `repeat` timed passes for latency and allocations.
+ */
+static PathResult checkPath(RunContext& ctx, Path path, const std::vector<Clip>& clips,
+                            const std::vector<ClipInputs>& inputs,
+                            const std::vector<std::vector<float>>& golden, float tolerance,
+                            int repeat, std::vector<double>* latencies) {
+    PathResult result;
+    const int classes = ctx.classes;
+    const int step = windowsPerCall(path);
+    std::vector<float> out(static_cast<size_t>(step) * classes);
+
+    // ====================================================================
+    // STEP 1: Outputs
+    // ====================================================================
+    for (size_t i = 0; i < clips.size(); i++) {
+        const Clip& clip = clips[i];
+        for (int w = 0; w < clip.windows(); w += step) {
+            const int count = std::min(step, clip.windows() - w);
+            if (runPath(ctx, path, clip, inputs[i], w, count, out.data()) != count) {
+                std::fprintf(stderr, "%s: inference failed on %s window %d\n", pathName(path),
+                             clip.label.c_str(), w);
+                result.failed = true;
+                return result;
+            }
+            for (int k = 0; k < count; k++) {
+                compareWindow(path, out.data() + k * classes,
+                              golden[i].data() + static_cast<size_t>(w + k) * classes, classes,
+                              tolerance, clip.label + ":" + std::to_string(w + k), &result);
+            }
+        }
+    }
+
+    // ====================================================================
+    // STEP 2: Latency and Allocations
+    // ====================================================================
+    // Only whole calls are timed, so every sample covers `step` windows.
+    // Room for every sample is reserved up front so the counted loop
+    // itself never allocates, whatever the clip lengths.
+    size_t timedCalls = 0;
+    for (const Clip& clip : clips) {
+        timedCalls += static_cast<size_t>(clip.windows() / step);
+    }
+    latencies->clear();
+    latencies->reserve(timedCalls * repeat);
+    int timedWindows = 0;
+    const uint64_t allocationsBefore = allocationCount();
+    for (int pass = 0; pass < repeat; pass++) {
+        for (size_t i = 0; i < clips.size(); i++) {
+            const Clip& clip = clips[i];
+            for (int w = 0; w + step <= clip.windows(); w += step) {
+                const auto t0 = std::chrono::steady_clock::now();
+                runPath(ctx, path, clip, inputs[i], w, step, out.data());
+                const auto t1 = std::chrono::steady_clock::now();
+                latencies->push_back(
+                        std::chrono::duration<double, std::micro>(t1 - t0).count() / step);
+                timedWindows += step;
+            }
+        }
+    }
+    const uint64_t allocations = allocationCount() - allocationsBefore;
+
+    std::sort(latencies->begin(), latencies->end());
+    result.p95Us = percentile(*latencies, 0.95);
+    result.allocationsPerWindow = timedWindows ? static_cast<double>(allocations) / timedWindows
+                                               : 0.0;
+    return result;
+}
+
+static bool parseDelegate(const char* name, DelegateType* type) {
+    static const struct { const char* name; DelegateType type; } kNames[] = {
+        {"cpu", DelegateType::Cpu}, {"xnnpack", DelegateType::XnnPack},
+        {"gpu", DelegateType::Gpu}, {"nnapi", DelegateType::Nnapi},
+    };
+    for (const auto& entry : kNames) {
+        if (std::strcmp(name, entry.name) == 0) {
+            *type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int usage() {
+    std::fprintf(stderr,
+            "usage: golden_test [--record] [--budget FILE] [--tolerance T]\n"
+            "                   [--delegate cpu|xnnpack|gpu|nnapi] [--threads N] [--repeat N]\n"
+            "                   [--rate HZ] model.tflite golden.txt [clip ...]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    // ====================================================================
+    // STEP 1: Parse Arguments
+    // ====================================================================
+    MLProcessorConfig config;
+    config.allowDelegateFallback = false;
+    bool record = false;
+    const char* budgetPath = nullptr;
+    float tolerance = 1e-4f;
+    int repeat = 3;
+    int rawSampleRate = 44100;
+    std::vector<const char*> positional;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (arg[0] != '-' || arg[1] != '-') {
+            positional.push_back(arg);
+            continue;
+        }
+        if (std::strcmp(arg, "--record") == 0) {
+            record = true;
+            continue;
+        }
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) return usage();
+        i++;
+        if (std::strcmp(arg, "--budget") == 0) {
+            budgetPath = value;
+        } else if (std::strcmp(arg, "--tolerance") == 0) {
+            tolerance = static_cast<float>(std::atof(value));
+        } else if (std::strcmp(arg, "--delegate") == 0) {
+            if (!parseDelegate(value, &config.delegate)) return usage();
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.numThreads = std::atoi(value);
+        } else if (std::strcmp(arg, "--repeat") == 0) {
+            repeat = std::atoi(value);
+        } else if (std::strcmp(arg, "--rate") == 0) {
+            rawSampleRate = std::atoi(value);
+        } else {
+            return usage();
+        }
+    }
+    if (positional.size() < 2 || !(tolerance >= 0.0f) || repeat < 0 || rawSampleRate < 1) {
+        return usage();
+    }
+    if (record && config.delegate != DelegateType::Cpu) {
+        std::fprintf(stderr, "golden vectors are recorded on the CPU reference\n");
+        return 2;
+    }
+
+    // ====================================================================
+    // STEP 2: Create the Processor
+    // ====================================================================
+    MLProcessor processor(positional[0], config);
+    if (!processor.isInitialized()) {
+        std::fprintf(stderr, "failed to initialize MLProcessor for %s\n", positional[0]);
+        return 1;
+    }
+    // Every window goes through the model, also on the decision paths
+    processor.setDecisionThresholds(-1.0f, 0.0f);
+
+    const int window = processor.getWindowLength();
+    const int classes = processor.getOutputSize();
+    if (!processor.configureStream(window, (kBatchWindows + 1) * window, kBatchWindows)) {
+        std::fprintf(stderr, "failed to configure a %d-window stream\n", kBatchWindows);
+        return 1;
+    }
+
+    // ====================================================================
+    // STEP 3: Clips and Reference Scores
+    // ====================================================================
+    const int sampleRate = processor.getModelSampleRate() > 0 ? processor.getModelSampleRate()
+                                                              : 44100;
+    std::vector<Clip> clips = builtInClips(sampleRate);
+    for (size_t f = 2; f < positional.size(); f++) {
+        Clip clip;
+        if (!loadClip(positional[f], rawSampleRate, &clip)) {
+            return 1;
+        }
+        clips.push_back(std::move(clip));
+    }
+
+    std::vector<ClipInputs> inputs;
+    for (Clip& clip : clips) {
+        clip.windowLength = window;
+        clip.samples.resize(static_cast<size_t>(clip.windows()) * window);
+        if (clip.windows() == 0) {
+            std::fprintf(stderr, "%s: shorter than one %d-sample window\n", clip.label.c_str(),
+                         window);
+            return 1;
+        }
+        clip.reference.resize(static_cast<size_t>(clip.windows()) * classes);
+        for (int w = 0; w < clip.windows(); w++) {
+            std::vector<float> scores = processor.processAudio(clip.window(w), window);
+            if (static_cast<int>(scores.size()) != classes) {
+                std::fprintf(stderr, "reference inference failed on %s window %d\n",
+                             clip.label.c_str(), w);
+                return 1;
+            }
+            std::copy(scores.begin(), scores.end(), clip.reference.begin() + w * classes);
+        }
+        inputs.push_back(prepareInputs(clip));
+    }
+
+    if (record) {
+        if (!writeGolden(positional[1], clips, classes)) {
+            return 1;
+        }
+        std::printf("recorded %zu clips (%d-sample windows, %d classes) to %s\n", clips.size(),
+                    window, classes, positional[1]);
+        return 0;
+    }
+
+    std::vector<std::vector<float>> golden;
+    std::vector<Budget> budgets;
+    if (!readGolden(positional[1], clips, classes, &golden) ||
+        (budgetPath && !readBudget(budgetPath, &budgets))) {
+        return 1;
+    }
+
+    // ====================================================================
+    // STEP 4: Check Every Path
+    // ====================================================================
+    RunContext ctx{processor, classes, {}, {}, {}, {}};
+    ctx.scores.resize(static_cast<size_t>(kBatchWindows) * classes);
+    ctx.windowStarts.resize(kBatchWindows);
+    ctx.padding.assign(static_cast<size_t>(kBatchWindows) * window, 0);
+    std::vector<double> latencies;  // Sized per path by checkPath
+
+    std::printf("golden_test: %s, %s, %d threads, %s kernels, %zu clips, tolerance %g\n",
+                positional[0], delegateTypeName(processor.getActiveDelegate()),
+                processor.getNumThreads(), AUDIO_KERNELS_NEON ? "neon" : "scalar", clips.size(),
+                tolerance);
+    std::printf("%-9s %8s %10s %8s %10s %12s  %s\n", "path", "windows", "max_error",
+                "top1_bad", "p95_us", "allocs/win", "result");
+
+    bool passed = true;
+    for (Path path : kPaths) {
+        PathResult result = checkPath(ctx, path, clips, inputs, golden, tolerance, repeat,
+                                      &latencies);
+        std::string verdict;
+        if (result.failed) {
+            verdict = "FAIL (inference)";
+        } else if (result.maxError > tolerance || result.topMismatches > 0) {
+            verdict = "FAIL (outputs, worst " + result.worstWindow + ")";
+        }
+        for (const Budget& budget : budgets) {
+            if (budget.path != pathName(path) || result.failed || repeat == 0) continue;
+            if (result.p95Us > budget.p95Us) {
+                verdict += verdict.empty() ? "FAIL (p95 latency)" : " (p95 latency)";
+            }
+            if (result.allocationsPerWindow > budget.allocationsPerWindow) {
+                verdict += verdict.empty() ? "FAIL (allocations)" : " (allocations)";
+            }
+        }
+        passed = passed && verdict.empty();
+
+        std::printf("%-9s %8d %10.3g %8d %10.1f %12.3f  %s\n", pathName(path), result.windows,
+                    result.maxError, result.topMismatches, result.p95Us,
+                    result.allocationsPerWindow, verdict.empty() ? "ok" : verdict.c_str());
+    }
+
+    std::printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,428 @@
+// ============================================================================
+// MLPROCESSOR END-TO-END BENCHMARK
+// ============================================================================
+//
+// Replays PCM / WAV corpora through MLProcessor window by window and
+// reports per-window latency percentiles, throughput and heap allocations
+// per call, so inference cost can be measured on a desktop or an aarch64
+// board (or through adb) and compared between releases.
+//
+// Usage: ml_bench [options] model.tflite corpus [corpus ...]
+//
+//   corpus            16-bit PCM .wav file (first channel is used) or raw
+//                     little-endian mono int16 PCM
+//   --mode M          view (processAudioView, default), vector (processAudio)
+//                     or classify (classify, RMS gate disabled)
+//   --delegate D      cpu | xnnpack | gpu | nnapi (default cpu)
+//   --threads N       interpreter threads (default 2)
+//   --hop N           samples between windows (default: the model's window)
+//   --repeat N        passes over the corpus (default 1)
+//   --warmup N        untimed windows before measuring (default 16)
+//   --rate HZ         sample rate of raw PCM files (default 44100)
+//   --pin             build and invoke the interpreter on the performance
+//                     cluster (ThreadPolicy::pinPerformanceCores)
+//
+// The report is one JSON object with one key per line (including the
+// processor's own per-stage histograms), written to stdout (library logs go
+// to stderr, see ml_log.h), so two runs can be compared with a plain diff.
+//
+// =============================================================================
+
+#include "ml_processor.h"
+#include "alloc_counter.h"
+#include "audio_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// CORPUS LOADING
+// ============================================================================
+
+/**
+ * One audio file of the corpus, as mono 16-bit samples.
+ */
+struct CorpusFile {
+    std::string path;
+    std::vector<int16_t> samples;
+    int sampleRate = 0;
+};
+
+static uint32_t readLE32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+/**
+ * Extract the first channel of a 16-bit PCM WAV image.
+ *
+ * This method:
+ * 1. Walks the RIFF chunks looking for "fmt " and "data"
+ * 2. Rejects anything but uncompressed 16-bit PCM
+ * 3. Copies every channels-th sample (channel 0)
+ */
+static bool parseWav(const std::vector<uint8_t>& bytes, CorpusFile* file) {
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 ||
+        std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    int channels = 0;
+    int bitsPerSample = 0;
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const uint8_t* chunk = bytes.data() + pos;
+        const size_t chunkSize = readLE32(chunk + 4);
+        const size_t body = pos + 8;
+        const size_t available = std::min(chunkSize, bytes.size() - body);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            const uint16_t format = readLE16(chunk + 8);
+            channels = readLE16(chunk + 10);
+            file->sampleRate = static_cast<int>(readLE32(chunk + 12));
+            bitsPerSample = readLE16(chunk + 22);
+            // 1 = PCM, 0xFFFE = WAVE_FORMAT_EXTENSIBLE (PCM subformat assumed)
+            if ((format != 1 && format != 0xFFFE) || bitsPerSample != 16 || channels < 1) {
+                std::fprintf(stderr, "%s: only 16-bit PCM WAV is supported\n",
+                             file->path.c_str());
+                return false;
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0 && channels > 0) {
+            const size_t frames = available / (2 * channels);
+            file->samples.resize(frames);
+            for (size_t i = 0; i < frames; i++) {
+                file->samples[i] = static_cast<int16_t>(
+                        readLE16(bytes.data() + body + i * 2 * channels));
+            }
+            return true;
+        }
+
+        // Chunks are padded to an even size
+        pos = body + chunkSize + (chunkSize & 1);
+    }
+
+    std::fprintf(stderr, "%s: no PCM data chunk\n", file->path.c_str());
+    return false;
+}
+
+/**
+ * Load one corpus file: WAV if it has a RIFF header, raw int16 otherwise.
+ */
+static bool loadCorpusFile(const char* path, int rawSampleRate, CorpusFile* file) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        std::fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t block[65536];
+    size_t n;
+    while ((n = std::fread(block, 1, sizeof(block), f)) > 0) {
+        bytes.insert(bytes.end(), block, block + n);
+    }
+    std::fclose(f);
+
+    file->path = path;
+    if (bytes.size() >= 4 && std::memcmp(bytes.data(), "RIFF", 4) == 0) {
+        return parseWav(bytes, file);
+    }
+
+    file->sampleRate = rawSampleRate;
+    file->samples.resize(bytes.size() / 2);
+    for (size_t i = 0; i < file->samples.size(); i++) {
+        file->samples[i] = static_cast<int16_t>(readLE16(bytes.data() + i * 2));
+    }
+    return true;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+enum class Mode { View, Vector, Classify };
+
+static const char* modeName(Mode mode) {
+    switch (mode) {
+        case Mode::View: return "view";
+        case Mode::Vector: return "vector";
+        case Mode::Classify: return "classify";
+    }
+    return "unknown";
+}
+
+/**
+ * Run one window through the processor in the selected mode.
+ *
+ * @return false if inference failed
+ */
+static bool runWindow(MLProcessor& processor, Mode mode, const int16_t* window,
+                      float* sink) {
+    switch (mode) {
+        case Mode::View: {
+            int length = 0;
+            const float* scores = processor.processAudioView(window, processor.getWindowLength(),
+                                                              &length);
+            if (!scores) return false;
+            *sink += scores[0];
+            return true;
+        }
+        case Mode::Vector: {
+            std::vector<float> scores = processor.processAudio(window, processor.getWindowLength());
+            if (scores.empty()) return false;
+            *sink += scores[0];
+            return true;
+        }
+        case Mode::Classify: {
+            ClassificationResult result = processor.classify(window, processor.getWindowLength());
+            if (result.windows < 0) return false;
+            *sink += result.score;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Value at quantile q (0..1) of an ascending-sorted sample, nearest rank.
+ */
+static double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(q * sorted.size() + 0.5);
+    rank = rank < 1 ? 1 : (rank > sorted.size() ? sorted.size() : rank);
+    return sorted[rank - 1];
+}
+
+static bool parseDelegate(const char* name, DelegateType* type) {
+    static const struct { const char* name; DelegateType type; } kNames[] = {
+        {"cpu", DelegateType::Cpu}, {"xnnpack", DelegateType::XnnPack},
+        {"gpu", DelegateType::Gpu}, {"nnapi", DelegateType::Nnapi},
+    };
+    for (const auto& entry : kNames) {
+        if (std::strcmp(name, entry.name) == 0) {
+            *type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int usage() {
+    std::fprintf(stderr,
+            "usage: ml_bench [--mode view|vector|classify] [--delegate cpu|xnnpack|gpu|nnapi]\n"
+            "                [--threads N] [--hop N] [--repeat N] [--warmup N] [--rate HZ]\n"
+            "                [--pin] model.tflite corpus [corpus ...]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    // ====================================================================
+    // STEP 1: Parse Arguments
+    // ====================================================================
+    Mode mode = Mode::View;
+    MLProcessorConfig config;
+    config.allowDelegateFallback = false;
+    int hop = 0;  // 0 = one window
+    int repeat = 1;
+    int warmup = 16;
+    int rawSampleRate = 44100;
+    std::vector<const char*> positional;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg[0] != '-' || arg[1] != '-') {
+            positional.push_back(arg);
+            continue;
+        }
+        if (std::strcmp(arg, "--pin") == 0) {
+            config.threadPolicy.pinPerformanceCores = true;
+            continue;
+        }
+        if (!value) return usage();
+        i++;
+        if (std::strcmp(arg, "--mode") == 0) {
+            if (std::strcmp(value, "view") == 0) mode = Mode::View;
+            else if (std::strcmp(value, "vector") == 0) mode = Mode::Vector;
+            else if (std::strcmp(value, "classify") == 0) mode = Mode::Classify;
+            else return usage();
+        } else if (std::strcmp(arg, "--delegate") == 0) {
+            if (!parseDelegate(value, &config.delegate)) return usage();
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.numThreads = std::atoi(value);
+        } else if (std::strcmp(arg, "--hop") == 0) {
+            hop = std::atoi(value);
+        } else if (std::strcmp(arg, "--repeat") == 0) {
+            repeat = std::atoi(value);
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            warmup = std::atoi(value);
+        } else if (std::strcmp(arg, "--rate") == 0) {
+            rawSampleRate = std::atoi(value);
+        } else {
+            return usage();
+        }
+    }
+    if (positional.size() < 2 || hop < 0 || repeat < 1 || warmup < 0 || rawSampleRate < 1) {
+        return usage();
+    }
+
+    // ====================================================================
+    // STEP 2: Create the Processor
+    // ====================================================================
+    MLProcessor processor(positional[0], config);
+    if (!processor.isInitialized()) {
+        std::fprintf(stderr, "failed to initialize MLProcessor for %s\n", positional[0]);
+        return 1;
+    }
+    // Every window goes through the model, also in classify mode
+    processor.setDecisionThresholds(-1.0f, 0.0f);
+
+    // The window length comes from the model's input shape. A stateful
+    // model steps through each file: its state already covers the overlap.
+    const size_t window = static_cast<size_t>(processor.getWindowLength());
+    if (hop == 0 || processor.isStateful()) {
+        hop = static_cast<int>(window);
+    }
+
+    // ====================================================================
+    // STEP 3: Load the Corpus
+    // ====================================================================
+    std::vector<CorpusFile> corpus(positional.size() - 1);
+    size_t windowsPerPass = 0;
+    double audioSecondsPerPass = 0.0;
+    for (size_t f = 0; f < corpus.size(); f++) {
+        if (!loadCorpusFile(positional[f + 1], rawSampleRate, &corpus[f])) {
+            return 1;
+        }
+        const size_t samples = corpus[f].samples.size();
+        if (samples >= window) {
+            windowsPerPass += (samples - window) / hop + 1;
+        }
+        audioSecondsPerPass += static_cast<double>(samples) / corpus[f].sampleRate;
+    }
+    if (windowsPerPass == 0) {
+        std::fprintf(stderr, "corpus has no complete %zu-sample window\n", window);
+        return 1;
+    }
+
+    // ====================================================================
+    // STEP 4: Warm Up
+    // ====================================================================
+    float sink = 0.0f;
+    for (int w = 0; w < warmup; w++) {
+        const CorpusFile& file = corpus[w % corpus.size()];
+        if (file.samples.size() >= window &&
+            !runWindow(processor, mode, file.samples.data(), &sink)) {
+            std::fprintf(stderr, "inference failed during warm-up\n");
+            return 1;
+        }
+    }
+
+    // ====================================================================
+    // STEP 5: Timed Replay
+    // ====================================================================
+    // Latencies are preallocated so the loop itself does not allocate
+    std::vector<double> latencies;
+    latencies.reserve(windowsPerPass * repeat);
+    processor.getStats().reset();
+    processor.resetCoreUsage();
+
+    const uint64_t allocationsBefore = allocationCount();
+    const uint64_t bytesBefore = allocationBytes();
+    const auto runStart = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < repeat; pass++) {
+        for (const CorpusFile& file : corpus) {
+            const size_t samples = file.samples.size();
+            processor.resetStream();  // Zeroes a stateful model's state
+            for (size_t start = 0; start + window <= samples; start += hop) {
+                const auto t0 = std::chrono::steady_clock::now();
+                if (!runWindow(processor, mode, file.samples.data() + start, &sink)) {
+                    std::fprintf(stderr, "inference failed on %s at sample %zu\n",
+                                 file.path.c_str(), start);
+                    return 1;
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            }
+        }
+    }
+
+    const auto runEnd = std::chrono::steady_clock::now();
+    const uint64_t allocations = allocationCount() - allocationsBefore;
+    const uint64_t bytes = allocationBytes() - bytesBefore;
+
+    // ====================================================================
+    // STEP 6: Report
+    // ====================================================================
+    const double wallSeconds = std::chrono::duration<double>(runEnd - runStart).count();
+    const double windows = static_cast<double>(latencies.size());
+    double meanUs = 0.0;
+    for (double us : latencies) meanUs += us;
+    meanUs /= windows;
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("{\n");
+    std::printf("  \"model\": \"%s\",\n", positional[0]);
+    std::printf("  \"mode\": \"%s\",\n", modeName(mode));
+    std::printf("  \"delegate\": \"%s\",\n", delegateTypeName(processor.getActiveDelegate()));
+    std::printf("  \"threads\": %d,\n", processor.getNumThreads());
+    std::printf("  \"kernels\": \"%s\",\n", AUDIO_KERNELS_NEON ? "neon" : "scalar");
+    std::printf("  \"files\": %zu,\n", corpus.size());
+    std::printf("  \"window\": %zu,\n", window);
+    std::printf("  \"hop\": %d,\n", hop);
+    std::printf("  \"stateful\": %s,\n", processor.isStateful() ? "true" : "false");
+    std::printf("  \"windows\": %zu,\n", latencies.size());
+    std::printf("  \"latency_us_min\": %.2f,\n", latencies.front());
+    std::printf("  \"latency_us_mean\": %.2f,\n", meanUs);
+    std::printf("  \"latency_us_p50\": %.2f,\n", percentile(latencies, 0.50));
+    std::printf("  \"latency_us_p95\": %.2f,\n", percentile(latencies, 0.95));
+    std::printf("  \"latency_us_p99\": %.2f,\n", percentile(latencies, 0.99));
+    std::printf("  \"latency_us_max\": %.2f,\n", latencies.back());
+    std::printf("  \"windows_per_s\": %.1f,\n", windows / wallSeconds);
+    std::printf("  \"realtime_factor\": %.1f,\n", audioSecondsPerPass * repeat / wallSeconds);
+    std::printf("  \"allocations_per_window\": %.3f,\n", allocations / windows);
+    std::printf("  \"allocated_bytes_per_window\": %.1f,\n", bytes / windows);
+    // Built-in stage histograms (bucketed, see ml_stats.h)
+    for (int stage = 0; stage < kStageCount; stage++) {
+        const MLStage id = static_cast<MLStage>(stage);
+        if (id == MLStage::Jni) continue;  // No JNI layer on this path
+        const StageSummary summary = processor.getStats().snapshot(id);
+        std::printf("  \"stage_%s_us_p50\": %.2f,\n", stageName(id), summary.p50Us);
+        std::printf("  \"stage_%s_us_p99\": %.2f,\n", stageName(id), summary.p99Us);
+    }
+    // What the processor accounts for (see MemoryReport)
+    const MemoryReport memory = processor.getMemoryReport();
+    std::printf("  \"memory_model_bytes\": %lld,\n", static_cast<long long>(memory.model.bytes));
+    std::printf("  \"memory_model_resident_bytes\": %lld,\n",
+                static_cast<long long>(memory.model.residentBytes));
+    std::printf("  \"memory_delegate_bytes\": %lld,\n",
+                static_cast<long long>(memory.delegateBytes));
+    std::printf("  \"memory_interpreter_bytes\": %lld,\n",
+                static_cast<long long>(memory.interpreterBytes));
+    std::printf("  \"memory_arena_bytes\": %lld,\n", static_cast<long long>(memory.arenaBytes));
+    std::printf("  \"memory_process_rss_bytes\": %lld,\n",
+                static_cast<long long>(memory.processResidentBytes));
+    // Share of the measured invokes that ran on the performance cluster
+    const CoreUsage cores = processor.getCoreUsage();
+    int64_t performanceInvokes = 0;
+    int64_t totalInvokes = 0;
+    for (int cpu = 0; cpu < cores.cpus; cpu++) {
+        totalInvokes += cores.invokes[cpu];
+        if (cores.performanceCores & (1ULL << cpu)) performanceInvokes += cores.invokes[cpu];
+    }
+    std::printf("  \"pinned\": %s,\n", cores.pinnedCores != 0 ? "true" : "false");
+    std::printf("  \"performance_core_share\": %.3f,\n",
+                totalInvokes > 0 ? static_cast<double>(performanceInvokes) / totalInvokes : 0.0);
+    std::printf("  \"checksum\": %.6f\n", sink);
+    std::printf("}\n");
+    return 0;
+}
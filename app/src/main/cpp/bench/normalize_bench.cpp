@@ -0,0 +1,151 @@
+// ============================================================================
+// NORMALIZATION MICROBENCHMARK
+// ============================================================================
+//
+// Compares the original two-pass scalar normalization from processAudio
+// (convert + track max, then divide) against normalizeInt16ToFloat from
+// audio_kernels.h on model-sized windows, and the generic peak + convert
+// kernels against the fixed-length variants MLProcessor selects at load
+// time (peakKernelFor / convertKernelFor).
+//
+// Usage: normalize_bench [iterations]
+//
+// =============================================================================
+
+#include "audio_kernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Window size of the bundled classifier model (see MLProcessor::getWindowLength)
+static const int kWindowLen = 512;
+
+// Number of distinct windows cycled through, so the input is not always
+// the same cache line pattern
+static const int kNumWindows = 64;
+
+/**
+ * Reference implementation: the loops processAudio used before the kernel.
+ */
+static float legacyNormalize(const int16_t* audioData, float* floatData, int length) {
+    float maxAmplitude = 0.0f;
+    for (int i = 0; i < length; i++) {
+        floatData[i] = static_cast<float>(audioData[i]);
+        float absValue = std::abs(floatData[i]);
+        if (absValue > maxAmplitude) {
+            maxAmplitude = absValue;
+        }
+    }
+
+    if (maxAmplitude > 0.0f) {
+        for (int i = 0; i < length; i++) {
+            floatData[i] = floatData[i] / maxAmplitude;
+        }
+    }
+    return maxAmplitude;
+}
+
+/**
+ * Peak + scaled conversion with the generic kernels.
+ */
+static float genericWindow(const int16_t* audioData, float* floatData, int length) {
+    const int32_t peak = peakAbsInt16(audioData, length);
+    convertInt16ToFloat(audioData, floatData, length, peak > 0 ? 1.0f / peak : 1.0f);
+    return static_cast<float>(peak);
+}
+
+/**
+ * Peak + scaled conversion with the kernels selected for kWindowLen.
+ */
+static float fixedWindow(const int16_t* audioData, float* floatData, int length) {
+    static const PeakKernel peakKernel = peakKernelFor(kWindowLen);
+    static const ConvertKernel convertKernel = convertKernelFor(kWindowLen);
+    const int32_t peak = peakKernel(audioData, length);
+    convertKernel(audioData, floatData, length, peak > 0 ? 1.0f / peak : 1.0f);
+    return static_cast<float>(peak);
+}
+
+/**
+ * Run `fn` over all windows `iterations` times and return ns per window.
+ */
+template <typename Fn>
+static double timeWindows(Fn fn, const std::vector<int16_t>& input,
+                          std::vector<float>& output, int iterations, float* sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        const int w = it % kNumWindows;
+        *sink += fn(input.data() + w * kWindowLen, output.data(), kWindowLen);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    // Synthetic dial-tone-like input with a varying amplitude per window,
+    // including a full-scale -32768 sample to exercise the edge case
+    std::vector<int16_t> input(kNumWindows * kWindowLen);
+    for (int w = 0; w < kNumWindows; w++) {
+        const double amplitude = 1000.0 + 30000.0 * w / kNumWindows;
+        for (int i = 0; i < kWindowLen; i++) {
+            const double t = i / 44100.0;
+            const double v = amplitude * 0.5 *
+                    (std::sin(2.0 * M_PI * 697.0 * t) + std::sin(2.0 * M_PI * 1209.0 * t));
+            input[w * kWindowLen + i] = static_cast<int16_t>(v);
+        }
+    }
+    input[kWindowLen / 2] = -32768;
+
+    // Correctness: largest deviation between the two implementations
+    std::vector<float> expected(kWindowLen), actual(kWindowLen);
+    float maxError = 0.0f;
+    for (int w = 0; w < kNumWindows; w++) {
+        legacyNormalize(input.data() + w * kWindowLen, expected.data(), kWindowLen);
+        normalizeInt16ToFloat(input.data() + w * kWindowLen, actual.data(), kWindowLen);
+        for (int i = 0; i < kWindowLen; i++) {
+            maxError = std::fmax(maxError, std::fabs(expected[i] - actual[i]));
+        }
+    }
+
+    // The fixed-length kernels must match the generic ones bit for bit
+    bool fixedMatches = true;
+    for (int w = 0; w < kNumWindows; w++) {
+        genericWindow(input.data() + w * kWindowLen, expected.data(), kWindowLen);
+        fixedWindow(input.data() + w * kWindowLen, actual.data(), kWindowLen);
+        for (int i = 0; i < kWindowLen; i++) {
+            fixedMatches = fixedMatches && expected[i] == actual[i];
+        }
+    }
+
+    // Timing (warm both paths once before measuring)
+    std::vector<float> output(kWindowLen);
+    float sink = 0.0f;
+    timeWindows(legacyNormalize, input, output, kNumWindows, &sink);
+    timeWindows(normalizeInt16ToFloat, input, output, kNumWindows, &sink);
+    const double legacyNs = timeWindows(legacyNormalize, input, output, iterations, &sink);
+    const double kernelNs = timeWindows(normalizeInt16ToFloat, input, output, iterations, &sink);
+    timeWindows(genericWindow, input, output, kNumWindows, &sink);
+    timeWindows(fixedWindow, input, output, kNumWindows, &sink);
+    const double genericNs = timeWindows(genericWindow, input, output, iterations, &sink);
+    const double fixedNs = timeWindows(fixedWindow, input, output, iterations, &sink);
+
+    std::printf("implementation: %s\n", AUDIO_KERNELS_NEON ? "neon" : "scalar");
+    std::printf("window: %d samples, iterations: %d\n", kWindowLen, iterations);
+    std::printf("legacy loops:   %8.1f ns/window\n", legacyNs);
+    std::printf("fused kernel:   %8.1f ns/window\n", kernelNs);
+    std::printf("speedup:        %8.2fx\n", legacyNs / kernelNs);
+    std::printf("generic window: %8.1f ns/window\n", genericNs);
+    std::printf("fixed window:   %8.1f ns/window (%s)\n", fixedNs,
+                peakKernelFor(kWindowLen) != peakAbsInt16 ? "specialized" : "generic");
+    std::printf("max abs error:  %g\n", maxError);
+    std::printf("fixed == generic: %s\n", fixedMatches ? "yes" : "no");
+    std::printf("(checksum %f)\n", sink);
+
+    // Reciprocal multiply vs. division differs by at most a couple of ULPs
+    return maxError < 1e-6f && fixedMatches ? 0 : 1;
+}
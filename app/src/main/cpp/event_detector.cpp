@@ -0,0 +1,160 @@
+// ============================================================================
+// EVENT DETECTOR - IMPLEMENTATION
+// ============================================================================
+
+#include "event_detector.h"
+#include "ml_log.h"
+
+#include <cstddef>
+
+// ============================================================================
+// EVENT DETECTOR CLASS IMPLEMENTATION
+// ============================================================================
+
+bool EventDetector::configure(int classCount, int smoothingWindows,
+                              float onLevel, float offLevel) {
+    if (classCount <= 0 || smoothingWindows < 1 || offLevel > onLevel) {
+        LOG_ERROR("Invalid event detector (%d classes, %d windows, on %.2f, off %.2f)",
+                  classCount, smoothingWindows, onLevel, offLevel);
+        return false;
+    }
+
+    classes = classCount;
+    smoothing = smoothingWindows;
+    onThreshold = onLevel;
+    offThreshold = offLevel;
+    history.assign(static_cast<size_t>(classes) * smoothing, 0.0f);
+    average.assign(static_cast<size_t>(classes), 0.0f);
+    queue.assign(kQueueCapacity, ClassEvent());
+    reset();
+    return true;
+}
+
+void EventDetector::reset() {
+    historyPos = 0;
+    historyCount = 0;
+    activeClass = -1;
+    activePeak = 0.0f;
+    activeOnset = 0;
+    lastWindowEnd = 0;
+    queueHead = 0;
+    queueCount = 0;
+    droppedEvents = 0;
+}
+
+/**
+ * Add one window and update the active class.
+ *
+ * This method:
+ * 1. Stores the row in the history ring and recomputes the average
+ * 2. Ends the active class if its average fell below offThreshold, or if
+ *    another class is above onThreshold and ahead of it
+ * 3. Starts the best class if none is active and it is above onThreshold
+ */
+void EventDetector::addWindow(const float* scores, int64_t windowStart, int64_t windowEnd) {
+    if (!isConfigured()) {
+        return;
+    }
+
+    // ====================================================================
+    // STEP 1: Moving Average
+    // ====================================================================
+    float* row = history.data() + static_cast<size_t>(historyPos) * classes;
+    for (int c = 0; c < classes; c++) {
+        row[c] = scores[c];
+    }
+    historyPos = historyPos + 1 < smoothing ? historyPos + 1 : 0;
+    if (historyCount < smoothing) {
+        historyCount++;
+    }
+
+    // Recomputed rather than updated incrementally, so float error never
+    // accumulates over a long stream (smoothing x classes adds)
+    for (int c = 0; c < classes; c++) {
+        average[c] = 0.0f;
+    }
+    for (int r = 0; r < historyCount; r++) {
+        const float* values = history.data() + static_cast<size_t>(r) * classes;
+        for (int c = 0; c < classes; c++) {
+            average[c] += values[c];
+        }
+    }
+    const float scale = 1.0f / static_cast<float>(historyCount);
+    int best = 0;
+    for (int c = 0; c < classes; c++) {
+        average[c] *= scale;
+        if (average[c] > average[best]) {
+            best = c;
+        }
+    }
+
+    // ====================================================================
+    // STEP 2: End the Active Class
+    // ====================================================================
+    if (activeClass >= 0) {
+        const float level = average[activeClass];
+        const bool replaced = best != activeClass && average[best] > onThreshold &&
+                              average[best] > level;
+        if (level < offThreshold || replaced) {
+            closeSegment();
+        } else if (level > activePeak) {
+            activePeak = level;
+        }
+    }
+
+    // ====================================================================
+    // STEP 3: Start a Class
+    // ====================================================================
+    if (activeClass < 0 && average[best] > onThreshold) {
+        activeClass = best;
+        activePeak = average[best];
+        activeOnset = windowStart;
+
+        ClassEvent onset;
+        onset.classIndex = best;
+        onset.score = average[best];
+        onset.onsetSample = windowStart;
+        emit(onset);
+    }
+
+    lastWindowEnd = windowEnd;
+}
+
+void EventDetector::endSegment() {
+    if (activeClass >= 0) {
+        closeSegment();
+    }
+    historyPos = 0;
+    historyCount = 0;
+}
+
+void EventDetector::closeSegment() {
+    ClassEvent offset;
+    offset.classIndex = activeClass;
+    offset.score = activePeak;
+    offset.onsetSample = activeOnset;
+    offset.offsetSample = lastWindowEnd;
+    emit(offset);
+    activeClass = -1;
+}
+
+void EventDetector::emit(const ClassEvent& event) {
+    if (queueCount == kQueueCapacity) {
+        // Keep the newest: consumers act on the current state
+        queueHead = (queueHead + 1) % kQueueCapacity;
+        queueCount--;
+        droppedEvents++;
+    }
+    queue[(queueHead + queueCount) % kQueueCapacity] = event;
+    queueCount++;
+}
+
+int EventDetector::popEvents(ClassEvent* events, int maxEvents) {
+    int count = 0;
+    while (count < maxEvents && queueCount > 0) {
+        events[count++] = queue[queueHead];
+        queueHead = (queueHead + 1) % kQueueCapacity;
+        queueCount--;
+    }
+    return count;
+}
@@ -0,0 +1,137 @@
+// ============================================================================
+// EVENT DETECTOR - HEADER
+// ============================================================================
+//
+// Turns the per-window posteriors of the streaming classifier into class
+// events (a class starts / a class ends) for consumers that only care
+// about changes, such as the UI.
+//
+// Key characteristics:
+// - Smoothing: Moving average of the last N window posteriors, so a single
+//   window scoring around the threshold does not flicker
+// - Hysteresis: A class turns on above onThreshold and only turns off
+//   below offThreshold (or when another class takes over)
+// - Timestamps: Onset / offset sample positions on the stream clock
+// - Allocation-free: History and the event queue are sized by configure()
+//
+// Not thread-safe: owned by the consumer (inference) thread.
+//
+// =============================================================================
+
+#ifndef EVENT_DETECTOR_H
+#define EVENT_DETECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// CLASS EVENT
+// ============================================================================
+/**
+ * One class change.
+ *
+ * Onset events (offsetSample == -1) mark the first window of a class;
+ * offset events repeat its onset and add the end of its last window.
+ */
+struct ClassEvent {
+    int classIndex = -1;         // Class that started or ended
+    float score = 0.0f;          // Smoothed score at onset, peak smoothed score at offset
+    int64_t onsetSample = 0;     // Start of the first window of the class
+    int64_t offsetSample = -1;   // End of its last window, -1 for onset events
+
+    bool isOnset() const { return offsetSample < 0; }
+};
+
+// ============================================================================
+// EVENT DETECTOR CLASS
+// ============================================================================
+class EventDetector {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    int classes = 0;
+    int smoothing = 0;
+    float onThreshold = 0.0f;
+    float offThreshold = 0.0f;
+
+    // Last `smoothing` posterior rows (ring) and their average
+    std::vector<float> history;
+    std::vector<float> average;
+    int historyPos = 0;
+    int historyCount = 0;
+
+    // Current segment (activeClass == -1 if no class is on)
+    int activeClass = -1;
+    float activePeak = 0.0f;
+    int64_t activeOnset = 0;
+    int64_t lastWindowEnd = 0;
+
+    // Events not yet collected with popEvents (ring; the oldest is
+    // overwritten when it is full)
+    static const int kQueueCapacity = 64;
+    std::vector<ClassEvent> queue;
+    int queueHead = 0;
+    int queueCount = 0;
+    int64_t droppedEvents = 0;
+
+    void emit(const ClassEvent& event);
+    void closeSegment();
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    /**
+     * Allocate storage and reset the detector.
+     *
+     * @param classes Scores per window (model output size)
+     * @param smoothingWindows Windows averaged (1 = no smoothing)
+     * @param onThreshold Smoothed score a class must exceed to start
+     * @param offThreshold Smoothed score below which it ends
+     *                     (at most onThreshold)
+     * @return false if the parameters are invalid
+     */
+    bool configure(int classes, int smoothingWindows, float onThreshold, float offThreshold);
+
+    /** true once configure() succeeded. */
+    bool isConfigured() const { return classes > 0; }
+
+    /**
+     * Add the posteriors of the next window.
+     *
+     * @param scores `classes` scores
+     * @param windowStart Stream position of its first sample
+     * @param windowEnd Stream position after its last sample
+     */
+    void addWindow(const float* scores, int64_t windowStart, int64_t windowEnd);
+
+    /**
+     * The stream was interrupted (e.g. silence): end the active class at
+     * the last window and forget the smoothing history.
+     */
+    void endSegment();
+
+    /**
+     * Forget history, the active class and queued events.
+     */
+    void reset();
+
+    /**
+     * Move queued events, oldest first, into `events`.
+     *
+     * @param events Destination
+     * @param maxEvents Capacity of events
+     * @return Number of events written
+     */
+    int popEvents(ClassEvent* events, int maxEvents);
+
+    /** Class currently on, -1 if none. */
+    int getActiveClass() const { return activeClass; }
+
+    /** Events overwritten because popEvents was not called in time. */
+    int64_t getDroppedEvents() const { return droppedEvents; }
+};
+
+#endif // EVENT_DETECTOR_H
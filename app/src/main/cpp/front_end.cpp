@@ -0,0 +1,397 @@
+// ============================================================================
+// AUDIO FRONT END - IMPLEMENTATION
+// ============================================================================
+
+#include "front_end.h"
+#include "audio_kernels.h"
+#include "ml_log.h"
+
+#include <cmath>
+
+static const double kPi = 3.14159265358979323846;
+
+// Kaiser window shape: ~80 dB stop-band attenuation for the resampler
+static const double kKaiserBeta = 8.0;
+
+// Resampler cut-off as a fraction of the lower Nyquist frequency; the rest
+// is the filter's transition band
+static const double kResamplerRolloff = 0.9;
+
+// Added before the log so silent bands stay finite
+static const float kMelFloor = 1e-10f;
+
+static int greatestCommonDivisor(int a, int b) {
+    while (b != 0) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * Zeroth-order modified Bessel function of the first kind (power series).
+ */
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+static double hzToMel(double hz) {
+    return 2595.0 * std::log10(1.0 + hz / 700.0);
+}
+
+static double melToHz(double mel) {
+    return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+}
+
+// ============================================================================
+// POLYPHASE RESAMPLER CLASS IMPLEMENTATION
+// ============================================================================
+
+/**
+ * Design the polyphase filter bank.
+ *
+ * This method:
+ * 1. Reduces outputRate / inputRate to L / M
+ * 2. Designs a Kaiser-windowed sinc low-pass of L * taps coefficients at
+ *    L times the input rate, with gain L (zero-stuffing loses a factor L)
+ * 3. Splits it into L branches: branch p holds coefficients p, p + L, ...
+ */
+bool PolyphaseResampler::configure(int inputRate, int outputRate, int tapsPerPhase) {
+    taps = 0;
+    bank.clear();
+    history.clear();
+
+    if (inputRate <= 0 || outputRate <= 0 || tapsPerPhase < 4 || tapsPerPhase > 256) {
+        LOG_ERROR("Invalid resampler %d -> %d Hz (%d taps)", inputRate, outputRate, tapsPerPhase);
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 1: Reduce the Ratio
+    // ====================================================================
+    const int divisor = greatestCommonDivisor(inputRate, outputRate);
+    upFactor = outputRate / divisor;
+    downFactor = inputRate / divisor;
+    if (upFactor == downFactor) {
+        return true;  // Same rate: nothing to do
+    }
+    if (upFactor > kMaxUpFactor) {
+        LOG_ERROR("Resampling %d -> %d Hz needs %d phases (max %d)",
+                  inputRate, outputRate, upFactor, kMaxUpFactor);
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 2: Prototype Low-Pass
+    // ====================================================================
+    const int length = upFactor * tapsPerPhase;
+    const int widest = upFactor > downFactor ? upFactor : downFactor;
+    const double cutoff = 0.5 * kResamplerRolloff / widest;  // Cycles per upsampled sample
+    const double center = 0.5 * (length - 1);
+    const double kaiserNorm = besselI0(kKaiserBeta);
+
+    // ====================================================================
+    // STEP 3: Split into Branches
+    // ====================================================================
+    bank.assign(static_cast<size_t>(length), 0.0f);
+    for (int n = 0; n < length; n++) {
+        const double t = n - center;
+        const double sinc = t == 0.0 ? 1.0 : std::sin(2.0 * kPi * cutoff * t) / (2.0 * kPi * cutoff * t);
+        const double ratio = 2.0 * n / (length - 1) - 1.0;
+        const double kaiser = besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) / kaiserNorm;
+        const double h = 2.0 * cutoff * sinc * kaiser * upFactor;
+
+        // Coefficient n belongs to branch n % L, tap n / L; taps are stored
+        // reversed (oldest sample first)
+        const int branch = n % upFactor;
+        const int tap = n / upFactor;
+        bank[static_cast<size_t>(branch) * tapsPerPhase + (tapsPerPhase - 1 - tap)] =
+                static_cast<float>(h);
+    }
+
+    taps = tapsPerPhase;
+    history.assign(static_cast<size_t>(2 * taps), 0.0f);
+    reset();
+
+    LOG_INFO("Resampler %d -> %d Hz (L=%d, M=%d, %d taps per phase)",
+             inputRate, outputRate, upFactor, downFactor, taps);
+    return true;
+}
+
+void PolyphaseResampler::reset() {
+    for (float& value : history) {
+        value = 0.0f;
+    }
+    historyPos = 0;
+    phase = 0;
+}
+
+int PolyphaseResampler::maxOutput(int inputCount) const {
+    if (!isActive()) {
+        return inputCount;
+    }
+    return static_cast<int>((static_cast<int64_t>(inputCount) * upFactor + downFactor - 1) /
+                            downFactor) + 1;
+}
+
+/**
+ * Convert a block of input samples.
+ *
+ * After each input sample, every output whose time falls before the next
+ * input is produced from the branch matching its fractional position.
+ */
+int PolyphaseResampler::process(const int16_t* input, int count, int16_t* output) {
+    if (!isActive()) {
+        for (int i = 0; i < count; i++) {
+            output[i] = input[i];
+        }
+        return count;
+    }
+
+    int produced = 0;
+    for (int i = 0; i < count; i++) {
+        // Append to both copies of the history, so the newest `taps`
+        // samples are history[historyPos, historyPos + taps)
+        const float sample = static_cast<float>(input[i]);
+        history[historyPos] = sample;
+        history[historyPos + taps] = sample;
+        historyPos = historyPos + 1 < taps ? historyPos + 1 : 0;
+
+        const float* window = history.data() + historyPos;
+        while (phase < upFactor) {
+            const float value = dotProductFloat(window, bank.data() + phase * taps, taps);
+            const float rounded = std::round(value);
+            output[produced++] = static_cast<int16_t>(
+                    rounded > 32767.0f ? 32767 : (rounded < -32768.0f ? -32768 : rounded));
+            phase += downFactor;
+        }
+        phase -= upFactor;
+    }
+    return produced;
+}
+
+// ============================================================================
+// MEL FRONT END CLASS IMPLEMENTATION
+// ============================================================================
+
+/**
+ * Precompute window, FFT tables and filterbank.
+ *
+ * This method:
+ * 1. Validates the frame geometry and frequency range
+ * 2. Builds the scaled Hann window
+ * 3. Builds bit reversal and twiddles of the half-size complex FFT and
+ *    the split factors of the real FFT
+ * 4. Builds the triangular mel filterbank as sparse weight runs
+ */
+bool MelFrontEnd::configure(int sampleRate, int size, int hop, int melBands,
+                            float minFrequency, float maxFrequency) {
+    fftSize = 0;
+
+    // ====================================================================
+    // STEP 1: Validate
+    // ====================================================================
+    const bool powerOfTwo = size > 0 && (size & (size - 1)) == 0;
+    const float nyquist = 0.5f * static_cast<float>(sampleRate);
+    const float topFrequency = maxFrequency > 0.0f && maxFrequency < nyquist ? maxFrequency : nyquist;
+    if (sampleRate <= 0 || !powerOfTwo || size < 16 || size > 4096 || hop <= 0 ||
+        melBands <= 0 || minFrequency < 0.0f || minFrequency >= topFrequency) {
+        LOG_ERROR("Invalid mel front end (%d Hz, fft %d, hop %d, %d bands, %.0f-%.0f Hz)",
+                  sampleRate, size, hop, melBands, minFrequency, maxFrequency);
+        return false;
+    }
+
+    const int half = size / 2;
+    const int bins = half + 1;
+
+    // ====================================================================
+    // STEP 2: Window
+    // ====================================================================
+    window.resize(static_cast<size_t>(size));
+    for (int i = 0; i < size; i++) {
+        window[i] = static_cast<float>((0.5 - 0.5 * std::cos(2.0 * kPi * i / size)) / 32768.0);
+    }
+
+    // ====================================================================
+    // STEP 3: FFT Tables
+    // ====================================================================
+    int bits = 0;
+    while ((1 << bits) < half) bits++;
+    bitReverse.resize(static_cast<size_t>(half));
+    for (int i = 0; i < half; i++) {
+        int reversed = 0;
+        for (int b = 0; b < bits; b++) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitReverse[i] = reversed;
+    }
+
+    twiddleRe.clear();
+    twiddleIm.clear();
+    for (int span = 1; span < half; span <<= 1) {
+        for (int j = 0; j < span; j++) {
+            const double angle = -kPi * j / span;
+            twiddleRe.push_back(static_cast<float>(std::cos(angle)));
+            twiddleIm.push_back(static_cast<float>(std::sin(angle)));
+        }
+    }
+
+    splitRe.resize(static_cast<size_t>(bins));
+    splitIm.resize(static_cast<size_t>(bins));
+    for (int k = 0; k < bins; k++) {
+        const double angle = -2.0 * kPi * k / size;
+        splitRe[k] = static_cast<float>(std::cos(angle));
+        splitIm[k] = static_cast<float>(std::sin(angle));
+    }
+
+    // ====================================================================
+    // STEP 4: Mel Filterbank
+    // ====================================================================
+    const double melLow = hzToMel(minFrequency);
+    const double melHigh = hzToMel(topFrequency);
+    const double binHz = static_cast<double>(sampleRate) / size;
+
+    bandStart.assign(static_cast<size_t>(melBands), 0);
+    bandLength.assign(static_cast<size_t>(melBands), 0);
+    bandOffset.assign(static_cast<size_t>(melBands), 0);
+    bandWeights.clear();
+    for (int b = 0; b < melBands; b++) {
+        const double left = melToHz(melLow + (melHigh - melLow) * b / (melBands + 1));
+        const double center = melToHz(melLow + (melHigh - melLow) * (b + 1) / (melBands + 1));
+        const double right = melToHz(melLow + (melHigh - melLow) * (b + 2) / (melBands + 1));
+
+        bandOffset[b] = static_cast<int>(bandWeights.size());
+        int first = -1;
+        for (int k = 0; k < bins; k++) {
+            const double f = k * binHz;
+            double weight = 0.0;
+            if (f > left && f <= center) {
+                weight = (f - left) / (center - left);
+            } else if (f > center && f < right) {
+                weight = (right - f) / (right - center);
+            }
+            if (weight > 0.0) {
+                if (first < 0) first = k;
+                // Bins between the first and this one stay in the run
+                while (first + static_cast<int>(bandWeights.size()) - bandOffset[b] < k) {
+                    bandWeights.push_back(0.0f);
+                }
+                bandWeights.push_back(static_cast<float>(weight));
+            }
+        }
+
+        if (first < 0) {
+            // Band narrower than a bin (small FFTs): take the nearest bin
+            first = static_cast<int>(std::lround(center / binHz));
+            first = first < bins ? first : bins - 1;
+            bandWeights.push_back(1.0f);
+        }
+        bandStart[b] = first;
+        bandLength[b] = static_cast<int>(bandWeights.size()) - bandOffset[b];
+    }
+
+    frame.assign(static_cast<size_t>(size), 0.0f);
+    re.assign(static_cast<size_t>(half), 0.0f);
+    im.assign(static_cast<size_t>(half), 0.0f);
+    power.assign(static_cast<size_t>(bins), 0.0f);
+
+    fftSize = size;
+    frameHop = hop;
+    bands = melBands;
+    LOG_INFO("Mel front end: %d Hz, fft %d, hop %d, %d bands (%.0f-%.0f Hz)",
+             sampleRate, size, hop, melBands, minFrequency, topFrequency);
+    return true;
+}
+
+int MelFrontEnd::frameCount(int samples) const {
+    if (!isConfigured() || samples < fftSize) {
+        return 0;
+    }
+    return 1 + (samples - fftSize) / frameHop;
+}
+
+int MelFrontEnd::samplesForFeatures(int features) const {
+    if (!isConfigured() || features <= 0 || features % bands != 0) {
+        return 0;
+    }
+    return fftSize + (features / bands - 1) * frameHop;
+}
+
+void MelFrontEnd::compute(const int16_t* samples, int count, float* features) {
+    const int frames = frameCount(count);
+    for (int f = 0; f < frames; f++) {
+        computeFrame(samples + f * frameHop, features + f * bands);
+    }
+}
+
+/**
+ * Log-mel energies of one frame.
+ *
+ * The N real samples are packed as N/2 complex values z[n] = x[2n] +
+ * i x[2n+1]; one N/2-point FFT Z then gives the real spectrum as
+ * X[k] = E[k] + W^k O[k], with E = (Z[k] + conj(Z[N/2-k])) / 2 and
+ * O = (Z[k] - conj(Z[N/2-k])) / 2i.
+ */
+void MelFrontEnd::computeFrame(const int16_t* samples, float* features) {
+    const int half = fftSize / 2;
+
+    // ====================================================================
+    // STEP 1: Window, Pack and Bit-Reverse
+    // ====================================================================
+    multiplyInt16ByFloat(samples, window.data(), frame.data(), fftSize);
+    for (int i = 0; i < half; i++) {
+        const int source = 2 * bitReverse[i];
+        re[i] = frame[source];
+        im[i] = frame[source + 1];
+    }
+
+    // ====================================================================
+    // STEP 2: Half-Size Complex FFT
+    // ====================================================================
+    int offset = 0;
+    for (int span = 1; span < half; span <<= 1) {
+        fftRadix2Stage(re.data(), im.data(), twiddleRe.data() + offset,
+                       twiddleIm.data() + offset, half, span);
+        offset += span;
+    }
+
+    // ====================================================================
+    // STEP 3: Real Power Spectrum (bins 0..N/2)
+    // ====================================================================
+    for (int k = 0; k <= half; k++) {
+        const int a = k < half ? k : 0;
+        const int b = k > 0 ? half - k : 0;
+        const float zr = re[a];
+        const float zi = im[a];
+        const float cr = re[b];
+        const float ci = -im[b];
+
+        const float er = 0.5f * (zr + cr);
+        const float ei = 0.5f * (zi + ci);
+        const float orr = 0.5f * (zi - ci);
+        const float oi = -0.5f * (zr - cr);
+
+        const float xr = er + splitRe[k] * orr - splitIm[k] * oi;
+        const float xi = ei + splitRe[k] * oi + splitIm[k] * orr;
+        power[k] = xr * xr + xi * xi;
+    }
+
+    // ====================================================================
+    // STEP 4: Mel Bands and Log
+    // ====================================================================
+    for (int b = 0; b < bands; b++) {
+        const float energy = dotProductFloat(power.data() + bandStart[b],
+                                             bandWeights.data() + bandOffset[b], bandLength[b]);
+        features[b] = std::log(energy + kMelFloor);
+    }
+}
@@ -0,0 +1,241 @@
+// ============================================================================
+// AUDIO FRONT END - HEADER
+// ============================================================================
+//
+// Optional signal processing between captured audio and the model input.
+//
+// Key characteristics:
+// - Polyphase resampler: Rational-rate conversion (e.g. a 48 kHz device mic
+//   into a 44.1 kHz / 16 kHz model) with a Kaiser-windowed sinc filter
+//   split into L branches, so only the taps of the needed phase run per
+//   output sample
+// - Log-mel features: Framing with a precomputed Hann window, radix-2 real
+//   FFT (split-complex, precomputed twiddles and bit reversal) and a sparse
+//   triangular mel filterbank, for compact models that take features
+//   instead of raw PCM
+// - Allocation-free after configure(): Tables and scratch are sized once;
+//   the per-sample loops are NEON kernels from audio_kernels.h
+//
+// Neither class is thread-safe; each MLProcessor owns its own instances
+// (the resampler on the producer side, the mel stage on the consumer side).
+//
+// =============================================================================
+
+#ifndef FRONT_END_H
+#define FRONT_END_H
+
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// FRONT END CONFIGURATION
+// ============================================================================
+/**
+ * Front-end settings (part of MLProcessorConfig).
+ *
+ * The defaults disable every stage: audio reaches the model unchanged.
+ */
+struct FrontEndConfig {
+    // Sample rate the model was trained at, 0 if unknown. Required for
+    // resampling (see MLProcessor::setStreamInputRate).
+    int modelSampleRate = 0;
+
+    // Rate of the audio pushed into the stream; 0 means modelSampleRate
+    // (no resampling).
+    int inputSampleRate = 0;
+
+    // Filter taps per polyphase branch: more taps give a sharper
+    // anti-aliasing filter at proportionally higher cost.
+    int resamplerTaps = 32;
+
+    // Feed log-mel energies instead of PCM samples to the model. The
+    // float32 input tensor holds frames x melBands values per window, and
+    // the window is the shortest block with that many frames:
+    // fftSize + (frames - 1) * frameHop samples.
+    bool logMel = false;
+    int fftSize = 256;       // Frame length, power of two
+    int frameHop = 128;      // Samples between frames
+    int melBands = 40;
+    float minFrequency = 20.0f;
+    float maxFrequency = 0.0f;  // 0 means Nyquist
+};
+
+// ============================================================================
+// POLYPHASE RESAMPLER CLASS
+// ============================================================================
+/**
+ * Streaming int16 sample-rate converter by a rational factor L / M.
+ *
+ * The prototype low-pass (cut-off at the lower Nyquist frequency) is
+ * designed at L times the input rate and stored as L branches of `taps`
+ * coefficients. Each output sample is one dot product of the last `taps`
+ * input samples with its branch.
+ */
+class PolyphaseResampler {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // Reduced conversion ratio: upFactor / downFactor = output / input
+    int upFactor = 1;
+    int downFactor = 1;
+    int taps = 0;
+
+    // upFactor branches of `taps` coefficients, each stored oldest-sample
+    // first so it lines up with the history window
+    std::vector<float> bank;
+
+    // Last `taps` input samples, stored twice so the window ending at any
+    // position is contiguous
+    std::vector<float> history;
+    int historyPos = 0;
+
+    // Position of the next output between the last two inputs, in units
+    // of 1 / upFactor input samples
+    int phase = 0;
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    // Largest L (after reducing L / M) accepted; 48 kHz <-> 44.1 kHz is 147 / 160
+    static const int kMaxUpFactor = 1024;
+
+    /**
+     * Design the filter bank for inputRate -> outputRate.
+     *
+     * @param inputRate Source sample rate
+     * @param outputRate Target sample rate
+     * @param tapsPerPhase Filter taps per branch (4..256)
+     * @return false if the rates or the ratio are unsupported
+     */
+    bool configure(int inputRate, int outputRate, int tapsPerPhase);
+
+    /**
+     * true once configured with two different rates.
+     */
+    bool isActive() const { return taps > 0; }
+
+    /**
+     * Forget the input history (e.g. before a new recording).
+     */
+    void reset();
+
+    /**
+     * Upper bound of process() output for `inputCount` input samples.
+     */
+    int maxOutput(int inputCount) const;
+
+    /**
+     * Convert a block of input samples.
+     *
+     * @param input Samples at the input rate
+     * @param count Number of input samples
+     * @param output Receives up to maxOutput(count) samples at the output rate
+     * @return Number of output samples written
+     */
+    int process(const int16_t* input, int count, int16_t* output);
+};
+
+// ============================================================================
+// MEL FRONT END CLASS
+// ============================================================================
+/**
+ * Log-mel energies of 16-bit audio.
+ *
+ * For every frame of fftSize samples (frameHop apart): Hann window, power
+ * spectrum of the real FFT, triangular mel bands (HTK mel scale), natural
+ * log. Samples are scaled by 1/32768, so features do not depend on the
+ * capture gain normalization of the raw-PCM path.
+ */
+class MelFrontEnd {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    int fftSize = 0;
+    int frameHop = 0;
+    int bands = 0;
+
+    // Hann window with the 1/32768 sample scale folded in
+    std::vector<float> window;
+
+    // Half-size complex FFT: input permutation and per-stage twiddles
+    // (stage with span h stores h values; stages are concatenated)
+    std::vector<int> bitReverse;
+    std::vector<float> twiddleRe;
+    std::vector<float> twiddleIm;
+
+    // exp(-2 pi i k / fftSize) for splitting the half-size FFT into the
+    // real FFT (k = 0..fftSize / 2)
+    std::vector<float> splitRe;
+    std::vector<float> splitIm;
+
+    // Sparse filterbank: band b covers power bins
+    // [bandStart[b], bandStart[b] + bandLength[b]) with weights at
+    // bandWeights[bandOffset[b]...]
+    std::vector<int> bandStart;
+    std::vector<int> bandLength;
+    std::vector<int> bandOffset;
+    std::vector<float> bandWeights;
+
+    // Scratch for one frame
+    std::vector<float> frame;
+    std::vector<float> re;
+    std::vector<float> im;
+    std::vector<float> power;
+
+    void computeFrame(const int16_t* samples, float* features);
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    /**
+     * Precompute window, FFT tables and filterbank.
+     *
+     * @param sampleRate Rate of the analysed audio
+     * @param fftSize Frame length (power of two, 16..4096)
+     * @param frameHop Samples between frames
+     * @param melBands Number of mel bands
+     * @param minFrequency Lower edge of the first band (Hz)
+     * @param maxFrequency Upper edge of the last band (Hz, 0 = Nyquist)
+     * @return false if the parameters are invalid
+     */
+    bool configure(int sampleRate, int fftSize, int frameHop, int melBands,
+                   float minFrequency, float maxFrequency);
+
+    bool isConfigured() const { return fftSize > 0; }
+    int getBands() const { return bands; }
+
+    /**
+     * Number of whole frames in `samples` samples.
+     */
+    int frameCount(int samples) const;
+
+    /**
+     * Features produced for `samples` samples: frameCount() x bands.
+     */
+    int featureCount(int samples) const { return frameCount(samples) * bands; }
+
+    /**
+     * Shortest block whose features are exactly `features` values (the
+     * inverse of featureCount), or 0 if that is not a whole number of
+     * frames.
+     */
+    int samplesForFeatures(int features) const;
+
+    /**
+     * Compute the log-mel energies of a block.
+     *
+     * @param samples Audio samples (16-bit PCM)
+     * @param count Number of samples
+     * @param features Receives featureCount(count) values, frame-major
+     *                 (frame f, band b at f * bands + b)
+     */
+    void compute(const int16_t* samples, int count, float* features);
+};
+
+#endif // FRONT_END_H
@@ -0,0 +1,403 @@
+// ============================================================================
+// INFERENCE SCHEDULER - IMPLEMENTATION
+// ============================================================================
+//
+// AThermal is resolved with dlsym instead of being linked: the app's minSdk
+// predates it (API 30), the same way AAudio is loaded in audio_capture.cpp.
+//
+// =============================================================================
+
+#include "inference_scheduler.h"
+#include "ml_log.h"
+
+#include <dlfcn.h>
+
+// ============================================================================
+// ATHERMAL ENTRY POINTS
+// ============================================================================
+
+// Opaque AThermalManager (android/thermal.h)
+struct AThermalManager;
+
+/**
+ * The AThermal functions used by the scheduler, resolved from libandroid.so.
+ */
+struct AThermalApi {
+    AThermalManager* (*acquireManager)();
+    int (*getCurrentThermalStatus)(AThermalManager* manager);
+    AThermalManager* manager;
+};
+
+/**
+ * Resolve AThermal and acquire the manager once per process.
+ *
+ * @return Entry points, or nullptr if the thermal API is unavailable
+ */
+static const AThermalApi* athermal() {
+    static const AThermalApi* api = []() -> const AThermalApi* {
+        // Never closed: the manager lives as long as the process
+        void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            LOG_INFO("Thermal status not available on this device");
+            return nullptr;
+        }
+
+        static AThermalApi table;
+        table.acquireManager = reinterpret_cast<AThermalManager* (*)()>(
+                dlsym(library, "AThermal_acquireManager"));
+        table.getCurrentThermalStatus = reinterpret_cast<int (*)(AThermalManager*)>(
+                dlsym(library, "AThermal_getCurrentThermalStatus"));
+        if (!table.acquireManager || !table.getCurrentThermalStatus) {
+            LOG_INFO("Thermal status not available on this device");
+            return nullptr;
+        }
+
+        table.manager = table.acquireManager();
+        if (!table.manager) {
+            LOG_ERROR("Failed to acquire the thermal manager");
+            return nullptr;
+        }
+        return &table;
+    }();
+    return api;
+}
+
+const char* qualityLevelName(QualityLevel level) {
+    switch (level) {
+        case QualityLevel::Full: return "full";
+        case QualityLevel::WideHop: return "wide-hop";
+        case QualityLevel::FewerThreads: return "fewer-threads";
+        case QualityLevel::Delegate: return "delegate";
+        case QualityLevel::LightModel: return "light-model";
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// INFERENCE SCHEDULER CLASS IMPLEMENTATION
+// ============================================================================
+
+InferenceScheduler::InferenceScheduler(MLProcessor& mlProcessor,
+                                       const SchedulerConfig& schedulerConfig)
+    : processor(mlProcessor), config(schedulerConfig) {
+}
+
+InferenceScheduler::~InferenceScheduler() {
+    stop();
+}
+
+int InferenceScheduler::thermalStatus() {
+    const AThermalApi* api = athermal();
+    return api ? api->getCurrentThermalStatus(api->manager) : -1;
+}
+
+/**
+ * Capture the full-quality settings and start the monitor.
+ *
+ * This method:
+ * 1. Validates the thresholds
+ * 2. Records the hop, model and engine settings in effect as level Full
+ * 3. Starts the monitor thread (unless intervalMs is 0)
+ */
+bool InferenceScheduler::start() {
+    if (isRunning()) {
+        LOG_ERROR("Inference scheduler already running");
+        return false;
+    }
+    if (config.intervalMs < 0 || config.recoverIntervals < 1 ||
+        !(config.recoverLoad < config.maxLoad) || config.throttledHop < 0) {
+        LOG_ERROR("Invalid scheduler (interval %d ms, load %.2f..%.2f, recover %d)",
+                  config.intervalMs, config.recoverLoad, config.maxLoad,
+                  config.recoverIntervals);
+        return false;
+    }
+
+    fullHop = processor.getStreamHopSize();
+    if (fullHop <= 0 || !processor.getModel()) {
+        LOG_ERROR("Stream not configured");
+        return false;
+    }
+
+    // The engine as running now: the tuned thread count and the delegate
+    // that was actually selected, without benchmarking again on a restore
+    fullModel = processor.getModel();
+    fullConfig = processor.getConfig();
+    fullConfig.delegate = processor.getActiveDelegate();
+    fullConfig.numThreads = processor.getNumThreads();
+    fullConfig.autoTuneThreads = false;
+
+    level = 0;
+    engineLevel = 0;
+    calmIntervals = 0;
+    for (bool& disabled : stepDisabled) {
+        disabled = false;
+    }
+    processor.getStats().snapshotSince(MLStage::Call, &callMark);
+    lastSample = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(statusMutex);
+        status = SchedulerStatus();
+    }
+
+    running.store(true, std::memory_order_release);
+    if (config.intervalMs > 0) {
+        monitor = std::thread(&InferenceScheduler::runMonitor, this);
+    }
+    LOG_INFO("Inference scheduler started (hop %d, %s, %d threads)", fullHop,
+             delegateTypeName(fullConfig.delegate), fullConfig.numThreads);
+    return true;
+}
+
+void InferenceScheduler::stop() {
+    if (running.exchange(false, std::memory_order_acq_rel)) {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+        wakeCondition.notify_all();
+    }
+    if (monitor.joinable()) {
+        monitor.join();
+    }
+    // The consumer may already be gone (capture or async classifier
+    // closed): publish the full-quality engine without waiting for it, so
+    // stop never blocks. The next inference call, or releaseArenas,
+    // adopts it.
+    if (level != 0) {
+        applyLevel(0, 0);
+    }
+
+    std::lock_guard<std::mutex> lock(statusMutex);
+    status.level = static_cast<QualityLevel>(level);
+}
+
+void InferenceScheduler::runMonitor() {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (running.load(std::memory_order_acquire)) {
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(config.intervalMs));
+        if (!running.load(std::memory_order_acquire)) {
+            break;
+        }
+        lock.unlock();
+        update();
+        lock.lock();
+    }
+}
+
+// ============================================================================
+// QUALITY LADDER
+// ============================================================================
+
+/**
+ * true if a step changes anything and has not failed before.
+ */
+bool InferenceScheduler::stepAvailable(int step) const {
+    if (step <= 0) {
+        return true;
+    }
+    if (step >= kQualityLevels || stepDisabled[step]) {
+        return false;
+    }
+
+    switch (static_cast<QualityLevel>(step)) {
+        case QualityLevel::WideHop:
+            return hopFor(step) > fullHop;
+        case QualityLevel::FewerThreads:
+            return config.throttledThreads > 0 && (fullConfig.numThreads <= 0 ||
+                                                   config.throttledThreads < fullConfig.numThreads);
+        case QualityLevel::Delegate:
+            return config.switchDelegate && config.throttledDelegate != fullConfig.delegate;
+        case QualityLevel::LightModel:
+            return config.throttledModel != nullptr;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Stream hop at a level.
+ */
+int InferenceScheduler::hopFor(int step) const {
+    if (step < static_cast<int>(QualityLevel::WideHop) ||
+        stepDisabled[static_cast<int>(QualityLevel::WideHop)]) {
+        return fullHop;
+    }
+    const int windowLength = processor.getWindowLength();
+    const int hop = config.throttledHop > 0 && config.throttledHop < windowLength
+            ? config.throttledHop : windowLength;
+    return hop > fullHop ? hop : fullHop;
+}
+
+/**
+ * Highest engine step (threads, delegate, model) in effect at a level, or
+ * 0 for the full-quality engine.
+ */
+int InferenceScheduler::engineFor(int step) const {
+    for (int s = step; s >= static_cast<int>(QualityLevel::FewerThreads); s--) {
+        if (stepAvailable(s)) {
+            return s;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Move to a level.
+ *
+ * This method:
+ * 1. Rebuilds the engine if the level's engine differs (hot swap on this
+ *    thread; a reduction that fails to build is disabled)
+ * 2. Requests the level's stream hop
+ */
+bool InferenceScheduler::applyLevel(int target, int swapTimeoutMs) {
+    // ====================================================================
+    // STEP 1: Engine
+    // ====================================================================
+    const int engine = engineFor(target);
+    if (engine != engineLevel) {
+        MLProcessorConfig settings = fullConfig;
+        std::shared_ptr<SharedModel> model = fullModel;
+        if (engine >= static_cast<int>(QualityLevel::FewerThreads) &&
+            stepAvailable(static_cast<int>(QualityLevel::FewerThreads))) {
+            settings.numThreads = config.throttledThreads;
+        }
+        if (engine >= static_cast<int>(QualityLevel::Delegate) &&
+            stepAvailable(static_cast<int>(QualityLevel::Delegate))) {
+            settings.delegate = config.throttledDelegate;
+        }
+        if (engine >= static_cast<int>(QualityLevel::LightModel) &&
+            stepAvailable(static_cast<int>(QualityLevel::LightModel))) {
+            model = config.throttledModel;
+        }
+
+        if (!processor.swapModel(model, settings, swapTimeoutMs)) {
+            LOG_ERROR("Scheduler could not switch to %s",
+                      qualityLevelName(static_cast<QualityLevel>(engine)));
+            if (engine > engineLevel) {
+                stepDisabled[engine] = true;
+            }
+            return false;
+        }
+        engineLevel = engine;
+    }
+
+    // ====================================================================
+    // STEP 2: Stream Hop
+    // ====================================================================
+    const int hop = hopFor(target);
+    if (hop != hopFor(level) && !processor.setStreamHopSize(hop)) {
+        stepDisabled[static_cast<int>(QualityLevel::WideHop)] = true;
+    }
+
+    level = target;
+    return true;
+}
+
+/**
+ * Sample the signals and move along the ladder.
+ *
+ * This method:
+ * 1. Measures the consumer's duty cycle and p95 call latency since the
+ *    last update, and reads the thermal status
+ * 2. Derives the lowest level allowed: one step per thermal status from
+ *    throttleThermalStatus on, and WideHop in power-save mode
+ * 3. Steps down when the stream falls behind, up after recoverIntervals
+ *    calm updates, never above the allowed level
+ */
+QualityLevel InferenceScheduler::update() {
+    if (!isRunning()) {
+        return static_cast<QualityLevel>(level);
+    }
+
+    // ====================================================================
+    // STEP 1: Sample the Signals
+    // ====================================================================
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedUs =
+            std::chrono::duration<double, std::micro>(now - lastSample).count();
+    lastSample = now;
+
+    const StageSummary calls = processor.getStats().snapshotSince(MLStage::Call, &callMark);
+    const float load = elapsedUs > 0.0
+            ? static_cast<float>(calls.meanUs * calls.count / elapsedUs) : 0.0f;
+    const float p95Ms = static_cast<float>(calls.p95Us / 1000.0);
+    const int thermal = thermalStatus();
+    const bool saving = powerSave.load(std::memory_order_relaxed);
+
+    // ====================================================================
+    // STEP 2: Lowest Allowed Level
+    // ====================================================================
+    // The n-th available step below full quality (the lowest one if
+    // there are fewer)
+    auto nthStep = [this](int n) {
+        int step = 0;
+        for (int s = 1; s < kQualityLevels && n > 0; s++) {
+            if (stepAvailable(s)) {
+                step = s;
+                n--;
+            }
+        }
+        return step;
+    };
+    int minLevel = thermal >= config.throttleThermalStatus
+            ? nthStep(thermal - config.throttleThermalStatus + 1) : 0;
+    if (saving && minLevel < nthStep(1)) {
+        minLevel = nthStep(1);
+    }
+
+    // ====================================================================
+    // STEP 3: Step Along the Ladder
+    // ====================================================================
+    const bool behind = load > config.maxLoad ||
+                        (config.maxLatencyMs > 0.0f && p95Ms > config.maxLatencyMs);
+    const bool calm = load < config.recoverLoad &&
+                      (config.maxLatencyMs <= 0.0f || p95Ms < config.maxLatencyMs / 2);
+
+    int target = level;
+    if (behind) {
+        calmIntervals = 0;
+        for (int s = level + 1; s < kQualityLevels; s++) {
+            if (stepAvailable(s)) {
+                target = s;
+                break;
+            }
+        }
+    } else if (calm && ++calmIntervals >= config.recoverIntervals) {
+        calmIntervals = 0;
+        target = 0;
+        for (int s = level - 1; s > 0; s--) {
+            if (stepAvailable(s)) {
+                target = s;
+                break;
+            }
+        }
+    } else if (!calm) {
+        calmIntervals = 0;
+    }
+    if (target < minLevel) {
+        target = minLevel;
+    }
+
+    const int previous = level;
+    if (target != level && applyLevel(target, config.swapTimeoutMs)) {
+        calmIntervals = 0;
+        LOG_INFO("Quality %s -> %s (thermal %d, load %.2f, p95 %.1f ms%s)",
+                 qualityLevelName(static_cast<QualityLevel>(previous)),
+                 qualityLevelName(static_cast<QualityLevel>(level)), thermal, load, p95Ms,
+                 saving ? ", power save" : "");
+    }
+
+    std::lock_guard<std::mutex> lock(statusMutex);
+    status.level = static_cast<QualityLevel>(level);
+    status.thermalStatus = thermal;
+    status.powerSave = saving;
+    status.load = load;
+    status.p95LatencyMs = p95Ms;
+    if (level > previous) status.throttles++;
+    if (level < previous) status.restores++;
+    return status.level;
+}
+
+SchedulerStatus InferenceScheduler::getStatus() const {
+    std::lock_guard<std::mutex> lock(statusMutex);
+    return status;
+}
@@ -0,0 +1,243 @@
+// ============================================================================
+// INFERENCE SCHEDULER - HEADER
+// ============================================================================
+//
+// Thermal-, load- and battery-aware quality control around an MLProcessor
+// stream.
+//
+// Key characteristics:
+// - Quality ladder: Under pressure, one step at a time, the stream hop is
+//   widened (fewer windows per second), the thread count reduced, the
+//   delegate switched and a lighter (e.g. quantized) model swapped in;
+//   with headroom the steps are undone in reverse order
+// - Signals: The thermal status (AThermal_getCurrentThermalStatus), the
+//   consumer's duty cycle and p95 call latency over the last interval
+//   (from the processor's stage histograms), and a power-save hint
+// - Off the audio path: A monitor thread samples the signals; engine
+//   changes are hot swaps (MLProcessor::swapModel) built on that thread,
+//   hop changes are picked up by the consumer between two calls
+// - Hysteresis: The thermal status sets a minimum step directly, load
+//   steps down at once, and a step is only undone after several calm
+//   intervals in a row
+// - Optional: AThermal (API 30) is loaded at runtime; without it only the
+//   load and the power-save hint drive the scheduler
+//
+// =============================================================================
+
+#ifndef INFERENCE_SCHEDULER_H
+#define INFERENCE_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ml_processor.h"
+
+// ============================================================================
+// QUALITY LEVELS
+// ============================================================================
+
+/**
+ * Steps of the quality ladder. Each level keeps the reductions of the
+ * levels above it; steps that are not configured are skipped.
+ */
+enum class QualityLevel : int {
+    Full = 0,          // Settings the processor and stream were set up with
+    WideHop = 1,       // Stream hop widened to SchedulerConfig::throttledHop
+    FewerThreads = 2,  // Inference on SchedulerConfig::throttledThreads
+    Delegate = 3,      // Inference on SchedulerConfig::throttledDelegate
+    LightModel = 4,    // SchedulerConfig::throttledModel swapped in
+};
+
+// Number of QualityLevel values
+static const int kQualityLevels = 5;
+
+/**
+ * Level name used in logs and reports ("full", "wide-hop", ...).
+ */
+const char* qualityLevelName(QualityLevel level);
+
+// ============================================================================
+// SCHEDULER CONFIGURATION
+// ============================================================================
+
+/**
+ * Thresholds and ladder steps of an InferenceScheduler.
+ */
+struct SchedulerConfig {
+    // How often the monitor thread samples the signals. 0 starts no
+    // thread: the caller calls update() on its own timer.
+    int intervalMs = 1000;
+
+    // Thermal status (AThermalStatus: 1 light, 2 moderate, 3 severe,
+    // 4 critical) from which the quality is reduced. Each status above it
+    // forces one more step.
+    int throttleThermalStatus = 2;
+
+    // Consumer duty cycle (time inside processor calls / wall time) above
+    // which the stream counts as falling behind, and below which it has
+    // headroom again
+    float maxLoad = 0.6f;
+    float recoverLoad = 0.3f;
+
+    // p95 latency of one processor call above which the stream counts as
+    // falling behind (0 disables the check)
+    float maxLatencyMs = 0.0f;
+
+    // Calm intervals in a row before one step is undone
+    int recoverIntervals = 5;
+
+    // WideHop: hop while throttled; 0 means the window length (no overlap).
+    // Skipped if it is not wider than the configured hop.
+    int throttledHop = 0;
+
+    // FewerThreads: threads while throttled. Skipped if the processor
+    // already runs on this many or fewer.
+    int throttledThreads = 1;
+
+    // Delegate: backend while throttled (e.g. NNAPI to move work off the
+    // CPU). Skipped unless enabled and different from the active one.
+    bool switchDelegate = false;
+    DelegateType throttledDelegate = DelegateType::Cpu;
+
+    // LightModel: cheaper model with the same windows and classes (e.g.
+    // the int8 build of the same network). Skipped if null.
+    std::shared_ptr<SharedModel> throttledModel;
+
+    // Longest wait for the consumer to adopt a rebuilt engine
+    int swapTimeoutMs = 1000;
+};
+
+/**
+ * What the scheduler saw and did on its last interval.
+ */
+struct SchedulerStatus {
+    QualityLevel level = QualityLevel::Full;
+    int thermalStatus = -1;   // AThermalStatus, -1 if unavailable
+    bool powerSave = false;
+    float load = 0.0f;        // Consumer duty cycle over the interval
+    float p95LatencyMs = 0.0f;
+    int64_t throttles = 0;    // Steps down since start()
+    int64_t restores = 0;     // Steps back up since start()
+};
+
+// ============================================================================
+// INFERENCE SCHEDULER CLASS
+// ============================================================================
+/**
+ * Adapts an MLProcessor stream to thermal and load pressure.
+ *
+ * start() must be called after configureStream and while no model swap is
+ * pending: the settings in effect then are the full-quality level. While
+ * the scheduler runs, swap models through it only (its engine changes are
+ * swaps). The processor must outlive the scheduler.
+ */
+class InferenceScheduler {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    MLProcessor& processor;
+    SchedulerConfig config;
+
+    // Full-quality settings, captured by start()
+    std::shared_ptr<SharedModel> fullModel;
+    MLProcessorConfig fullConfig;
+    int fullHop = 0;
+
+    // Ladder position. Steps whose engine failed to build are disabled
+    // until the next start().
+    int level = 0;
+    int calmIntervals = 0;
+    bool stepDisabled[kQualityLevels] = {};
+
+    // Engine (threads, delegate, model) currently swapped in, as a level:
+    // rebuilding is only needed when the target level's engine differs
+    int engineLevel = 0;
+
+    // Interval sampling of the processor's call latency
+    HistogramMark callMark;
+    std::chrono::steady_clock::time_point lastSample;
+
+    std::atomic<bool> powerSave{false};
+
+    // Monitor thread; stop() wakes it through wakeCondition
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::thread monitor;
+
+    // Last status, read by getStatus() from any thread
+    mutable std::mutex statusMutex;
+    SchedulerStatus status;
+
+    bool stepAvailable(int step) const;
+    int hopFor(int step) const;
+    int engineFor(int step) const;
+    bool applyLevel(int target, int swapTimeoutMs);
+    void runMonitor();
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    explicit InferenceScheduler(MLProcessor& processor,
+                                const SchedulerConfig& config = SchedulerConfig());
+
+    /**
+     * Destructor: Stops the monitor and restores full quality.
+     */
+    ~InferenceScheduler();
+
+    InferenceScheduler(const InferenceScheduler&) = delete;
+    InferenceScheduler& operator=(const InferenceScheduler&) = delete;
+
+    /**
+     * Capture the full-quality settings and start the monitor thread.
+     *
+     * @return false if already running, the stream is not configured or
+     *         the configuration is invalid
+     */
+    bool start();
+
+    /**
+     * Stop the monitor and restore full quality. Safe to call when not
+     * running, and never waits for the consumer: a full-quality engine is
+     * published for the next inference call (or releaseArenas) to adopt.
+     */
+    void stop();
+
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+    /**
+     * Sample the signals once and move along the ladder (what the monitor
+     * does every intervalMs). For callers that drive the scheduler from
+     * their own timer, started with intervalMs == 0; not to be called
+     * while the monitor thread runs.
+     *
+     * @return The level now in effect
+     */
+    QualityLevel update();
+
+    /**
+     * Battery hint (e.g. PowerManager power-save mode or a low battery):
+     * while set, the stream stays at WideHop or lower quality.
+     */
+    void setPowerSaveMode(bool enabled) { powerSave.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * Status of the last interval.
+     */
+    SchedulerStatus getStatus() const;
+
+    /**
+     * Current thermal status of the device (AThermalStatus), or -1 if the
+     * thermal API is unavailable.
+     */
+    static int thermalStatus();
+};
+
+#endif // INFERENCE_SCHEDULER_H
@@ -22,28 +22,40 @@
 
 // Standard C++ library headers
 #include <string>        // String handling (e.g., const char*)
-#include <vector>        // Dynamic arrays (for returning results)
+#include <utility>       // std::move
 
-// Android logging: Log output appears in Android Studio's Logcat
-#include <android/log.h>
+// Asset manager: Lets the model be mapped straight out of the APK
+#include <android/asset_manager_jni.h>
 
 // Include the platform-independent ML processor
 #include "ml_processor.h"
 
+// Offline classification of memory-mapped audio files
+#include "offline_classifier.h"
+
+// AAudio capture feeding a processor stream
+#include "audio_capture.h"
+#include "async_classifier.h"
+
+// Thermal- and load-aware quality control of a processor stream
+#include "inference_scheduler.h"
+
+// Asynchronous logging layer: Log output appears in Android Studio's Logcat
+#include "ml_log.h"
+
 // ============================================================================
 // LOGGING MACROS
 // ============================================================================
-
-// Tag for log messages: appears in Android logcat to identify source
-#define LOG_TAG "AudioML"
+// Messages go through the asynchronous logging layer (ml_log.h) and show up
+// in logcat under the "AudioML" tag.
 
 // LOGI: Log informational messages (normal operation)
 // Example: LOGI("Model loaded with %d inputs", numInputs);
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGI(...) LOG_INFO(__VA_ARGS__)
 
 // LOGE: Log error messages (problems encountered)
 // Example: LOGE("Failed to allocate tensors");
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) LOG_ERROR(__VA_ARGS__)
 
 // ============================================================================
 // JNI WRAPPER FUNCTIONS
@@ -52,17 +64,250 @@
 // Each function converts Java types to C++ types, calls the appropriate
 // MLProcessor method, and converts the result back to Java types.
 
+// ============================================================================
+// INITIALIZATION HELPERS
+// ============================================================================
+
+// Layout of the int[] front-end settings are passed in (see
+// NativeMLProcessor.FrontEnd); frequencies are whole Hz
+static const int kFrontEndModelRate = 0;
+static const int kFrontEndInputRate = 1;
+static const int kFrontEndTaps = 2;
+static const int kFrontEndLogMel = 3;
+static const int kFrontEndFftSize = 4;
+static const int kFrontEndFrameHop = 5;
+static const int kFrontEndMelBands = 6;
+static const int kFrontEndMinHz = 7;
+static const int kFrontEndMaxHz = 8;
+static const int kFrontEndLength = 9;
+
+// Layout of the int[] thread policy (see NativeMLProcessor.ThreadPolicy)
+static const int kThreadPolicyPin = 0;
+static const int kThreadPolicyPriority = 1;
+static const int kThreadPolicyLength = 2;
+
+/**
+ * Fill an MLProcessorConfig from the nativeInit* arguments.
+ *
+ * @return false (after logging) if an argument is invalid
+ */
+static bool buildConfig(JNIEnv* env, jint delegate, jint numThreads,
+                        jboolean autoTuneThreads, jstring cacheDir, jintArray frontEnd,
+                        jint warmUpInvokes, jboolean delegateCache, jintArray threadPolicy,
+                        MLProcessorConfig* config) {
+    if (!delegateTypeFromInt(delegate, &config->delegate)) {
+        LOGE("Unknown delegate %d", delegate);
+        return false;
+    }
+    config->numThreads = numThreads;
+    config->autoTuneThreads = autoTuneThreads == JNI_TRUE;
+    config->warmUpInvokes = warmUpInvokes;
+    config->delegateCache = delegateCache == JNI_TRUE;
+
+    if (cacheDir) {
+        const char* dir = env->GetStringUTFChars(cacheDir, nullptr);
+        if (!dir) {
+            LOGE("Failed to get string from Java");
+            return false;
+        }
+        config->cacheDir = dir;
+        env->ReleaseStringUTFChars(cacheDir, dir);
+    }
+
+    if (frontEnd) {
+        if (env->GetArrayLength(frontEnd) < kFrontEndLength) {
+            LOGE("Front-end settings too short");
+            return false;
+        }
+        jint values[kFrontEndLength];
+        env->GetIntArrayRegion(frontEnd, 0, kFrontEndLength, values);
+        FrontEndConfig& fe = config->frontEnd;
+        fe.modelSampleRate = values[kFrontEndModelRate];
+        fe.inputSampleRate = values[kFrontEndInputRate];
+        fe.resamplerTaps = values[kFrontEndTaps];
+        fe.logMel = values[kFrontEndLogMel] != 0;
+        fe.fftSize = values[kFrontEndFftSize];
+        fe.frameHop = values[kFrontEndFrameHop];
+        fe.melBands = values[kFrontEndMelBands];
+        fe.minFrequency = static_cast<float>(values[kFrontEndMinHz]);
+        fe.maxFrequency = static_cast<float>(values[kFrontEndMaxHz]);
+    }
+
+    if (threadPolicy) {
+        if (env->GetArrayLength(threadPolicy) < kThreadPolicyLength) {
+            LOGE("Thread policy too short");
+            return false;
+        }
+        jint values[kThreadPolicyLength];
+        env->GetIntArrayRegion(threadPolicy, 0, kThreadPolicyLength, values);
+        config->threadPolicy.pinPerformanceCores = values[kThreadPolicyPin] != 0;
+        if (!threadPriorityFromInt(values[kThreadPolicyPriority],
+                                   &config->threadPolicy.streamPriority)) {
+            LOGE("Unknown thread priority %d", values[kThreadPolicyPriority]);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Turn a freshly constructed processor into a handle for Java.
+ *
+ * @return Handle, or 0 (processor deleted) if initialization failed
+ */
+static jlong toHandle(MLProcessor* processor) {
+    // Report failure as a 0 handle so the Java side can throw
+    if (!processor->isInitialized()) {
+        LOGE("MLProcessor initialization failed");
+        delete processor;
+        return 0;
+    }
+
+    LOGI("MLProcessor running on %s with %d threads",
+         delegateTypeName(processor->getActiveDelegate()), processor->getNumThreads());
+
+    // Return pointer cast to jlong so Java can store it
+    return reinterpret_cast<jlong>(processor);
+}
+
+// Layout of the float[] a classification is reported in
+// (see NativeMLProcessor.Classification)
+static const int kResultClassIndex = 0;
+static const int kResultScore = 1;
+static const int kResultRms = 2;
+static const int kResultWindows = 3;
+static const int kResultLength = 4;
+
+// Layout of the long[] filled by nativeGetCascadeStats (see CascadeStats)
+static const int kCascadeStatsLength = 4;
+
+// Layout of the long[] filled by nativeGetMemoryReport
+// (see NativeMLProcessor.MemoryReport)
+static const int kMemoryReportLength = 10;
+
+// Layout of the long[] filled by nativeGetCoreUsage (see
+// NativeMLProcessor.CoreUsage): two CPU masks, then one count per CPU
+static const int kCoreUsagePerformance = 0;
+static const int kCoreUsagePinned = 1;
+static const int kCoreUsageInvokes = 2;
+
+/**
+ * Copy a ClassificationResult into the caller's reusable float[].
+ */
+static void writeResult(JNIEnv* env, jfloatArray out, const ClassificationResult& result) {
+    jfloat values[kResultLength];
+    values[kResultClassIndex] = static_cast<jfloat>(result.classIndex);
+    values[kResultScore] = result.score;
+    values[kResultRms] = result.rms;
+    values[kResultWindows] = static_cast<jfloat>(result.windows);
+    env->SetFloatArrayRegion(out, 0, kResultLength, values);
+}
+
+// Layout of the double[] stage statistics are reported in: one row of
+// kStatsFields values per MLStage (see NativeMLProcessor.StageStats)
+static const int kStatsCount = 0;
+static const int kStatsMean = 1;
+static const int kStatsP50 = 2;
+static const int kStatsP95 = 3;
+static const int kStatsP99 = 4;
+static const int kStatsMax = 5;
+static const int kStatsFields = 6;
+
+// Timeline entries copied per JNI region write in nativePoll
+static const int kPollBatch = 64;
+
+/**
+ * Number of events that fit the four parallel event arrays
+ * (see NativeMLProcessor.Events).
+ */
+static jsize eventCapacity(JNIEnv* env, jintArray classIndices, jfloatArray scores,
+                           jlongArray onsets, jlongArray offsets) {
+    jsize capacity = env->GetArrayLength(classIndices);
+    if (env->GetArrayLength(scores) < capacity) capacity = env->GetArrayLength(scores);
+    if (env->GetArrayLength(onsets) < capacity) capacity = env->GetArrayLength(onsets);
+    if (env->GetArrayLength(offsets) < capacity) capacity = env->GetArrayLength(offsets);
+    return capacity;
+}
+
+/**
+ * Copy a batch of events (count <= kPollBatch) into the event arrays at
+ * index `offset`.
+ */
+static void writeEvents(JNIEnv* env, const ClassEvent* events, int count, jsize offset,
+                        jintArray classIndices, jfloatArray scores,
+                        jlongArray onsets, jlongArray offsets) {
+    jint batchClasses[kPollBatch];
+    jfloat batchScores[kPollBatch];
+    jlong batchOnsets[kPollBatch];
+    jlong batchOffsets[kPollBatch];
+    for (int i = 0; i < count; i++) {
+        batchClasses[i] = events[i].classIndex;
+        batchScores[i] = events[i].score;
+        batchOnsets[i] = static_cast<jlong>(events[i].onsetSample);
+        batchOffsets[i] = static_cast<jlong>(events[i].offsetSample);
+    }
+    env->SetIntArrayRegion(classIndices, offset, count, batchClasses);
+    env->SetFloatArrayRegion(scores, offset, count, batchScores);
+    env->SetLongArrayRegion(onsets, offset, count, batchOnsets);
+    env->SetLongArrayRegion(offsets, offset, count, batchOffsets);
+}
+
+// android.media.AudioFormat encodings nativeProcessAudioDirect accepts
+// (see NativeMLProcessor.SampleFormat)
+static const jint kEncodingPcm16Bit = 2;
+static const jint kEncodingPcmFloat = 4;
+static const jint kEncodingPcm32Bit = 22;
+
+/**
+ * Run one window held in a direct buffer of `Sample` values.
+ */
+template <typename Sample>
+static jint processDirect(JNIEnv* env, MLProcessor* processor, jobject audioData,
+                          jint length, float* predictions, jlong outputCapacity) {
+    auto* samples = static_cast<const Sample*>(env->GetDirectBufferAddress(audioData));
+    if (!samples) {
+        LOGE("Audio and output buffers must be direct");
+        return -1;
+    }
+
+    // Capacities are in bytes
+    jlong inputCapacity = env->GetDirectBufferCapacity(audioData) / sizeof(Sample);
+    if (length <= 0 || length > inputCapacity) {
+        LOGE("Invalid sample count %d (buffer holds %lld)", length,
+             static_cast<long long>(inputCapacity));
+        return -1;
+    }
+
+    return processor->processAudioInto(samples, length, predictions,
+                                       static_cast<int>(outputCapacity));
+}
+
 extern "C" {
 
+/**
+ * JNI Function: Library load hook
+ *
+ * Starts the log drain thread while the library is loaded, so no audio
+ * callback or stream worker ever has to (see logStart).
+ */
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* /* vm */, void* /* reserved */) {
+    logStart();
+    return JNI_VERSION_1_6;
+}
+
 /**
  * JNI Function: Initialize ML processor with model file
  * 
  * Java signature:
- *   public native long nativeInit(String modelPath)
+ *   public native long nativeInit(String modelPath, int delegate, int numThreads,
+ *                                 boolean autoTuneThreads, String cacheDir,
+ *                                 int[] frontEnd, int warmUpInvokes,
+ *                                 boolean delegateCache, int[] threadPolicy)
  * 
  * This function:
- * 1. Receives the model file path from Java
- * 2. Creates a new MLProcessor instance
+ * 1. Receives the model file path, preferred delegate and threading
+ *    settings from Java
+ * 2. Creates a new MLProcessor instance (with delegate fallback)
  * 3. Returns a handle (pointer cast to long) to the Java caller
  * 
  * The handle is stored in Java and passed back to other JNI functions
@@ -71,11 +316,28 @@ extern "C" {
  * @param env JNI environment pointer
  * @param this Reference to the calling object (unused here)
  * @param modelPath Java String containing path to .tflite model file
- * @return Long handle to MLProcessor instance (cast from pointer)
+ * @param delegate Preferred backend (0 = CPU, 1 = XNNPACK, 2 = GPU, 3 = NNAPI)
+ * @param numThreads CPU threads (-1 = let TensorFlow Lite decide)
+ * @param autoTuneThreads Benchmark thread counts and keep the fastest
+ * @param cacheDir Directory for the per-device tuning cache (may be null)
+ * @param frontEnd Resampler / log-mel settings (may be null: none)
+ * @param warmUpInvokes Silent invokes at the end of construction (0 = none)
+ * @param delegateCache Persist delegate state (weights, programs) in cacheDir
+ * @param threadPolicy Core pinning / stream priority (may be null: none)
+ * @return Long handle to MLProcessor instance (cast from pointer), 0 on failure
  */
 JNIEXPORT jlong JNICALL
 Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeInit(
-        JNIEnv* env, jobject /* this */, jstring modelPath) {
+        JNIEnv* env, jobject /* this */, jstring modelPath, jint delegate,
+        jint numThreads, jboolean autoTuneThreads, jstring cacheDir,
+        jintArray frontEnd, jint warmUpInvokes, jboolean delegateCache,
+        jintArray threadPolicy) {
+
+    MLProcessorConfig config;
+    if (!buildConfig(env, delegate, numThreads, autoTuneThreads, cacheDir, frontEnd,
+                     warmUpInvokes, delegateCache, threadPolicy, &config)) {
+        return 0;
+    }
 
     // Convert Java string to C string
     const char* path = env->GetStringUTFChars(modelPath, nullptr);
@@ -84,16 +346,313 @@ Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeInit(
         return 0;
     }
 
-    LOGI("Initializing MLProcessor with model: %s", path);
+    LOGI("Initializing MLProcessor with model: %s (%s requested)", path,
+         delegateTypeName(config.delegate));
 
     // Create new MLProcessor instance with the model path
-    MLProcessor* processor = new MLProcessor(path);
+    MLProcessor* processor = new MLProcessor(path, config);
     
     // Release the C string (Java will manage the original)
     env->ReleaseStringUTFChars(modelPath, path);
 
-    // Return pointer cast to jlong so Java can store it
-    return reinterpret_cast<jlong>(processor);
+    return toHandle(processor);
+}
+
+/**
+ * JNI Function: Initialize ML processor from a file descriptor range
+ * 
+ * Java signature:
+ *   public native long nativeInitFromFd(int fd, long offset, long length, int delegate,
+ *                                       int numThreads, boolean autoTuneThreads,
+ *                                       String cacheDir, int[] frontEnd,
+ *                                       int warmUpInvokes, boolean delegateCache,
+ *                                       int[] threadPolicy)
+ * 
+ * Meant for AssetFileDescriptor (fd of the APK plus the asset's offset and
+ * length): the range is mmapped and the model is built over it without
+ * copying. The descriptor is not retained; Java may close it afterwards.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param fd Readable file descriptor
+ * @param offset Start of the model inside the file
+ * @param length Model size in bytes
+ * @param delegate Preferred backend (see nativeInit)
+ * @param numThreads CPU threads (-1 = let TensorFlow Lite decide)
+ * @param autoTuneThreads Benchmark thread counts and keep the fastest
+ * @param cacheDir Directory for the per-device tuning cache (may be null)
+ * @param frontEnd Resampler / log-mel settings (may be null: none)
+ * @param warmUpInvokes Silent invokes at the end of construction (0 = none)
+ * @param delegateCache Persist delegate state (weights, programs) in cacheDir
+ * @param threadPolicy Core pinning / stream priority (may be null: none)
+ * @return Long handle to MLProcessor instance (cast from pointer), 0 on failure
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeInitFromFd(
+        JNIEnv* env, jobject /* this */, jint fd, jlong offset, jlong length,
+        jint delegate, jint numThreads, jboolean autoTuneThreads, jstring cacheDir,
+        jintArray frontEnd, jint warmUpInvokes, jboolean delegateCache,
+        jintArray threadPolicy) {
+
+    MLProcessorConfig config;
+    if (!buildConfig(env, delegate, numThreads, autoTuneThreads, cacheDir, frontEnd,
+                     warmUpInvokes, delegateCache, threadPolicy, &config)) {
+        return 0;
+    }
+
+    ModelBuffer buffer;
+    if (!buffer.mapFile(fd, offset, length)) {
+        LOGE("Failed to map model (fd %d, offset %lld, length %lld)", fd,
+             static_cast<long long>(offset), static_cast<long long>(length));
+        return 0;
+    }
+
+    LOGI("Initializing MLProcessor from fd %d (%lld bytes, %s requested)", fd,
+         static_cast<long long>(length), delegateTypeName(config.delegate));
+
+    return toHandle(new MLProcessor(std::move(buffer), config));
+}
+
+/**
+ * JNI Function: Initialize ML processor from an APK asset
+ * 
+ * Java signature:
+ *   public native long nativeInitFromAsset(AssetManager assets, String assetName,
+ *                                          int delegate, int numThreads,
+ *                                          boolean autoTuneThreads, String cacheDir,
+ *                                          int[] frontEnd, int warmUpInvokes,
+ *                                          boolean delegateCache, int[] threadPolicy)
+ * 
+ * Uncompressed assets are mmapped from the APK; compressed ones are read
+ * into memory by the asset manager. Either way nothing is written to disk.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param assets Java AssetManager
+ * @param assetName Asset path inside the APK
+ * @param delegate Preferred backend (see nativeInit)
+ * @param numThreads CPU threads (-1 = let TensorFlow Lite decide)
+ * @param autoTuneThreads Benchmark thread counts and keep the fastest
+ * @param cacheDir Directory for the per-device tuning cache (may be null)
+ * @param frontEnd Resampler / log-mel settings (may be null: none)
+ * @param warmUpInvokes Silent invokes at the end of construction (0 = none)
+ * @param delegateCache Persist delegate state (weights, programs) in cacheDir
+ * @param threadPolicy Core pinning / stream priority (may be null: none)
+ * @return Long handle to MLProcessor instance (cast from pointer), 0 on failure
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeInitFromAsset(
+        JNIEnv* env, jobject /* this */, jobject assets, jstring assetName,
+        jint delegate, jint numThreads, jboolean autoTuneThreads, jstring cacheDir,
+        jintArray frontEnd, jint warmUpInvokes, jboolean delegateCache,
+        jintArray threadPolicy) {
+
+    MLProcessorConfig config;
+    if (!buildConfig(env, delegate, numThreads, autoTuneThreads, cacheDir, frontEnd,
+                     warmUpInvokes, delegateCache, threadPolicy, &config)) {
+        return 0;
+    }
+
+    AAssetManager* assetManager = AAssetManager_fromJava(env, assets);
+    if (!assetManager) {
+        LOGE("Invalid AssetManager");
+        return 0;
+    }
+
+    const char* name = env->GetStringUTFChars(assetName, nullptr);
+    if (!name) {
+        LOGE("Failed to get string from Java");
+        return 0;
+    }
+
+    ModelBuffer buffer;
+    const bool opened = buffer.openAsset(assetManager, name);
+    if (opened) {
+        LOGI("Initializing MLProcessor from asset %s (%zu bytes, %s requested)", name,
+             buffer.size(), delegateTypeName(config.delegate));
+    } else {
+        LOGE("Failed to open model asset %s", name);
+    }
+    env->ReleaseStringUTFChars(assetName, name);
+    if (!opened) {
+        return 0;
+    }
+
+    return toHandle(new MLProcessor(std::move(buffer), config));
+}
+
+/**
+ * JNI Function: Backend the processor actually runs on
+ * 
+ * Java signature:
+ *   public native int nativeGetActiveDelegate(long handle)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @return Delegate id (same numbering as nativeInit), or -1 if invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetActiveDelegate(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+    return static_cast<jint>(processor->getActiveDelegate());
+}
+
+/**
+ * JNI Function: Thread count the interpreter runs with
+ * 
+ * Java signature:
+ *   public native int nativeGetNumThreads(long handle)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle Handle to MLProcessor instance (from nativeInit)
+ * @return Thread count (after auto-tuning), or 0 if invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetNumThreads(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+    return processor->getNumThreads();
+}
+
+/**
+ * JNI Function: Hot-swap the model from a file
+ * 
+ * Java signature:
+ *   public native boolean nativeSwapModel(long handle, String modelPath, int timeoutMs)
+ * 
+ * Blocks the calling (background) thread while the replacement is built
+ * and warmed up; the stream keeps classifying on the old model meanwhile
+ * (see MLProcessor::swapModel).
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle Handle to MLProcessor instance (from nativeInit)
+ * @param modelPath Java String containing path to the replacement model
+ * @param timeoutMs Longest wait for the consumer to adopt it
+ * @return true if the replacement was published
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeSwapModel(
+        JNIEnv* env, jobject /* this */, jlong handle, jstring modelPath, jint timeoutMs) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+
+    const char* path = env->GetStringUTFChars(modelPath, nullptr);
+    if (!path) {
+        LOGE("Failed to get string from Java");
+        return JNI_FALSE;
+    }
+    std::shared_ptr<SharedModel> model = SharedModel::fromFile(path);
+    env->ReleaseStringUTFChars(modelPath, path);
+
+    return processor->swapModel(std::move(model), timeoutMs) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Hot-swap the model from a file descriptor range
+ * 
+ * Java signature:
+ *   public native boolean nativeSwapModelFromFd(long handle, int fd, long offset,
+ *                                               long length, int timeoutMs)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle Handle to MLProcessor instance (from nativeInit)
+ * @param fd Readable file descriptor (only used during the call)
+ * @param offset Start of the model inside the file
+ * @param length Model size in bytes
+ * @param timeoutMs Longest wait for the consumer to adopt it
+ * @return true if the replacement was published
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeSwapModelFromFd(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jint fd, jlong offset,
+        jlong length, jint timeoutMs) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+
+    ModelBuffer buffer;
+    if (!buffer.mapFile(fd, offset, length)) {
+        LOGE("Failed to map model (fd %d, offset %lld, length %lld)", fd,
+             static_cast<long long>(offset), static_cast<long long>(length));
+        return JNI_FALSE;
+    }
+
+    return processor->swapModel(SharedModel::fromBuffer(std::move(buffer)), timeoutMs)
+           ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Hot-swap the model from an APK asset
+ * 
+ * Java signature:
+ *   public native boolean nativeSwapModelFromAsset(long handle, AssetManager assets,
+ *                                                  String assetName, int timeoutMs)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle Handle to MLProcessor instance (from nativeInit)
+ * @param assets Java AssetManager
+ * @param assetName Asset path inside the APK
+ * @param timeoutMs Longest wait for the consumer to adopt it
+ * @return true if the replacement was published
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeSwapModelFromAsset(
+        JNIEnv* env, jobject /* this */, jlong handle, jobject assets, jstring assetName,
+        jint timeoutMs) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+
+    AAssetManager* assetManager = AAssetManager_fromJava(env, assets);
+    if (!assetManager) {
+        LOGE("Invalid AssetManager");
+        return JNI_FALSE;
+    }
+
+    const char* name = env->GetStringUTFChars(assetName, nullptr);
+    if (!name) {
+        LOGE("Failed to get string from Java");
+        return JNI_FALSE;
+    }
+
+    ModelBuffer buffer;
+    const bool opened = buffer.openAsset(assetManager, name);
+    if (!opened) {
+        LOGE("Failed to open model asset %s", name);
+    }
+    env->ReleaseStringUTFChars(assetName, name);
+    if (!opened) {
+        return JNI_FALSE;
+    }
+
+    return processor->swapModel(SharedModel::fromBuffer(std::move(buffer)), timeoutMs)
+           ? JNI_TRUE : JNI_FALSE;
 }
 
 /**
@@ -125,6 +684,9 @@ Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudio(
         return env->NewFloatArray(0);
     }
 
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+
     // Get the length of the input array
     jsize length = env->GetArrayLength(audioData);
     if (length <= 0) {
@@ -132,7 +694,7 @@ Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudio(
         return env->NewFloatArray(0);
     }
 
-    LOGI("Processing %d audio samples", length);
+    LOG_EVERY_MS(ML_LOG_LEVEL_DEBUG, 1000, "Processing %d audio samples", length);
 
     // Get a C++ pointer to the Java short array data
     // JNI_ABORT means we don't copy changes back to Java (read-only)
@@ -142,52 +704,2088 @@ Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudio(
         return env->NewFloatArray(0);
     }
 
-    // Call the platform-independent processAudio method
-    std::vector<float> result = processor->processAudio(
-            reinterpret_cast<const int16_t*>(data), length);
+    // Call the platform-independent processAudioView method. The result
+    // points straight into the output tensor, so no intermediate vector is
+    // allocated on the native side.
+    int resultSize = 0;
+    const float* result = processor->processAudioView(
+            reinterpret_cast<const int16_t*>(data), length, &resultSize);
 
     // Release the array (no need to copy changes back)
     env->ReleaseShortArrayElements(audioData, data, JNI_ABORT);
 
-    // Convert C++ vector result to Java float array
-    jfloatArray output = env->NewFloatArray(result.size());
-    if (output) {
-        // Copy data from vector to Java array
-        env->SetFloatArrayRegion(output, 0, result.size(), result.data());
+    // Copy the predictions from the output tensor to a Java float array
+    jfloatArray output = env->NewFloatArray(resultSize);
+    if (output && result) {
+        env->SetFloatArrayRegion(output, 0, resultSize, result);
     }
 
-    LOGI("Returned %zu predictions", result.size());
+    LOG_EVERY_MS(ML_LOG_LEVEL_DEBUG, 1000, "Returned %d predictions", resultSize);
     return output;
 }
 
 /**
- * JNI Function: Clean up and destroy ML processor
+ * JNI Function: Process audio into a caller-provided array (no allocation)
  * 
  * Java signature:
- *   public native void nativeClose(long handle)
+ *   public native int nativeProcessAudioInto(long handle, short[] audioData, int length,
+ *                                            float[] output)
  * 
  * This function:
- * 1. Retrieves the MLProcessor instance from the handle
- * 2. Deletes the instance (destructor cleans up TensorFlow Lite resources)
- * 3. Prevents memory leaks from native object
+ * 1. Rebuilds the interpreter if releaseArenas released it
+ * 2. Pins the input array with GetPrimitiveArrayCritical (no copy on ART
+ *    for non-movable arrays, and never an allocation)
+ * 3. Runs inference straight from the pinned samples
+ * 4. Copies the predictions into the caller's reusable output array
  * 
- * Must be called when done with the processor to release native memory.
+ * The critical region spans one inference (never an interpreter rebuild)
+ * and makes no JNI calls; the output is written after it ends, with
+ * SetFloatArrayRegion.
  * 
  * @param env JNI environment pointer
  * @param this Reference to the calling object (unused here)
  * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java short array containing audio samples
+ * @param length Number of valid samples at the start of audioData
+ * @param output Java float array receiving the predictions
+ * @return Number of predictions written, or -1 on failure
  */
-JNIEXPORT void JNICALL
-Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeClose(
-        JNIEnv* env, jobject /* this */, jlong handle) {
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudioInto(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData,
+        jint length, jfloatArray output) {
 
-    // Cast handle back to MLProcessor pointer
     auto* processor = reinterpret_cast<MLProcessor*>(handle);
-    if (processor) {
-        LOGI("Closing MLProcessor");
-        delete processor;  // Destructor will clean up all TensorFlow Lite resources
-    } else {
-        LOGE("Attempted to close invalid processor handle");
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+
+    // Never read past the end of the Java array
+    jsize arrayLength = env->GetArrayLength(audioData);
+    if (length > arrayLength) length = arrayLength;
+    if (length <= 0) {
+        LOGE("Empty audio data array");
+        return -1;
+    }
+
+    jsize capacity = env->GetArrayLength(output);
+    if (capacity < processor->getOutputSize()) {
+        LOGE("Output array too small (%d < %d)", capacity, processor->getOutputSize());
+        return -1;
+    }
+
+    // A released interpreter (releaseArenas) is rebuilt before pinning:
+    // for GPU / NNAPI that compiles the delegate, and the GC is blocked
+    // while the array is pinned
+    if (!processor->ensureReady()) {
+        return -1;
+    }
+
+    // Pin the samples: read-only, so JNI_ABORT skips any copy-back
+    void* data = env->GetPrimitiveArrayCritical(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to pin audio array");
+        return -1;
+    }
+
+    int resultSize = 0;
+    const float* result = processor->processAudioView(
+            static_cast<const int16_t*>(data), length, &resultSize);
+
+    env->ReleasePrimitiveArrayCritical(audioData, data, JNI_ABORT);
+
+    if (!result) {
+        return -1;
+    }
+    env->SetFloatArrayRegion(output, 0, resultSize, result);
+    return resultSize;
+}
+
+/**
+ * JNI Function: Process float audio into a caller-provided array
+ * 
+ * Java signature:
+ *   public native int nativeProcessAudioFloatInto(long handle, float[] audioData,
+ *                                                 int length, float[] output)
+ * 
+ * Same as nativeProcessAudioInto for ENCODING_PCM_FLOAT captures: the
+ * pinned floats are normalized straight into the input tensor, so the
+ * Java side does not convert them to 16-bit first.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java float array containing audio samples (full scale 1.0)
+ * @param length Number of valid samples at the start of audioData
+ * @param output Java float array receiving the predictions
+ * @return Number of predictions written, or -1 on failure
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudioFloatInto(
+        JNIEnv* env, jobject /* this */, jlong handle, jfloatArray audioData,
+        jint length, jfloatArray output) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+
+    // Never read past the end of the Java array
+    jsize arrayLength = env->GetArrayLength(audioData);
+    if (length > arrayLength) length = arrayLength;
+    if (length <= 0) {
+        LOGE("Empty audio data array");
+        return -1;
+    }
+
+    jsize capacity = env->GetArrayLength(output);
+    if (capacity < processor->getOutputSize()) {
+        LOGE("Output array too small (%d < %d)", capacity, processor->getOutputSize());
+        return -1;
+    }
+
+    // Rebuild a released interpreter before pinning (see nativeProcessAudioInto)
+    if (!processor->ensureReady()) {
+        return -1;
+    }
+
+    // Pin the samples: read-only, so JNI_ABORT skips any copy-back
+    void* data = env->GetPrimitiveArrayCritical(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to pin audio array");
+        return -1;
+    }
+
+    int resultSize = 0;
+    const float* result = processor->processAudioView(
+            static_cast<const float*>(data), length, &resultSize);
+
+    env->ReleasePrimitiveArrayCritical(audioData, data, JNI_ABORT);
+
+    if (!result) {
+        return -1;
+    }
+    env->SetFloatArrayRegion(output, 0, resultSize, result);
+    return resultSize;
+}
+
+/**
+ * JNI Function: Process audio between direct buffers (zero-copy)
+ * 
+ * Java signature:
+ *   public native int nativeProcessAudioDirect(long handle, java.nio.ByteBuffer audioData,
+ *                                              int length, int encoding,
+ *                                              java.nio.ByteBuffer output)
+ * 
+ * Both buffers must be direct and in native byte order. Their memory is
+ * read and written in place via GetDirectBufferAddress, so the call
+ * neither copies nor allocates and does not interact with the GC at all.
+ * Buffer positions are ignored: samples start at byte 0 of audioData and
+ * predictions are written from byte 0 of output.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Direct buffer holding PCM samples
+ * @param length Number of samples in audioData
+ * @param encoding AudioFormat encoding of the samples (ENCODING_PCM_16BIT,
+ *                 ENCODING_PCM_32BIT or ENCODING_PCM_FLOAT)
+ * @param output Direct buffer receiving float predictions
+ * @return Number of predictions written, or -1 on failure
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudioDirect(
+        JNIEnv* env, jobject /* this */, jlong handle, jobject audioData,
+        jint length, jint encoding, jobject output) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+
+    // GetDirectBufferAddress returns nullptr for heap (non-direct) buffers
+    auto* predictions = static_cast<float*>(env->GetDirectBufferAddress(output));
+    if (!predictions) {
+        LOGE("Audio and output buffers must be direct");
+        return -1;
+    }
+    jlong outputCapacity = env->GetDirectBufferCapacity(output) / sizeof(float);
+
+    switch (encoding) {
+        case kEncodingPcm16Bit:
+            return processDirect<int16_t>(env, processor, audioData, length,
+                                          predictions, outputCapacity);
+        case kEncodingPcm32Bit:
+            return processDirect<int32_t>(env, processor, audioData, length,
+                                          predictions, outputCapacity);
+        case kEncodingPcmFloat:
+            return processDirect<float>(env, processor, audioData, length,
+                                        predictions, outputCapacity);
+        default:
+            LOGE("Unsupported sample encoding %d", encoding);
+            return -1;
+    }
+}
+
+/**
+ * JNI Function: Process several windows in one interpreter invoke
+ * 
+ * Java signature:
+ *   public native float[] nativeProcessAudioBatch(long handle, short[] audioData)
+ * 
+ * This function:
+ * 1. Splits the contiguous short array into N = length / window length windows
+ * 2. Calls processAudioBatchInto, writing straight into the result array
+ * 3. Returns the N x classes prediction matrix (row-major)
+ * 
+ * Trailing samples that do not fill a whole window are ignored.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java short array containing N consecutive windows
+ * @return Java float array with N rows of predictions (empty on failure)
+ */
+JNIEXPORT jfloatArray JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessAudioBatch(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return env->NewFloatArray(0);
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+
+    // Number of whole windows in the input
+    const int windowLength = processor->getWindowLength();
+    jsize numWindows = windowLength > 0 ? env->GetArrayLength(audioData) / windowLength : 0;
+    if (numWindows <= 0) {
+        LOGE("Audio batch shorter than one window");
+        return env->NewFloatArray(0);
+    }
+
+    jsize resultSize = numWindows * processor->getOutputSize();
+    jfloatArray output = env->NewFloatArray(resultSize);
+    if (!output) {
+        return nullptr;  // OutOfMemoryError pending
+    }
+
+    jshort* data = env->GetShortArrayElements(audioData, nullptr);
+    jfloat* result = env->GetFloatArrayElements(output, nullptr);
+    if (!data || !result) {
+        LOGE("Failed to get array elements");
+        if (data) env->ReleaseShortArrayElements(audioData, data, JNI_ABORT);
+        if (result) env->ReleaseFloatArrayElements(output, result, JNI_ABORT);
+        return env->NewFloatArray(0);
+    }
+
+    // Predictions are written directly into the Java array's elements
+    int written = processor->processAudioBatchInto(
+            reinterpret_cast<const int16_t*>(data), numWindows, result, resultSize);
+
+    env->ReleaseShortArrayElements(audioData, data, JNI_ABORT);
+    env->ReleaseFloatArrayElements(output, result, 0);
+
+    if (written < 0) {
+        return env->NewFloatArray(0);
+    }
+    return output;
+}
+
+/**
+ * JNI Function: Number of predictions per inference
+ * 
+ * Java signature:
+ *   public native int nativeGetOutputSize(long handle)
+ * 
+ * Lets the Java side pre-allocate result arrays (one row per window).
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @return Number of output values, or 0 if the processor is invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetOutputSize(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+    return processor->getOutputSize();
+}
+
+/**
+ * JNI Function: Samples per classification window
+ * 
+ * Java signature:
+ *   public native int nativeGetWindowLength(long handle)
+ * 
+ * Read from the model's input shape at load time, so the Java side sizes
+ * its capture buffers and batches from it instead of a constant.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @return Window length in samples, or 0 if the processor is invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetWindowLength(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+    return processor->getWindowLength();
+}
+
+/**
+ * JNI Function: Whether the model is a stateful streaming variant
+ * 
+ * Java signature:
+ *   public native boolean nativeIsStateful(long handle)
+ * 
+ * Stateful models carry their state between invokes; the window length is
+ * then the step each invoke takes (see MLProcessor::isStateful).
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @return JNI_TRUE if stateful, JNI_FALSE otherwise or if the handle is invalid
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeIsStateful(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+    return processor->isStateful() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Shape of the model's input or output tensor
+ * 
+ * Java signature:
+ *   public native int nativeGetTensorShape(long handle, boolean input, int[] dims)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param input true for the input tensor, false for the output tensor
+ * @param dims Receives up to dims.length dimensions
+ * @return Tensor rank, or 0 if the processor is invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetTensorShape(
+        JNIEnv* env, jobject /* this */, jlong handle, jboolean input, jintArray dims) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor || !dims) {
+        LOGE("Invalid processor handle or shape array");
+        return 0;
+    }
+
+    // TFLite tensors used here have at most a handful of dimensions
+    int shape[8];
+    const int rank = input ? processor->getInputShape(shape, 8)
+                           : processor->getOutputShape(shape, 8);
+    const jsize capacity = env->GetArrayLength(dims);
+    jsize count = rank < capacity ? rank : capacity;
+    if (count > 8) count = 8;
+    if (count > 0) {
+        env->SetIntArrayRegion(dims, 0, count, reinterpret_cast<const jint*>(shape));
+    }
+    return rank;
+}
+
+/**
+ * JNI Function: Configure the streaming classifier
+ * 
+ * Java signature:
+ *   public native boolean nativeConfigureStream(long handle, int hopSize,
+ *                                               int bufferCapacity, int batchSize)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param hopSize Samples between consecutive windows (1..window length)
+ * @param bufferCapacity Samples the stream can buffer between reads
+ * @param batchSize Windows classified per interpreter invoke
+ * @return true if the stream was configured
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeConfigureStream(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jint hopSize,
+        jint bufferCapacity, jint batchSize) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+
+    LOGI("Configuring stream: hop %d, capacity %d, batch %d",
+         hopSize, bufferCapacity, batchSize);
+    return processor->configureStream(hopSize, bufferCapacity, batchSize)
+            ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Push captured samples into the stream
+ * 
+ * Java signature:
+ *   public native int nativePushAudio(long handle, short[] audioData, int length)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java short array containing audio samples
+ * @param length Number of valid samples at the start of audioData
+ * @return Number of samples accepted by the stream
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativePushAudio(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData,
+        jint length) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+
+    // Never read past the end of the Java array
+    jsize arrayLength = env->GetArrayLength(audioData);
+    if (length > arrayLength) length = arrayLength;
+    if (length <= 0) return 0;
+
+    jshort* data = env->GetShortArrayElements(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to get array elements");
+        return 0;
+    }
+
+    int pushed = processor->pushAudio(reinterpret_cast<const int16_t*>(data), length);
+
+    // Read-only access: nothing to copy back
+    env->ReleaseShortArrayElements(audioData, data, JNI_ABORT);
+    return pushed;
+}
+
+/**
+ * JNI Function: Classify all complete windows in the stream
+ * 
+ * Java signature:
+ *   public native int nativeProcessStream(long handle, float[] scores, long[] windowStarts)
+ * 
+ * Results are written into caller-provided arrays (row-major, one row of
+ * getOutputSize() scores per window), so the Java side can reuse them
+ * between calls.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param scores Java float array receiving the score rows
+ * @param windowStarts Java long array receiving each window's first sample index
+ * @return Number of windows classified, or -1 on failure
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeProcessStream(
+        JNIEnv* env, jobject /* this */, jlong handle, jfloatArray scores,
+        jlongArray windowStarts) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor || processor->getOutputSize() <= 0) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+
+    // Capacity is bounded by both output arrays
+    int maxWindows = env->GetArrayLength(scores) / processor->getOutputSize();
+    jsize startsLength = env->GetArrayLength(windowStarts);
+    if (startsLength < maxWindows) maxWindows = startsLength;
+    if (maxWindows <= 0) return 0;
+
+    jfloat* scoreData = env->GetFloatArrayElements(scores, nullptr);
+    jlong* startData = env->GetLongArrayElements(windowStarts, nullptr);
+    if (!scoreData || !startData) {
+        LOGE("Failed to get array elements");
+        if (scoreData) env->ReleaseFloatArrayElements(scores, scoreData, JNI_ABORT);
+        if (startData) env->ReleaseLongArrayElements(windowStarts, startData, JNI_ABORT);
+        return -1;
+    }
+
+    static_assert(sizeof(jlong) == sizeof(int64_t), "jlong must be 64-bit");
+    int windows = processor->processStream(
+            scoreData, reinterpret_cast<int64_t*>(startData), maxWindows);
+
+    // Mode 0: copy the results back to the Java arrays
+    env->ReleaseFloatArrayElements(scores, scoreData, 0);
+    env->ReleaseLongArrayElements(windowStarts, startData, 0);
+    return windows;
+}
+
+/**
+ * JNI Function: Drop buffered stream samples
+ * 
+ * Java signature:
+ *   public native void nativeResetStream(long handle)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeResetStream(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return;
+    }
+    processor->resetStream();
+}
+
+/**
+ * JNI Function: Set the silence gate and confidence threshold
+ * 
+ * Java signature:
+ *   public native void nativeSetDecisionThresholds(long handle, float minRms, float minScore)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param minRms Audio at or below this RMS is not classified
+ * @param minScore Classes at or below this score are not reported
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeSetDecisionThresholds(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jfloat minRms, jfloat minScore) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return;
+    }
+    processor->setDecisionThresholds(minRms, minScore);
+}
+
+/**
+ * JNI Function: Gate, classify and decide natively
+ * 
+ * Java signature:
+ *   public native boolean nativeClassify(long handle, short[] audioData, int length,
+ *                                        boolean stream, float[] result)
+ * 
+ * With stream == false the first MLProcessor window of audioData is
+ * classified (MLProcessor::classify); with stream == true the samples are
+ * pushed into the configured stream and every completed window counts
+ * (MLProcessor::classifyStream). Either way only the compact decision
+ * crosses back to Java: result = {classIndex, score, rms, windows}.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java short array containing audio samples
+ * @param length Number of valid samples at the start of audioData
+ * @param stream Use the streaming classifier
+ * @param result Java float array (at least 4 values) receiving the decision
+ * @return false if the arguments are invalid or inference failed
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeClassify(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData,
+        jint length, jboolean stream, jfloatArray result) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+    if (env->GetArrayLength(result) < kResultLength) {
+        LOGE("Result array must hold %d values", kResultLength);
+        return JNI_FALSE;
+    }
+
+    // Never read past the end of the Java array
+    jsize arrayLength = env->GetArrayLength(audioData);
+    if (length > arrayLength) length = arrayLength;
+    if (length <= 0) {
+        LOGE("Empty audio data array");
+        return JNI_FALSE;
+    }
+
+    // Rebuild a released interpreter before pinning (see nativeProcessAudioInto)
+    if (!processor->ensureReady()) {
+        return JNI_FALSE;
+    }
+
+    // Pinned for the duration of the call, read-only (see nativeProcessAudioInto)
+    void* data = env->GetPrimitiveArrayCritical(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to pin audio array");
+        return JNI_FALSE;
+    }
+
+    const auto* samples = static_cast<const int16_t*>(data);
+    ClassificationResult decision = stream == JNI_TRUE
+            ? processor->classifyStream(samples, length)
+            : processor->classify(samples, length);
+
+    env->ReleasePrimitiveArrayCritical(audioData, data, JNI_ABORT);
+
+    writeResult(env, result, decision);
+    return decision.windows >= 0 ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Classify every channel of interleaved audio
+ * 
+ * Java signature:
+ *   private external fun nativeClassifyChannels(handle: Long, audioData: ShortArray,
+ *       frames: Int, channels: Int, results: FloatArray): Int
+ * 
+ * The first window of every channel is classified in one batched invoke
+ * (MLProcessor::classifyChannels). Channel c's decision is written to
+ * results[4 * c ..] with the same layout as nativeClassify.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java short array of interleaved frames
+ * @param frames Number of valid frames at the start of audioData
+ * @param channels Samples per frame
+ * @param results Java float array (at least 4 * channels values)
+ * @return Channel with the highest reported score, -1 if none reported a
+ *         class, -2 if the arguments are invalid or inference failed
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeClassifyChannels(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData,
+        jint frames, jint channels, jfloatArray results) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -2;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+    if (channels < 1 || channels > MLProcessor::kMaxChannels) {
+        LOGE("Invalid channel count %d", channels);
+        return -2;
+    }
+    if (env->GetArrayLength(results) < kResultLength * channels) {
+        LOGE("Result array must hold %d values", kResultLength * channels);
+        return -2;
+    }
+
+    // Never read past the end of the Java array
+    jsize arrayFrames = env->GetArrayLength(audioData) / channels;
+    if (frames > arrayFrames) frames = arrayFrames;
+    if (frames <= 0) {
+        LOGE("Empty audio data array");
+        return -2;
+    }
+
+    // Rebuild a released interpreter before pinning (see nativeProcessAudioInto)
+    if (!processor->ensureReady()) {
+        return -2;
+    }
+
+    // Pinned for the duration of the call, read-only (see nativeProcessAudioInto)
+    void* data = env->GetPrimitiveArrayCritical(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to pin audio array");
+        return -2;
+    }
+
+    ClassificationResult decisions[MLProcessor::kMaxChannels];
+    const int best = processor->classifyChannels(static_cast<const int16_t*>(data), frames,
+                                                 channels, decisions);
+
+    env->ReleasePrimitiveArrayCritical(audioData, data, JNI_ABORT);
+
+    jfloat values[kResultLength * MLProcessor::kMaxChannels];
+    for (int c = 0; c < channels; c++) {
+        jfloat* row = values + c * kResultLength;
+        row[kResultClassIndex] = static_cast<jfloat>(decisions[c].classIndex);
+        row[kResultScore] = decisions[c].score;
+        row[kResultRms] = decisions[c].rms;
+        row[kResultWindows] = static_cast<jfloat>(decisions[c].windows);
+    }
+    env->SetFloatArrayRegion(results, 0, kResultLength * channels, values);
+    return decisions[0].windows >= 0 ? best : -2;
+}
+
+/**
+ * JNI Function: Enable class events on the decision API
+ * 
+ * Java signature:
+ *   private external fun nativeConfigureEvents(handle: Long, smoothingWindows: Int,
+ *       onThreshold: Float, offThreshold: Float): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param smoothingWindows Window posteriors averaged
+ * @param onThreshold Smoothed score a class must exceed to start
+ * @param offThreshold Smoothed score below which it ends
+ * @return false if the handle or the parameters are invalid
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeConfigureEvents(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jint smoothingWindows,
+        jfloat onThreshold, jfloat offThreshold) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+    return processor->configureEvents(smoothingWindows, onThreshold, offThreshold)
+            ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Screen stream windows with the activity detector
+ * 
+ * Java signature:
+ *   private external fun nativeConfigureCascade(handle: Long, snrDb: Float,
+ *       minCrossingRate: Float, maxCrossingRate: Float, hangoverWindows: Int): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param snrDb Energy above the noise floor a window needs
+ * @param minCrossingRate Lowest zero crossings per sample accepted
+ * @param maxCrossingRate Highest zero crossings per sample accepted
+ * @param hangoverWindows Windows still classified after a detection
+ * @return false if the handle or the parameters are invalid
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeConfigureCascade(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jfloat snrDb,
+        jfloat minCrossingRate, jfloat maxCrossingRate, jint hangoverWindows) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+    return processor->configureCascade(snrDb, minCrossingRate, maxCrossingRate,
+                                       hangoverWindows) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Snapshot the per-stage cascade counts
+ * 
+ * Java signature:
+ *   private external fun nativeGetCascadeStats(handle: Long, stats: LongArray): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param stats Receives {windows, detected, confident, skippedInvokes}
+ * @return false if the handle or the array is invalid
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetCascadeStats(
+        JNIEnv* env, jobject /* this */, jlong handle, jlongArray stats) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+    if (env->GetArrayLength(stats) < kCascadeStatsLength) {
+        LOGE("Cascade stats array must hold %d values", kCascadeStatsLength);
+        return JNI_FALSE;
+    }
+
+    const CascadeStats counts = processor->getCascadeStats();
+    jlong values[kCascadeStatsLength];
+    values[0] = counts.windows;
+    values[1] = counts.detected;
+    values[2] = counts.confident;
+    values[3] = counts.skippedInvokes;
+    env->SetLongArrayRegion(stats, 0, kCascadeStatsLength, values);
+    return JNI_TRUE;
+}
+
+/**
+ * JNI Function: Clear the per-stage cascade counts
+ * 
+ * @param handle MLProcessor pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeResetCascadeStats(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return;
+    }
+    processor->resetCascadeStats();
+}
+
+/**
+ * JNI Function: Stream a captured block and return the class events
+ * 
+ * Java signature:
+ *   private external fun nativeClassifyStreamEvents(handle: Long, audioData: ShortArray,
+ *       length: Int, classIndices: IntArray, scores: FloatArray,
+ *       onsets: LongArray, offsets: LongArray): Int
+ * 
+ * Runs MLProcessor::classifyStream, then moves the queued events into the
+ * parallel arrays (event i at index i of each; the shortest array bounds
+ * the count). Most blocks return 0 events, so the caller only touches the
+ * UI on class changes.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param audioData Java short array containing audio samples
+ * @param length Number of valid samples at the start of audioData
+ * @return Events written, or -1 if the arguments are invalid or inference failed
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeClassifyStreamEvents(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData, jint length,
+        jintArray classIndices, jfloatArray scores, jlongArray onsets, jlongArray offsets) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+
+    // Whole JNI call, including pinning and copies (see ml_stats.h)
+    ScopedStage timing(processor->getStats(), MLStage::Jni);
+    if (!processor->hasEvents()) {
+        LOGE("Events not configured");
+        return -1;
+    }
+
+    // Never read past the end of the Java array
+    jsize arrayLength = env->GetArrayLength(audioData);
+    if (length > arrayLength) length = arrayLength;
+    if (length <= 0) {
+        LOGE("Empty audio data array");
+        return -1;
+    }
+
+    // Rebuild a released interpreter before pinning (see nativeProcessAudioInto)
+    if (!processor->ensureReady()) {
+        return -1;
+    }
+
+    // Pinned for the duration of the call, read-only (see nativeProcessAudioInto)
+    void* data = env->GetPrimitiveArrayCritical(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to pin audio array");
+        return -1;
+    }
+    const ClassificationResult decision =
+            processor->classifyStream(static_cast<const int16_t*>(data), length);
+    env->ReleasePrimitiveArrayCritical(audioData, data, JNI_ABORT);
+    if (decision.windows < 0) {
+        return -1;
+    }
+
+    const jsize capacity = eventCapacity(env, classIndices, scores, onsets, offsets);
+    ClassEvent events[kPollBatch];
+    jsize written = 0;
+    while (written < capacity) {
+        const int wanted = capacity - written < kPollBatch ? capacity - written : kPollBatch;
+        const int count = processor->popEvents(events, wanted);
+        if (count == 0) {
+            break;
+        }
+        writeEvents(env, events, count, written, classIndices, scores, onsets, offsets);
+        written += count;
+    }
+    return written;
+}
+
+/**
+ * JNI Function: Snapshot the per-stage latency histograms
+ * 
+ * Java signature:
+ *   public native int nativeGetStats(long handle, double[] stats)
+ * 
+ * Row i (offset i * 6) describes MLStage i as {count, mean, p50, p95, p99,
+ * max}, durations in microseconds. Safe to call from any thread while
+ * inference is running.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param stats Java double array with room for kStageCount rows
+ * @return Number of stages written, or -1 on failure
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetStats(
+        JNIEnv* env, jobject /* this */, jlong handle, jdoubleArray stats) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+    if (env->GetArrayLength(stats) < kStageCount * kStatsFields) {
+        LOGE("Stats array must hold %d values", kStageCount * kStatsFields);
+        return -1;
+    }
+
+    jdouble values[kStageCount * kStatsFields];
+    for (int stage = 0; stage < kStageCount; stage++) {
+        const StageSummary summary = processor->getStats().snapshot(static_cast<MLStage>(stage));
+        jdouble* row = values + stage * kStatsFields;
+        row[kStatsCount] = static_cast<jdouble>(summary.count);
+        row[kStatsMean] = summary.meanUs;
+        row[kStatsP50] = summary.p50Us;
+        row[kStatsP95] = summary.p95Us;
+        row[kStatsP99] = summary.p99Us;
+        row[kStatsMax] = summary.maxUs;
+    }
+    env->SetDoubleArrayRegion(stats, 0, kStageCount * kStatsFields, values);
+    return kStageCount;
+}
+
+/**
+ * JNI Function: Clear the per-stage latency histograms
+ * 
+ * Java signature:
+ *   public native void nativeResetStats(long handle)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeResetStats(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return;
+    }
+    processor->getStats().reset();
+}
+
+/**
+ * JNI Function: Emit ATrace sections for the timed stages
+ * 
+ * Java signature:
+ *   public native void nativeSetTraceEnabled(long handle, boolean enabled)
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param enabled Emit sections while a Perfetto / systrace capture runs
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeSetTraceEnabled(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jboolean enabled) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return;
+    }
+    processor->getStats().setTraceEnabled(enabled == JNI_TRUE);
+}
+
+/**
+ * JNI Function: Report the memory the processor accounts for
+ * 
+ * Java signature:
+ *   private external fun nativeGetMemoryReport(handle: Long, report: LongArray): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param report Receives {modelBytes, modelResidentBytes, modelMapped, delegate,
+ *               delegateBytes, interpreterBytes, arenaBytes, batchSize, released,
+ *               processResidentBytes}
+ * @return false if the handle or the array is invalid
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetMemoryReport(
+        JNIEnv* env, jobject /* this */, jlong handle, jlongArray report) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return JNI_FALSE;
+    }
+    if (env->GetArrayLength(report) < kMemoryReportLength) {
+        LOGE("Memory report array must hold %d values", kMemoryReportLength);
+        return JNI_FALSE;
+    }
+
+    const MemoryReport memory = processor->getMemoryReport();
+    jlong values[kMemoryReportLength];
+    values[0] = memory.model.bytes;
+    values[1] = memory.model.residentBytes;
+    values[2] = memory.model.mapped ? 1 : 0;
+    values[3] = static_cast<jlong>(memory.delegate);
+    values[4] = memory.delegateBytes;
+    values[5] = memory.interpreterBytes;
+    values[6] = memory.arenaBytes;
+    values[7] = memory.batchSize;
+    values[8] = memory.released ? 1 : 0;
+    values[9] = memory.processResidentBytes;
+    env->SetLongArrayRegion(report, 0, kMemoryReportLength, values);
+    return JNI_TRUE;
+}
+
+/**
+ * JNI Function: Release interpreter, arenas and delegate while idle
+ * 
+ * They are built again by the next inference call.
+ * 
+ * @param handle MLProcessor pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeReleaseArenas(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return;
+    }
+    processor->releaseArenas();
+}
+
+/**
+ * JNI Function: Apply the thread policy to the calling thread
+ * 
+ * Java signature:
+ *   private external fun nativePrepareStreamThread(handle: Long): Int
+ * 
+ * Called on the Java recording thread, which then feeds the stream (see
+ * MLProcessor::prepareStreamThread).
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @return Priority applied (ThreadPriority id), or -1 if the handle is invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativePrepareStreamThread(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+    return static_cast<jint>(processor->prepareStreamThread());
+}
+
+/**
+ * JNI Function: Report where the invokes ran
+ * 
+ * Java signature:
+ *   private external fun nativeGetCoreUsage(handle: Long, usage: LongArray): Int
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ * @param usage Receives {performanceCores, pinnedCores, invokes on CPU 0,
+ *              invokes on CPU 1, ...}
+ * @return Number of CPUs reported, or -1 if the handle or the array is invalid
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeGetCoreUsage(
+        JNIEnv* env, jobject /* this */, jlong handle, jlongArray usage) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return -1;
+    }
+
+    const CoreUsage cores = processor->getCoreUsage();
+    const jsize length = kCoreUsageInvokes + cores.cpus;
+    if (env->GetArrayLength(usage) < length) {
+        LOGE("Core usage array must hold %d values", length);
+        return -1;
+    }
+
+    jlong values[kCoreUsageInvokes + kMaxCpus];
+    values[kCoreUsagePerformance] = static_cast<jlong>(cores.performanceCores);
+    values[kCoreUsagePinned] = static_cast<jlong>(cores.pinnedCores);
+    for (int cpu = 0; cpu < cores.cpus; cpu++) {
+        values[kCoreUsageInvokes + cpu] = cores.invokes[cpu];
+    }
+    env->SetLongArrayRegion(usage, 0, length, values);
+    return cores.cpus;
+}
+
+/**
+ * JNI Function: Clean up and destroy ML processor
+ * 
+ * Java signature:
+ *   public native void nativeClose(long handle)
+ * 
+ * This function:
+ * 1. Retrieves the MLProcessor instance from the handle
+ * 2. Deletes the instance (destructor cleans up TensorFlow Lite resources)
+ * 3. Prevents memory leaks from native object
+ * 
+ * Must be called when done with the processor to release native memory.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle MLProcessor pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeMLProcessor_nativeClose(
+        JNIEnv* env, jobject /* this */, jlong handle) {
+
+    // Cast handle back to MLProcessor pointer
+    auto* processor = reinterpret_cast<MLProcessor*>(handle);
+    if (processor) {
+        LOGI("Closing MLProcessor");
+        delete processor;  // Destructor will clean up all TensorFlow Lite resources
+    } else {
+        LOGE("Attempted to close invalid processor handle");
+    }
+}
+
+// ============================================================================
+// OFFLINE FILE CLASSIFICATION
+// ============================================================================
+// Bridge for OfflineClassifier.kt. The handle is an OfflineClassifier
+// pointer; it shares the model of the NativeMLProcessor it was created from.
+
+/**
+ * JNI Function: Create an offline classifier over a processor's model
+ * 
+ * Java signature:
+ *   private external fun nativeCreate(processorHandle: Long, workers: Int): Long
+ * 
+ * Every worker gets its own single-threaded interpreter on the processor's
+ * backend; parallelism comes from the workers instead. GPU / NNAPI
+ * processors run the offline workers on XNNPACK, as one accelerator cannot
+ * be shared by many parallel interpreters.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param processorHandle MLProcessor pointer cast to jlong
+ * @param workers Worker threads
+ * @return Handle (pointer cast to jlong), or 0 on failure
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeCreate(
+        JNIEnv* /* env */, jobject /* this */, jlong processorHandle, jint workers) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(processorHandle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+
+    MLProcessorConfig config;
+    const DelegateType active = processor->getActiveDelegate();
+    config.delegate = active == DelegateType::Gpu || active == DelegateType::Nnapi
+            ? DelegateType::XnnPack : active;
+    config.numThreads = 1;
+    config.frontEnd = processor->getFrontEnd();
+    config.frontEnd.inputSampleRate = 0;  // Files are read at the model rate
+
+    auto* classifier = new OfflineClassifier(processor->getModel(), workers, config);
+    if (!classifier->isInitialized()) {
+        LOGE("OfflineClassifier initialization failed");
+        delete classifier;
+        return 0;
+    }
+    LOGI("OfflineClassifier running %d workers", classifier->getWorkerCount());
+    return reinterpret_cast<jlong>(classifier);
+}
+
+/**
+ * Start a run over an opened file, logging the outcome.
+ */
+static jboolean startRun(OfflineClassifier* classifier, AudioFile&& file, jint hopSize,
+                         jint channel, jfloat minRms, jfloat minScore) {
+    if (!file.isOpen()) {
+        return JNI_FALSE;
+    }
+    return classifier->start(std::move(file), hopSize, channel, minRms, minScore)
+            ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Map an audio file and start classifying it
+ * 
+ * Java signature:
+ *   private external fun nativeStartFile(handle: Long, path: String, hopSize: Int,
+ *       channel: Int, rawSampleRate: Int, rawChannels: Int, minRms: Float,
+ *       minScore: Float): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle OfflineClassifier pointer cast to jlong
+ * @param path WAV or raw PCM file
+ * @param hopSize Frames between window starts
+ * @param channel Channel to classify
+ * @param rawSampleRate Sample rate of raw PCM (ignored for WAV)
+ * @param rawChannels Channel count of raw PCM (ignored for WAV)
+ * @param minRms Silence gate
+ * @param minScore Confidence threshold
+ * @return true if the run started
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeStartFile(
+        JNIEnv* env, jobject /* this */, jlong handle, jstring path, jint hopSize,
+        jint channel, jint rawSampleRate, jint rawChannels, jfloat minRms, jfloat minScore) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid offline classifier handle");
+        return JNI_FALSE;
+    }
+
+    const char* filePath = env->GetStringUTFChars(path, nullptr);
+    if (!filePath) {
+        LOGE("Failed to get string from Java");
+        return JNI_FALSE;
+    }
+    AudioFile file;
+    file.open(filePath, rawSampleRate, rawChannels);
+    env->ReleaseStringUTFChars(path, filePath);
+
+    return startRun(classifier, std::move(file), hopSize, channel, minRms, minScore);
+}
+
+/**
+ * JNI Function: Map an audio file region and start classifying it
+ * 
+ * Java signature:
+ *   private external fun nativeStartFd(handle: Long, fd: Int, offset: Long,
+ *       length: Long, hopSize: Int, channel: Int, rawSampleRate: Int,
+ *       rawChannels: Int, minRms: Float, minScore: Float): Boolean
+ * 
+ * The descriptor is only used during the call; the mapping stays valid
+ * after Java closes it.
+ * 
+ * @param fd Readable file descriptor
+ * @param offset Start of the audio file inside fd
+ * @param length Audio file size in bytes
+ * @see nativeStartFile for the remaining parameters
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeStartFd(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jint fd, jlong offset,
+        jlong length, jint hopSize, jint channel, jint rawSampleRate, jint rawChannels,
+        jfloat minRms, jfloat minScore) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid offline classifier handle");
+        return JNI_FALSE;
+    }
+
+    AudioFile file;
+    file.openFd(fd, offset, length, rawSampleRate, rawChannels);
+    return startRun(classifier, std::move(file), hopSize, channel, minRms, minScore);
+}
+
+/**
+ * JNI Function: Collect finished timeline entries in order
+ * 
+ * Java signature:
+ *   private external fun nativePoll(handle: Long, startFrames: LongArray,
+ *       classIndices: IntArray, scores: FloatArray, rms: FloatArray): Int
+ * 
+ * Entry i is written to index i of every array; the shortest array bounds
+ * the count. Entries are copied out in small stack batches, so nothing is
+ * pinned or allocated.
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle OfflineClassifier pointer cast to jlong
+ * @return Entries written (0 if none is ready yet), or -1 once the run is
+ *         finished and every entry has been returned
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativePoll(
+        JNIEnv* env, jobject /* this */, jlong handle, jlongArray startFrames,
+        jintArray classIndices, jfloatArray scores, jfloatArray rms) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid offline classifier handle");
+        return -1;
+    }
+
+    jsize capacity = env->GetArrayLength(startFrames);
+    if (env->GetArrayLength(classIndices) < capacity) capacity = env->GetArrayLength(classIndices);
+    if (env->GetArrayLength(scores) < capacity) capacity = env->GetArrayLength(scores);
+    if (env->GetArrayLength(rms) < capacity) capacity = env->GetArrayLength(rms);
+
+    TimelineEntry entries[kPollBatch];
+    jlong batchStarts[kPollBatch];
+    jint batchClasses[kPollBatch];
+    jfloat batchScores[kPollBatch];
+    jfloat batchRms[kPollBatch];
+
+    jsize written = 0;
+    while (written < capacity) {
+        const int wanted = capacity - written < kPollBatch ? capacity - written : kPollBatch;
+        const int count = classifier->poll(entries, wanted);
+        if (count == 0) {
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            batchStarts[i] = static_cast<jlong>(entries[i].startFrame);
+            batchClasses[i] = entries[i].result.classIndex;
+            batchScores[i] = entries[i].result.score;
+            batchRms[i] = entries[i].result.rms;
+        }
+        env->SetLongArrayRegion(startFrames, written, count, batchStarts);
+        env->SetIntArrayRegion(classIndices, written, count, batchClasses);
+        env->SetFloatArrayRegion(scores, written, count, batchScores);
+        env->SetFloatArrayRegion(rms, written, count, batchRms);
+        written += count;
+    }
+
+    if (written == 0 && classifier->isFinished()) {
+        return -1;
+    }
+    return written;
+}
+
+/**
+ * JNI Function: Number of windows in the current run
+ * 
+ * @param handle OfflineClassifier pointer cast to jlong
+ * @return Window count, or 0 if the handle is invalid
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeGetWindowCount(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    return classifier ? classifier->getWindowCount() : 0;
+}
+
+/**
+ * JNI Function: Windows classified so far (for progress reporting)
+ * 
+ * @param handle OfflineClassifier pointer cast to jlong
+ * @return Completed windows, or 0 if the handle is invalid
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeGetCompleted(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    return classifier ? classifier->getCompletedWindows() : 0;
+}
+
+/**
+ * JNI Function: True if a window failed inference in the current run
+ * 
+ * @param handle OfflineClassifier pointer cast to jlong
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeHasFailed(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    return !classifier || classifier->hasFailed() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Stop the current run and join the workers
+ * 
+ * @param handle OfflineClassifier pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeCancel(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid offline classifier handle");
+        return;
+    }
+    classifier->cancel();
+}
+
+/**
+ * JNI Function: Cancel any run and destroy the offline classifier
+ * 
+ * @param handle OfflineClassifier pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_OfflineClassifier_nativeClose(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<OfflineClassifier*>(handle);
+    if (classifier) {
+        LOGI("Closing OfflineClassifier");
+        delete classifier;  // Joins the workers and unmaps the file
+    } else {
+        LOGE("Attempted to close invalid offline classifier handle");
+    }
+}
+
+// ============================================================================
+// NATIVE AUDIO CAPTURE
+// ============================================================================
+// Bridge for NativeAudioCapture.kt. The handle is an AudioCapture pointer
+// bound to the NativeMLProcessor it was created from.
+
+/**
+ * JNI Function: Create a capture engine for a processor
+ * 
+ * Java signature:
+ *   private external fun nativeCreate(processorHandle: Long): Long
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param processorHandle MLProcessor pointer cast to jlong
+ * @return Handle (pointer cast to jlong), or 0 if AAudio is unavailable
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeCreate(
+        JNIEnv* /* env */, jobject /* this */, jlong processorHandle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(processorHandle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+    if (!AudioCapture::isAvailable()) {
+        return 0;
+    }
+    return reinterpret_cast<jlong>(new AudioCapture(*processor));
+}
+
+/**
+ * JNI Function: Open the AAudio input stream and start classifying
+ * 
+ * Java signature:
+ *   private external fun nativeStart(handle: Long, sampleRate: Int,
+ *                                    exclusive: Boolean): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle AudioCapture pointer cast to jlong
+ * @param sampleRate Capture rate (0 = device native rate)
+ * @param exclusive Request an exclusive stream
+ * @return true if capture started
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeStart(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jint sampleRate,
+        jboolean exclusive) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    if (!capture) {
+        LOGE("Invalid capture handle");
+        return JNI_FALSE;
+    }
+    return capture->start(sampleRate, exclusive == JNI_TRUE) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Block until the worker publishes a decision
+ * 
+ * Java signature:
+ *   private external fun nativeWaitForResult(handle: Long, timeoutMs: Int,
+ *                                            result: FloatArray): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle AudioCapture pointer cast to jlong
+ * @param timeoutMs Longest wait
+ * @param result Receives {classIndex, score, rms, windows}
+ * @return false on timeout or once capture stopped
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeWaitForResult(
+        JNIEnv* env, jobject /* this */, jlong handle, jint timeoutMs, jfloatArray result) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    if (!capture) {
+        LOGE("Invalid capture handle");
+        return JNI_FALSE;
+    }
+    if (env->GetArrayLength(result) < kResultLength) {
+        LOGE("Result array must hold %d values", kResultLength);
+        return JNI_FALSE;
+    }
+
+    ClassificationResult decision;
+    if (!capture->waitForResult(&decision, timeoutMs)) {
+        return JNI_FALSE;
+    }
+    writeResult(env, result, decision);
+    return JNI_TRUE;
+}
+
+/**
+ * JNI Function: Block until the worker queues class events
+ * 
+ * Java signature:
+ *   private external fun nativeWaitForEvents(handle: Long, timeoutMs: Int,
+ *       classIndices: IntArray, scores: FloatArray, onsets: LongArray,
+ *       offsets: LongArray): Int
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle AudioCapture pointer cast to jlong
+ * @param timeoutMs Longest wait
+ * @return Events written (event i at index i of each array), 0 on timeout
+ *         or once capture stopped
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeWaitForEvents(
+        JNIEnv* env, jobject /* this */, jlong handle, jint timeoutMs, jintArray classIndices,
+        jfloatArray scores, jlongArray onsets, jlongArray offsets) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    if (!capture) {
+        LOGE("Invalid capture handle");
+        return 0;
+    }
+
+    jsize capacity = eventCapacity(env, classIndices, scores, onsets, offsets);
+    if (capacity > kPollBatch) capacity = kPollBatch;
+    ClassEvent events[kPollBatch];
+    const int count = capture->waitForEvents(events, capacity, timeoutMs);
+    if (count > 0) {
+        writeEvents(env, events, count, 0, classIndices, scores, onsets, offsets);
+    }
+    return count;
+}
+
+/**
+ * JNI Function: True while the stream and the worker run
+ * 
+ * @param handle AudioCapture pointer cast to jlong
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeIsRunning(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    return capture && capture->isRunning() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Samples dropped because the worker fell behind
+ * 
+ * @param handle AudioCapture pointer cast to jlong
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeGetDroppedSamples(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    return capture ? capture->getDroppedSamples() : 0;
+}
+
+/**
+ * JNI Function: Under-/overruns reported by AAudio
+ * 
+ * @param handle AudioCapture pointer cast to jlong
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeGetXRunCount(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    return capture ? capture->getXRunCount() : 0;
+}
+
+/**
+ * JNI Function: True if the stream got exclusive access to the device
+ * 
+ * @param handle AudioCapture pointer cast to jlong
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeIsExclusive(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    return capture && capture->isExclusive() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Stop the stream and the worker
+ * 
+ * @param handle AudioCapture pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeStop(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    if (!capture) {
+        LOGE("Invalid capture handle");
+        return;
+    }
+    capture->stop();
+}
+
+/**
+ * JNI Function: Stop and destroy the capture engine
+ * 
+ * @param handle AudioCapture pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAudioCapture_nativeClose(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* capture = reinterpret_cast<AudioCapture*>(handle);
+    if (capture) {
+        LOGI("Closing AudioCapture");
+        delete capture;  // Stops the stream and joins the worker
+    } else {
+        LOGE("Attempted to close invalid capture handle");
+    }
+}
+
+// ============================================================================
+// NATIVE ASYNC CLASSIFIER
+// ============================================================================
+// Bridge for NativeAsyncClassifier.kt. The handle is an AsyncClassifier
+// pointer bound to the NativeMLProcessor it was created from.
+
+// Status layout written by nativeWait: {ticket, eventCount}
+static const int kAsyncStatusTicket = 0;
+static const int kAsyncStatusEvents = 1;
+static const int kAsyncStatusLength = 2;
+
+/**
+ * JNI Function: Create an async classifier for a processor
+ * 
+ * Java signature:
+ *   private external fun nativeCreate(processorHandle: Long): Long
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param processorHandle MLProcessor pointer cast to jlong
+ * @return Handle (pointer cast to jlong), or 0 on error
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeCreate(
+        JNIEnv* /* env */, jobject /* this */, jlong processorHandle) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(processorHandle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+    return reinterpret_cast<jlong>(new AsyncClassifier(*processor));
+}
+
+/**
+ * JNI Function: Allocate the input slots and start the worker
+ * 
+ * Java signature:
+ *   private external fun nativeStart(handle: Long, slots: Int, slotSamples: Int): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle AsyncClassifier pointer cast to jlong
+ * @param slots Blocks in flight at most
+ * @param slotSamples Largest block accepted by nativeSubmit
+ * @return true if the worker started
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeStart(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jint slots, jint slotSamples) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid async classifier handle");
+        return JNI_FALSE;
+    }
+    return classifier->start(slots, slotSamples) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Copy a block into a free slot and queue it
+ * 
+ * Java signature:
+ *   private external fun nativeSubmit(handle: Long, audioData: ShortArray,
+ *                                     length: Int, stream: Boolean): Long
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle AsyncClassifier pointer cast to jlong
+ * @param audioData Java short array with 16-bit PCM samples
+ * @param length Number of valid samples
+ * @param stream Stream the block (true) or classify it as one window
+ * @return Ticket of the block, or -1 if every slot is in flight
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeSubmit(
+        JNIEnv* env, jobject /* this */, jlong handle, jshortArray audioData, jint length,
+        jboolean stream) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid async classifier handle");
+        return -1;
+    }
+
+    // Never read past the end of the Java array
+    jsize arrayLength = env->GetArrayLength(audioData);
+    if (length > arrayLength) length = arrayLength;
+    if (length <= 0) {
+        LOGE("Empty audio data array");
+        return -1;
+    }
+
+    // Pinned only for the copy into the slot (see nativeProcessAudioInto)
+    void* data = env->GetPrimitiveArrayCritical(audioData, nullptr);
+    if (!data) {
+        LOGE("Failed to pin audio array");
+        return -1;
+    }
+    const int64_t ticket = classifier->submit(static_cast<const int16_t*>(data), length,
+                                              stream == JNI_TRUE);
+    env->ReleasePrimitiveArrayCritical(audioData, data, JNI_ABORT);
+    return static_cast<jlong>(ticket);
+}
+
+/**
+ * JNI Function: Wait for the oldest outstanding block (0 ms = poll)
+ * 
+ * Java signature:
+ *   private external fun nativeWait(handle: Long, timeoutMs: Int,
+ *       status: LongArray, result: FloatArray, classIndices: IntArray,
+ *       scores: FloatArray, onsets: LongArray, offsets: LongArray): Boolean
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param handle AsyncClassifier pointer cast to jlong
+ * @param timeoutMs Longest wait
+ * @param status Receives {ticket, eventCount}
+ * @param result Receives {classIndex, score, rms, windows}
+ * @return false on timeout, or if nothing is in flight
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeWait(
+        JNIEnv* env, jobject /* this */, jlong handle, jint timeoutMs, jlongArray status,
+        jfloatArray result, jintArray classIndices, jfloatArray scores, jlongArray onsets,
+        jlongArray offsets) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid async classifier handle");
+        return JNI_FALSE;
+    }
+    if (env->GetArrayLength(status) < kAsyncStatusLength ||
+        env->GetArrayLength(result) < kResultLength) {
+        LOGE("Status / result arrays must hold %d / %d values", kAsyncStatusLength,
+             kResultLength);
+        return JNI_FALSE;
+    }
+
+    AsyncResult outcome;
+    if (!classifier->wait(&outcome, timeoutMs)) {
+        return JNI_FALSE;
+    }
+
+    // Events that do not fit the arrays are dropped (the Kotlin side sizes
+    // them for AsyncResult::kMaxEvents)
+    jsize count = eventCapacity(env, classIndices, scores, onsets, offsets);
+    if (count > outcome.eventCount) count = outcome.eventCount;
+    if (count > 0) {
+        writeEvents(env, outcome.events, count, 0, classIndices, scores, onsets, offsets);
+    }
+    writeResult(env, result, outcome.result);
+
+    jlong values[kAsyncStatusLength];
+    values[kAsyncStatusTicket] = static_cast<jlong>(outcome.ticket);
+    values[kAsyncStatusEvents] = static_cast<jlong>(count);
+    env->SetLongArrayRegion(status, 0, kAsyncStatusLength, values);
+    return JNI_TRUE;
+}
+
+/**
+ * JNI Function: Blocks submitted and not yet collected
+ * 
+ * @param handle AsyncClassifier pointer cast to jlong
+ */
+JNIEXPORT jint JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeInFlight(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    return classifier ? classifier->inFlight() : 0;
+}
+
+/**
+ * JNI Function: Submissions refused because every slot was in flight
+ * 
+ * @param handle AsyncClassifier pointer cast to jlong
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeGetRejected(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    return classifier ? classifier->getRejected() : 0;
+}
+
+/**
+ * JNI Function: Stop the worker (pending blocks are discarded)
+ * 
+ * @param handle AsyncClassifier pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeStop(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    if (!classifier) {
+        LOGE("Invalid async classifier handle");
+        return;
+    }
+    classifier->stop();
+}
+
+/**
+ * JNI Function: Stop and destroy the async classifier
+ * 
+ * @param handle AsyncClassifier pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeAsyncClassifier_nativeClose(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* classifier = reinterpret_cast<AsyncClassifier*>(handle);
+    if (classifier) {
+        LOGI("Closing AsyncClassifier");
+        delete classifier;  // Joins the worker
+    } else {
+        LOGE("Attempted to close invalid async classifier handle");
+    }
+}
+
+// ============================================================================
+// NATIVE INFERENCE SCHEDULER
+// ============================================================================
+// Bridge for NativeInferenceScheduler.kt. The handle is an
+// InferenceScheduler pointer bound to the NativeMLProcessor it was created
+// from.
+
+// Status layout written by nativeGetStatus (see NativeInferenceScheduler.Status)
+static const int kSchedulerLevel = 0;
+static const int kSchedulerThermal = 1;
+static const int kSchedulerPowerSave = 2;
+static const int kSchedulerLoad = 3;
+static const int kSchedulerP95 = 4;
+static const int kSchedulerThrottles = 5;
+static const int kSchedulerRestores = 6;
+static const int kSchedulerStatusLength = 7;
+
+/**
+ * JNI Function: Create an inference scheduler for a processor
+ * 
+ * Java signature:
+ *   private external fun nativeCreate(processorHandle: Long, intervalMs: Int,
+ *       throttleThermalStatus: Int, maxLoad: Float, recoverLoad: Float,
+ *       maxLatencyMs: Float, recoverIntervals: Int, throttledHop: Int,
+ *       throttledThreads: Int, throttledDelegate: Int, lightModelPath: String?): Long
+ * 
+ * @param env JNI environment pointer
+ * @param this Reference to the calling object (unused here)
+ * @param processorHandle MLProcessor pointer cast to jlong
+ * @param throttledDelegate DelegateType id, or -1 to keep the delegate
+ * @param lightModelPath Model for the LightModel step, or null to skip it
+ * @return Handle (pointer cast to jlong), or 0 on error (including an
+ *         unknown delegate id)
+ */
+JNIEXPORT jlong JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeInferenceScheduler_nativeCreate(
+        JNIEnv* env, jobject /* this */, jlong processorHandle, jint intervalMs,
+        jint throttleThermalStatus, jfloat maxLoad, jfloat recoverLoad, jfloat maxLatencyMs,
+        jint recoverIntervals, jint throttledHop, jint throttledThreads,
+        jint throttledDelegate, jstring lightModelPath) {
+
+    auto* processor = reinterpret_cast<MLProcessor*>(processorHandle);
+    if (!processor) {
+        LOGE("Invalid processor handle");
+        return 0;
+    }
+
+    SchedulerConfig config;
+    config.intervalMs = intervalMs;
+    config.throttleThermalStatus = throttleThermalStatus;
+    config.maxLoad = maxLoad;
+    config.recoverLoad = recoverLoad;
+    config.maxLatencyMs = maxLatencyMs;
+    config.recoverIntervals = recoverIntervals;
+    config.throttledHop = throttledHop;
+    config.throttledThreads = throttledThreads;
+    if (throttledDelegate >= 0) {
+        if (!delegateTypeFromInt(throttledDelegate, &config.throttledDelegate)) {
+            LOGE("Unknown delegate %d", throttledDelegate);
+            return 0;
+        }
+        config.switchDelegate = true;
+    }
+
+    if (lightModelPath) {
+        const char* path = env->GetStringUTFChars(lightModelPath, nullptr);
+        if (!path) {
+            LOGE("Failed to get string from Java");
+            return 0;
+        }
+        config.throttledModel = SharedModel::fromFile(path);
+        env->ReleaseStringUTFChars(lightModelPath, path);
+        if (!config.throttledModel) {
+            return 0;  // Loading failed and was logged by SharedModel
+        }
+    }
+
+    return reinterpret_cast<jlong>(new InferenceScheduler(*processor, config));
+}
+
+/**
+ * JNI Function: Capture the full-quality settings and start monitoring
+ * 
+ * @param handle InferenceScheduler pointer cast to jlong
+ * @return false if already running or the stream is not configured
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeInferenceScheduler_nativeStart(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* scheduler = reinterpret_cast<InferenceScheduler*>(handle);
+    if (!scheduler) {
+        LOGE("Invalid scheduler handle");
+        return JNI_FALSE;
+    }
+    return scheduler->start() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * JNI Function: Forward the battery saver state
+ * 
+ * @param handle InferenceScheduler pointer cast to jlong
+ * @param enabled Keep the stream at reduced quality
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeInferenceScheduler_nativeSetPowerSaveMode(
+        JNIEnv* /* env */, jobject /* this */, jlong handle, jboolean enabled) {
+
+    auto* scheduler = reinterpret_cast<InferenceScheduler*>(handle);
+    if (scheduler) {
+        scheduler->setPowerSaveMode(enabled == JNI_TRUE);
+    }
+}
+
+/**
+ * JNI Function: Status of the last interval
+ * 
+ * @param env JNI environment pointer
+ * @param handle InferenceScheduler pointer cast to jlong
+ * @param status Java double array (at least 7 values) receiving
+ *               {level, thermalStatus, powerSave, load, p95Ms, throttles, restores}
+ * @return false if the handle or array is invalid
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeInferenceScheduler_nativeGetStatus(
+        JNIEnv* env, jobject /* this */, jlong handle, jdoubleArray status) {
+
+    auto* scheduler = reinterpret_cast<InferenceScheduler*>(handle);
+    if (!scheduler || env->GetArrayLength(status) < kSchedulerStatusLength) {
+        LOGE("Invalid scheduler handle or status array");
+        return JNI_FALSE;
+    }
+
+    const SchedulerStatus current = scheduler->getStatus();
+    jdouble values[kSchedulerStatusLength];
+    values[kSchedulerLevel] = static_cast<jdouble>(static_cast<int>(current.level));
+    values[kSchedulerThermal] = current.thermalStatus;
+    values[kSchedulerPowerSave] = current.powerSave ? 1.0 : 0.0;
+    values[kSchedulerLoad] = current.load;
+    values[kSchedulerP95] = current.p95LatencyMs;
+    values[kSchedulerThrottles] = static_cast<jdouble>(current.throttles);
+    values[kSchedulerRestores] = static_cast<jdouble>(current.restores);
+    env->SetDoubleArrayRegion(status, 0, kSchedulerStatusLength, values);
+    return JNI_TRUE;
+}
+
+/**
+ * JNI Function: Stop monitoring and restore full quality
+ * 
+ * @param handle InferenceScheduler pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeInferenceScheduler_nativeStop(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* scheduler = reinterpret_cast<InferenceScheduler*>(handle);
+    if (!scheduler) {
+        LOGE("Invalid scheduler handle");
+        return;
+    }
+    scheduler->stop();
+}
+
+/**
+ * JNI Function: Stop and destroy the scheduler
+ * 
+ * @param handle InferenceScheduler pointer cast to jlong
+ */
+JNIEXPORT void JNICALL
+Java_com_atleastitworks_example_1ndk_1ml_NativeInferenceScheduler_nativeClose(
+        JNIEnv* /* env */, jobject /* this */, jlong handle) {
+
+    auto* scheduler = reinterpret_cast<InferenceScheduler*>(handle);
+    if (scheduler) {
+        LOGI("Closing InferenceScheduler");
+        delete scheduler;  // Joins the monitor
+    } else {
+        LOGE("Attempted to close invalid scheduler handle");
     }
 }
 
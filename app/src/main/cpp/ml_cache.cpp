@@ -0,0 +1,165 @@
+// ============================================================================
+// PERSISTENT TUNING CACHE - IMPLEMENTATION
+// ============================================================================
+
+#include "ml_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__ANDROID__)
+#include <sys/system_properties.h>
+#endif
+
+// ============================================================================
+// IDENTITY HELPERS
+// ============================================================================
+
+static const uint64_t kFnvOffsetBasis = 1469598103934665603ULL;
+static const uint64_t kFnvPrime = 1099511628211ULL;
+
+/**
+ * Continue an FNV-1a hash over `size` more bytes.
+ */
+static uint64_t fnv1a(uint64_t h, const unsigned char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= kFnvPrime;
+    }
+    return h;
+}
+
+/**
+ * 64-bit FNV-1a hash of a memory block.
+ */
+uint64_t hashBytes(const void* data, size_t size) {
+    return fnv1a(kFnvOffsetBasis, static_cast<const unsigned char*>(data), size);
+}
+
+/**
+ * 64-bit FNV-1a hash of a file's contents.
+ */
+bool hashFile(const char* path, uint64_t* hash) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    uint64_t h = kFnvOffsetBasis;
+    unsigned char buffer[16384];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        h = fnv1a(h, buffer, n);
+    }
+
+    const bool ok = !ferror(file);
+    fclose(file);
+    if (ok) *hash = h;
+    return ok;
+}
+
+#if defined(__ANDROID__)
+/**
+ * Read an Android system property ("" if unset).
+ */
+static std::string systemProperty(const char* name) {
+    char value[PROP_VALUE_MAX] = {0};
+    __system_property_get(name, value);
+    return value;
+}
+#endif
+
+/**
+ * Identifier of the device the code runs on.
+ */
+std::string deviceFingerprint() {
+    std::string fingerprint;
+#if defined(__ANDROID__)
+    fingerprint += systemProperty("ro.product.manufacturer") + "/";
+    fingerprint += systemProperty("ro.product.model") + "/";
+    fingerprint += systemProperty("ro.build.fingerprint") + "/";
+#endif
+    fingerprint += "cpus" + std::to_string(std::thread::hardware_concurrency());
+
+    // Keys are stored as "key=value" lines: keep the separators out
+    for (char& c : fingerprint) {
+        if (c == '=' || c == '\n' || c == '\r') c = '_';
+    }
+    return fingerprint;
+}
+
+// ============================================================================
+// CACHE FILE ACCESS
+// ============================================================================
+
+/**
+ * Read all "key=value" lines of a cache file.
+ */
+static std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) {
+        return lines;
+    }
+
+    char buffer[1024];
+    std::string line;
+    while (fgets(buffer, sizeof(buffer), file)) {
+        line += buffer;
+        if (!line.empty() && line.back() == '\n') {
+            line.pop_back();
+            lines.push_back(line);
+            line.clear();
+        }
+    }
+    if (!line.empty()) lines.push_back(line);
+
+    fclose(file);
+    return lines;
+}
+
+bool cacheLoad(const std::string& path, const std::string& key, std::string* value) {
+    const std::string prefix = key + "=";
+    for (const std::string& line : readLines(path)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) {
+            *value = line.substr(prefix.size());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool cacheStore(const std::string& path, const std::string& key, const std::string& value) {
+    const std::string prefix = key + "=";
+
+    // Keep every other entry, replace ours
+    std::vector<std::string> lines = readLines(path);
+    std::vector<std::string> kept;
+    for (const std::string& line : lines) {
+        if (line.compare(0, prefix.size(), prefix) != 0) {
+            kept.push_back(line);
+        }
+    }
+    kept.push_back(prefix + value);
+
+    // Write to a temporary file and rename it over the old one, so a crash
+    // mid-write never leaves a truncated cache behind
+    const std::string temp = path + ".tmp";
+    FILE* file = fopen(temp.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    bool ok = true;
+    for (const std::string& line : kept) {
+        ok = ok && fprintf(file, "%s\n", line.c_str()) >= 0;
+    }
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
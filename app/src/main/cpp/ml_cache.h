@@ -0,0 +1,75 @@
+// ============================================================================
+// PERSISTENT TUNING CACHE - HEADER
+// ============================================================================
+//
+// Small key/value store for decisions that are expensive to make at startup
+// (e.g. the auto-tuned interpreter thread count) and only depend on the
+// device and the model, so later launches can skip them.
+//
+// Key characteristics:
+// - Plain text: One "key=value" entry per line, easy to inspect with adb
+// - Crash-safe: Updates are written to a temporary file and renamed
+// - Self-invalidating: Keys embed the model hash and a device fingerprint,
+//   so a new model or a restored backup on another phone misses the cache
+//
+// =============================================================================
+
+#ifndef ML_CACHE_H
+#define ML_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ============================================================================
+// IDENTITY HELPERS
+// ============================================================================
+
+/**
+ * 64-bit FNV-1a hash of a memory block.
+ */
+uint64_t hashBytes(const void* data, size_t size);
+
+/**
+ * 64-bit FNV-1a hash of a file's contents (same value as hashBytes over
+ * the whole file).
+ *
+ * @param path File to hash
+ * @param hash Receives the hash
+ * @return false if the file cannot be read
+ */
+bool hashFile(const char* path, uint64_t* hash);
+
+/**
+ * Identifier of the device the code runs on.
+ *
+ * On Android: manufacturer, model and build fingerprint from system
+ * properties. Everywhere: the number of online CPU cores.
+ */
+std::string deviceFingerprint();
+
+// ============================================================================
+// CACHE FILE ACCESS
+// ============================================================================
+
+/**
+ * Look up a key in a cache file.
+ *
+ * @param path Cache file path
+ * @param key Entry key (must not contain '=' or newlines)
+ * @param value Receives the stored value
+ * @return false if the file or the key does not exist
+ */
+bool cacheLoad(const std::string& path, const std::string& key, std::string* value);
+
+/**
+ * Insert or replace a key in a cache file.
+ *
+ * @param path Cache file path (its directory must exist)
+ * @param key Entry key (must not contain '=' or newlines)
+ * @param value Value to store (must not contain newlines)
+ * @return false if the file could not be written
+ */
+bool cacheStore(const std::string& path, const std::string& key, const std::string& value);
+
+#endif // ML_CACHE_H
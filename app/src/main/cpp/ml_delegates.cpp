@@ -0,0 +1,209 @@
+// ============================================================================
+// TENSORFLOW LITE DELEGATES - IMPLEMENTATION
+// ============================================================================
+//
+// Delegate factories are looked up at runtime rather than linked directly:
+// libtensorflowlite_c.so usually contains XNNPACK (and NNAPI on Android
+// builds), while the GPU delegate ships as a separate
+// libtensorflowlite_gpu_delegate.so that may or may not be packaged.
+// Only the headers are needed at build time, for the option structs.
+//
+// =============================================================================
+
+#include "ml_delegates.h"
+#include "ml_cache.h"
+#include "ml_log.h"
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tensorflow/lite/delegates/gpu/delegate.h"
+#include "tensorflow/lite/delegates/nnapi/nnapi_delegate_c_api.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+
+// ============================================================================
+// SYMBOL LOOKUP
+// ============================================================================
+
+// Libraries searched for each delegate's factory functions
+static const char* const kCoreLibraries[] = {"libtensorflowlite_c.so", nullptr};
+static const char* const kGpuLibraries[] = {"libtensorflowlite_gpu_delegate.so",
+                                            "libtensorflowlite_c.so", nullptr};
+
+/**
+ * Find an exported function in the process or in one of `libraries`.
+ *
+ * Libraries opened here are intentionally never closed: delegates created
+ * from them may live as long as the process.
+ *
+ * @param name Symbol name
+ * @param libraries Null-terminated list of shared libraries to try
+ * @return Symbol address, or nullptr if not found
+ */
+static void* findSymbol(const char* name, const char* const* libraries) {
+#if defined(_WIN32)
+    (void)name;
+    (void)libraries;
+    return nullptr;
+#else
+    void* symbol = dlsym(RTLD_DEFAULT, name);
+    for (int i = 0; !symbol && libraries[i]; i++) {
+        void* library = dlopen(libraries[i], RTLD_NOW | RTLD_LOCAL);
+        if (library) {
+            symbol = dlsym(library, name);
+        }
+    }
+    return symbol;
+#endif
+}
+
+// Typed lookup: the declaration from the delegate header provides the
+// function type. decltype is unevaluated, so this does not create a link-time
+// reference to the symbol.
+#define FIND_FUNCTION(fn, libraries) \
+    reinterpret_cast<decltype(&fn)>(findSymbol(#fn, libraries))
+
+// ============================================================================
+// DELEGATE FUNCTIONS
+// ============================================================================
+
+const char* delegateTypeName(DelegateType type) {
+    switch (type) {
+        case DelegateType::Cpu: return "CPU";
+        case DelegateType::XnnPack: return "XNNPACK";
+        case DelegateType::Gpu: return "GPU";
+        case DelegateType::Nnapi: return "NNAPI";
+    }
+    return "unknown";
+}
+
+bool delegateTypeFromInt(int value, DelegateType* type) {
+    if (value < static_cast<int>(DelegateType::Cpu) ||
+        value > static_cast<int>(DelegateType::Nnapi)) {
+        return false;
+    }
+    *type = static_cast<DelegateType>(value);
+    return true;
+}
+
+int delegateFallbackChain(DelegateType requested, DelegateType* chain) {
+    int length = 0;
+    chain[length++] = requested;
+    if (requested == DelegateType::Gpu || requested == DelegateType::Nnapi) {
+        chain[length++] = DelegateType::XnnPack;
+    }
+    if (requested != DelegateType::Cpu) {
+        chain[length++] = DelegateType::Cpu;
+    }
+    return length;
+}
+
+void makeDelegateCache(const std::string& directory, uint64_t modelHash, DelegateCache* cache) {
+    // The device fingerprint includes the build fingerprint, so an OS
+    // update (which may bring a new GPU / NNAPI driver) changes the token
+    const std::string identity = std::to_string(modelHash) + "/" + deviceFingerprint();
+    char token[17];
+    std::snprintf(token, sizeof(token), "%016" PRIx64, hashBytes(identity.data(), identity.size()));
+
+    cache->directory = directory;
+    cache->token = token;
+    cache->xnnpackWeights = directory + "/xnnpack_" + cache->token + ".weights";
+}
+
+/**
+ * Create a delegate instance.
+ *
+ * Options favour steady-state speed, as the classifier runs continuously
+ * on a live stream rather than answering one-off requests. With a cache,
+ * XNNPACK maps its packed weights from a file (written on the first run),
+ * and GPU / NNAPI serialize their compiled model under the cache token.
+ */
+TfLiteDelegate* createDelegate(DelegateType type, int numThreads, const DelegateCache* cache) {
+    const bool cached = cache != nullptr && cache->isEnabled();
+
+    switch (type) {
+        case DelegateType::Cpu:
+            return nullptr;
+
+        case DelegateType::XnnPack: {
+            auto defaults = FIND_FUNCTION(TfLiteXNNPackDelegateOptionsDefault, kCoreLibraries);
+            auto create = FIND_FUNCTION(TfLiteXNNPackDelegateCreate, kCoreLibraries);
+            if (!defaults || !create) break;
+
+            TfLiteXNNPackDelegateOptions xnnOptions = defaults();
+            xnnOptions.num_threads = numThreads;
+            if (cached) {
+                xnnOptions.weight_cache_file_path = cache->xnnpackWeights.c_str();
+            }
+            return create(&xnnOptions);
+        }
+
+        case DelegateType::Gpu: {
+            auto defaults = FIND_FUNCTION(TfLiteGpuDelegateOptionsV2Default, kGpuLibraries);
+            auto create = FIND_FUNCTION(TfLiteGpuDelegateV2Create, kGpuLibraries);
+            if (!defaults || !create) break;
+
+            TfLiteGpuDelegateOptionsV2 gpuOptions = defaults();
+            gpuOptions.inference_preference = TFLITE_GPU_INFERENCE_PREFERENCE_SUSTAINED_SPEED;
+            gpuOptions.inference_priority1 = TFLITE_GPU_INFERENCE_PRIORITY_MIN_LATENCY;
+            // fp16 is accurate enough for a softmax classifier
+            gpuOptions.is_precision_loss_allowed = 1;
+            if (cached) {
+                // Skips OpenCL program compilation / tuning on later launches
+                gpuOptions.experimental_flags |= TFLITE_GPU_EXPERIMENTAL_FLAGS_ENABLE_SERIALIZATION;
+                gpuOptions.serialization_dir = cache->directory.c_str();
+                gpuOptions.model_token = cache->token.c_str();
+            }
+            return create(&gpuOptions);
+        }
+
+        case DelegateType::Nnapi: {
+            auto defaults = FIND_FUNCTION(TfLiteNnapiDelegateOptionsDefault, kCoreLibraries);
+            auto create = FIND_FUNCTION(TfLiteNnapiDelegateCreate, kCoreLibraries);
+            if (!defaults || !create) break;
+
+            TfLiteNnapiDelegateOptions nnapiOptions = defaults();
+            nnapiOptions.execution_preference = TfLiteNnapiDelegateOptions::kSustainedSpeed;
+            // NNAPI's own CPU fallback is slower than our XNNPACK fallback
+            nnapiOptions.disallow_nnapi_cpu = 1;
+            if (cached) {
+                nnapiOptions.cache_dir = cache->directory.c_str();
+                nnapiOptions.model_token = cache->token.c_str();
+            }
+            return create(&nnapiOptions);
+        }
+    }
+
+    LOG_ERROR("%s delegate not available in this build", delegateTypeName(type));
+    return nullptr;
+}
+
+/**
+ * Destroy a delegate created by createDelegate.
+ */
+void deleteDelegate(DelegateType type, TfLiteDelegate* delegate) {
+    if (!delegate) return;
+
+    switch (type) {
+        case DelegateType::Cpu:
+            break;
+        case DelegateType::XnnPack:
+            if (auto destroy = FIND_FUNCTION(TfLiteXNNPackDelegateDelete, kCoreLibraries)) {
+                destroy(delegate);
+            }
+            break;
+        case DelegateType::Gpu:
+            if (auto destroy = FIND_FUNCTION(TfLiteGpuDelegateV2Delete, kGpuLibraries)) {
+                destroy(delegate);
+            }
+            break;
+        case DelegateType::Nnapi:
+            if (auto destroy = FIND_FUNCTION(TfLiteNnapiDelegateDelete, kCoreLibraries)) {
+                destroy(delegate);
+            }
+            break;
+    }
+}
@@ -0,0 +1,118 @@
+// ============================================================================
+// TENSORFLOW LITE DELEGATES - HEADER
+// ============================================================================
+//
+// Creation of the hardware delegates MLProcessor can run the model on.
+//
+// Key characteristics:
+// - Optional: Delegate factories are resolved at runtime with dlsym, so a
+//   missing delegate library (e.g. no libtensorflowlite_gpu_delegate.so in
+//   the APK) is reported as "unavailable" instead of failing to link
+// - Ordered: Every delegate has a fallback chain ending at plain CPU
+// - Persistent: Delegates that support it keep their one-time work (packed
+//   XNNPACK weights, compiled GPU programs, NNAPI compilations) in files, so
+//   later launches skip it
+//
+// =============================================================================
+
+#ifndef ML_DELEGATES_H
+#define ML_DELEGATES_H
+
+#include <cstdint>
+#include <string>
+#include "tensorflow/lite/c/c_api.h"
+
+// ============================================================================
+// DELEGATE TYPES
+// ============================================================================
+
+/**
+ * Execution backends, in the numbering used by the JNI layer.
+ */
+enum class DelegateType : int {
+    Cpu = 0,      // Built-in TensorFlow Lite CPU kernels (no delegate)
+    XnnPack = 1,  // XNNPACK optimized CPU kernels
+    Gpu = 2,      // GPU delegate (OpenCL / OpenGL ES)
+    Nnapi = 3,    // Android Neural Networks API (DSP / NPU / vendor drivers)
+};
+
+// Largest fallback chain returned by delegateFallbackChain
+static const int kMaxDelegateChain = 4;
+
+// ============================================================================
+// DELEGATE CACHE
+// ============================================================================
+/**
+ * Where delegates persist their compiled state.
+ *
+ * The token identifies the model and the device, so files written for
+ * another model, or before an OS / driver update, are never read back.
+ * The strings are referenced by live delegates: keep the object alive
+ * (and unchanged) until they are deleted.
+ */
+struct DelegateCache {
+    std::string directory;      // Existing directory, e.g. the app's filesDir
+    std::string token;          // Hex key of model hash + device fingerprint
+    std::string xnnpackWeights; // XNNPACK weight cache file inside directory
+
+    bool isEnabled() const { return !directory.empty(); }
+};
+
+/**
+ * Fill a DelegateCache for one model on this device.
+ *
+ * @param directory Cache directory (must exist)
+ * @param modelHash Content hash of the model (SharedModel::contentHash)
+ * @param cache Receives the paths
+ */
+void makeDelegateCache(const std::string& directory, uint64_t modelHash, DelegateCache* cache);
+
+// ============================================================================
+// DELEGATE FUNCTIONS
+// ============================================================================
+
+/**
+ * Human-readable delegate name for logs ("CPU", "XNNPACK", ...).
+ */
+const char* delegateTypeName(DelegateType type);
+
+/**
+ * Convert a JNI integer to a DelegateType.
+ *
+ * @param value Integer from the Java side
+ * @param type Receives the delegate type
+ * @return false if value is not a known delegate
+ */
+bool delegateTypeFromInt(int value, DelegateType* type);
+
+/**
+ * Fallback order starting at `requested`.
+ *
+ * GPU and NNAPI fall back to XNNPACK, XNNPACK falls back to CPU, and the
+ * chain always ends with CPU.
+ *
+ * @param requested Preferred delegate
+ * @param chain Receives up to kMaxDelegateChain delegate types
+ * @return Number of entries written
+ */
+int delegateFallbackChain(DelegateType requested, DelegateType* chain);
+
+/**
+ * Create a delegate instance.
+ *
+ * @param type Delegate to create (Cpu always returns nullptr)
+ * @param numThreads CPU threads for delegates that use them (XNNPACK)
+ * @param cache Persistent caches to use, or nullptr for none
+ * @return Delegate, or nullptr if unavailable on this device/build
+ */
+TfLiteDelegate* createDelegate(DelegateType type, int numThreads,
+                               const DelegateCache* cache = nullptr);
+
+/**
+ * Destroy a delegate created by createDelegate.
+ *
+ * Must only be called after every interpreter using it has been deleted.
+ */
+void deleteDelegate(DelegateType type, TfLiteDelegate* delegate);
+
+#endif // ML_DELEGATES_H
@@ -0,0 +1,234 @@
+// ============================================================================
+// LOGGING - IMPLEMENTATION
+// ============================================================================
+//
+// The queue is a bounded multi-producer ring (Vyukov's sequence-number
+// scheme): each slot carries a sequence counter that tells producers when
+// it is free and the consumer when it holds a complete message. Producers
+// claim a slot with one compare-and-swap; nothing on the producer side can
+// wait for the consumer. The drain thread sleeps on a semaphore the
+// producers post after publishing, so an idle process never wakes it.
+//
+// Slots store their sequence relative to their index, so the zero-filled
+// statics already are an empty queue: producers need no initialization
+// step, and the drain thread is started explicitly (logStart) off the
+// audio path.
+//
+// =============================================================================
+
+#include "ml_log.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include <semaphore.h>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+// Tag for log messages: appears in Android logcat to identify source
+static const char* const kLogTag = "AudioML";
+
+// Queued messages (power of two) and bytes per message, including the NUL
+static const uint32_t kQueueSize = 256;
+static const int kMessageSize = 224;
+
+// Polling interval of the drain thread where unnamed semaphores are not
+// supported (sem_init fails, e.g. on macOS)
+static const int kDrainIntervalMs = 20;
+
+// ============================================================================
+// MESSAGE QUEUE
+// ============================================================================
+
+struct LogSlot {
+    std::atomic<uint32_t> sequence;  // Minus the slot index (see loadSequence)
+    int level;
+    char text[kMessageSize];
+};
+
+// Zero-initialized statics with trivial destructors, so the queue stays
+// usable while the process exits (the drain thread is never joined)
+static LogSlot slots[kQueueSize];
+static std::atomic<uint32_t> enqueuePos{0};
+static uint32_t dequeuePos = 0;
+static std::atomic<uint64_t> droppedCount{0};
+static uint64_t droppedReported = 0;
+
+// Serializes the consumer side (drain thread and logFlush); producers never
+// take it
+static std::atomic_flag consumerBusy = ATOMIC_FLAG_INIT;
+
+static std::once_flag startOnce;
+
+// Posted once per published (or dropped) message. sem_post never blocks
+// and only enters the kernel when the drain thread is waiting.
+static sem_t drainWakeup;
+static std::atomic<bool> drainWakeupReady{false};
+
+/**
+ * Vyukov sequence of the slot at queue position `pos` (slot i starts at i).
+ */
+static uint32_t loadSequence(const LogSlot& slot, uint32_t pos, std::memory_order order) {
+    return slot.sequence.load(order) + (pos & (kQueueSize - 1));
+}
+
+static void storeSequence(LogSlot& slot, uint32_t pos, uint32_t sequence,
+                          std::memory_order order) {
+    slot.sequence.store(sequence - (pos & (kQueueSize - 1)), order);
+}
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Write one message to the platform log.
+ */
+static void writeMessage(int level, const char* text) {
+#ifdef __ANDROID__
+    static const int kPriorities[] = {
+        ANDROID_LOG_DEBUG, ANDROID_LOG_INFO, ANDROID_LOG_WARN, ANDROID_LOG_ERROR};
+    __android_log_write(kPriorities[level], kLogTag, text);
+#else
+    static const char* const kPrefixes[] = {"[DEBUG] ", "[INFO] ", "[WARN] ", "[ERROR] "};
+    std::fprintf(stderr, "%s%s\n", kPrefixes[level], text);
+#endif
+}
+
+/**
+ * Write out every complete message (consumer side).
+ *
+ * Messages claimed by a producer but not yet fully written stop the drain;
+ * they are picked up on the next pass.
+ */
+static void drainQueue() {
+    while (consumerBusy.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    for (;;) {
+        LogSlot& slot = slots[dequeuePos & (kQueueSize - 1)];
+        if (loadSequence(slot, dequeuePos, std::memory_order_acquire) != dequeuePos + 1) {
+            break;
+        }
+        writeMessage(slot.level, slot.text);
+        // Hand the slot back to producers for the next lap
+        storeSequence(slot, dequeuePos, dequeuePos + kQueueSize, std::memory_order_release);
+        dequeuePos++;
+    }
+
+    const uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != droppedReported) {
+        char text[64];
+        std::snprintf(text, sizeof(text), "%llu log messages dropped (queue full)",
+                      static_cast<unsigned long long>(dropped - droppedReported));
+        writeMessage(ML_LOG_LEVEL_WARN, text);
+        droppedReported = dropped;
+    }
+
+    consumerBusy.clear(std::memory_order_release);
+}
+
+/**
+ * Start the drain thread (once, see logStart).
+ */
+static void startDrainThread() {
+    std::atexit(logFlush);
+
+    const bool wakeup = sem_init(&drainWakeup, 0, 0) == 0;
+    drainWakeupReady.store(wakeup, std::memory_order_release);
+
+    std::thread([wakeup] {
+        for (;;) {
+            if (wakeup) {
+                while (sem_wait(&drainWakeup) != 0) {
+                    // EINTR: wait again
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(kDrainIntervalMs));
+            }
+            drainQueue();
+        }
+    }).detach();
+}
+
+/**
+ * Wake the drain thread (producer side, never blocks).
+ */
+static void wakeDrainThread() {
+    if (drainWakeupReady.load(std::memory_order_acquire)) {
+        sem_post(&drainWakeup);
+    }
+}
+
+// ============================================================================
+// LOG FUNCTIONS
+// ============================================================================
+
+void logStart() {
+    std::call_once(startOnce, startDrainThread);
+}
+
+void logMessage(int level, const char* format, ...) {
+    // ====================================================================
+    // STEP 1: Claim a Slot (drop the message if the queue is full)
+    // ====================================================================
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    LogSlot* slot;
+    for (;;) {
+        slot = &slots[pos & (kQueueSize - 1)];
+        const uint32_t sequence = loadSequence(*slot, pos, std::memory_order_acquire);
+        const int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            wakeDrainThread();  // So the loss gets reported
+            return;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // ====================================================================
+    // STEP 2: Format in Place and Publish
+    // ====================================================================
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(slot->text, kMessageSize, format, args);
+    va_end(args);
+
+    slot->level = level < ML_LOG_LEVEL_DEBUG ? ML_LOG_LEVEL_DEBUG
+                : level > ML_LOG_LEVEL_ERROR ? ML_LOG_LEVEL_ERROR : level;
+    storeSequence(*slot, pos, pos + 1, std::memory_order_release);
+    wakeDrainThread();
+}
+
+bool logAllowEvery(std::atomic<int64_t>* nextAllowedNs, int intervalMs) {
+    const int64_t now = nowNs();
+    int64_t next = nextAllowedNs->load(std::memory_order_relaxed);
+    if (now < next) {
+        return false;
+    }
+    // Only one of several racing threads wins the interval
+    return nextAllowedNs->compare_exchange_strong(
+            next, now + static_cast<int64_t>(intervalMs) * 1000000,
+            std::memory_order_relaxed);
+}
+
+void logFlush() {
+    drainQueue();
+}
+
+uint64_t logDropped() {
+    return droppedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,131 @@
+// ============================================================================
+// LOGGING - HEADER
+// ============================================================================
+//
+// Logging layer shared by the native sources (replaces the per-file printf
+// and __android_log_print macros).
+//
+// Key characteristics:
+// - Compile-time filtering: Levels below ML_LOG_MIN_LEVEL compile to dead
+//   code, so disabled diagnostics cost nothing (release builds default to
+//   INFO, debug builds to DEBUG)
+// - Asynchronous: The calling thread only formats the message into a slot
+//   of a lock-free bounded queue; a background thread writes it to logcat
+//   (Android) or stderr. No lock on the audio thread; it only posts a
+//   semaphore (a futex wake if the drain thread is asleep), and the drain
+//   thread sleeps until something is logged
+// - Never blocks: When the queue is full the message is dropped and
+//   counted, and the drain thread reports how many were lost
+// - Started off the audio path: logStart (called by JNI_OnLoad and the
+//   MLProcessor constructors) creates the drain thread, so logging never
+//   allocates or starts a thread on the calling thread
+// - Rate limiting: LOG_EVERY_MS logs a call site at most once per interval,
+//   for diagnostics on paths that run for every audio window
+//
+// Usage:
+//   LOG_INFO("Model loaded from %s", path);
+//   LOG_EVERY_MS(ML_LOG_LEVEL_DEBUG, 1000, "Max amplitude: %f", peak);
+//
+// =============================================================================
+
+#ifndef ML_LOG_H
+#define ML_LOG_H
+
+#include <atomic>
+#include <cstdint>
+
+// ============================================================================
+// LOG LEVELS
+// ============================================================================
+
+#define ML_LOG_LEVEL_DEBUG 0
+#define ML_LOG_LEVEL_INFO 1
+#define ML_LOG_LEVEL_WARN 2
+#define ML_LOG_LEVEL_ERROR 3
+#define ML_LOG_LEVEL_NONE 4
+
+// Lowest level compiled in; override with -DML_LOG_MIN_LEVEL=...
+#ifndef ML_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define ML_LOG_MIN_LEVEL ML_LOG_LEVEL_INFO
+#else
+#define ML_LOG_MIN_LEVEL ML_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+// ============================================================================
+// LOG FUNCTIONS
+// ============================================================================
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ML_LOG_PRINTF_FORMAT __attribute__((format(printf, 2, 3)))
+#else
+#define ML_LOG_PRINTF_FORMAT
+#endif
+
+/**
+ * Start the drain thread, if not yet running. Call it off the audio path
+ * before real-time threads log (JNI_OnLoad and the MLProcessor
+ * constructors do); messages logged earlier wait in the queue.
+ */
+void logStart();
+
+/**
+ * Format a message and queue it for the drain thread (never blocks, never
+ * allocates, never starts a thread).
+ *
+ * Use the LOG_* macros instead, so filtered levels are compiled out.
+ *
+ * @param level ML_LOG_LEVEL_DEBUG .. ML_LOG_LEVEL_ERROR
+ * @param format printf-style format; messages are truncated to ~220 bytes
+ */
+void logMessage(int level, const char* format, ...) ML_LOG_PRINTF_FORMAT;
+
+/**
+ * Rate limiter for one call site.
+ *
+ * @param nextAllowedNs Per-call-site state (monotonic ns of the next slot)
+ * @param intervalMs Minimum time between two messages
+ * @return true if the call site may log now
+ */
+bool logAllowEvery(std::atomic<int64_t>* nextAllowedNs, int intervalMs);
+
+/**
+ * Write out every queued message on the calling thread.
+ *
+ * Also runs at process exit, so host tools do not lose their last lines.
+ */
+void logFlush();
+
+/**
+ * Number of messages dropped because the queue was full.
+ */
+uint64_t logDropped();
+
+// ============================================================================
+// LOGGING MACROS
+// ============================================================================
+
+#define ML_LOG(level, ...) \
+    do { \
+        if ((level) >= ML_LOG_MIN_LEVEL) logMessage((level), __VA_ARGS__); \
+    } while (0)
+
+#define LOG_DEBUG(...) ML_LOG(ML_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) ML_LOG(ML_LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) ML_LOG(ML_LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) ML_LOG(ML_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+// Log at most once every intervalMs from this call site; the other calls
+// cost a steady_clock read (vDSO, no syscall) and a relaxed atomic load
+#define LOG_EVERY_MS(level, intervalMs, ...) \
+    do { \
+        if ((level) >= ML_LOG_MIN_LEVEL) { \
+            static std::atomic<int64_t> mlLogNextAllowed{0}; \
+            if (logAllowEvery(&mlLogNextAllowed, (intervalMs))) { \
+                logMessage((level), __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#endif // ML_LOG_H
@@ -0,0 +1,124 @@
+// ============================================================================
+// MEMORY ACCOUNTING - IMPLEMENTATION
+// ============================================================================
+
+#include "ml_memory.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+int64_t heapBytesInUse() {
+#if defined(__ANDROID__)
+    // Bionic (jemalloc / scudo) reports every allocated byte in uordblks
+    return static_cast<int64_t>(mallinfo().uordblks);
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    // glibc keeps large blocks in their own mappings (hblkhd)
+    const struct mallinfo2 info = mallinfo2();
+    return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#elif defined(__GLIBC__)
+    const struct mallinfo info = mallinfo();
+    return static_cast<int64_t>(info.uordblks) + static_cast<int64_t>(info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+int64_t residentBytes(const void* address, size_t length) {
+#if defined(__linux__)
+    if (!address || length == 0) {
+        return 0;
+    }
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> pages((length + pageSize - 1) / pageSize);
+    if (mincore(const_cast<void*>(address), length, pages.data()) != 0) {
+        return -1;
+    }
+    int64_t resident = 0;
+    for (unsigned char page : pages) {
+        if (page & 1) {
+            resident += static_cast<int64_t>(pageSize);
+        }
+    }
+    return resident;
+#else
+    (void)address;
+    (void)length;
+    return -1;
+#endif
+}
+
+/**
+ * Sum the smaps entries of one file.
+ *
+ * This method:
+ * 1. Resolves the path as the kernel prints it
+ * 2. Walks /proc/self/smaps: a header line ("start-end perms offset dev
+ *    inode path") opens each mapping, followed by "Key: value kB" lines
+ * 3. Adds Size and Rss of the mappings whose path matches
+ */
+bool mappedFileUsage(const char* path, int64_t* mappedBytes, int64_t* residentMappedBytes) {
+    *mappedBytes = 0;
+    *residentMappedBytes = 0;
+#if defined(__linux__)
+    char canonical[PATH_MAX];
+    if (!path || !realpath(path, canonical)) {
+        return false;
+    }
+    FILE* smaps = std::fopen("/proc/self/smaps", "r");
+    if (!smaps) {
+        return false;
+    }
+
+    bool found = false;
+    bool matching = false;
+    char line[PATH_MAX + 128];
+    while (std::fgets(line, sizeof(line), smaps)) {
+        unsigned long start = 0;
+        unsigned long end = 0;
+        if (std::sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+            const char* name = std::strchr(line, '/');
+            const size_t length = std::strlen(canonical);
+            matching = name && std::strncmp(name, canonical, length) == 0 &&
+                       (name[length] == '\n' || name[length] == '\0');
+            found = found || matching;
+            continue;
+        }
+        long long kilobytes = 0;
+        if (matching && std::sscanf(line, "Size: %lld kB", &kilobytes) == 1) {
+            *mappedBytes += kilobytes * 1024;
+        } else if (matching && std::sscanf(line, "Rss: %lld kB", &kilobytes) == 1) {
+            *residentMappedBytes += kilobytes * 1024;
+        }
+    }
+    std::fclose(smaps);
+    return found;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+int64_t processResidentBytes() {
+#if defined(__linux__)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return -1;
+    }
+    long long sizePages = 0;
+    long long residentPages = 0;
+    const int fields = std::fscanf(statm, "%lld %lld", &sizePages, &residentPages);
+    std::fclose(statm);
+    return fields == 2 ? residentPages * sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
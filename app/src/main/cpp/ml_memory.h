@@ -0,0 +1,57 @@
+// ============================================================================
+// MEMORY ACCOUNTING - HEADER
+// ============================================================================
+//
+// Process-level memory probes used to report what a processor costs (see
+// MLProcessor::getMemoryReport), so several ML components in one process
+// can be budgeted against RSS.
+//
+// Key characteristics:
+// - Heap: Bytes in use from the allocator (mallinfo). Differences around
+//   a step measure what it allocated, including inside TensorFlow Lite and
+//   the delegates, which expose no memory API of their own
+// - Mappings: Size and resident part of file mappings (mincore, or
+//   /proc/self/smaps for mappings made inside TensorFlow Lite)
+// - Not on the hot path: Every probe is a system call or a file read
+// - Best effort: Probes return -1 where the platform has no equivalent
+//
+// =============================================================================
+
+#ifndef ML_MEMORY_H
+#define ML_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Heap bytes currently allocated by the process, or -1 if unavailable.
+ *
+ * Process-wide: a difference across a step also counts what other threads
+ * allocated or freed meanwhile.
+ */
+int64_t heapBytesInUse();
+
+/**
+ * Bytes of [address, address + length) currently resident in RAM.
+ *
+ * @param address Start of a mapping (page aligned)
+ * @return Resident bytes (whole pages), or -1 if unavailable
+ */
+int64_t residentBytes(const void* address, size_t length);
+
+/**
+ * Size and resident part of every mapping of a file in this process.
+ *
+ * @param path File (resolved to its canonical path)
+ * @param mappedBytes Receives the mapped size
+ * @param residentMappedBytes Receives the resident part
+ * @return false if the file is not mapped (or /proc is unavailable)
+ */
+bool mappedFileUsage(const char* path, int64_t* mappedBytes, int64_t* residentMappedBytes);
+
+/**
+ * Resident set size of the whole process, or -1 if unavailable.
+ */
+int64_t processResidentBytes();
+
+#endif // ML_MEMORY_H
@@ -0,0 +1,115 @@
+// ============================================================================
+// SHARED TENSORFLOW LITE MODEL - IMPLEMENTATION
+// ============================================================================
+
+#include "ml_model.h"
+#include "ml_cache.h"
+#include "ml_log.h"
+#include "ml_memory.h"
+
+#include <utility>
+
+#include <sys/stat.h>
+
+// ============================================================================
+// SHARED MODEL CLASS IMPLEMENTATION
+// ============================================================================
+
+SharedModel::~SharedModel() {
+    // Delete the model first: it may point into `buffer`
+    if (model) TfLiteModelDelete(model);
+}
+
+/**
+ * Load a model from a .tflite file.
+ */
+std::shared_ptr<SharedModel> SharedModel::fromFile(const char* modelPath) {
+    // TfLiteModelCreateFromFile reads the .tflite file from disk and
+    // parses its contents into a TfLiteModel structure that describes
+    // the neural network architecture.
+    TfLiteModel* model = TfLiteModelCreateFromFile(modelPath);
+    if (!model) {
+        LOG_ERROR("Failed to load model from %s", modelPath);
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedModel> shared(new SharedModel());
+    shared->model = model;
+    shared->path = modelPath;
+    return shared;
+}
+
+/**
+ * Build a model over mapped bytes.
+ *
+ * TfLiteModelCreate does not copy: the flatbuffer is parsed in place,
+ * which is why the buffer moves into the shared model.
+ */
+std::shared_ptr<SharedModel> SharedModel::fromBuffer(ModelBuffer&& modelBuffer) {
+    if (!modelBuffer.data()) {
+        LOG_ERROR("Empty model buffer");
+        return nullptr;
+    }
+
+    std::shared_ptr<SharedModel> shared(new SharedModel());
+    shared->buffer = std::move(modelBuffer);
+    shared->model = TfLiteModelCreate(shared->buffer.data(), shared->buffer.size());
+    if (!shared->model) {
+        LOG_ERROR("Failed to load model from buffer (%zu bytes)", shared->buffer.size());
+        return nullptr;
+    }
+    return shared;
+}
+
+const char* SharedModel::description() const {
+    return path.empty() ? "mapped buffer" : path.c_str();
+}
+
+/**
+ * Hash of the model bytes, computed once.
+ */
+bool SharedModel::contentHash(uint64_t* value) {
+    std::call_once(hashOnce, [this] {
+        if (buffer.data()) {
+            hash = hashBytes(buffer.data(), buffer.size());
+            hashValid = true;
+        } else {
+            hashValid = hashFile(path.c_str(), &hash);
+        }
+    });
+
+    if (hashValid) *value = hash;
+    return hashValid;
+}
+
+/**
+ * Memory taken by the model bytes.
+ *
+ * This method:
+ * 1. Buffers: the mapping (or the inflated asset) this model owns
+ * 2. Files: the mappings of the file, if TensorFlow Lite mapped it;
+ *    otherwise the file was read into the heap and is resident as a whole
+ */
+ModelMemory SharedModel::memoryUsage() const {
+    ModelMemory usage;
+    if (buffer.data()) {
+        usage.bytes = static_cast<int64_t>(buffer.size());
+        usage.residentBytes = buffer.residentBytes();
+        usage.mapped = buffer.isMapped();
+        return usage;
+    }
+
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+        usage.bytes = static_cast<int64_t>(info.st_size);
+    }
+    int64_t mappedBytes = 0;
+    int64_t residentMappedBytes = 0;
+    if (mappedFileUsage(path.c_str(), &mappedBytes, &residentMappedBytes)) {
+        usage.mapped = true;
+        usage.residentBytes = residentMappedBytes;
+    } else {
+        usage.residentBytes = usage.bytes;
+    }
+    return usage;
+}
@@ -0,0 +1,121 @@
+// ============================================================================
+// SHARED TENSORFLOW LITE MODEL - HEADER
+// ============================================================================
+//
+// A loaded TfLiteModel that several interpreters (MLProcessor instances)
+// can run on at the same time.
+//
+// Key characteristics:
+// - One copy of the weights: The model (and the file or mapping it was
+//   built over) is loaded once and shared by every processor using it
+// - Reference-counted: Handed out as std::shared_ptr; the model is deleted
+//   when the last processor releases it
+// - Thread-safe: A TfLiteModel is read-only once created, so interpreters
+//   on different threads may use it without synchronization
+//
+// =============================================================================
+
+#ifndef ML_MODEL_H
+#define ML_MODEL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "tensorflow/lite/c/c_api.h"
+#include "model_buffer.h"
+
+/**
+ * Memory taken by a model's bytes.
+ */
+struct ModelMemory {
+    int64_t bytes = 0;           // Size of the model
+    int64_t residentBytes = -1;  // Part of it in RAM, -1 if unknown
+    bool mapped = false;         // File-backed pages (reclaimable) vs heap copy
+};
+
+// ============================================================================
+// SHARED MODEL CLASS
+// ============================================================================
+/**
+ * Owner of a TfLiteModel and of the bytes it was built over.
+ *
+ * Create with fromFile / fromBuffer; both return nullptr on failure.
+ */
+class SharedModel {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // Model bytes for models built over a mapping. Must outlive `model`.
+    ModelBuffer buffer;
+
+    // The parsed model shared by all interpreters
+    TfLiteModel* model = nullptr;
+
+    // File the model was read from (empty for buffers), for logs and hashing
+    std::string path;
+
+    // Content hash, computed on first use (see contentHash)
+    std::once_flag hashOnce;
+    uint64_t hash = 0;
+    bool hashValid = false;
+
+    SharedModel() = default;
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    ~SharedModel();
+
+    SharedModel(const SharedModel&) = delete;
+    SharedModel& operator=(const SharedModel&) = delete;
+
+    /**
+     * Load a model from a .tflite file (TfLiteModelCreateFromFile).
+     *
+     * @param modelPath Absolute path to the .tflite model file on disk
+     * @return Shared model, or nullptr if it cannot be loaded
+     */
+    static std::shared_ptr<SharedModel> fromFile(const char* modelPath);
+
+    /**
+     * Build a model over mapped bytes (TfLiteModelCreate, no copy).
+     *
+     * @param modelBuffer Mapped model; ownership moves into the shared model
+     * @return Shared model, or nullptr if the bytes are not a valid model
+     */
+    static std::shared_ptr<SharedModel> fromBuffer(ModelBuffer&& modelBuffer);
+
+    /**
+     * The TensorFlow Lite model, valid for the lifetime of this object.
+     */
+    TfLiteModel* get() const { return model; }
+
+    /**
+     * Human-readable origin for log messages (file path or "mapped buffer").
+     */
+    const char* description() const;
+
+    /**
+     * 64-bit FNV-1a hash of the model bytes, used to key persistent caches.
+     *
+     * Computed once on the first call (which reads the whole model) and
+     * cached; safe to call from several threads.
+     *
+     * @param value Receives the hash
+     * @return false if the model bytes cannot be read
+     */
+    bool contentHash(uint64_t* value);
+
+    /**
+     * Size and resident part of the model bytes: the mapping this model
+     * was built over, or the file TfLiteModelCreateFromFile mapped (or
+     * read into the heap).
+     */
+    ModelMemory memoryUsage() const;
+};
+
+#endif // ML_MODEL_H
@@ -0,0 +1,124 @@
+// ============================================================================
+// ML PROCESSOR POOL - IMPLEMENTATION
+// ============================================================================
+
+#include "ml_pool.h"
+#include "ml_log.h"
+
+#include <thread>
+#include <utility>
+
+// Slot each thread checked out last; the next scan starts there
+static thread_local int lastSlot = 0;
+
+// ============================================================================
+// ML PROCESSOR POOL CLASS IMPLEMENTATION
+// ============================================================================
+
+/**
+ * Constructor: Build `size` processors over one shared model.
+ */
+MLProcessorPool::MLProcessorPool(std::shared_ptr<SharedModel> model, int size,
+                                 const MLProcessorConfig& config) {
+    if (!model || size < 1) {
+        LOG_ERROR("Invalid processor pool (model %p, size %d)",
+                  static_cast<void*>(model.get()), size);
+        return;
+    }
+
+    slots.reset(new Slot[size]);
+    slotCount = size;
+
+    // ====================================================================
+    // STEP 1: First Processor Selects the Backend
+    // ====================================================================
+    slots[0].processor.reset(new MLProcessor(model, config));
+    if (!slots[0].processor->isInitialized()) {
+        LOG_ERROR("Processor pool: first processor failed to initialize");
+        return;
+    }
+
+    // ====================================================================
+    // STEP 2: Remaining Processors Reuse Its Decision
+    // ====================================================================
+    MLProcessorConfig pinned = config;
+    pinned.delegate = slots[0].processor->getActiveDelegate();
+    pinned.allowDelegateFallback = false;
+    pinned.numThreads = slots[0].processor->getNumThreads();
+    pinned.autoTuneThreads = false;
+
+    for (int i = 1; i < size; i++) {
+        slots[i].processor.reset(new MLProcessor(model, pinned));
+        if (!slots[i].processor->isInitialized()) {
+            LOG_ERROR("Processor pool: processor %d failed to initialize", i);
+            return;
+        }
+    }
+
+    LOG_INFO("Processor pool ready: %d x %s, %d threads each", size,
+             delegateTypeName(pinned.delegate), pinned.numThreads);
+}
+
+bool MLProcessorPool::isInitialized() const {
+    if (slotCount == 0) {
+        return false;
+    }
+    for (int i = 0; i < slotCount; i++) {
+        if (!slots[i].processor || !slots[i].processor->isInitialized()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int MLProcessorPool::getWindowLength() const {
+    return isInitialized() ? slots[0].processor->getWindowLength() : 0;
+}
+
+/**
+ * Check out a free processor without blocking.
+ *
+ * This method:
+ * 1. Starts at the slot this thread used last
+ * 2. Claims the first free slot with a compare-and-swap on its busy flag
+ */
+MLProcessorPool::Lease MLProcessorPool::tryAcquire() {
+    for (int n = 0; n < slotCount; n++) {
+        const int slot = (lastSlot + n) % slotCount;
+
+        // Cheap relaxed check first, so busy slots are not written to
+        if (slots[slot].busy.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        bool expected = false;
+        if (slots[slot].busy.compare_exchange_strong(expected, true,
+                                                     std::memory_order_acquire,
+                                                     std::memory_order_relaxed)) {
+            lastSlot = slot;
+            return Lease(this, slot);
+        }
+    }
+    return Lease();
+}
+
+/**
+ * Check out a processor, yielding until one becomes free.
+ */
+MLProcessorPool::Lease MLProcessorPool::acquire() {
+    if (slotCount == 0) {
+        return Lease();
+    }
+    for (;;) {
+        Lease lease = tryAcquire();
+        if (lease) {
+            return lease;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void MLProcessorPool::release(int slot) {
+    // Release ordering publishes everything the holder wrote to the
+    // processor to the next thread that acquires it
+    slots[slot].busy.store(false, std::memory_order_release);
+}
@@ -0,0 +1,173 @@
+// ============================================================================
+// ML PROCESSOR POOL - HEADER
+// ============================================================================
+//
+// A fixed set of MLProcessor instances over one SharedModel, checked out by
+// worker threads so several audio streams (or chunks of one long file) can
+// be classified in parallel with a single copy of the weights.
+//
+// Key characteristics:
+// - Shared weights: Every processor builds its own interpreter and tensor
+//   arena on the same TfLiteModel
+// - Lock-free checkout: Each slot has an atomic "busy" flag; acquiring is a
+//   compare-and-swap scan, releasing is one store. No mutex is taken on the
+//   inference path
+// - Sticky: A thread starts its scan at the slot it used last, so repeated
+//   checkouts from the same worker land on the same (cache-warm) interpreter
+//
+// Thread budget: every processor runs numThreads threads of its own, so a
+// pool of N processors uses up to N * numThreads cores. For scaling across
+// cores, numThreads = 1 per processor is usually the best choice.
+//
+// =============================================================================
+
+#ifndef ML_POOL_H
+#define ML_POOL_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "ml_model.h"
+#include "ml_processor.h"
+
+// ============================================================================
+// ML PROCESSOR POOL CLASS
+// ============================================================================
+/**
+ * Fixed-size pool of processors sharing one model.
+ */
+class MLProcessorPool {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // One pooled processor. Padded to a cache line so threads flipping
+    // neighbouring busy flags do not contend on the same line.
+    struct alignas(64) Slot {
+        std::unique_ptr<MLProcessor> processor;
+        std::atomic<bool> busy{false};
+    };
+
+    // Slots are created once in the constructor and never reallocated
+    std::unique_ptr<Slot[]> slots;
+    int slotCount = 0;
+
+    // Release a slot taken by tryAcquire / acquire
+    void release(int slot);
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    // ====================================================================
+    // LEASE: RAII handle to a checked-out processor
+    // ====================================================================
+    /**
+     * Exclusive use of one pooled processor until the lease is destroyed
+     * (or moved from). An empty lease converts to false.
+     */
+    class Lease {
+    private:
+        MLProcessorPool* pool = nullptr;
+        int slot = -1;
+
+        friend class MLProcessorPool;
+        Lease(MLProcessorPool* pool, int slot) : pool(pool), slot(slot) {}
+
+    public:
+        Lease() = default;
+        ~Lease() { reset(); }
+
+        Lease(Lease&& other) noexcept : pool(other.pool), slot(other.slot) {
+            other.pool = nullptr;
+            other.slot = -1;
+        }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                reset();
+                pool = other.pool;
+                slot = other.slot;
+                other.pool = nullptr;
+                other.slot = -1;
+            }
+            return *this;
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * Return the processor to the pool early.
+         */
+        void reset() {
+            if (pool) pool->release(slot);
+            pool = nullptr;
+            slot = -1;
+        }
+
+        explicit operator bool() const { return pool != nullptr; }
+        MLProcessor* get() const { return pool ? pool->slots[slot].processor.get() : nullptr; }
+        MLProcessor* operator->() const { return get(); }
+        MLProcessor& operator*() const { return *get(); }
+
+        /**
+         * Index of the pooled processor (0..size()-1), e.g. for per-worker
+         * output buffers.
+         */
+        int index() const { return slot; }
+    };
+
+    /**
+     * Constructor: Build `size` processors over one shared model.
+     *
+     * This constructor:
+     * 1. Builds the first processor with `config` (delegate selection,
+     *    fallback and optional thread auto-tuning run once)
+     * 2. Builds the remaining processors pinned to the backend and thread
+     *    count the first one settled on, skipping the benchmarks
+     *
+     * @param model Loaded model (see SharedModel::fromFile / fromBuffer)
+     * @param size Number of processors (concurrent checkouts), at least 1
+     * @param config Delegate and runtime settings for every processor
+     */
+    MLProcessorPool(std::shared_ptr<SharedModel> model, int size,
+                    const MLProcessorConfig& config = MLProcessorConfig());
+
+    MLProcessorPool(const MLProcessorPool&) = delete;
+    MLProcessorPool& operator=(const MLProcessorPool&) = delete;
+
+    /**
+     * Check if every processor in the pool initialized successfully.
+     *
+     * Outstanding leases must be released before the pool is destroyed.
+     */
+    bool isInitialized() const;
+
+    /**
+     * Number of processors in the pool.
+     */
+    int size() const { return slotCount; }
+
+    /**
+     * Samples per window of the pooled model (every processor shares it),
+     * or 0 if the pool failed to initialize.
+     */
+    int getWindowLength() const;
+
+    /**
+     * Check out a free processor without blocking.
+     *
+     * @return Lease on a processor, or an empty lease if all are busy
+     */
+    Lease tryAcquire();
+
+    /**
+     * Check out a processor, yielding until one becomes free.
+     *
+     * @return Lease on a processor (empty only if the pool is empty)
+     */
+    Lease acquire();
+};
+
+#endif // ML_POOL_H
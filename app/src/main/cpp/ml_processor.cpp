@@ -15,18 +15,129 @@
 // =============================================================================
 
 #include "ml_processor.h"
+#include "audio_kernels.h"
+#include "ml_cache.h"
+#include "ml_log.h"
+#include "ml_memory.h"
+#include <algorithm>
 #include <cstdint>
 #include <vector>
-#include <cstdio>
-#include <cmath>
+#include <cstring>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 // ============================================================================
-// LOGGING MACROS (Platform-independent)
+// RUNTIME DEFAULTS
 // ============================================================================
 
-// Simple printf-based logging that works on all platforms
-#define LOG_INFO(...) printf("[INFO] " __VA_ARGS__); printf("\n")
-#define LOG_ERROR(...) printf("[ERROR] " __VA_ARGS__); printf("\n")
+// Upper bound of the thread auto-tuning sweep when maxThreads is 0. Past
+// 8 threads a 512-sample conv model only gains synchronization overhead.
+static const int kMaxTunedThreads = 8;
+
+// File (inside MLProcessorConfig::cacheDir) holding tuning decisions
+static const char* const kTuningCacheFile = "ml_tuning.cache";
+
+// ============================================================================
+// BENCHMARK HELPERS
+// ============================================================================
+
+/**
+ * Time a few invokes of an interpreter on a silent input.
+ *
+ * The first invoke is untimed: it absorbs one-time costs (kernel
+ * preparation, weight packing, shader compilation) that steady-state
+ * inference never pays again.
+ *
+ * @param interpreter Interpreter with allocated tensors
+ * @param runs Number of timed invokes
+ * @return Fastest invoke in milliseconds, or -1 if an invoke failed
+ */
+static double benchmarkInterpreter(TfLiteInterpreter* interpreter, int runs) {
+    TfLiteTensor* input = TfLiteInterpreterGetInputTensor(interpreter, 0);
+    if (!input || !TfLiteTensorData(input)) {
+        return -1.0;
+    }
+    std::memset(TfLiteTensorData(input), 0, TfLiteTensorByteSize(input));
+
+    if (TfLiteInterpreterInvoke(interpreter) != kTfLiteOk) {
+        return -1.0;
+    }
+
+    double best = -1.0;
+    for (int i = 0; i < runs; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (TfLiteInterpreterInvoke(interpreter) != kTfLiteOk) {
+            return -1.0;
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (best < 0.0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+/**
+ * Tensor element types the processor can feed / read.
+ */
+static bool isSupportedType(TfLiteType type) {
+    return type == kTfLiteFloat32 || type == kTfLiteInt8 || type == kTfLiteUInt8;
+}
+
+/**
+ * Bytes per element of a supported tensor type.
+ */
+static size_t elementSize(TfLiteType type) {
+    return type == kTfLiteFloat32 ? sizeof(float) : sizeof(int8_t);
+}
+
+/**
+ * Heap growth between two heapBytesInUse() readings (-1 if unmeasured).
+ * Other threads freeing memory meanwhile can make it negative; that is
+ * reported as no growth.
+ */
+static int64_t heapGrowth(int64_t before, int64_t after) {
+    if (before < 0 || after < 0) {
+        return -1;
+    }
+    return after > before ? after - before : 0;
+}
+
+/**
+ * Index of the largest of `count` values (first one on ties).
+ *
+ * Quantized scores can be compared before dequantizing: the scale is
+ * positive, so dequantization preserves their order.
+ */
+template <typename T>
+static int argmaxOf(const T* values, int count) {
+    int best = 0;
+    for (int i = 1; i < count; i++) {
+        if (values[i] > values[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * Convert `count` samples into a tensor row and fill the rest of the row.
+ *
+ * SampleKernels resolves the <Sample, Dest> pair to its kernel at compile
+ * time, so each combination is a single branch-free pass.
+ */
+template <typename Sample, typename Dest>
+static void storeRow(const Sample* samples, Dest* dst, int count, int padding,
+                     float scale, int32_t zeroPoint, Dest fill) {
+    SampleKernels<Sample>::store(samples, dst, count, scale, zeroPoint);
+    for (int i = 0; i < padding; i++) {
+        dst[count + i] = fill;
+    }
+}
 
 // ============================================================================
 // ML PROCESSOR CLASS IMPLEMENTATION
@@ -35,189 +146,2245 @@
 /**
  * Constructor: Initialize the ML processor with a model file.
  * 
- * This constructor:
- * 1. Loads the .tflite model from the given file path
- * 2. Creates interpreter options (e.g., thread configuration)
- * 3. Creates a TensorFlow Lite interpreter from the model
- * 4. Allocates memory for input/output tensors
- * 5. Logs status messages
+ * Loads the .tflite model from the given file path into a SharedModel
+ * that only this processor uses, then continues like the shared-model
+ * constructor.
  * 
  * @param modelPath Absolute path to the .tflite model file on disk
+ * @param config Delegate and runtime settings
+ */
+MLProcessor::MLProcessor(const char* modelPath, const MLProcessorConfig& config)
+        : MLProcessor(SharedModel::fromFile(modelPath), config) {
+}
+
+/**
+ * Constructor: Initialize the ML processor over model bytes in memory.
+ *
+ * Builds a SharedModel over the mapped bytes (TfLiteModelCreate, no copy),
+ * then continues like the shared-model constructor.
+ *
+ * @param buffer Mapped model
+ * @param config Delegate and runtime settings
+ */
+MLProcessor::MLProcessor(ModelBuffer&& buffer, const MLProcessorConfig& config)
+        : MLProcessor(SharedModel::fromBuffer(std::move(buffer)), config) {
+}
+
+/**
+ * Constructor: Initialize the ML processor on an already loaded model.
+ * 
+ * This constructor:
+ * 1. Takes a reference to the shared model (no weights are loaded) and,
+ *    with pinPerformanceCores, pins the calling thread to the performance
+ *    cluster until it returns, so the worker threads TensorFlow Lite and
+ *    the delegates start while building and warming up are placed there
+ * 2. Sets up the front end (stream resampler, log-mel features)
+ * 3. Selects a backend (delegate with fallback, optionally with persistent
+ *    delegate caches) and builds the interpreter
+ * 4. Optionally auto-tunes the thread count
+ * 5. Optionally warms the interpreter up
+ * 6. Logs status messages
+ * 
+ * @param sharedModel Loaded model (nullptr leaves the processor uninitialized)
+ * @param config Delegate and runtime settings
  */
-MLProcessor::MLProcessor(const char* modelPath) {
+MLProcessor::MLProcessor(std::shared_ptr<SharedModel> sharedModel,
+                         const MLProcessorConfig& config)
+        : sharedModel(std::move(sharedModel)), model(nullptr), interpreter(nullptr),
+          options(nullptr), delegate(nullptr), activeDelegate(DelegateType::Cpu),
+          numThreads(config.numThreads),
+          inputTensor(nullptr), outputTensor(nullptr), outputSize(0),
+          inputType(kTfLiteFloat32), outputType(kTfLiteFloat32),
+          inputQuant{0.0f, 0}, outputQuant{0.0f, 0},
+          inputDims(), inputRank(0), outputDims(), outputRank(0), batchSize(1),
+          delegateHeapBytes(-1), interpreterHeapBytes(-1), arenaHeapBytes(-1),
+          arenasReleased(false), stateful(false), streamBatchSize(1), streamConfiguredHop(0),
+          minRms(0.0f), minScore(0.0f),
+          streamClock(0), frontEnd(config.frontEnd), inputRowSize(0), windowLength(0),
+          peakWindow(peakAbsInt16), convertWindow(convertInt16ToFloat),
+          channelBatching(true), engineConfig(config) {
+    // Before any stream thread logs (the construction thread is not one)
+    logStart();
+
     // ====================================================================
-    // STEP 1: Load Model File
+    // STEP 1: Reference the Model
     // ====================================================================
-    // TfLiteModelCreateFromFile reads the .tflite file from disk and
-    // parses its contents into a TfLiteModel structure that describes
-    // the neural network architecture.
-    model = TfLiteModelCreateFromFile(modelPath);
-    if (!model) {
-        LOG_ERROR("Failed to load model from %s", modelPath);
+    // The model itself was loaded (and validated) by SharedModel; a null
+    // model means loading failed and has already been logged.
+    if (!this->sharedModel) {
+        return;
+    }
+    model = this->sharedModel->get();
+    const char* source = this->sharedModel->description();
+    ScopedThreadPin pin(config.threadPolicy.pinPerformanceCores ? performanceCores() : 0);
+
+    // ====================================================================
+    // STEP 2: Set Up the Front End
+    // ====================================================================
+    // The mel stage decides how many samples the input tensor's rows
+    // stand for, which the interpreter works out from the tensor, so it
+    // comes first.
+    if (frontEnd.logMel &&
+        !melFrontEnd.configure(frontEnd.modelSampleRate, frontEnd.fftSize,
+                               frontEnd.frameHop, frontEnd.melBands,
+                               frontEnd.minFrequency, frontEnd.maxFrequency)) {
+        return;
+    }
+    if (frontEnd.inputSampleRate > 0 && !setStreamInputRate(frontEnd.inputSampleRate)) {
+        return;
+    }
+
+    // ====================================================================
+    // STEP 3: Select Backend and Create Interpreter
+    // ====================================================================
+    // Cache files are named after the model hash, so every delegate built
+    // below (candidates, tuning sweep) shares the same files
+    uint64_t modelHash = 0;
+    if (config.delegateCache && !config.cacheDir.empty()) {
+        if (this->sharedModel->contentHash(&modelHash)) {
+            delegateCache.reset(new DelegateCache());
+            makeDelegateCache(config.cacheDir, modelHash, delegateCache.get());
+        } else {
+            LOG_WARN("Cannot hash %s, delegate caches disabled", source);
+        }
+    }
+    if (!selectDelegate(config)) {
+        LOG_ERROR("No usable backend for %s", source);
+        return;
+    }
+    if (melFrontEnd.isConfigured()) {
+        melPadding.assign(static_cast<size_t>(windowLength), 0);
+    }
+    stateful = !stateTensors.empty();
+
+    // ====================================================================
+    // STEP 4: Tune the Thread Count (optional)
+    // ====================================================================
+    if (config.autoTuneThreads && !tuneThreads(config)) {
+        LOG_ERROR("Thread tuning failed for %s", source);
+        return;
+    }
+
+    // ====================================================================
+    // STEP 5: Warm Up (optional)
+    // ====================================================================
+    if (config.warmUpInvokes > 0 && !warmUp(config.warmUpInvokes)) {
+        LOG_ERROR("Warm-up failed for %s", source);
+        destroyInterpreter();
         return;
     }
 
+    // Log successful initialization
+    LOG_INFO("Model loaded successfully from %s (%s, %d threads, %d-sample windows)",
+             source, delegateTypeName(activeDelegate), numThreads, windowLength);
+    if (isStateful()) {
+        LOG_INFO("Stateful model: %zu state tensors carried between %d-sample steps",
+                 stateTensors.size(), windowLength);
+    }
+}
+
+/**
+ * Destructor: Clean up all allocated resources.
+ * 
+ * Automatically called when the MLProcessor object is deleted.
+ * Releases all memory and handles to prevent leaks.
+ */
+MLProcessor::~MLProcessor() {
+    // A swap nobody adopted, or an old model nobody collected
+    delete pendingSwap.exchange(nullptr);
+    delete retiredSwap.exchange(nullptr);
+
+    // Delete interpreter, delegate and options (frees inference memory)
+    destroyInterpreter();
+    
+    // The model is released with sharedModel, once no other processor
+    // references it
+}
+
+/**
+ * Create options, delegate and interpreter for one backend.
+ *
+ * This method:
+ * 1. Creates interpreter options (thread configuration, delegate)
+ * 2. Creates a TensorFlow Lite interpreter from the model
+ * 3. Allocates memory for input/output tensors
+ * 4. Caches the input/output tensors and their shapes, and derives the
+ *    window length from the input shape
+ * 5. Pairs the state tensors of a stateful model
+ *
+ * @param type Backend to build
+ * @param threads CPU threads for the interpreter and delegate
+ * @return true if the interpreter is ready
+ */
+bool MLProcessor::createInterpreter(DelegateType type, int threads) {
     // ====================================================================
-    // STEP 2: Create Interpreter Options
+    // STEP 1: Create Interpreter Options
     // ====================================================================
     // Create a configuration object for the interpreter
     options = TfLiteInterpreterOptionsCreate();
     
     // Set number of CPU threads for inference
-    // 2 threads provides good balance between speed and power consumption
     // More threads = faster inference but higher power usage
-    TfLiteInterpreterOptionsSetNumThreads(options, 2);
+    numThreads = threads;
+    TfLiteInterpreterOptionsSetNumThreads(options, threads);
+
+    // Attach the hardware delegate, if any. Unsupported operations stay on
+    // the CPU kernels; the delegate must outlive the interpreter.
+    activeDelegate = type;
+    const int64_t heapBefore = heapBytesInUse();
+    if (type != DelegateType::Cpu) {
+        delegate = createDelegate(type, threads, delegateCache.get());
+        if (!delegate) {
+            return false;
+        }
+        TfLiteInterpreterOptionsAddDelegate(options, delegate);
+    }
+    const int64_t heapDelegate = heapBytesInUse();
+    delegateHeapBytes = heapGrowth(heapBefore, heapDelegate);
 
     // ====================================================================
-    // STEP 3: Create Interpreter
+    // STEP 2: Create Interpreter
     // ====================================================================
     // Create a TfLiteInterpreter that will execute the model using the
     // given options. The interpreter is ready to accept input and produce
-    // output after this step.
+    // output after this step. Delegate preparation happens here too, so a
+    // delegate that cannot handle the model fails at this point.
     interpreter = TfLiteInterpreterCreate(model, options);
     if (!interpreter) {
-        LOG_ERROR("Failed to create interpreter");
-        return;
+        LOG_ERROR("Failed to create interpreter (%s)", delegateTypeName(type));
+        return false;
     }
+    const int64_t heapInterpreter = heapBytesInUse();
+    interpreterHeapBytes = heapGrowth(heapDelegate, heapInterpreter);
 
     // ====================================================================
-    // STEP 4: Allocate Tensors
+    // STEP 3: Allocate Tensors
     // ====================================================================
     // Allocate memory for input and output tensors based on the model's
     // tensor requirements. This reserves GPU/CPU buffers for data.
     if (TfLiteInterpreterAllocateTensors(interpreter) != kTfLiteOk) {
         LOG_ERROR("Failed to allocate tensors");
+        return false;
     }
+    arenaHeapBytes = heapGrowth(heapInterpreter, heapBytesInUse());
 
-    // Log successful initialization
-    LOG_INFO("Model loaded successfully from %s", modelPath);
+    // ====================================================================
+    // STEP 4: Cache Input/Output Tensors
+    // ====================================================================
+    // The tensor handles stay valid for the interpreter's lifetime, so we
+    // look them up (and size the output) once here instead of on every
+    // inference. After this step the hot path performs no allocation.
+    // Float32 and full-integer (int8 / uint8) models are supported; the
+    // quantization parameters are read once so the hot path only applies
+    // them.
+    TfLiteTensor* input = TfLiteInterpreterGetInputTensor(interpreter, 0);
+    const TfLiteTensor* output = TfLiteInterpreterGetOutputTensor(interpreter, 0);
+    if (!input || !isSupportedType(TfLiteTensorType(input))) {
+        LOG_ERROR("Unexpected input tensor (need float32 / int8 / uint8)");
+        return false;
+    }
+    if (!output || !isSupportedType(TfLiteTensorType(output))) {
+        LOG_ERROR("Unexpected output tensor (need float32 / int8 / uint8)");
+        return false;
+    }
+
+    inputType = TfLiteTensorType(input);
+    outputType = TfLiteTensorType(output);
+    inputQuant = TfLiteTensorQuantizationParams(input);
+    outputQuant = TfLiteTensorQuantizationParams(output);
+    if ((inputType != kTfLiteFloat32 && !(inputQuant.scale > 0.0f)) ||
+        (outputType != kTfLiteFloat32 && !(outputQuant.scale > 0.0f))) {
+        LOG_ERROR("Quantized tensor without a valid scale");
+        return false;
+    }
+
+    // Remember both shapes: the input's batch dimension is resized later,
+    // and both are reported through getInputShape / getOutputShape
+    inputRank = TfLiteTensorNumDims(input);
+    outputRank = TfLiteTensorNumDims(output);
+    if (inputRank < 1 || inputRank > kMaxTensorDims ||
+        outputRank < 1 || outputRank > kMaxTensorDims) {
+        LOG_ERROR("Tensor ranks %d / %d not supported", inputRank, outputRank);
+        return false;
+    }
+    for (int i = 0; i < inputRank; i++) {
+        inputDims[i] = TfLiteTensorDim(input, i);
+    }
+    for (int i = 0; i < outputRank; i++) {
+        outputDims[i] = TfLiteTensorDim(output, i);
+    }
+
+    // ====================================================================
+    // STEP 5: Derive the Window Length
+    // ====================================================================
+    // One batch row is every dimension after the batch dimension (the
+    // whole tensor for rank 1). Raw-sample models take one sample per
+    // value; log-mel models take whole frames, so the row must split into
+    // frames of melBands values.
+    int rowSize = 1;
+    for (int i = inputRank > 1 ? 1 : 0; i < inputRank; i++) {
+        rowSize *= inputDims[i];
+    }
+    if (rowSize <= 0 ||
+        TfLiteTensorByteSize(input) < static_cast<size_t>(rowSize) * elementSize(inputType)) {
+        LOG_ERROR("Unexpected input tensor shape");
+        return false;
+    }
+
+    int window = rowSize;
+    if (melFrontEnd.isConfigured()) {
+        window = melFrontEnd.samplesForFeatures(rowSize);
+        if (inputType != kTfLiteFloat32 || window <= 0) {
+            LOG_ERROR("Log-mel front end needs a float32 input of whole %d-band frames "
+                      "(got %d values)", melFrontEnd.getBands(), rowSize);
+            return false;
+        }
+    }
+
+    // Get the dimensions of the output tensor to determine how many
+    // predictions are generated (e.g., 12 classes for the dial tones).
+    int size = 1;
+    for (int i = 0; i < outputRank; i++) {
+        size *= outputDims[i];
+    }
+
+    // The model's geometry is only written when it changes: a rebuild
+    // after releaseArenas is the same model, and swapModel reads these on
+    // other threads while the consumer rebuilds
+    if (inputRowSize != rowSize) {
+        inputRowSize = rowSize;
+    }
+    if (windowLength != window) {
+        windowLength = window;
+        peakWindow = peakKernelFor(window);
+        convertWindow = convertKernelFor(window);
+    }
+    if (outputSize != size) {
+        outputSize = size;
+    }
+
+    inputTensor = input;
+    outputTensor = output;
+    batchSize = 1;
+    if (outputType != kTfLiteFloat32) {
+        dequantized.assign(outputSize, 0.0f);
+    }
+
+    // ====================================================================
+    // STEP 6: Bind State Tensors
+    // ====================================================================
+    return bindStateTensors();
 }
 
 /**
- * Destructor: Clean up all allocated resources.
- * 
- * Automatically called when the MLProcessor object is deleted.
- * Releases all memory and handles to prevent leaks.
+ * Key of a state tensor named `<key><suffix>`, optionally followed by a
+ * ":N" output index as the converter appends.
+ *
+ * @return false if the name does not end in the suffix
  */
-MLProcessor::~MLProcessor() {
-    // Delete the interpreter (frees inference memory)
+static bool stateKey(const char* name, const char* suffix, std::string* key) {
+    std::string stem = name ? name : "";
+    const size_t colon = stem.rfind(':');
+    if (colon != std::string::npos && colon + 1 < stem.size() &&
+        stem.find_first_not_of("0123456789", colon + 1) == std::string::npos) {
+        stem.erase(colon);
+    }
+    const size_t suffixLength = std::strlen(suffix);
+    if (stem.size() <= suffixLength ||
+        stem.compare(stem.size() - suffixLength, suffixLength, suffix) != 0) {
+        return false;
+    }
+    *key = stem.substr(0, stem.size() - suffixLength);
+    return true;
+}
+
+/**
+ * Pair the state inputs of a stateful model with their outputs.
+ *
+ * This method:
+ * 1. Requires every input after the first to be named `<key>_in`
+ * 2. Feeds it from the one output (after the scores) named `<key>_out`;
+ *    pairing by position is not safe, as the converter orders signature
+ *    tensors by name
+ * 3. Requires the pair to agree in type, byte size and quantization, as
+ *    the state is copied over byte for byte
+ * The model is rejected rather than guessed at if any of these fails. The
+ * state starts zeroed.
+ */
+bool MLProcessor::bindStateTensors() {
+    stateTensors.clear();
+    const int inputs = TfLiteInterpreterGetInputTensorCount(interpreter);
+    const int outputs = TfLiteInterpreterGetOutputTensorCount(interpreter);
+    if (inputs <= 1) {
+        return true;
+    }
+
+    std::vector<bool> outputUsed(outputs > 0 ? outputs : 0, false);
+    for (int i = 1; i < inputs; i++) {
+        TfLiteTensor* input = TfLiteInterpreterGetInputTensor(interpreter, i);
+        std::string key;
+        if (!input || !stateKey(TfLiteTensorName(input), "_in", &key)) {
+            LOG_ERROR("Input %d (%s) is not a state input named <key>_in", i,
+                      input ? TfLiteTensorName(input) : "?");
+            return false;
+        }
+
+        int match = -1;
+        for (int j = 1; j < outputs; j++) {
+            const TfLiteTensor* candidate = TfLiteInterpreterGetOutputTensor(interpreter, j);
+            std::string outputKey;
+            if (!candidate || !stateKey(TfLiteTensorName(candidate), "_out", &outputKey) ||
+                outputKey != key) {
+                continue;
+            }
+            if (match >= 0) {
+                LOG_ERROR("State input %s matches outputs %d and %d",
+                          TfLiteTensorName(input), match, j);
+                return false;
+            }
+            match = j;
+        }
+        if (match < 0 || outputUsed[match]) {
+            LOG_ERROR("State input %s has no output of its own named %s_out",
+                      TfLiteTensorName(input), key.c_str());
+            return false;
+        }
+        outputUsed[match] = true;
+
+        const TfLiteTensor* output = TfLiteInterpreterGetOutputTensor(interpreter, match);
+        if (!TfLiteTensorData(input) || !TfLiteTensorData(output)) {
+            LOG_ERROR("State tensor %s has no data buffer", key.c_str());
+            return false;
+        }
+
+        const TfLiteType type = TfLiteTensorType(input);
+        const TfLiteQuantizationParams inQuant = TfLiteTensorQuantizationParams(input);
+        const TfLiteQuantizationParams outQuant = TfLiteTensorQuantizationParams(output);
+        if (!isSupportedType(type) || TfLiteTensorType(output) != type ||
+            TfLiteTensorByteSize(input) != TfLiteTensorByteSize(output) ||
+            (type != kTfLiteFloat32 && (inQuant.scale != outQuant.scale ||
+                                        inQuant.zero_point != outQuant.zero_point))) {
+            LOG_ERROR("State input %d (%s) does not match output %d (%s)", i,
+                      TfLiteTensorName(input), match, TfLiteTensorName(output));
+            return false;
+        }
+
+        StateTensor state;
+        state.input = input;
+        state.output = output;
+        state.bytes = TfLiteTensorByteSize(input);
+        state.fill = type == kTfLiteFloat32 ? 0 : static_cast<uint8_t>(inQuant.zero_point);
+        stateTensors.push_back(state);
+    }
+
+    resetState();
+    return true;
+}
+
+/**
+ * Zero every state tensor, and drop one saved by releaseArenas.
+ */
+void MLProcessor::resetState() {
+    savedState.clear();
+    for (const StateTensor& state : stateTensors) {
+        std::memset(TfLiteTensorData(state.input), state.fill, state.bytes);
+    }
+}
+
+/**
+ * Release interpreter, delegate and options, and clear cached tensors.
+ */
+void MLProcessor::destroyInterpreter() {
+    releaseInterpreter();
+    outputSize = 0;
+}
+
+/**
+ * Release interpreter, delegate and options, keeping outputSize.
+ */
+void MLProcessor::releaseInterpreter() {
+    inputTensor = nullptr;
+    outputTensor = nullptr;
+    stateTensors.clear();
+
+    // Delete the interpreter first (frees inference memory); the delegate
+    // must outlive it
     if (interpreter) TfLiteInterpreterDelete(interpreter);
-    
+    interpreter = nullptr;
+
+    // Delete the delegate (frees accelerator resources)
+    deleteDelegate(activeDelegate, delegate);
+    delegate = nullptr;
+
     // Delete the interpreter options (frees configuration memory)
     if (options) TfLiteInterpreterOptionsDelete(options);
-    
-    // Delete the model (frees model structure memory)
-    if (model) TfLiteModelDelete(model);
+    options = nullptr;
 }
 
 /**
- * Process audio samples - fully portable implementation
- * 
+ * Pick the backend, falling back down the delegate chain.
+ *
+ * For every candidate of delegateFallbackChain(config.delegate):
+ * 1. Build the interpreter; skip the candidate if the delegate is missing
+ *    or rejects the model
+ * 2. Warm it up and time a few invokes; skip it if an invoke fails
+ * 3. Compare against the plain CPU kernels (measured once, lazily) and
+ *    skip it if it is slower
+ * The first candidate that passes is kept. CPU, the end of every chain,
+ * is accepted as soon as it works.
+ *
+ * @param config Construction settings
+ * @return true if an interpreter was created
+ */
+bool MLProcessor::selectDelegate(const MLProcessorConfig& config) {
+    DelegateType chain[kMaxDelegateChain];
+    int chainLength = delegateFallbackChain(config.delegate, chain);
+    if (!config.allowDelegateFallback) {
+        chainLength = 1;
+    }
+
+    const int runs = config.delegateBenchmarkRuns > 0 ? config.delegateBenchmarkRuns : 1;
+    double cpuLatency = -1.0;
+
+    for (int i = 0; i < chainLength; i++) {
+        const DelegateType type = chain[i];
+
+        // ================================================================
+        // STEP 1: Build the Candidate
+        // ================================================================
+        if (!createInterpreter(type, config.numThreads)) {
+            LOG_ERROR("%s backend unavailable, falling back", delegateTypeName(type));
+            destroyInterpreter();
+            continue;
+        }
+
+        // Nothing to compare against: accept the only candidate or CPU
+        if (type == DelegateType::Cpu || !config.allowDelegateFallback) {
+            return true;
+        }
+
+        // ================================================================
+        // STEP 2: Warm-Up and Validate
+        // ================================================================
+        const double latency = benchmarkInterpreter(interpreter, runs);
+        if (latency < 0.0) {
+            LOG_ERROR("%s backend failed warm-up invoke, falling back",
+                      delegateTypeName(type));
+            destroyInterpreter();
+            continue;
+        }
+
+        // ================================================================
+        // STEP 3: Compare Against the CPU Kernels
+        // ================================================================
+        if (cpuLatency < 0.0) {
+            TfLiteInterpreterOptions* cpuOptions = TfLiteInterpreterOptionsCreate();
+            TfLiteInterpreterOptionsSetNumThreads(cpuOptions, config.numThreads);
+            TfLiteInterpreter* cpu = TfLiteInterpreterCreate(model, cpuOptions);
+            if (cpu && TfLiteInterpreterAllocateTensors(cpu) == kTfLiteOk) {
+                cpuLatency = benchmarkInterpreter(cpu, runs);
+            }
+            if (cpu) TfLiteInterpreterDelete(cpu);
+            TfLiteInterpreterOptionsDelete(cpuOptions);
+        }
+
+        LOG_INFO("%s backend: %.3f ms/invoke (CPU %.3f ms)",
+                 delegateTypeName(type), latency, cpuLatency);
+
+        if (cpuLatency >= 0.0 && latency > cpuLatency) {
+            LOG_INFO("%s backend slower than CPU, falling back", delegateTypeName(type));
+            destroyInterpreter();
+            continue;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Auto-tune the thread count for the selected backend.
+ *
  * This method:
- * 1. Validates the interpreter is initialized
- * 2. Gets the input tensor from the model
- * 3. Converts int16 PCM audio to normalized floats
- * 4. Copies data to the input tensor
- * 5. Invokes the interpreter (runs inference)
- * 6. Extracts and returns output predictions
- * 
- * @param audioData Raw audio samples (16-bit PCM)
- * @param length Number of samples in audioData
- * @return Vector of output predictions from the model
+ * 1. Skips backends that do not run on CPU threads (GPU, NNAPI)
+ * 2. Reuses a cached decision for this device, model and backend
+ * 3. Otherwise rebuilds the interpreter with 1..maxThreads threads,
+ *    benchmarks each and keeps the fastest
+ * 4. Stores the decision in the cache
+ *
+ * @param config Construction settings
+ * @return true if an interpreter is ready afterwards
  */
-std::vector<float> MLProcessor::processAudio(const int16_t* audioData, int length) {
-    std::vector<float> result;
+bool MLProcessor::tuneThreads(const MLProcessorConfig& config) {
+    const DelegateType type = activeDelegate;
+    if (type != DelegateType::Cpu && type != DelegateType::XnnPack) {
+        return true;
+    }
 
-    if (!interpreter) {
-        LOG_ERROR("Interpreter not initialized");
-        return result;
+    int maxThreads = config.maxThreads;
+    if (maxThreads <= 0) {
+        maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (maxThreads > kMaxTunedThreads) maxThreads = kMaxTunedThreads;
     }
+    if (maxThreads < 1) maxThreads = 1;
 
     // ====================================================================
-    // STEP 1: Get Input Tensor
+    // STEP 1: Reuse a Cached Decision
     // ====================================================================
-    // Retrieve the input tensor from the interpreter. Index 0 refers to
-    // the first (and typically only) input tensor in the model.
-    TfLiteTensor* inputTensor = TfLiteInterpreterGetInputTensor(interpreter, 0);
-    if (!inputTensor) {
-        LOG_ERROR("Failed to get input tensor");
-        return result;
+    std::string cachePath;
+    std::string cacheKey;
+    uint64_t modelHash = 0;
+    if (!config.cacheDir.empty() && sharedModel->contentHash(&modelHash)) {
+        cachePath = config.cacheDir + "/" + kTuningCacheFile;
+        cacheKey = "threads/" + std::to_string(modelHash) + "/" +
+                   delegateTypeName(type) + "/" + std::to_string(maxThreads) + "/" +
+                   deviceFingerprint();
+
+        std::string cached;
+        if (cacheLoad(cachePath, cacheKey, &cached)) {
+            const int threads = std::atoi(cached.c_str());
+            if (threads >= 1 && threads <= maxThreads) {
+                LOG_INFO("Using cached thread count %d", threads);
+                if (threads == numThreads) {
+                    return true;
+                }
+                destroyInterpreter();
+                return createInterpreter(type, threads);
+            }
+        }
     }
 
     // ====================================================================
-    // STEP 2: Convert int16 to float and normalize
+    // STEP 2: Sweep 1..maxThreads
     // ====================================================================
-    // Audio data comes as signed 16-bit integers. We need to:
-    // 1. Convert to float (values roughly in range [-32768, 32767])
-    // 2. Normalize to [-1.0, 1.0] by dividing by max amplitude
-    
-    std::vector<float> floatData(length);
-    float maxAmplitude = 0.0f;
-    for (int i = 0; i < MODEL_INPUT_LEN && i < length; i++) {
-        floatData[i] = static_cast<float>(audioData[i]);
-        // Track max amplitude to normalize between -1.0 and 1.0
-        float absValue = std::abs(floatData[i]);
-        if (absValue > maxAmplitude) {
-            maxAmplitude = absValue;
+    const int runs = config.delegateBenchmarkRuns > 0 ? config.delegateBenchmarkRuns : 1;
+    int bestThreads = numThreads;
+    double bestLatency = -1.0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        destroyInterpreter();
+        if (!createInterpreter(type, threads)) {
+            continue;
         }
-    }
 
-    // Normalize to -1.0 to 1.0 range
-    if (maxAmplitude > 0.0f) {
-        for (int i = 0; i < MODEL_INPUT_LEN && i < length; i++) {
-            floatData[i] = floatData[i] / maxAmplitude;
+        const double latency = benchmarkInterpreter(interpreter, runs);
+        LOG_INFO("%d threads: %.3f ms/invoke", threads, latency);
+        if (latency >= 0.0 && (bestLatency < 0.0 || latency < bestLatency)) {
+            bestLatency = latency;
+            bestThreads = threads;
         }
     }
 
-    LOG_INFO("Audio normalization - Max amplitude: %f", maxAmplitude);
+    // Rebuild with the winner (unless the sweep ended on it)
+    if (numThreads != bestThreads || !isInitialized()) {
+        destroyInterpreter();
+        if (!createInterpreter(type, bestThreads)) {
+            return false;
+        }
+    }
 
     // ====================================================================
-    // STEP 3: Copy Data to Input Tensor
+    // STEP 3: Cache the Decision
     // ====================================================================
-    // Copy the normalized float audio data into the input tensor buffer
-    // that the interpreter will use for inference.
-    TfLiteTensorCopyFromBuffer(inputTensor, floatData.data(),
-                               MODEL_INPUT_LEN * sizeof(float));
+    if (!cachePath.empty() && bestLatency >= 0.0 &&
+        !cacheStore(cachePath, cacheKey, std::to_string(bestThreads))) {
+        LOG_ERROR("Failed to write tuning cache %s", cachePath.c_str());
+    }
 
-    // ====================================================================
-    // STEP 4: Run Inference
-    // ====================================================================
-    // Execute the neural network model with the input data.
-    // This performs the forward pass through all layers of the network.
-    if (TfLiteInterpreterInvoke(interpreter) != kTfLiteOk) {
-        LOG_ERROR("Failed to invoke interpreter");
-        return result;
+    LOG_INFO("Auto-tuned thread count: %d (%.3f ms/invoke)", bestThreads, bestLatency);
+    return true;
+}
+
+/**
+ * Warm the final interpreter up.
+ *
+ * This method:
+ * 1. Zeroes the input tensor (silence, valid for float and quantized input)
+ * 2. Invokes the interpreter `invokes` times
+ * 3. Logs the first and last invoke, so the one-time cost is visible
+ */
+bool MLProcessor::warmUp(int invokes) {
+    if (!inputTensor || !TfLiteTensorData(inputTensor)) {
+        LOG_ERROR("Interpreter not initialized");
+        return false;
     }
+    std::memset(TfLiteTensorData(inputTensor), 0, TfLiteTensorByteSize(inputTensor));
 
-    // ====================================================================
-    // STEP 5: Extract Output Tensor
-    // ====================================================================
-    // Retrieve the output tensor from the interpreter. The model's final
-    // layer produces output predictions that are stored here.
-    const TfLiteTensor* outputTensor = TfLiteInterpreterGetOutputTensor(
-            interpreter, 0);
-    if (!outputTensor) {
-        LOG_ERROR("Failed to get output tensor");
-        return result;
+    double firstMs = 0.0;
+    double lastMs = 0.0;
+    for (int i = 0; i < invokes; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (TfLiteInterpreterInvoke(interpreter) != kTfLiteOk) {
+            LOG_ERROR("Warm-up invoke %d failed", i);
+            return false;
+        }
+        auto end = std::chrono::steady_clock::now();
+        lastMs = std::chrono::duration<double, std::milli>(end - start).count();
+        if (i == 0) {
+            firstMs = lastMs;
+        }
+    }
+
+    LOG_INFO("Warm-up: %d invokes, first %.3f ms, last %.3f ms", invokes, firstMs, lastMs);
+    return true;
+}
+
+/**
+ * Fill the input tensor and run the interpreter.
+ *
+ * This method:
+ * 1. Validates the interpreter and cached tensors are ready
+ * 2. Converts the PCM audio (int16, int32 or float) directly into the
+ *    input tensor, normalized to [-1.0, 1.0]
+ * 3. Invokes the interpreter (runs inference)
+ *
+ * No heap allocation happens here: the input tensor's own buffer is used
+ * as the conversion target, replacing the former scratch vector and the
+ * TfLiteTensorCopyFromBuffer copy.
+ *
+ * @param audioData Raw audio samples (int16, int32 or float PCM)
+ * @param length Number of samples in audioData
+ * @param peak Known peak amplitude, or -1 to compute it
+ * @return true if inference succeeded
+ */
+template <typename Sample>
+bool MLProcessor::runInference(const Sample* audioData, int length, float peak) {
+    adoptPendingSwap();
+    if (!ensureInterpreter()) {
+        return false;
+    }
+
+    if (!audioData || length <= 0) {
+        LOG_ERROR("Empty audio data");
+        return false;
+    }
+
+    // A single window needs batch size 1 (no-op unless a batch call ran)
+    if (!ensureBatchSize(1)) {
+        return false;
     }
 
     // ====================================================================
-    // STEP 6: Calculate Output Size
+    // STEP 1: Find the Peak Amplitude
     // ====================================================================
-    // Get the dimensions of the output tensor to determine how many
-    // predictions were generated (e.g., 10 classes for digit recognition).
-    int outputSize = 1;
-    for (int i = 0; i < TfLiteTensorNumDims(outputTensor); i++) {
-        outputSize *= TfLiteTensorDim(outputTensor, i);
+    // Audio data is normalized to [-1.0, 1.0] by the max amplitude.
+    // Callers that already scanned the samples (e.g. the RMS gate) pass
+    // the peak in, so the samples are read only once. Whole int16 windows
+    // use the fixed-length kernel picked at load time.
+    const int count = length < windowLength ? length : windowLength;
+    {
+        ScopedStage timing(stats, MLStage::Input);
+        if (peak < 0.0f) {
+            if constexpr (std::is_same<Sample, int16_t>::value) {
+                peak = static_cast<float>(count == windowLength
+                                                  ? peakWindow(audioData, count)
+                                                  : peakAbsInt16(audioData, count));
+            } else {
+                peak = SampleKernels<Sample>::peak(audioData, count);
+            }
+        }
+
+        // ================================================================
+        // STEP 2: Convert and Normalize into the Input Tensor
+        // ================================================================
+        // Written straight into the tensor's own buffer (float, or
+        // quantized int8 / uint8) in a single vectorized pass; see
+        // writeInputWindow.
+        if (!writeInputWindow(0, audioData, count, peak)) {
+            return false;
+        }
     }
 
+    // Per-window diagnostic: debug builds only, at most once per second
+    LOG_EVERY_MS(ML_LOG_LEVEL_DEBUG, 1000, "Audio normalization - Max amplitude: %f",
+                 peak);
+
     // ====================================================================
-    // STEP 7: Copy Output Data
+    // STEP 3: Run Inference
     // ====================================================================
-    // Copy the output predictions from the tensor into our result vector.
-    result.resize(outputSize);
-    TfLiteTensorCopyToBuffer(outputTensor, result.data(),
-                             outputSize * sizeof(float));
+    return invokeInterpreter();
+}
 
-    return result;
+/**
+ * Resize the input tensor's batch dimension.
+ *
+ * This method:
+ * 1. Returns immediately if the batch size is unchanged (hot path)
+ * 2. Resizes dimension 0 of the input tensor to `windows`
+ * 3. Reallocates the tensors and refreshes the cached tensor handles
+ * 4. Checks the output grew to `windows` rows of outputSize values
+ *
+ * @param windows Number of windows per invoke
+ * @return true if the interpreter now runs `windows` windows per invoke
+ */
+bool MLProcessor::ensureBatchSize(int windows) {
+    if (windows == batchSize) {
+        return true;
+    }
+
+    if (windows <= 0 || inputRank < 1) {
+        LOG_ERROR("Invalid batch size %d", windows);
+        return false;
+    }
+
+    // One state per model: a batch would be several streams
+    if (isStateful()) {
+        LOG_ERROR("Stateful model runs one step per invoke (batch %d)", windows);
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 1: Resize the Batch Dimension
+    // ====================================================================
+    int dims[kMaxTensorDims];
+    for (int i = 0; i < inputRank; i++) {
+        dims[i] = inputDims[i];
+    }
+    dims[0] = windows;
+
+    if (TfLiteInterpreterResizeInputTensor(interpreter, 0, dims, inputRank) != kTfLiteOk) {
+        LOG_ERROR("Failed to resize input tensor to batch %d", windows);
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 2: Reallocate Tensors
+    // ====================================================================
+    // Tensor buffers move on reallocation, which is why the hot paths
+    // always fetch TfLiteTensorData instead of caching data pointers. The
+    // arena grows or shrinks with the batch.
+    const int64_t heapBefore = heapBytesInUse();
+    if (TfLiteInterpreterAllocateTensors(interpreter) != kTfLiteOk) {
+        LOG_ERROR("Failed to allocate tensors for batch %d", windows);
+        batchSize = 0;  // Unknown state: force a resize on the next call
+        return false;
+    }
+
+    const int64_t heapAfter = heapBytesInUse();
+    if (arenaHeapBytes >= 0 && heapBefore >= 0 && heapAfter >= 0) {
+        arenaHeapBytes = std::max<int64_t>(0, arenaHeapBytes + heapAfter - heapBefore);
+    }
+
+    inputTensor = TfLiteInterpreterGetInputTensor(interpreter, 0);
+    outputTensor = TfLiteInterpreterGetOutputTensor(interpreter, 0);
+
+    // ====================================================================
+    // STEP 3: Validate the Output Shape
+    // ====================================================================
+    const size_t expectedBytes =
+            static_cast<size_t>(windows) * outputSize * elementSize(outputType);
+    if (!inputTensor || !outputTensor ||
+        TfLiteTensorByteSize(outputTensor) != expectedBytes) {
+        LOG_ERROR("Model does not support batch size %d", windows);
+        batchSize = 0;
+        return false;
+    }
+
+    if (outputType != kTfLiteFloat32) {
+        dequantized.assign(static_cast<size_t>(windows) * outputSize, 0.0f);
+    }
+
+    batchSize = windows;
+    return true;
+}
+
+/**
+ * Check the interpreter is ready, rebuilding a released one.
+ *
+ * This method:
+ * 1. Returns at once while the interpreter exists (the hot path)
+ * 2. After releaseArenas, builds it again on the backend and thread count
+ *    it ran on; the batch is resized by the caller's ensureBatchSize
+ */
+bool MLProcessor::ensureInterpreter() {
+    if (inputTensor && outputTensor) {
+        return true;
+    }
+    if (!arenasReleased) {
+        LOG_ERROR("Interpreter not initialized");
+        return false;
+    }
+
+    // Taken before the rebuild, which zeroes the state (see resetState)
+    std::vector<uint8_t> state;
+    state.swap(savedState);
+
+    arenasReleased = false;
+    if (!createInterpreter(activeDelegate, numThreads)) {
+        LOG_ERROR("Failed to rebuild the interpreter (%s, %d threads)",
+                  delegateTypeName(activeDelegate), numThreads);
+        releaseInterpreter();
+        return false;
+    }
+
+    // Continue a stateful stream where it was released (the rebuild
+    // zeroed the state)
+    size_t offset = 0;
+    for (const StateTensor& tensor : stateTensors) {
+        if (offset + tensor.bytes <= state.size()) {
+            std::memcpy(TfLiteTensorData(tensor.input), state.data() + offset, tensor.bytes);
+        }
+        offset += tensor.bytes;
+    }
+
+    LOG_INFO("Interpreter rebuilt after release (%s, %d threads, arena %lld bytes)",
+             delegateTypeName(activeDelegate), numThreads,
+             static_cast<long long>(arenaHeapBytes));
+    return true;
+}
+
+/**
+ * Peak-normalize one window into a row of the input tensor.
+ *
+ * This method:
+ * 1. Locates the row inside the tensor buffer (which moves on reallocation,
+ *    so it is fetched on every call)
+ * 2. float32: widens and scales by 1/peak (bit-identical to
+ *    normalizeInt16ToFloat)
+ * 3. int8 / uint8: folds 1/peak and the tensor scale into one factor and
+ *    quantizes straight from the source samples (no float intermediate)
+ * 4. Zero-pads the rest of the row, so a short buffer never leaves stale
+ *    data from the previous window in the tensor
+ *
+ * With the log-mel front end the row holds the window's features instead
+ * (computed from the raw samples; the peak is not used).
+ */
+template <typename Sample>
+bool MLProcessor::writeInputWindow(int row, const Sample* samples, int count, float peak) {
+    void* inputData = TfLiteTensorData(inputTensor);
+    if (!inputData) {
+        LOG_ERROR("Input tensor has no data buffer");
+        return false;
+    }
+
+    const size_t offset = static_cast<size_t>(row) * inputRowSize;
+    if (melFrontEnd.isConfigured()) {
+        if constexpr (std::is_same<Sample, int16_t>::value) {
+            if (count < windowLength) {
+                std::memcpy(melPadding.data(), samples, count * sizeof(int16_t));
+                std::memset(melPadding.data() + count, 0,
+                            (windowLength - count) * sizeof(int16_t));
+                samples = melPadding.data();
+            }
+            melFrontEnd.compute(samples, windowLength,
+                                static_cast<float*>(inputData) + offset);
+            return true;
+        } else {
+            LOG_ERROR("The log-mel front end takes 16-bit PCM only");
+            return false;
+        }
+    }
+
+    // A silent window is all zeros: scaling by 1.0 keeps it that way. A
+    // step's own peak would rescale the samples the state was computed
+    // from, so stateful models use the format's full scale.
+    if (isStateful()) {
+        peak = SampleKernels<Sample>::fullScale();
+    }
+    const float normalize = peak > 0.0f ? 1.0f / peak : 1.0f;
+    const int padding = windowLength - count;
+    const int32_t zeroPoint = inputQuant.zero_point;
+
+    switch (inputType) {
+        case kTfLiteInt8:
+            storeRow(samples, static_cast<int8_t*>(inputData) + offset, count, padding,
+                     normalize / inputQuant.scale, zeroPoint,
+                     static_cast<int8_t>(zeroPoint));
+            break;
+        case kTfLiteUInt8:
+            storeRow(samples, static_cast<uint8_t*>(inputData) + offset, count, padding,
+                     normalize / inputQuant.scale, zeroPoint,
+                     static_cast<uint8_t>(zeroPoint));
+            break;
+        default: {
+            auto* dst = static_cast<float*>(inputData) + offset;
+            if constexpr (std::is_same<Sample, int16_t>::value) {
+                if (count == windowLength) {
+                    convertWindow(samples, dst, count, normalize);
+                    break;
+                }
+            }
+            storeRow(samples, dst, count, padding, normalize, 0, 0.0f);
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Scores of the last invoke as floats.
+ */
+const float* MLProcessor::outputScores(int rows) {
+    ScopedStage timing(stats, MLStage::Output);
+    const void* outputData = TfLiteTensorData(outputTensor);
+    if (!outputData) {
+        LOG_ERROR("Output tensor has no data buffer");
+        return nullptr;
+    }
+
+    if (outputType == kTfLiteFloat32) {
+        return static_cast<const float*>(outputData);
+    }
+
+    // real = scale * (q - zero_point)
+    const int count = rows * outputSize;
+    const float scale = outputQuant.scale;
+    const int32_t zeroPoint = outputQuant.zero_point;
+    if (outputType == kTfLiteInt8) {
+        const auto* q = static_cast<const int8_t*>(outputData);
+        for (int i = 0; i < count; i++) dequantized[i] = scale * (q[i] - zeroPoint);
+    } else {
+        const auto* q = static_cast<const uint8_t*>(outputData);
+        for (int i = 0; i < count; i++) dequantized[i] = scale * (q[i] - zeroPoint);
+    }
+    return dequantized.data();
+}
+
+/**
+ * Run the interpreter on the current contents of the input tensor.
+ *
+ * For a stateful model the new state is then copied from each state
+ * output into its input, tensor to tensor: the C API cannot alias the two
+ * buffers, and a kernel reading the old state while writing the new one
+ * needs them distinct anyway. The copy is the size of the state, far less
+ * than recomputing the window the state summarizes.
+ *
+ * @return true if inference succeeded
+ */
+bool MLProcessor::invokeInterpreter() {
+    ScopedStage timing(stats, MLStage::Invoke);
+
+    // Execute the neural network model with the input data.
+    // This performs the forward pass through all layers of the network.
+    if (TfLiteInterpreterInvoke(interpreter) != kTfLiteOk) {
+        LOG_ERROR("Failed to invoke interpreter");
+        return false;
+    }
+
+    for (const StateTensor& state : stateTensors) {
+        std::memcpy(TfLiteTensorData(state.input), TfLiteTensorData(state.output), state.bytes);
+    }
+
+    // Where it ran, for getCoreUsage (one getcpu call)
+    const int cpu = currentCpu();
+    if (cpu >= 0 && cpu < kMaxCpus) {
+        invokeCpus[cpu].fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * Process audio samples and return a view over the output tensor.
+ *
+ * The returned pointer refers to the interpreter's output buffer: no copy
+ * and no allocation. It is only valid until the next inference call.
+ *
+ * @param audioData Raw audio samples (int16, int32 or float PCM)
+ * @param length Number of samples in audioData
+ * @param outputLength Receives the number of predictions (may be null)
+ * @return Pointer to the predictions, or nullptr on failure
+ */
+template <typename Sample>
+const float* MLProcessor::processAudioView(const Sample* audioData, int length,
+                                           int* outputLength) {
+    ScopedStage timing(stats, MLStage::Call);
+    if (outputLength) *outputLength = 0;
+
+    if (!runInference(audioData, length)) {
+        return nullptr;
+    }
+
+    // Float32 outputs are handed out directly; quantized outputs are
+    // dequantized into a preallocated buffer
+    const float* outputData = outputScores(1);
+    if (!outputData) {
+        return nullptr;
+    }
+
+    if (outputLength) *outputLength = outputSize;
+    return outputData;
+}
+
+/**
+ * Process audio samples into a caller-provided buffer (zero-allocation).
+ *
+ * @param audioData Raw audio samples (int16, int32 or float PCM)
+ * @param length Number of samples in audioData
+ * @param output Destination buffer for the predictions
+ * @param outputCapacity Number of floats available in output
+ * @return Number of predictions written, or -1 on failure
+ */
+template <typename Sample>
+int MLProcessor::processAudioInto(const Sample* audioData, int length,
+                                  float* output, int outputCapacity) {
+    if (!output || outputCapacity < outputSize) {
+        LOG_ERROR("Output buffer too small (%d < %d)", outputCapacity, outputSize);
+        return -1;
+    }
+
+    int count = 0;
+    const float* predictions = processAudioView(audioData, length, &count);
+    if (!predictions) {
+        return -1;
+    }
+
+    std::memcpy(output, predictions, count * sizeof(float));
+    return count;
+}
+
+/**
+ * Process audio samples - fully portable implementation
+ * 
+ * Convenience wrapper over processAudioView that returns the predictions
+ * in a newly allocated vector. Prefer processAudioInto / processAudioView
+ * on the audio-rate path, as this allocates on every call.
+ * 
+ * @param audioData Raw audio samples (int16, int32 or float PCM)
+ * @param length Number of samples in audioData
+ * @return Vector of output predictions from the model
+ */
+template <typename Sample>
+std::vector<float> MLProcessor::processAudio(const Sample* audioData, int length) {
+    int count = 0;
+    const float* predictions = processAudioView(audioData, length, &count);
+    if (!predictions) {
+        return {};
+    }
+
+    return std::vector<float>(predictions, predictions + count);
+}
+
+/**
+ * Process several windows in a single interpreter invoke.
+ *
+ * This method:
+ * 1. Resizes the input tensor to numWindows rows (only if N changed)
+ * 2. Peak-normalizes each window into its own row of the input tensor
+ * 3. Invokes the interpreter once for the whole batch
+ * 4. Copies the N x outputSize prediction matrix into `output`
+ *
+ * @param audioData numWindows * getWindowLength() samples (16-bit PCM)
+ * @param numWindows Number of windows (N)
+ * @param output Destination buffer, N x getOutputSize() floats (row-major)
+ * @param outputCapacity Number of floats available in output
+ * @return Number of floats written, or -1 on failure
+ */
+int MLProcessor::processAudioBatchInto(const int16_t* audioData, int numWindows,
+                                       float* output, int outputCapacity) {
+    ScopedStage timing(stats, MLStage::Call);
+    adoptPendingSwap();
+    if (!ensureInterpreter()) {
+        return -1;
+    }
+
+    if (!audioData || numWindows <= 0) {
+        LOG_ERROR("Empty audio batch");
+        return -1;
+    }
+
+    const int resultSize = numWindows * outputSize;
+    if (!output || outputCapacity < resultSize) {
+        LOG_ERROR("Output buffer too small (%d < %d)", outputCapacity, resultSize);
+        return -1;
+    }
+
+    // ====================================================================
+    // STEP 1: Resize the Input Tensor (only when N changes)
+    // ====================================================================
+    if (!ensureBatchSize(numWindows)) {
+        return -1;
+    }
+
+    // ====================================================================
+    // STEP 2: Normalize Every Window into Its Row
+    // ====================================================================
+    {
+        ScopedStage inputTiming(stats, MLStage::Input);
+        for (int w = 0; w < numWindows; w++) {
+            const int16_t* window = audioData + static_cast<size_t>(w) * windowLength;
+            if (!writeInputWindow(w, window, windowLength,
+                                  peakWindow(window, windowLength))) {
+                return -1;
+            }
+        }
+    }
+
+    // ====================================================================
+    // STEP 3: Run Inference Once for the Whole Batch
+    // ====================================================================
+    if (!invokeInterpreter()) {
+        return -1;
+    }
+
+    // ====================================================================
+    // STEP 4: Copy the Prediction Matrix
+    // ====================================================================
+    const float* outputData = outputScores(numWindows);
+    if (!outputData) {
+        return -1;
+    }
+    std::memcpy(output, outputData, resultSize * sizeof(float));
+    return resultSize;
+}
+
+/**
+ * Process several windows in a single interpreter invoke (allocating).
+ *
+ * @param audioData numWindows * getWindowLength() samples (16-bit PCM)
+ * @param numWindows Number of windows (N)
+ * @return N x getOutputSize() predictions (row-major), empty on failure
+ */
+std::vector<float> MLProcessor::processAudioBatch(const int16_t* audioData, int numWindows) {
+    if (numWindows <= 0) {
+        return {};
+    }
+
+    std::vector<float> result(static_cast<size_t>(numWindows) * outputSize);
+    const int written = processAudioBatchInto(audioData, numWindows,
+                                              result.data(), static_cast<int>(result.size()));
+    if (written < 0) {
+        return {};
+    }
+    return result;
+}
+
+/**
+ * Copy a loaded tensor shape into a caller's array.
+ */
+static int copyShape(const int* shape, int rank, int* dims, int maxDims) {
+    for (int i = 0; i < rank && i < maxDims; i++) {
+        dims[i] = shape[i];
+    }
+    return rank;
+}
+
+int MLProcessor::getInputShape(int* dims, int maxDims) const {
+    return isInitialized() ? copyShape(inputDims, inputRank, dims, maxDims) : 0;
+}
+
+int MLProcessor::getOutputShape(int* dims, int maxDims) const {
+    return isInitialized() ? copyShape(outputDims, outputRank, dims, maxDims) : 0;
+}
+
+// ============================================================================
+// STREAMING API
+// ============================================================================
+
+/**
+ * Configure (or reconfigure) the streaming classifier.
+ *
+ * @param hopSize Samples between window starts (1..getWindowLength())
+ * @param bufferCapacity Samples the ring buffer can hold
+ * @param batchSize Windows classified per interpreter invoke
+ * @return false if the configuration is invalid
+ */
+bool MLProcessor::configureStream(int hopSize, int bufferCapacity, int batchSize) {
+    // Size the interpreter the stream will actually run on
+    adoptPendingSwap();
+    if (batchSize < 1) {
+        LOG_ERROR("Invalid stream batch size %d", batchSize);
+        return false;
+    }
+
+    if (windowLength <= 0) {
+        LOG_ERROR("Interpreter not initialized");
+        return false;
+    }
+
+    // The state already covers the samples before a step, so a stateful
+    // model takes each sample once
+    if (isStateful() && hopSize != windowLength) {
+        LOG_WARN("Stateful model steps %d samples, hop %d ignored", windowLength, hopSize);
+        hopSize = windowLength;
+    }
+
+    if (!streamWindow.configure(windowLength, hopSize)) {
+        LOG_ERROR("Invalid stream hop size %d (must be 1..%d)", hopSize, windowLength);
+        return false;
+    }
+
+    // The ring buffer must be able to hold a whole batch of windows
+    const int minCapacity = windowLength + (batchSize - 1) * hopSize;
+    if (bufferCapacity < minCapacity) {
+        LOG_ERROR("Stream buffer must hold at least %d samples", minCapacity);
+        return false;
+    }
+
+    // Size the input tensor for the stream batch once, up front, so
+    // processStream never reallocates. Models with a fixed batch dimension
+    // fall back to one window per invoke.
+    if (batchSize > 1 && !ensureBatchSize(batchSize)) {
+        LOG_ERROR("Batched streaming unavailable, using batch size 1");
+        batchSize = 1;
+    }
+
+    // All streaming storage is allocated here, once; pushAudio() and
+    // processStream() never allocate.
+    streamBuffer.reset(bufferCapacity);
+    streamChunk.assign(static_cast<size_t>(windowLength), 0);
+    streamBatchSize = batchSize;
+    streamConfiguredHop = hopSize;
+    pendingHop.store(0, std::memory_order_relaxed);
+
+    const size_t maxWindows = streamBuffer.capacity() / hopSize + 1;
+    streamScores.assign(maxWindows * outputSize, 0.0f);
+    streamStarts.assign(maxWindows, 0);
+    cascadeRows.assign(static_cast<size_t>(batchSize), 0);
+
+    LOG_INFO("Stream configured: hop %d, buffer %zu samples, batch %d",
+             hopSize, streamBuffer.capacity(), batchSize);
+    return true;
+}
+
+/**
+ * Request a new hop for the running stream.
+ *
+ * Only values fixed by configureStream are read here, so this is safe
+ * while the consumer runs; the consumer applies the hop in runStream.
+ *
+ * @param hopSize Samples between window starts
+ * @return false if the stream is not configured or the hop is invalid
+ */
+bool MLProcessor::setStreamHopSize(int hopSize) {
+    if (streamConfiguredHop <= 0) {
+        LOG_ERROR("Stream not configured");
+        return false;
+    }
+
+    // Narrower than configured would overflow the score storage, and a
+    // batch must stay completable from a full buffer
+    const size_t batchSpan =
+            windowLength + static_cast<size_t>(streamBatchSize - 1) * hopSize;
+    if (hopSize < streamConfiguredHop || hopSize > windowLength ||
+        batchSpan > streamBuffer.capacity()) {
+        LOG_ERROR("Invalid stream hop %d (%d..%d)", hopSize, streamConfiguredHop,
+                  windowLength);
+        return false;
+    }
+
+    pendingHop.store(hopSize, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Set the rate of the audio given to pushAudio().
+ *
+ * @param sampleRate Capture rate of the pushed audio
+ * @return false if the model rate is unknown or the ratio unsupported
+ */
+bool MLProcessor::setStreamInputRate(int sampleRate) {
+    if (frontEnd.modelSampleRate <= 0) {
+        LOG_ERROR("Cannot resample to an unknown model sample rate");
+        return false;
+    }
+    if (!streamResampler.configure(sampleRate, frontEnd.modelSampleRate,
+                                   frontEnd.resamplerTaps)) {
+        return false;
+    }
+    resampleBlock.assign(static_cast<size_t>(streamResampler.maxOutput(kResampleBlock)), 0);
+    frontEnd.inputSampleRate = sampleRate;
+    return true;
+}
+
+/**
+ * Producer side: append captured samples to the stream.
+ *
+ * When resampling, input is converted block by block through a fixed
+ * scratch buffer. A block is only converted if its output fits the ring
+ * buffer, so dropped input never advances the filter state.
+ *
+ * @param samples Raw audio samples (16-bit PCM)
+ * @param count Number of samples
+ * @return Number of samples accepted
+ */
+int MLProcessor::pushAudio(const int16_t* samples, int count) {
+    if (!samples || count <= 0) {
+        return 0;
+    }
+    if (!streamResampler.isActive()) {
+        return static_cast<int>(streamBuffer.write(samples, count));
+    }
+
+    int consumed = 0;
+    while (consumed < count) {
+        const int block = count - consumed < kResampleBlock ? count - consumed : kResampleBlock;
+        if (streamBuffer.freeSpace() < static_cast<size_t>(streamResampler.maxOutput(block))) {
+            break;  // Ring buffer full: drop the rest
+        }
+        const int produced = streamResampler.process(samples + consumed, block,
+                                                     resampleBlock.data());
+        streamBuffer.write(resampleBlock.data(), produced);
+        consumed += block;
+    }
+    return consumed;
+}
+
+/**
+ * Consumer side: classify every complete window available so far.
+ *
+ * This method loops over batches of streamBatchSize windows:
+ * 1. Checking that the buffered samples complete a whole batch
+ * 2. For each window of the batch, moving just enough samples from the
+ *    ring buffer to complete it and writing it, normalized, into its row
+ *    of the input tensor (so no window is overwritten before it is used)
+ * 3. Invoking the interpreter once and copying the prediction rows
+ *
+ * Overlapping windows share work: each sample is converted into the window
+ * history and inspected for the peak only once (see SlidingWindow). The
+ * per-window normalization scale still differs, so every window costs one
+ * widen + multiply store pass into the tensor, with no scratch copy.
+ *
+ * @param scores Output matrix, maxWindows x getOutputSize() floats
+ * @param windowStarts Receives each window's first sample index (may be null)
+ * @param maxWindows Number of rows available in scores
+ * @return Number of windows classified, or -1 on failure
+ */
+int MLProcessor::processStream(float* scores, int64_t* windowStarts, int maxWindows) {
+    ScopedStage timing(stats, MLStage::Call);
+    return runStream(scores, windowStarts, maxWindows);
+}
+
+int MLProcessor::runStream(float* scores, int64_t* windowStarts, int maxWindows) {
+    if (!streamWindow.isConfigured()) {
+        LOG_ERROR("Stream not configured");
+        return -1;
+    }
+
+    adoptPendingSwap();
+    if (!ensureInterpreter()) {
+        return -1;
+    }
+
+    // Hop change requested by setStreamHopSize (one load when none is)
+    if (pendingHop.load(std::memory_order_relaxed) != 0) {
+        streamWindow.setHopSize(pendingHop.exchange(0, std::memory_order_relaxed));
+    }
+
+    if (!scores || maxWindows <= 0) {
+        return 0;
+    }
+
+    const int hopSize = streamWindow.getHopSize();
+    int windows = 0;
+    while (windows + streamBatchSize <= maxWindows) {
+        // ================================================================
+        // STEP 1: Check a whole batch can be completed
+        // ================================================================
+        // The next window needs samplesNeeded() more samples, every window
+        // after it hopSize more.
+        const size_t needed = streamWindow.samplesNeeded();
+        const size_t buffered = streamBuffer.available();
+        const size_t ready = buffered >= needed ? 1 + (buffered - needed) / hopSize : 0;
+        if (ready < static_cast<size_t>(streamBatchSize)) {
+            break;  // Wait for more audio
+        }
+
+        // No-op unless processAudio/processAudioBatch changed the batch
+        if (!ensureBatchSize(streamBatchSize)) {
+            return -1;
+        }
+
+        // ================================================================
+        // STEP 2: Complete and normalize each window into its row
+        // ================================================================
+        // With the cascade, only windows the activity detector accepts get
+        // a row (rows are packed; cascadeRows maps them back to windows)
+        const bool cascade = activityDetector.isConfigured();
+        int rows = 0;
+        {
+            ScopedStage inputTiming(stats, MLStage::Input);
+            for (int b = 0; b < streamBatchSize; b++) {
+                while (!streamWindow.windowReady()) {
+                    const size_t received = streamBuffer.read(streamChunk.data(),
+                                                              streamWindow.samplesNeeded());
+                    if (received == 0) {
+                        LOG_ERROR("Stream buffer underrun");
+                        return -1;
+                    }
+                    streamWindow.append(streamChunk.data(), static_cast<int>(received));
+                }
+
+                if (windowStarts) {
+                    windowStarts[windows + b] = streamWindow.windowStart();
+                }
+
+                if (cascade &&
+                    !activityDetector.accept(streamWindow.windowData(), windowLength)) {
+                    std::memset(scores + (windows + b) * outputSize, 0,
+                                outputSize * sizeof(float));
+                    streamWindow.advance();
+                    continue;
+                }
+
+                // Same conversion as processAudio, so a streamed window is
+                // bit-identical to classifying the same samples directly
+                if (!writeInputWindow(rows, streamWindow.windowData(), windowLength,
+                                      streamWindow.windowPeak())) {
+                    return -1;
+                }
+                cascadeRows[rows++] = b;
+                streamWindow.advance();
+            }
+        }
+
+        if (cascade) {
+            cascadeWindows.fetch_add(streamBatchSize, std::memory_order_relaxed);
+            cascadeDetected.fetch_add(rows, std::memory_order_relaxed);
+            if (rows == 0) {
+                cascadeSkipped.fetch_add(1, std::memory_order_relaxed);
+                windows += streamBatchSize;
+                continue;  // Nothing worth an invoke in this batch
+            }
+        }
+
+        // ================================================================
+        // STEP 3: Run inference and store the prediction rows
+        // ================================================================
+        // Rows past `rows` still hold older windows; they are ignored
+        if (!invokeInterpreter()) {
+            return -1;
+        }
+
+        const float* outputData = outputScores(rows);
+        if (!outputData) {
+            return -1;
+        }
+        if (rows == streamBatchSize) {
+            std::memcpy(scores + windows * outputSize, outputData,
+                        streamBatchSize * outputSize * sizeof(float));
+        } else {
+            for (int r = 0; r < rows; r++) {
+                std::memcpy(scores + (windows + cascadeRows[r]) * outputSize,
+                            outputData + r * outputSize, outputSize * sizeof(float));
+            }
+        }
+
+        if (cascade) {
+            int confident = 0;
+            for (int r = 0; r < rows; r++) {
+                const float* row = outputData + r * outputSize;
+                if (row[argmaxOf(row, outputSize)] > minScore) {
+                    confident++;
+                }
+            }
+            cascadeConfident.fetch_add(confident, std::memory_order_relaxed);
+        }
+        windows += streamBatchSize;
+    }
+
+    return windows;
+}
+
+/**
+ * Consumer side: drop queued samples and restart the window history.
+ */
+void MLProcessor::resetStream() {
+    const size_t discarded = streamBuffer.discard(streamBuffer.available());
+    streamClock += streamWindow.samplesAppended() + static_cast<int64_t>(discarded);
+    streamWindow.reset();
+    resetState();
+    eventDetector.endSegment();
+    activityDetector.endSegment();
+}
+
+/**
+ * Consumer side: advance the event clock over gated-out input.
+ */
+void MLProcessor::skipStream(int64_t inputSamples) {
+    if (inputSamples <= 0) {
+        return;
+    }
+    if (streamResampler.isActive()) {
+        inputSamples = inputSamples * frontEnd.modelSampleRate / frontEnd.inputSampleRate;
+    }
+    streamClock += inputSamples;
+}
+
+// ============================================================================
+// DECISION API
+// ============================================================================
+
+void MLProcessor::setDecisionThresholds(float silenceRms, float confidence) {
+    minRms = silenceRms;
+    minScore = confidence;
+}
+
+/**
+ * Reduce rows of scores to a decision.
+ */
+ClassificationResult MLProcessor::decide(const float* scores, int rows, float rms) const {
+    ScopedStage timing(stats, MLStage::Output);
+    ClassificationResult result;
+    result.rms = rms;
+    result.windows = rows;
+
+    // Argmax over every window's scores: the best class anywhere wins
+    int best = -1;
+    const int total = rows * outputSize;
+    for (int i = 0; i < total; i++) {
+        if (best < 0 || scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return result;
+    }
+
+    result.score = scores[best];
+    if (result.score > minScore) {
+        result.classIndex = best % outputSize;
+    }
+    return result;
+}
+
+/**
+ * Classify one window and reduce the scores to a single decision.
+ *
+ * This method:
+ * 1. Computes peak and energy in one fused pass
+ * 2. Returns early (no inference) below the RMS gate
+ * 3. Normalizes with the known peak, runs the model
+ * 4. Reduces the output tensor to argmax + threshold
+ */
+template <typename Sample>
+ClassificationResult MLProcessor::classify(const Sample* audioData, int length) {
+    ScopedStage timing(stats, MLStage::Call);
+    ClassificationResult result;
+    if (!audioData || length <= 0) {
+        LOG_ERROR("Empty audio data");
+        result.windows = -1;
+        return result;
+    }
+
+    // ====================================================================
+    // STEP 1: Silence Gate
+    // ====================================================================
+    const int count = length < windowLength ? length : windowLength;
+    const float peak = SampleKernels<Sample>::peakAndRms(audioData, count, &result.rms);
+    if (!(result.rms > minRms)) {
+        return result;
+    }
+
+    // ====================================================================
+    // STEP 2: Inference and Decision
+    // ====================================================================
+    if (!runInference(audioData, length, peak)) {
+        result.windows = -1;
+        return result;
+    }
+
+    const void* outputData = TfLiteTensorData(outputTensor);
+    if (!outputData) {
+        LOG_ERROR("Output tensor has no data buffer");
+        result.windows = -1;
+        return result;
+    }
+    if (outputType == kTfLiteFloat32) {
+        return decide(static_cast<const float*>(outputData), 1, result.rms);
+    }
+
+    // Quantized output: pick the winner on the raw values and dequantize
+    // only its score
+    ScopedStage outputTiming(stats, MLStage::Output);
+    int best;
+    int32_t quantized;
+    if (outputType == kTfLiteInt8) {
+        const auto* q = static_cast<const int8_t*>(outputData);
+        best = argmaxOf(q, outputSize);
+        quantized = q[best];
+    } else {
+        const auto* q = static_cast<const uint8_t*>(outputData);
+        best = argmaxOf(q, outputSize);
+        quantized = q[best];
+    }
+
+    result.windows = 1;
+    result.score = outputQuant.scale * (quantized - outputQuant.zero_point);
+    if (result.score > minScore) {
+        result.classIndex = best;
+    }
+    return result;
+}
+
+// Sample formats of the one-shot API (see ml_processor.h)
+#define ML_INSTANTIATE_ONE_SHOT(Sample)                                                  \
+    template std::vector<float> MLProcessor::processAudio(const Sample*, int);            \
+    template int MLProcessor::processAudioInto(const Sample*, int, float*, int);          \
+    template const float* MLProcessor::processAudioView(const Sample*, int, int*);        \
+    template ClassificationResult MLProcessor::classify(const Sample*, int);
+
+ML_INSTANTIATE_ONE_SHOT(int16_t)
+ML_INSTANTIATE_ONE_SHOT(int32_t)
+ML_INSTANTIATE_ONE_SHOT(float)
+
+#undef ML_INSTANTIATE_ONE_SHOT
+
+/**
+ * Gate a captured block, stream it and reduce all completed windows.
+ */
+ClassificationResult MLProcessor::classifyStream(const int16_t* samples, int count) {
+    ScopedStage timing(stats, MLStage::Call);
+    ClassificationResult result;
+    if (!streamWindow.isConfigured() || streamScores.empty()) {
+        LOG_ERROR("Stream not configured");
+        result.windows = -1;
+        return result;
+    }
+    if (!samples || count <= 0) {
+        return result;
+    }
+
+    // ====================================================================
+    // STEP 1: Silence Gate over the Whole Block
+    // ====================================================================
+    int64_t sumSquares = 0;
+    peakAndEnergyInt16(samples, count, &sumSquares);
+    result.rms = rmsFromEnergyInt16(sumSquares, count);
+    if (!(result.rms > minRms)) {
+        // Drop buffered samples so the next window does not straddle the
+        // silent gap
+        resetStream();
+        skipStream(count);
+        return result;
+    }
+
+    // ====================================================================
+    // STEP 2: Stream and Classify Completed Windows
+    // ====================================================================
+    pushAudio(samples, count);
+    return reducePending(result.rms);
+}
+
+/**
+ * Classify and reduce windows pushed by an external producer.
+ */
+ClassificationResult MLProcessor::classifyPending(float rms) {
+    ScopedStage timing(stats, MLStage::Call);
+    if (!streamWindow.isConfigured() || streamScores.empty()) {
+        LOG_ERROR("Stream not configured");
+        ClassificationResult result;
+        result.windows = -1;
+        return result;
+    }
+    return reducePending(rms);
+}
+
+ClassificationResult MLProcessor::reducePending(float rms) {
+    ClassificationResult result;
+    result.rms = rms;
+    const int windows = runStream(streamScores.data(), streamStarts.data(),
+                                  static_cast<int>(streamStarts.size()));
+    if (windows < 0) {
+        result.windows = -1;
+        return result;
+    }
+
+    if (eventDetector.isConfigured()) {
+        for (int w = 0; w < windows; w++) {
+            const int64_t start = streamClock + streamStarts[w];
+            eventDetector.addWindow(streamScores.data() + static_cast<size_t>(w) * outputSize,
+                                    start, start + windowLength);
+        }
+    }
+
+    // Reduce every window to one decision
+    return decide(streamScores.data(), windows, rms);
+}
+
+// ============================================================================
+// MULTI-CHANNEL API
+// ============================================================================
+
+/**
+ * Mark every channel's decision as failed.
+ */
+static int failChannels(ClassificationResult* results, int channels) {
+    for (int c = 0; c < channels; c++) {
+        results[c].windows = -1;
+    }
+    return -1;
+}
+
+/**
+ * Classify one window per channel of interleaved PCM.
+ *
+ * This method:
+ * 1. Deinterleaves the first window of every channel in one pass
+ * 2. Gates every channel on its RMS (peak and energy in one fused pass)
+ * 3. Normalizes loud channels into their batch row, silent ones into a
+ *    zero row, and invokes once for all channels (once per loud channel
+ *    on models that cannot batch)
+ * 4. Reduces every loud channel's row to its own decision
+ */
+int MLProcessor::classifyChannels(const int16_t* interleaved, int frames, int channels,
+                                  ClassificationResult* results) {
+    ScopedStage timing(stats, MLStage::Call);
+    if (!results || channels < 1 || channels > kMaxChannels) {
+        LOG_ERROR("Invalid channel count %d", channels);
+        return -1;
+    }
+    for (int c = 0; c < channels; c++) {
+        results[c] = ClassificationResult();
+    }
+
+    adoptPendingSwap();
+    if (!ensureInterpreter()) {
+        return failChannels(results, channels);
+    }
+    if (!interleaved || frames <= 0) {
+        LOG_ERROR("Empty audio data");
+        return failChannels(results, channels);
+    }
+    if (isStateful() && channels > 1) {
+        LOG_ERROR("Stateful model keeps the state of one channel, got %d", channels);
+        return failChannels(results, channels);
+    }
+
+    // ====================================================================
+    // STEP 1: Deinterleave
+    // ====================================================================
+    // Channel c's window starts at c * windowLength; windows shorter than
+    // windowLength are zero-padded by writeInputWindow.
+    const int count = frames < windowLength ? frames : windowLength;
+    const size_t needed = static_cast<size_t>(channels) * windowLength;
+    if (channelWindows.size() < needed) {
+        channelWindows.resize(needed);
+    }
+    float peaks[kMaxChannels];
+    int loud = 0;
+    {
+        ScopedStage inputTiming(stats, MLStage::Input);
+        deinterleaveInt16(interleaved, channelWindows.data(), count, channels, windowLength);
+
+        // ================================================================
+        // STEP 2: Silence Gate per Channel
+        // ================================================================
+        for (int c = 0; c < channels; c++) {
+            const int16_t* window =
+                    channelWindows.data() + static_cast<size_t>(c) * windowLength;
+            peaks[c] = SampleKernels<int16_t>::peakAndRms(window, count, &results[c].rms);
+            if (results[c].rms > minRms) {
+                loud++;
+            }
+        }
+    }
+    if (loud == 0) {
+        return -1;
+    }
+
+    // ====================================================================
+    // STEP 3: Inference
+    // ====================================================================
+    if (channelBatching && !ensureBatchSize(channels)) {
+        LOG_WARN("Model cannot batch %d channels, classifying them one at a time", channels);
+        channelBatching = false;
+    }
+
+    if (channelBatching) {
+        {
+            ScopedStage inputTiming(stats, MLStage::Input);
+            for (int c = 0; c < channels; c++) {
+                const int16_t* window =
+                        channelWindows.data() + static_cast<size_t>(c) * windowLength;
+                const bool classified = results[c].rms > minRms;
+                if (!writeInputWindow(c, window, classified ? count : 0,
+                                      classified ? peaks[c] : 0.0f)) {
+                    return failChannels(results, channels);
+                }
+            }
+        }
+        if (!invokeInterpreter()) {
+            return failChannels(results, channels);
+        }
+        const float* scores = outputScores(channels);
+        if (!scores) {
+            return failChannels(results, channels);
+        }
+
+        // ================================================================
+        // STEP 4: One Decision per Channel
+        // ================================================================
+        for (int c = 0; c < channels; c++) {
+            if (results[c].rms > minRms) {
+                results[c] = decide(scores + static_cast<size_t>(c) * outputSize, 1,
+                                    results[c].rms);
+            }
+        }
+    } else {
+        if (!ensureBatchSize(1)) {
+            return failChannels(results, channels);
+        }
+        for (int c = 0; c < channels; c++) {
+            if (!(results[c].rms > minRms)) {
+                continue;
+            }
+            {
+                ScopedStage inputTiming(stats, MLStage::Input);
+                const int16_t* window =
+                        channelWindows.data() + static_cast<size_t>(c) * windowLength;
+                if (!writeInputWindow(0, window, count, peaks[c])) {
+                    return failChannels(results, channels);
+                }
+            }
+            const float* scores = invokeInterpreter() ? outputScores(1) : nullptr;
+            if (!scores) {
+                return failChannels(results, channels);
+            }
+            results[c] = decide(scores, 1, results[c].rms);
+        }
+    }
+
+    // The channel with the highest reported score wins
+    int best = -1;
+    for (int c = 0; c < channels; c++) {
+        if (results[c].classIndex >= 0 &&
+            (best < 0 || results[c].score > results[best].score)) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// EVENT API
+// ============================================================================
+
+/**
+ * Enable (or reconfigure) event detection.
+ */
+bool MLProcessor::configureEvents(int smoothingWindows, float onThreshold, float offThreshold) {
+    if (outputSize <= 0) {
+        LOG_ERROR("Interpreter not initialized");
+        return false;
+    }
+    if (!eventDetector.configure(outputSize, smoothingWindows, onThreshold, offThreshold)) {
+        return false;
+    }
+    LOG_INFO("Events configured: %d windows smoothing, on > %.2f, off < %.2f",
+             smoothingWindows, onThreshold, offThreshold);
+    return true;
+}
+
+int MLProcessor::popEvents(ClassEvent* events, int maxEvents) {
+    if (!events || maxEvents <= 0) {
+        return 0;
+    }
+    return eventDetector.popEvents(events, maxEvents);
+}
+
+// ============================================================================
+// CASCADE API
+// ============================================================================
+
+bool MLProcessor::configureCascade(float snrDb, float minCrossingRate, float maxCrossingRate,
+                                   int hangoverWindows) {
+    if (isStateful()) {
+        LOG_ERROR("Cascade unavailable: a stateful model must see every step");
+        return false;
+    }
+    if (!activityDetector.configure(snrDb, minCrossingRate, maxCrossingRate, hangoverWindows)) {
+        return false;
+    }
+    resetCascadeStats();
+    LOG_INFO("Cascade configured: %.1f dB over noise, crossings %.2f..%.2f, hangover %d",
+             snrDb, minCrossingRate, maxCrossingRate, hangoverWindows);
+    return true;
+}
+
+CascadeStats MLProcessor::getCascadeStats() const {
+    CascadeStats result;
+    result.windows = cascadeWindows.load(std::memory_order_relaxed);
+    result.detected = cascadeDetected.load(std::memory_order_relaxed);
+    result.confident = cascadeConfident.load(std::memory_order_relaxed);
+    result.skippedInvokes = cascadeSkipped.load(std::memory_order_relaxed);
+    return result;
+}
+
+void MLProcessor::resetCascadeStats() {
+    cascadeWindows.store(0, std::memory_order_relaxed);
+    cascadeDetected.store(0, std::memory_order_relaxed);
+    cascadeConfident.store(0, std::memory_order_relaxed);
+    cascadeSkipped.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// THREAD PLACEMENT
+// ============================================================================
+
+/**
+ * Pin and raise the calling thread per the thread policy.
+ */
+ThreadPriority MLProcessor::prepareStreamThread() const {
+    const ThreadPolicy& policy = engineConfig.threadPolicy;
+    const bool pinned = policy.pinPerformanceCores && pinCurrentThread(performanceCores());
+    const ThreadPriority applied = raiseCurrentThreadPriority(policy.streamPriority);
+    LOG_INFO("Stream thread: %s priority, cores 0x%llx%s", threadPriorityName(applied),
+             static_cast<unsigned long long>(currentThreadCores()),
+             pinned ? " (performance cluster)" : "");
+    return applied;
+}
+
+CoreUsage MLProcessor::getCoreUsage() const {
+    CoreUsage usage;
+    usage.cpus = cpuCount();
+    for (int cpu = 0; cpu < usage.cpus; cpu++) {
+        usage.invokes[cpu] = invokeCpus[cpu].load(std::memory_order_relaxed);
+    }
+    usage.performanceCores = performanceCores();
+    usage.pinnedCores = engineConfig.threadPolicy.pinPerformanceCores ? usage.performanceCores
+                                                                       : 0;
+    return usage;
+}
+
+void MLProcessor::resetCoreUsage() {
+    for (std::atomic<int64_t>& count : invokeCpus) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// MEMORY
+// ============================================================================
+
+/**
+ * Memory this processor accounts for.
+ */
+MemoryReport MLProcessor::getMemoryReport() const {
+    MemoryReport report;
+    if (sharedModel) {
+        report.model = sharedModel->memoryUsage();
+    }
+    report.delegate = activeDelegate;
+    report.released = arenasReleased;
+    if (arenasReleased) {
+        report.delegateBytes = 0;
+        report.interpreterBytes = 0;
+        report.arenaBytes = 0;
+    } else if (isInitialized()) {
+        report.delegateBytes = delegateHeapBytes;
+        report.interpreterBytes = interpreterHeapBytes;
+        report.arenaBytes = arenaHeapBytes;
+        report.batchSize = batchSize;
+    }
+    report.processResidentBytes = processResidentBytes();
+    return report;
+}
+
+/**
+ * Release interpreter, arenas and delegate until the next inference call.
+ *
+ * The model, the settings and everything the stream, decisions and events
+ * hold stay; outputSize too, since callers size their score buffers by it.
+ * A stateful model's state lives in the interpreter's tensors, so it is
+ * copied out first and written back by ensureInterpreter. A swap still
+ * waiting for the consumer is adopted first and the engine it replaced is
+ * deleted, so no fully built replacement stays allocated while idle.
+ */
+void MLProcessor::releaseArenas() {
+    // Whichever side takes a retired engine out of retiredSwap deletes it
+    // (see swapModel)
+    delete retiredSwap.exchange(nullptr, std::memory_order_acquire);
+    adoptPendingSwap();
+    delete retiredSwap.exchange(nullptr, std::memory_order_acquire);
+
+    if (arenasReleased || !inputTensor || !outputTensor) {
+        return;
+    }
+
+    savedState.clear();
+    for (const StateTensor& state : stateTensors) {
+        const auto* bytes = static_cast<const uint8_t*>(TfLiteTensorData(state.input));
+        savedState.insert(savedState.end(), bytes, bytes + state.bytes);
+    }
+
+    const int64_t heapBefore = heapBytesInUse();
+    releaseInterpreter();
+    arenasReleased = true;
+
+    const int64_t freed = heapGrowth(heapBytesInUse(), heapBefore);
+    LOG_INFO("Interpreter released while idle (%s, %lld heap bytes freed)",
+             delegateTypeName(activeDelegate), static_cast<long long>(freed));
+}
+
+// ============================================================================
+// MODEL HOT SWAP
+// ============================================================================
+
+/**
+ * Exchange the interpreter-side state with another processor.
+ */
+void MLProcessor::swapEngine(MLProcessor& other) {
+    std::swap(sharedModel, other.sharedModel);
+    std::swap(model, other.model);
+    std::swap(interpreter, other.interpreter);
+    std::swap(options, other.options);
+    std::swap(delegate, other.delegate);
+    std::swap(activeDelegate, other.activeDelegate);
+    std::swap(delegateCache, other.delegateCache);
+    std::swap(numThreads, other.numThreads);
+    std::swap(inputTensor, other.inputTensor);
+    std::swap(outputTensor, other.outputTensor);
+    std::swap(inputType, other.inputType);
+    std::swap(outputType, other.outputType);
+    std::swap(inputQuant, other.inputQuant);
+    std::swap(outputQuant, other.outputQuant);
+    std::swap(dequantized, other.dequantized);
+    std::swap(inputDims, other.inputDims);
+    std::swap(inputRank, other.inputRank);
+    std::swap(outputDims, other.outputDims);
+    std::swap(outputRank, other.outputRank);
+    std::swap(batchSize, other.batchSize);
+    std::swap(channelBatching, other.channelBatching);
+    std::swap(delegateHeapBytes, other.delegateHeapBytes);
+    std::swap(interpreterHeapBytes, other.interpreterHeapBytes);
+    std::swap(arenaHeapBytes, other.arenaHeapBytes);
+    std::swap(arenasReleased, other.arenasReleased);
+    std::swap(stateTensors, other.stateTensors);
+    std::swap(savedState, other.savedState);
+}
+
+/**
+ * Consumer side: adopt a published replacement.
+ *
+ * Only one old model is handed back at a time: while the swapping thread
+ * has not collected the previous one, adoption waits for a later call.
+ */
+void MLProcessor::adoptPendingSwap() {
+    // Hot path: a single load when no swap is pending
+    if (!pendingSwap.load(std::memory_order_relaxed) ||
+        retiredSwap.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // swapModel may supersede the replacement concurrently; whichever side
+    // takes it out of pendingSwap owns it
+    MLProcessor* replacement = pendingSwap.exchange(nullptr, std::memory_order_acquire);
+    if (!replacement) {
+        return;
+    }
+
+    // The replacement now holds the old interpreter; every use of it on
+    // this thread happens before the release store below
+    swapEngine(*replacement);
+    retiredSwap.store(replacement, std::memory_order_release);
+    LOG_INFO("Switched to model %s (%s, %d threads)", sharedModel->description(),
+             delegateTypeName(activeDelegate), numThreads);
+}
+
+/**
+ * Replace the model without stopping classification.
+ *
+ * This method:
+ * 1. Builds and warms up a replacement with the given settings (by default
+ *    this processor's)
+ * 2. Checks it fits (same scores per window, stream batch size, stateful
+ *    or not)
+ * 3. Publishes it, superseding a swap the consumer never adopted
+ * 4. Waits for the consumer to hand the old model back and deletes it
+ */
+bool MLProcessor::swapModel(std::shared_ptr<SharedModel> model, int timeoutMs) {
+    return swapModel(std::move(model), engineConfig, timeoutMs);
+}
+
+bool MLProcessor::swapModel(std::shared_ptr<SharedModel> model,
+                            const MLProcessorConfig& settings, int timeoutMs) {
+    std::lock_guard<std::mutex> lock(swapMutex);
+
+    // outputSize, windowLength and inputRowSize are written by the first
+    // build only: a swap requires them to match and does not exchange them,
+    // and a rebuild after releaseArenas leaves them untouched. So they can
+    // be read here while the consumer runs.
+    if (outputSize <= 0) {
+        LOG_ERROR("Interpreter not initialized");
+        return false;
+    }
+    if (!model) {
+        return false;  // Loading failed and was logged by SharedModel
+    }
+    const std::string source = model->description();
+
+    // ====================================================================
+    // STEP 1: Build the Replacement
+    // ====================================================================
+    // Backend selection, tuning and caches as requested (by default as at
+    // construction), over this processor's front end. Only the live stream
+    // resamples, and the replacement is always warmed up, as its first
+    // invoke would otherwise land on the audio path.
+    MLProcessorConfig config = settings;
+    config.frontEnd = engineConfig.frontEnd;
+    config.frontEnd.inputSampleRate = 0;
+    if (config.warmUpInvokes < 1) {
+        config.warmUpInvokes = 1;
+    }
+    std::unique_ptr<MLProcessor> replacement(new MLProcessor(std::move(model), config));
+    if (!replacement->isInitialized()) {
+        LOG_ERROR("Replacement model %s failed to initialize", source.c_str());
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 2: Check It Fits
+    // ====================================================================
+    // The stream window is sized by windowLength, stream scores and the
+    // event detector by outputSize
+    if (replacement->windowLength != windowLength ||
+        replacement->inputRowSize != inputRowSize) {
+        LOG_ERROR("Replacement model %s takes %d-sample windows, expected %d", source.c_str(),
+                  replacement->windowLength, windowLength);
+        return false;
+    }
+    if (replacement->outputSize != outputSize) {
+        LOG_ERROR("Replacement model %s has %d outputs, expected %d", source.c_str(),
+                  replacement->outputSize, outputSize);
+        return false;
+    }
+
+    // The stream hop, cascade and channel batching depend on it
+    if (replacement->isStateful() != isStateful()) {
+        LOG_ERROR("Replacement model %s is %s, expected %s", source.c_str(),
+                  replacement->isStateful() ? "stateful" : "stateless",
+                  isStateful() ? "stateful" : "stateless");
+        return false;
+    }
+
+    // Allocate (and warm) the stream batch shape here, so the consumer
+    // never resizes tensors after adopting
+    if (streamBatchSize > 1 &&
+        (!replacement->ensureBatchSize(streamBatchSize) || !replacement->warmUp(1))) {
+        LOG_ERROR("Replacement model %s does not run batches of %d", source.c_str(),
+                  streamBatchSize);
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 3: Publish
+    // ====================================================================
+    MLProcessor* published = replacement.release();
+    delete pendingSwap.exchange(published, std::memory_order_acq_rel);
+
+    // ====================================================================
+    // STEP 4: Wait for the Consumer and Delete the Old Model
+    // ====================================================================
+    // An old model left by an earlier swap that timed out may come back
+    // first; it is deleted the same way
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0);
+    for (;;) {
+        MLProcessor* retired = retiredSwap.exchange(nullptr, std::memory_order_acquire);
+        if (retired) {
+            const bool adopted = retired == published;
+            delete retired;
+            if (adopted) {
+                LOG_INFO("Model %s swapped in", source.c_str());
+                return true;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    LOG_INFO("Model %s published, adopted on the next call", source.c_str());
+    return true;
 }
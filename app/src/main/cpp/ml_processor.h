@@ -16,18 +16,157 @@
 #ifndef ML_PROCESSOR_H
 #define ML_PROCESSOR_H
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include "tensorflow/lite/c/c_api.h"
+#include "activity_detector.h"
+#include "audio_kernels.h"
+#include "event_detector.h"
+#include "front_end.h"
+#include "ml_delegates.h"
+#include "ml_model.h"
+#include "ml_stats.h"
+#include "ml_threads.h"
+#include "model_buffer.h"
+#include "ring_buffer.h"
+#include "sliding_window.h"
 
 // ============================================================================
-// MODEL CONSTANTS
+// ML PROCESSOR CONFIGURATION
 // ============================================================================
+/**
+ * Construction-time settings for MLProcessor.
+ *
+ * The defaults reproduce the original behaviour (plain CPU kernels).
+ */
+struct MLProcessorConfig {
+    // Preferred execution backend. When fallback is allowed, the processor
+    // walks delegateFallbackChain() (e.g. GPU -> XNNPACK -> CPU) until a
+    // delegate initializes, survives a warm-up invoke and is not slower
+    // than the plain CPU kernels.
+    DelegateType delegate = DelegateType::Cpu;
+
+    // Fall back down the chain on failure / slowness. When false, a failing
+    // delegate leaves the processor uninitialized.
+    bool allowDelegateFallback = true;
+
+    // Timed invokes per candidate when validating a delegate (after one
+    // untimed warm-up invoke). The fastest run is used for comparison.
+    int delegateBenchmarkRuns = 3;
+
+    // CPU threads for inference (CPU kernels and XNNPACK). 2 is a balance
+    // between speed and power; -1 lets TensorFlow Lite decide.
+    int numThreads = 2;
+
+    // Benchmark 1..maxThreads threads on the loaded model at startup and
+    // keep the fastest. Only applies to CPU-side backends (CPU, XNNPACK).
+    bool autoTuneThreads = false;
+
+    // Upper bound for the sweep; 0 means all online cores (at most 8).
+    int maxThreads = 0;
+
+    // Directory for persistent per-device caches (e.g. the app's filesDir).
+    // When set, the auto-tuned thread count is stored there and reused on
+    // later launches instead of sweeping again. Empty disables caching.
+    std::string cacheDir;
+
+    // Let delegates persist their one-time work in cacheDir: XNNPACK packed
+    // weights, GPU compiled programs and NNAPI compilations, keyed by model
+    // hash and device. Later launches reach steady-state latency at once.
+    bool delegateCache = false;
 
-// INPUT_LEN: Number of audio samples the model expects per inference.
-// The trained TensorFlow Lite model requires exactly 512 samples as input.
-// This is a hard constraint of the model architecture.
-#define MODEL_INPUT_LEN 512
+    // Untimed invokes on a silent input at the end of construction, so the
+    // first real window does not pay one-time costs (lazy kernel
+    // preparation, weight packing, shader compilation). 0 disables.
+    int warmUpInvokes = 0;
+
+    // Resampling of streamed audio and optional log-mel features in front
+    // of the model (see front_end.h). Off by default.
+    FrontEndConfig frontEnd;
+
+    // Core pinning and stream-thread priority (see ml_threads.h). Off by
+    // default: threads run wherever and at whatever priority they start.
+    ThreadPolicy threadPolicy;
+};
+
+// ============================================================================
+// CLASSIFICATION RESULT
+// ============================================================================
+/**
+ * Compact decision returned by MLProcessor::classify / classifyStream.
+ *
+ * rms is always filled. When the audio is below the silence gate no
+ * inference runs (windows == 0). Otherwise score is the best class score
+ * over all classified windows, and classIndex its class - or -1 if the
+ * score does not exceed the confidence threshold.
+ */
+struct ClassificationResult {
+    int classIndex = -1;   // Winning class, -1 if silent / not confident
+    float score = 0.0f;    // Best score (0 if no inference ran)
+    float rms = 0.0f;      // Loudness in [0, 1] (samples scaled by 1/32768)
+    int windows = 0;       // Windows classified for this decision
+};
+
+// ============================================================================
+// CASCADE STATISTICS
+// ============================================================================
+/**
+ * Per-stage counts of the classification cascade (see
+ * MLProcessor::configureCascade), since configuration or the last reset.
+ *
+ * detected / windows is the share of windows the first stage passes on
+ * (compute spent); confident / detected the share of those the model
+ * confirms (first-stage precision).
+ */
+struct CascadeStats {
+    int64_t windows = 0;         // Stream windows reaching the activity detector
+    int64_t detected = 0;        // Accepted by it and classified by the model
+    int64_t confident = 0;       // Of those, best score above the confidence threshold
+    int64_t skippedInvokes = 0;  // Invokes saved (batches without accepted windows)
+};
+
+// ============================================================================
+// MEMORY REPORT
+// ============================================================================
+/**
+ * Memory one processor accounts for (see MLProcessor::getMemoryReport).
+ *
+ * Heap figures are the allocator growth measured around each build step
+ * (see ml_memory.h), -1 where the heap cannot be measured. Memory a GPU or
+ * NNAPI driver keeps outside the process heap is not included.
+ */
+struct MemoryReport {
+    ModelMemory model;                // Model bytes, shared with every processor on it
+    DelegateType delegate = DelegateType::Cpu;
+    int64_t delegateBytes = -1;       // Creating the delegate
+    int64_t interpreterBytes = -1;    // Interpreter and delegate graph preparation
+    int64_t arenaBytes = -1;          // Tensor arena at the current batch size
+    int batchSize = 0;                // Batch the arena is allocated for
+    bool released = false;            // Arenas released (three figures above are 0)
+    int64_t processResidentBytes = -1;  // RSS of the whole process
+};
+
+// ============================================================================
+// CORE USAGE
+// ============================================================================
+/**
+ * Where a processor's invokes ran (see MLProcessor::getCoreUsage), since
+ * construction or the last reset.
+ *
+ * Each invoke is counted on the CPU its calling thread finished it on;
+ * TensorFlow Lite's own worker threads follow the calling thread's
+ * affinity (see ml_threads.h) but are not sampled individually.
+ */
+struct CoreUsage {
+    int cpus = 0;                    // Entries of invokes (CPUs on the device)
+    int64_t invokes[kMaxCpus] = {};  // Invokes finished on each CPU
+    uint64_t performanceCores = 0;   // Mask of the performance cluster
+    uint64_t pinnedCores = 0;        // Mask inference is pinned to, 0 if not pinned
+};
 
 // ============================================================================
 // ML PROCESSOR CLASS: TensorFlow Lite Wrapper
@@ -52,8 +191,12 @@ class MLProcessor {
 // PRIVATE MEMBER VARIABLES
 // ========================================================================
 private:
+    // Loaded model, possibly shared with other processors (see ml_model.h).
+    // Holding the reference keeps the weights alive for this interpreter.
+    std::shared_ptr<SharedModel> sharedModel;
+
     // TfLiteModel: Represents the loaded neural network model structure.
-    // Loaded from the .tflite file and used to create interpreters.
+    // Owned by sharedModel and used to create interpreters.
     TfLiteModel* model;
     
     // TfLiteInterpreter: Executes inference by running the loaded model
@@ -64,6 +207,356 @@ private:
     // Specifies number of threads, delegate options, etc.
     TfLiteInterpreterOptions* options;
 
+    // TfLiteDelegate: Hardware delegate the interpreter runs on (nullptr for
+    // plain CPU kernels). Owned here; must outlive the interpreter.
+    TfLiteDelegate* delegate;
+    DelegateType activeDelegate;
+
+    // Persistent delegate caches (null unless configured). Delegates
+    // reference its strings, so it is kept on the heap: a model swap moves
+    // the pointer together with the delegate, never the strings.
+    std::unique_ptr<DelegateCache> delegateCache;
+
+    // Thread count the interpreter was built with
+    int numThreads;
+
+    // Cached input/output tensors. They are looked up once in the
+    // constructor so the inference path does not query the interpreter
+    // (or allocate anything) on every call.
+    TfLiteTensor* inputTensor;
+    const TfLiteTensor* outputTensor;
+
+    // Number of float values produced by the output tensor (e.g. one
+    // confidence score per class). Computed once after tensor allocation.
+    int outputSize;
+
+    // Element types and quantization of the input/output tensors. Float32
+    // models use the float path; full-integer models (int8 / uint8) are
+    // quantized straight from int16 and dequantized on output.
+    TfLiteType inputType;
+    TfLiteType outputType;
+    TfLiteQuantizationParams inputQuant;
+    TfLiteQuantizationParams outputQuant;
+
+    // Dequantized scores for quantized outputs (batchSize * outputSize),
+    // resized together with the batch
+    std::vector<float> dequantized;
+
+    // Per-stage latency histograms (see ml_stats.h). Mutable so const
+    // methods on the hot path can be timed too.
+    mutable StageStats stats;
+
+    // Invokes per CPU they finished on (see getCoreUsage); read from any
+    // thread
+    std::atomic<int64_t> invokeCpus[kMaxCpus]{};
+
+    // Shapes of the input and output tensors as loaded from the model.
+    // Dimension 0 is the batch dimension; processAudioBatch resizes the
+    // input's to N windows.
+    static const int kMaxTensorDims = 8;
+    int inputDims[kMaxTensorDims];
+    int inputRank;
+    int outputDims[kMaxTensorDims];
+    int outputRank;
+
+    // Current batch dimension of the input tensor. The interpreter is only
+    // resized (and its tensors reallocated) when a call needs a different N.
+    int batchSize;
+
+    // Heap growth of building the delegate, the interpreter and its tensor
+    // arena (see MemoryReport), measured in createInterpreter and
+    // ensureBatchSize
+    int64_t delegateHeapBytes;
+    int64_t interpreterHeapBytes;
+    int64_t arenaHeapBytes;
+
+    // Set by releaseArenas: interpreter and delegate are deleted and built
+    // again by the next inference call (see ensureInterpreter)
+    bool arenasReleased;
+
+    // Stateful streaming models (see isStateful): every input after the
+    // first is a state tensor `<key>_in`, paired with the output `<key>_out`.
+    // After each invoke the output is copied into the input, so the next
+    // step starts from it. fill is the byte of an all-zero state (the
+    // zero point of a quantized one).
+    struct StateTensor {
+        TfLiteTensor* input;
+        const TfLiteTensor* output;
+        size_t bytes;
+        uint8_t fill;
+    };
+    std::vector<StateTensor> stateTensors;
+
+    // State of every stateTensors entry, back to back, while releaseArenas
+    // has the interpreter deleted (restored by ensureInterpreter)
+    std::vector<uint8_t> savedState;
+
+    // Whether the model has state tensors. Set once at construction and
+    // kept across releases and swaps (a swap needs the same kind of
+    // model), so swapModel can read it while the consumer runs.
+    bool stateful;
+
+    // Streaming state (see configureStream). The ring buffer is the only
+    // structure shared between the producer and the consumer thread; the
+    // sliding window and the transfer chunk belong to the consumer.
+    SpscRingBuffer<int16_t> streamBuffer;
+    SlidingWindow streamWindow;
+    std::vector<int16_t> streamChunk;
+
+    // Windows per invoke on the streaming path (see configureStream)
+    int streamBatchSize;
+
+    // Hop given to configureStream (the narrowest setStreamHopSize accepts,
+    // so the score storage always covers one call), and a hop change
+    // waiting for the consumer (0 if none)
+    int streamConfiguredHop;
+    std::atomic<int> pendingHop{0};
+
+    // Scores / window starts filled by classifyStream, sized for the most
+    // windows one call can produce (allocated in configureStream)
+    std::vector<float> streamScores;
+    std::vector<int64_t> streamStarts;
+
+    // Decision thresholds (see setDecisionThresholds)
+    float minRms;
+    float minScore;
+
+    // Class events over the decision API's windows (see configureEvents).
+    // streamClock counts the stream samples before the current window
+    // history (reset / gated-out audio), so event times keep increasing
+    // across silent gaps.
+    EventDetector eventDetector;
+    int64_t streamClock;
+
+    // Cascade (see configureCascade): first-stage detector and the batch
+    // row -> window mapping of accepted windows. The counters are read by
+    // getCascadeStats from any thread.
+    ActivityDetector activityDetector;
+    std::vector<int> cascadeRows;
+    std::atomic<int64_t> cascadeWindows{0};
+    std::atomic<int64_t> cascadeDetected{0};
+    std::atomic<int64_t> cascadeConfident{0};
+    std::atomic<int64_t> cascadeSkipped{0};
+
+    // Front-end settings and the values one window occupies in the input
+    // tensor (one batch row): the window's samples, or its log-mel features
+    FrontEndConfig frontEnd;
+    int inputRowSize;
+
+    // Samples per window, read from the input tensor at load time, and the
+    // per-window kernels selected for that length (see audio_kernels.h)
+    int windowLength;
+    PeakKernel peakWindow;
+    ConvertKernel convertWindow;
+
+    // Producer side: converts pushed audio to the model rate in blocks of
+    // kResampleBlock samples through resampleBlock (see setStreamInputRate)
+    static const int kResampleBlock = 256;
+    PolyphaseResampler streamResampler;
+    std::vector<int16_t> resampleBlock;
+
+    // Consumer side: log-mel stage, plus a zero-padded copy for windows
+    // shorter than windowLength
+    MelFrontEnd melFrontEnd;
+    std::vector<int16_t> melPadding;
+
+    // Multi-channel input (see classifyChannels): one deinterleaved window
+    // per channel, channel-major, grown when the channel count rises.
+    // Cleared once the model rejects a batch of channels, which then run
+    // one invoke each.
+    std::vector<int16_t> channelWindows;
+    bool channelBatching;
+
+    // Model hot swap (see swapModel). Replacements are built with the
+    // settings this processor was built with. A replacement is a complete
+    // processor handed to the consumer through pendingSwap; the consumer
+    // exchanges interpreters with it between two calls and hands it back,
+    // now holding the old interpreter, through retiredSwap, for the
+    // swapping thread to delete. swapMutex serializes swapModel calls.
+    MLProcessorConfig engineConfig;
+    std::atomic<MLProcessor*> pendingSwap{nullptr};
+    std::atomic<MLProcessor*> retiredSwap{nullptr};
+    std::mutex swapMutex;
+
+    /**
+     * Reduce rows of scores to a decision: argmax over every value, then
+     * the confidence threshold.
+     *
+     * @param scores rows * outputSize scores
+     * @param rows Number of windows
+     * @param rms Loudness to report
+     */
+    ClassificationResult decide(const float* scores, int rows, float rms) const;
+
+    /**
+     * Create options, delegate and interpreter for one backend, allocate the
+     * tensors and cache the tensor handles and shapes.
+     *
+     * @param type Backend to build
+     * @param threads CPU threads for the interpreter and delegate
+     * @return true if the interpreter is ready (otherwise call
+     *         destroyInterpreter before trying another backend)
+     */
+    bool createInterpreter(DelegateType type, int threads);
+
+    /**
+     * Release interpreter, delegate and options, and clear cached tensors.
+     */
+    void destroyInterpreter();
+
+    /**
+     * destroyInterpreter without resetting outputSize, for releasing and
+     * rebuilding the same model while swapModel may read it on another
+     * thread.
+     */
+    void releaseInterpreter();
+
+    /**
+     * Pick the backend: try each delegate of the fallback chain, keep the
+     * first that works and is not slower than the CPU kernels.
+     *
+     * @param config Construction settings
+     * @return true if an interpreter was created
+     */
+    bool selectDelegate(const MLProcessorConfig& config);
+
+    /**
+     * Auto-tune the thread count for the selected backend: reuse a cached
+     * decision for this device and model, or sweep 1..maxThreads, keep the
+     * fastest and cache it.
+     *
+     * @param config Construction settings
+     * @return true if an interpreter is ready afterwards
+     */
+    bool tuneThreads(const MLProcessorConfig& config);
+
+    /**
+     * Run `invokes` untimed invokes of the final interpreter on a silent
+     * input, so one-time costs are paid during construction.
+     *
+     * @param invokes Number of invokes (at least 1)
+     * @return false if an invoke failed
+     */
+    bool warmUp(int invokes);
+
+    /**
+     * Fill the input tensor and run the interpreter.
+     *
+     * Converts and normalizes the samples straight into the input
+     * tensor's own buffer (no intermediate scratch buffer), then invokes
+     * the interpreter. Performs no heap allocation.
+     *
+     * @param audioData Raw audio samples (int16, int32 or float PCM)
+     * @param length Number of samples in audioData
+     * @param peak Peak amplitude of the samples if already known, or -1
+     *             to compute it here
+     * @return true if inference succeeded
+     */
+    template <typename Sample>
+    bool runInference(const Sample* audioData, int length, float peak = -1.0f);
+
+    /**
+     * Resize the input tensor's batch dimension to `windows`.
+     *
+     * No-op when the batch size is already `windows`; otherwise resizes the
+     * input, reallocates the tensors and refreshes the cached handles.
+     *
+     * @param windows Number of windows per invoke
+     * @return true if the interpreter now runs `windows` windows per invoke
+     */
+    bool ensureBatchSize(int windows);
+
+    /**
+     * Check the interpreter is ready, rebuilding it first if releaseArenas
+     * deleted it.
+     *
+     * @return false (logged) if there is no interpreter and none can be
+     *         built
+     */
+    bool ensureInterpreter();
+
+    /**
+     * Pair the state inputs of a stateful model with their outputs (see
+     * stateTensors) by name and zero them. Models with a single input have
+     * none.
+     *
+     * @return false if an extra input is not named `<key>_in`, or has no
+     *         single `<key>_out` output of the same type, size and
+     *         quantization
+     */
+    bool bindStateTensors();
+
+    /**
+     * Zero every state tensor (and drop a state releaseArenas saved), so
+     * the next step starts a new stream.
+     */
+    void resetState();
+
+    /**
+     * Peak-normalize one window into row `row` of the input tensor, in the
+     * tensor's element type (float32, or int8 / uint8 quantized in the same
+     * pass), or write its log-mel features when the mel front end is on.
+     * Samples beyond `count` are zero-padded. Stateful models are scaled by
+     * the sample format's full scale instead, as a step is only part of
+     * what the model sees.
+     *
+     * @param row Batch row (0..batchSize-1)
+     * @param samples Raw audio samples (int16, int32 or float PCM; the
+     *                log-mel front end takes int16 only)
+     * @param count Number of samples (at most windowLength)
+     * @param peak Peak amplitude of the samples (0 for silence)
+     * @return false if the input tensor has no buffer or the format is
+     *         not supported
+     */
+    template <typename Sample>
+    bool writeInputWindow(int row, const Sample* samples, int count, float peak);
+
+    /**
+     * Scores of the last invoke as floats: the output tensor itself for
+     * float32 models, otherwise `rows` rows dequantized into `dequantized`.
+     *
+     * @param rows Number of batch rows to return
+     * @return rows * outputSize scores, or nullptr if unavailable
+     */
+    const float* outputScores(int rows);
+
+    /**
+     * Body of processStream, shared with classifyStream (which times the
+     * whole call itself).
+     */
+    int runStream(float* scores, int64_t* windowStarts, int maxWindows);
+
+    /**
+     * Classify every buffered stream window and reduce them to a decision
+     * (body of classifyPending, shared with classifyStream).
+     */
+    ClassificationResult reducePending(float rms);
+
+    /**
+     * Run the interpreter on the current contents of the input tensor and
+     * carry the state of a stateful model over to the next invoke.
+     * @return true if inference succeeded
+     */
+    bool invokeInterpreter();
+
+    /**
+     * Exchange everything that belongs to the interpreter (model, options,
+     * delegate, tensor handles, types and shapes) with `other`. Stream,
+     * decision, event and cascade state stay where they are, and so do
+     * outputSize, windowLength and inputRowSize, which swapModel requires
+     * to match and reads on another thread.
+     */
+    void swapEngine(MLProcessor& other);
+
+    /**
+     * Consumer side: adopt the replacement published by swapModel, if any.
+     *
+     * Called at the start of every inference entry point, so each call runs
+     * on one interpreter from start to end. Lock-free and allocation-free:
+     * a few pointer exchanges, the old interpreter is deleted elsewhere.
+     */
+    void adoptPendingSwap();
+
 // ========================================================================
 // PUBLIC METHODS
 // ========================================================================
@@ -74,13 +567,47 @@ public:
      * This constructor:
      * 1. Loads the .tflite model from the given file path
      * 2. Creates interpreter options (e.g., thread configuration)
-     * 3. Creates a TensorFlow Lite interpreter from the model
-     * 4. Allocates memory for input/output tensors
-     * 5. Logs status messages
+     * 3. Creates the requested delegate, falling back if it fails
+     * 4. Creates a TensorFlow Lite interpreter from the model
+     * 5. Allocates memory for input/output tensors
+     * 6. Logs status messages
      * 
      * @param modelPath Absolute path to the .tflite model file on disk
+     * @param config Delegate and runtime settings (defaults: CPU kernels)
      */
-    MLProcessor(const char* modelPath);
+    MLProcessor(const char* modelPath,
+                const MLProcessorConfig& config = MLProcessorConfig());
+
+    /**
+     * Constructor: Initialize the ML processor over model bytes in memory.
+     *
+     * The model is built with TfLiteModelCreate directly over the buffer
+     * (no copy), so a model mmapped from the APK never touches filesDir.
+     * The processor takes ownership of the buffer and keeps it alive for
+     * as long as the model exists.
+     *
+     * @param buffer Mapped model (see ModelBuffer::mapFile / openAsset)
+     * @param config Delegate and runtime settings (defaults: CPU kernels)
+     */
+    explicit MLProcessor(ModelBuffer&& buffer,
+                         const MLProcessorConfig& config = MLProcessorConfig());
+
+    /**
+     * Constructor: Initialize the ML processor on an already loaded model.
+     *
+     * Only an interpreter (plus delegate) is created; the weights stay in
+     * the shared model, so several processors - e.g. one per audio stream
+     * or worker thread - cost one copy of the model. The processor keeps
+     * its own reference, so the model lives until the last one is deleted.
+     *
+     * @param sharedModel Model from SharedModel::fromFile / fromBuffer
+     * @param config Delegate and runtime settings (defaults: CPU kernels)
+     */
+    explicit MLProcessor(std::shared_ptr<SharedModel> sharedModel,
+                         const MLProcessorConfig& config = MLProcessorConfig());
+
+    MLProcessor(const MLProcessor&) = delete;
+    MLProcessor& operator=(const MLProcessor&) = delete;
 
     /**
      * Destructor: Clean up all allocated resources.
@@ -90,13 +617,597 @@ public:
      */
     ~MLProcessor();
 
+    // ====================================================================
+    // ONE-SHOT INFERENCE
+    // ====================================================================
+    // processAudio*, and classify below, are templates over the source
+    // sample type, instantiated in ml_processor.cpp for:
+    // - int16_t: 16-bit PCM (ENCODING_PCM_16BIT)
+    // - int32_t: 32-bit PCM (ENCODING_PCM_32BIT, or 24-bit audio in 32-bit
+    //   containers)
+    // - float:   float PCM (ENCODING_PCM_FLOAT, full scale 1.0)
+    // Every format is peak-normalized straight into the input tensor's
+    // type in one pass (SampleKernels in audio_kernels.h), so captures in
+    // another format need no conversion to int16 first. The log-mel front
+    // end, batches and the stream take 16-bit PCM only.
+
     /**
      * Process audio samples - fully portable implementation
-     * @param audioData Raw audio samples (16-bit PCM)
+     * @param audioData Raw audio samples (int16, int32 or float PCM)
      * @param length Number of samples
      * @return Vector of output predictions
      */
-    std::vector<float> processAudio(const int16_t* audioData, int length);
+    template <typename Sample>
+    std::vector<float> processAudio(const Sample* audioData, int length);
+
+    /**
+     * Process audio samples into a caller-provided buffer (zero-allocation).
+     *
+     * Same computation as processAudio, but the predictions are copied into
+     * `output` instead of a freshly allocated vector. Intended for the
+     * steady-state audio path where heap churn causes jitter.
+     *
+     * @param audioData Raw audio samples (int16, int32 or float PCM)
+     * @param length Number of samples
+     * @param output Destination buffer for the predictions
+     * @param outputCapacity Number of floats available in output
+     * @return Number of predictions written, or -1 on failure
+     */
+    template <typename Sample>
+    int processAudioInto(const Sample* audioData, int length,
+                         float* output, int outputCapacity);
+
+    /**
+     * Process audio samples and return a view over the output tensor.
+     *
+     * No copy and no allocation: the returned pointer refers to the
+     * interpreter's output buffer and stays valid only until the next
+     * inference call on this processor (or its destruction).
+     *
+     * @param audioData Raw audio samples (int16, int32 or float PCM)
+     * @param length Number of samples
+     * @param outputLength Receives the number of predictions (may be null)
+     * @return Pointer to the predictions, or nullptr on failure
+     */
+    template <typename Sample>
+    const float* processAudioView(const Sample* audioData, int length,
+                                  int* outputLength);
+
+    /**
+     * true if the model loaded and an interpreter is ready for inference
+     * (or released by releaseArenas, to be built on the next call).
+     */
+    bool isInitialized() const { return (inputTensor && outputTensor) || arenasReleased; }
+
+    /**
+     * Backend the interpreter actually runs on, after fallback.
+     *
+     * This and the other model getters below describe the model the
+     * consumer runs; after swapModel, read them on the consumer thread or
+     * once isSwapPending() is false.
+     */
+    DelegateType getActiveDelegate() const { return activeDelegate; }
+
+    /**
+     * Thread count the interpreter runs with (after auto-tuning).
+     */
+    int getNumThreads() const { return numThreads; }
+
+    /**
+     * Model this processor runs, for creating more processors over it.
+     */
+    const std::shared_ptr<SharedModel>& getModel() const { return sharedModel; }
+
+    /**
+     * Front-end settings the processor was built with.
+     */
+    const FrontEndConfig& getFrontEnd() const { return frontEnd; }
+
+    /**
+     * Sample rate the model expects (0 if not configured). One-shot calls
+     * (processAudio*, classify) take audio at this rate; only the stream
+     * resamples.
+     */
+    int getModelSampleRate() const { return frontEnd.modelSampleRate; }
+
+    /**
+     * Number of predictions produced per inference (0 if not initialized).
+     */
+    int getOutputSize() const { return outputSize; }
+
+    /**
+     * Samples per window (0 if not initialized), read from the model's
+     * input tensor at load time: its values per batch row, or the window
+     * whose log-mel features fill a row. One-shot calls classify the first
+     * getWindowLength() samples; batches and the stream use windows of
+     * exactly this length. For a stateful model this is the step: the new
+     * samples each invoke takes.
+     */
+    int getWindowLength() const { return windowLength; }
+
+    /**
+     * True if the model is a stateful streaming variant: input 0 takes
+     * the newest getWindowLength() samples and every further input is
+     * state (e.g. the convolution activations the previous steps already
+     * computed) that the model returns, updated. State inputs are named
+     * `<key>_in` and fed from the output named `<key>_out` (a ":N" suffix
+     * is ignored); a model whose extra inputs do not pair up this way is
+     * rejected at load time.
+     *
+     * The state stays in the interpreter's tensors between invokes, so
+     * each step only computes what the new samples change. Every inference
+     * call is one step of a single stream: batches and the stream run one
+     * step per invoke, the stream hop is the step, resetStream zeroes the
+     * state, and neither the cascade nor batched channels are available.
+     */
+    bool isStateful() const { return stateful; }
+
+    /**
+     * Shape of the input / output tensor as loaded (batch dimension 1).
+     *
+     * @param dims Receives up to maxDims dimensions, outermost first
+     * @param maxDims Capacity of dims
+     * @return Rank of the tensor (0 if not initialized)
+     */
+    int getInputShape(int* dims, int maxDims) const;
+    int getOutputShape(int* dims, int maxDims) const;
+
+    /**
+     * True if the model takes quantized (int8 / uint8) input.
+     */
+    bool isQuantized() const { return inputType == kTfLiteInt8 || inputType == kTfLiteUInt8; }
+
+    /**
+     * Per-stage latency histograms of this processor.
+     *
+     * Recorded lock-free on the inference thread; snapshots may be taken
+     * from any thread. Also used by the JNI layer for its own stage.
+     */
+    StageStats& getStats() const { return stats; }
+
+    /**
+     * Process several windows in a single interpreter invoke.
+     *
+     * `audioData` holds numWindows consecutive windows of
+     * getWindowLength() samples. Each window is normalized independently
+     * (exactly as processAudio would), all of them are written into one
+     * input tensor of batch size numWindows, and the interpreter runs once.
+     *
+     * The tensors are only reallocated when numWindows differs from the
+     * previous call, so repeated calls with the same N do not allocate.
+     *
+     * @param audioData numWindows * getWindowLength() samples (16-bit PCM)
+     * @param numWindows Number of windows (N)
+     * @param output Destination buffer, N x getOutputSize() floats (row-major)
+     * @param outputCapacity Number of floats available in output
+     * @return Number of floats written (N * getOutputSize()), or -1 on failure
+     */
+    int processAudioBatchInto(const int16_t* audioData, int numWindows,
+                              float* output, int outputCapacity);
+
+    /**
+     * Process several windows in a single interpreter invoke.
+     *
+     * Allocating convenience wrapper over processAudioBatchInto.
+     *
+     * @param audioData numWindows * getWindowLength() samples (16-bit PCM)
+     * @param numWindows Number of windows (N)
+     * @return N x getOutputSize() predictions (row-major), empty on failure
+     */
+    std::vector<float> processAudioBatch(const int16_t* audioData, int numWindows);
+
+    // ====================================================================
+    // STREAMING API
+    // ====================================================================
+    // Continuous classification over overlapping getWindowLength() windows.
+    // A capture thread pushes samples with pushAudio() while an inference
+    // thread calls processStream(); the two sides only share a lock-free
+    // single-producer/single-consumer ring buffer.
+
+    /**
+     * Configure (or reconfigure) the streaming classifier.
+     *
+     * Allocates the ring buffer and window storage. Must not be called
+     * while another thread is inside pushAudio() or processStream().
+     *
+     * @param hopSize Samples between window starts (1..getWindowLength());
+     *                getWindowLength() means no overlap. Stateful models
+     *                always step by getWindowLength() (see isStateful)
+     * @param bufferCapacity Samples the ring buffer can hold between two
+     *                       processStream() calls
+     * @param batchSize Windows classified per interpreter invoke. With
+     *                  N > 1, processStream only runs full batches of N
+     *                  (leftover windows wait for more audio), so the
+     *                  input tensor keeps a fixed shape and is never
+     *                  reallocated on the hot path. Falls back to 1 if the
+     *                  model cannot be resized.
+     * @return false if the configuration is invalid
+     */
+    bool configureStream(int hopSize, int bufferCapacity, int batchSize = 1);
+
+    /**
+     * Set the rate of the audio given to pushAudio().
+     *
+     * Pushed audio is resampled to the model rate (FrontEndConfig::
+     * modelSampleRate, which must be set) before it enters the ring
+     * buffer; passing the model rate turns resampling off. Allocates the
+     * filter bank, so it must not be called while another thread is inside
+     * pushAudio().
+     *
+     * @param sampleRate Capture rate of the pushed audio
+     * @return false if the model rate is unknown or the ratio unsupported
+     */
+    bool setStreamInputRate(int sampleRate);
+
+    /**
+     * Producer side: append captured samples to the stream.
+     *
+     * Lock-free and allocation-free; safe to call from an audio thread.
+     * Samples are converted to the model rate first if an input rate was
+     * set (setStreamInputRate).
+     *
+     * @param samples Raw audio samples (16-bit PCM, at the input rate)
+     * @param count Number of samples
+     * @return Number of samples accepted (less than count if the ring
+     *         buffer is full; the remainder is dropped)
+     */
+    int pushAudio(const int16_t* samples, int count);
+
+    /**
+     * Consumer side: classify every complete window available so far.
+     *
+     * Each window's predictions are written as one row of getOutputSize()
+     * floats. Windows left over when maxWindows is reached (or that do not
+     * fill a whole batch) stay queued for the next call.
+     *
+     * @param scores Output matrix, maxWindows x getOutputSize() floats
+     * @param windowStarts Receives the absolute sample index of each
+     *                     window's first sample (may be null)
+     * @param maxWindows Number of rows available in scores
+     * @return Number of windows classified, or -1 on failure
+     */
+    int processStream(float* scores, int64_t* windowStarts, int maxWindows);
+
+    /**
+     * Consumer side: drop queued samples and start over with the next
+     * pushed sample (e.g. after a silent gap). Ends the active event class.
+     */
+    void resetStream();
+
+    /**
+     * Consumer side: account for audio the producer gated out instead of
+     * pushing, so event timestamps stay on the capture clock.
+     *
+     * @param inputSamples Samples skipped, at the stream input rate
+     */
+    void skipStream(int64_t inputSamples);
+
+    /**
+     * Change the hop of a running stream (e.g. to classify fewer windows
+     * under load, see InferenceScheduler).
+     *
+     * Any thread: the consumer switches at the start of its next call,
+     * keeping the queued samples and the window history.
+     *
+     * @param hopSize Samples between window starts, from the hop given to
+     *                configureStream up to getWindowLength(); a batch of
+     *                windows must still fit the stream buffer
+     * @return false if the stream is not configured or the hop is invalid
+     */
+    bool setStreamHopSize(int hopSize);
+
+    /**
+     * Hop size of the stream (0 if not configured). Consumer side after
+     * setStreamHopSize.
+     */
+    int getStreamHopSize() const { return streamWindow.getHopSize(); }
+
+    // ====================================================================
+    // DECISION API
+    // ====================================================================
+
+    /**
+     * Set the thresholds used by classify() and classifyStream().
+     *
+     * Both comparisons are strict: audio is classified only if its RMS is
+     * above minRms, and a class is reported only if its score is above
+     * minScore. The defaults (0, 0) skip only all-zero audio.
+     *
+     * @param silenceRms RMS gate in [0, 1] (samples scaled to full scale 1.0)
+     * @param confidence Minimum score of a reported class
+     */
+    void setDecisionThresholds(float silenceRms, float confidence);
+
+    /**
+     * Silence gate set by setDecisionThresholds().
+     */
+    float getMinRms() const { return minRms; }
+
+    /**
+     * Classify one window and reduce the scores to a single decision.
+     *
+     * Peak and energy come from one fused pass over the samples; silent
+     * windows return right after it, skipping inference entirely. Loud
+     * windows are normalized with the same peak (no second scan), run
+     * through the model and reduced to argmax + threshold natively.
+     *
+     * The RMS gate measures against each format's full scale (32768 for
+     * int16, 2^31 for int32, 1.0 for float).
+     *
+     * @param audioData Raw audio samples (int16, int32 or float PCM, first
+     *                  getWindowLength() used)
+     * @param length Number of samples
+     * @return Decision; windows == -1 if inference failed
+     */
+    template <typename Sample>
+    ClassificationResult classify(const Sample* audioData, int length);
+
+    /**
+     * Gate a captured block, stream it and reduce all completed windows to
+     * a single decision (the stream must be configured).
+     *
+     * This method:
+     * 1. Computes the RMS of the block (silent blocks reset the stream so
+     *    no window straddles the gap, and return with windows == 0)
+     * 2. Pushes the block and classifies every window it completes
+     * 3. Returns the best class over those windows, thresholded
+     *
+     * Allocation-free: the score storage is sized in configureStream.
+     *
+     * @param samples Raw audio samples (16-bit PCM)
+     * @param count Number of samples
+     * @return Decision; windows == -1 if inference failed
+     */
+    ClassificationResult classifyStream(const int16_t* samples, int count);
+
+    /**
+     * Consumer side: classify every complete window pushed so far and
+     * reduce them to a single decision.
+     *
+     * For producers that push (and gate) on their own, e.g. an audio
+     * callback writing with pushAudio() while this runs on a worker thread
+     * (see AudioCapture). No silence gate is applied here.
+     *
+     * @param rms Loudness to report with the decision
+     * @return Decision; windows == 0 if no window is complete yet, -1 if
+     *         inference failed
+     */
+    ClassificationResult classifyPending(float rms);
+
+    // ====================================================================
+    // MULTI-CHANNEL API
+    // ====================================================================
+    // Stereo and microphone-array captures: interleaved 16-bit frames are
+    // split into one window per channel in a single pass (see
+    // deinterleaveInt16), and every channel is classified by the same
+    // batched invoke, one batch row per channel.
+
+    // Most channels one classifyChannels call accepts
+    static const int kMaxChannels = 32;
+
+    /**
+     * Classify the first window of every channel of interleaved PCM.
+     *
+     * Each channel gets its own decision, with the same silence gate and
+     * confidence threshold as classify(). Silent channels are not
+     * classified, and when every channel is silent no inference runs.
+     * Models with a fixed batch dimension fall back to one invoke per
+     * loud channel. Stateful models take one channel only.
+     *
+     * The input tensor is resized to `channels` rows (reallocated only when
+     * the channel count changes), so alternating with other batch sizes on
+     * the same processor reallocates on every switch. With a constant
+     * channel count, calls do not allocate.
+     *
+     * @param interleaved Frames of `channels` interleaved samples (16-bit
+     *                    PCM; the first getWindowLength() frames are used,
+     *                    fewer are zero-padded)
+     * @param frames Number of frames in interleaved
+     * @param channels Samples per frame (1..kMaxChannels)
+     * @param results Receives one decision per channel (`channels` entries)
+     * @return Channel with the highest reported score, or -1 if no channel
+     *         reported a class (on failure every results[c].windows is -1)
+     */
+    int classifyChannels(const int16_t* interleaved, int frames, int channels,
+                         ClassificationResult* results);
+
+    // ====================================================================
+    // EVENT API
+    // ====================================================================
+    // Class changes instead of per-block decisions: every window classified
+    // by classifyStream / classifyPending also feeds a smoothing and
+    // hysteresis stage (see event_detector.h), which queues an event when
+    // a class starts or ends. Timestamps are stream sample positions at the
+    // model rate, counted from the first pushed sample. All calls are
+    // consumer side.
+
+    /**
+     * Enable (or reconfigure) event detection. Needs an initialized model.
+     *
+     * @param smoothingWindows Window posteriors averaged (1 = none)
+     * @param onThreshold Smoothed score a class must exceed to start
+     * @param offThreshold Smoothed score below which it ends
+     * @return false if the parameters are invalid
+     */
+    bool configureEvents(int smoothingWindows, float onThreshold, float offThreshold);
+
+    /** true once configureEvents() succeeded. */
+    bool hasEvents() const { return eventDetector.isConfigured(); }
+
+    /**
+     * Collect queued events, oldest first.
+     *
+     * @param events Destination
+     * @param maxEvents Capacity of events
+     * @return Number of events written (the rest stay queued)
+     */
+    int popEvents(ClassEvent* events, int maxEvents);
+
+    /**
+     * Class currently on according to the event stage, -1 if none.
+     */
+    int getActiveClass() const { return eventDetector.getActiveClass(); }
+
+    // ====================================================================
+    // CASCADE API
+    // ====================================================================
+    // A cheap activity detector (adaptive energy + zero-crossing rate, see
+    // activity_detector.h) screens every stream window; only accepted
+    // windows are invoked. Rejected windows get all-zero scores (no class),
+    // so processStream rows, decisions and events stay aligned with the
+    // stream. One-shot calls (processAudio, classify) are not screened.
+
+    /**
+     * Enable (or reconfigure) the cascade; consumer side.
+     *
+     * @param snrDb Energy above the tracked noise floor a window needs
+     * @param minCrossingRate Lowest zero crossings per sample accepted
+     * @param maxCrossingRate Highest zero crossings per sample accepted
+     *                        (white noise is about 0.5)
+     * @param hangoverWindows Windows still classified after a detection
+     * @return false if the parameters are invalid, or the model is
+     *         stateful (a skipped step would leave its state behind)
+     */
+    bool configureCascade(float snrDb, float minCrossingRate, float maxCrossingRate,
+                          int hangoverWindows);
+
+    /** true once configureCascade() succeeded. */
+    bool hasCascade() const { return activityDetector.isConfigured(); }
+
+    /**
+     * Snapshot the per-stage counts. Safe to call from any thread.
+     */
+    CascadeStats getCascadeStats() const;
+
+    /** Clear the per-stage counts. Safe to call from any thread. */
+    void resetCascadeStats();
+
+    // ====================================================================
+    // THREAD PLACEMENT API
+    // ====================================================================
+    // Keeps real-time inference on the performance cluster at audio
+    // priority, per the config's threadPolicy. The processor pins its own
+    // construction (and so the worker threads TensorFlow Lite starts
+    // there); the threads that drive the stream call prepareStreamThread.
+
+    /**
+     * Apply the thread policy to the calling thread: pin it to the
+     * performance cluster (if pinPerformanceCores) and raise it to
+     * streamPriority. Worker threads TensorFlow Lite starts later from it
+     * inherit the pinning. Call once at the start of a capture or
+     * inference thread (AudioCapture and AsyncClassifier do).
+     *
+     * @return Priority actually applied
+     */
+    ThreadPriority prepareStreamThread() const;
+
+    /**
+     * Snapshot where the invokes ran. Safe to call from any thread.
+     */
+    CoreUsage getCoreUsage() const;
+
+    /** Restart the per-CPU invoke counts. */
+    void resetCoreUsage();
+
+    // ====================================================================
+    // MEMORY API
+    // ====================================================================
+    // What the model, the interpreter and its delegate cost, and a way to
+    // give the inference memory back while the processor is idle. Consumer
+    // side, like the stream.
+
+    /**
+     * Memory this processor accounts for, plus the process RSS.
+     */
+    MemoryReport getMemoryReport() const;
+
+    /**
+     * Release the interpreter's memory while idle (e.g. when recording
+     * stops): interpreter, tensor arenas and delegate are deleted, the
+     * model, settings and stream state are kept. A stateful model's state
+     * is saved and written back on the rebuild, so the stream continues
+     * where it stopped (resetStream starts it over).
+     *
+     * The next inference call builds them again with the same backend and
+     * thread count, so it pays the interpreter setup (and, for GPU / NNAPI,
+     * the delegate compilation unless delegateCache is set). A hot swap
+     * still waiting for the consumer is adopted first, and the engine it
+     * replaces deleted. Otherwise a no-op if already released.
+     */
+    void releaseArenas();
+
+    /** true between releaseArenas() and the next inference call. */
+    bool isReleased() const { return arenasReleased; }
+
+    /**
+     * Rebuild a released interpreter now instead of in the next inference
+     * call, e.g. before JNI pins a Java array (GetPrimitiveArrayCritical
+     * blocks the GC for as long as the rebuild takes).
+     *
+     * @return false (logged) if there is no interpreter and none can be
+     *         built
+     */
+    bool ensureReady() { return ensureInterpreter(); }
+
+    // ====================================================================
+    // MODEL HOT SWAP
+    // ====================================================================
+    // Replace the model while the stream keeps running (read-copy-update):
+    // the replacement is built and warmed up off the audio path, published
+    // with an atomic pointer exchange and picked up by the consumer between
+    // two calls. The old model is deleted on the swapping thread once the
+    // consumer has let go of it, so an update causes no gap in the audio.
+
+    /**
+     * Replace the model without stopping classification.
+     *
+     * This method, called on any thread except the consumer:
+     * 1. Builds a replacement over `model` on the calling thread, with the
+     *    settings this processor was built with (delegate selection, thread
+     *    tuning, warm-up at the stream batch size); the consumer keeps
+     *    classifying on the old model meanwhile
+     * 2. Publishes it with one atomic pointer exchange
+     * 3. Waits up to timeoutMs for the consumer to adopt it - calls already
+     *    running finish on the old model - and deletes the old interpreter
+     *    and model here, off the audio path
+     *
+     * The replacement must take windows of the same length and produce as
+     * many scores per window as the current model. Queued samples,
+     * thresholds, events and the cascade carry over. If the consumer makes
+     * no call within timeoutMs the swap stays published; the old model is
+     * then deleted by the next swapModel or the destructor.
+     *
+     * @param model Replacement model (SharedModel::fromFile / fromBuffer)
+     * @param timeoutMs Longest wait for the consumer to adopt it
+     * @return false (current model kept) if the replacement cannot be built
+     *         or does not fit the current model
+     */
+    bool swapModel(std::shared_ptr<SharedModel> model, int timeoutMs = 1000);
+
+    /**
+     * Replace the model and rebuild it with other settings (delegate,
+     * thread count), like swapModel otherwise.
+     *
+     * Later swapModel(model) calls go back to the construction settings
+     * (getConfig()).
+     *
+     * @param model Replacement model (may be the current getModel())
+     * @param config Settings for the replacement (its front end is ignored:
+     *               the stream keeps this processor's)
+     * @param timeoutMs Longest wait for the consumer to adopt it
+     * @return false (current model kept) if the replacement cannot be built
+     *         or does not fit the current model
+     */
+    bool swapModel(std::shared_ptr<SharedModel> model, const MLProcessorConfig& config,
+                   int timeoutMs = 1000);
+
+    /**
+     * Settings this processor was constructed with.
+     */
+    const MLProcessorConfig& getConfig() const { return engineConfig; }
+
+    /** true while a swapped-in model waits for the consumer. */
+    bool isSwapPending() const { return pendingSwap.load(std::memory_order_acquire) != nullptr; }
 };
 
 #endif // ML_PROCESSOR_H
@@ -0,0 +1,207 @@
+// ============================================================================
+// HOT-PATH STAGE STATISTICS - IMPLEMENTATION
+// ============================================================================
+
+#include "ml_stats.h"
+
+#ifdef __ANDROID__
+#include <android/trace.h>
+#endif
+
+// Durations below 2^kMinShift ns share bucket 0
+static const int kMinShift = 6;
+
+const char* stageName(MLStage stage) {
+    switch (stage) {
+        case MLStage::Input: return "input";
+        case MLStage::Invoke: return "invoke";
+        case MLStage::Output: return "output";
+        case MLStage::Call: return "call";
+        case MLStage::Jni: return "jni";
+    }
+    return "unknown";
+}
+
+/**
+ * Index of the highest set bit (value must be non-zero).
+ */
+static int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+#endif
+}
+
+// ============================================================================
+// LATENCY HISTOGRAM IMPLEMENTATION
+// ============================================================================
+
+/**
+ * Bucket of a duration: the power of two it falls in, split into four
+ * sub-buckets by the next two bits.
+ */
+int LatencyHistogram::bucketFor(uint64_t ns) {
+    if (ns < (1u << kMinShift)) {
+        return 0;
+    }
+    const int msb = highestBit(ns);
+    const int sub = static_cast<int>((ns >> (msb - 2)) & 3);
+    const int bucket = (msb - kMinShift) * 4 + sub + 1;
+    return bucket < kBuckets ? bucket : kBuckets - 1;
+}
+
+uint64_t LatencyHistogram::bucketUpperNs(int bucket) {
+    if (bucket == 0) {
+        return 1u << kMinShift;
+    }
+    const int msb = (bucket - 1) / 4 + kMinShift;
+    const uint64_t sub = (bucket - 1) % 4;
+    return (5 + sub) << (msb - 2);
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    // Relaxed ordering: the counters are independent statistics, a reader
+    // may see a record half-applied, which only skews one snapshot by one
+    // sample
+    buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t previous = maxNs.load(std::memory_order_relaxed);
+    while (ns > previous &&
+           !maxNs.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * Walk cumulative bucket counts to the p50 / p95 / p99 ranks.
+ *
+ * Each percentile is reported as its bucket's upper bound, capped at
+ * maxNs.
+ */
+static void fillPercentiles(const uint64_t* counts, int buckets, uint64_t total,
+                            uint64_t maxNs, uint64_t (*upperNs)(int), StageSummary* summary) {
+    const double quantiles[] = {0.50, 0.95, 0.99};
+    double* targets[] = {&summary->p50Us, &summary->p95Us, &summary->p99Us};
+    int next = 0;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < buckets && next < 3; i++) {
+        cumulative += counts[i];
+        while (next < 3 && cumulative >= quantiles[next] * total) {
+            const uint64_t upper = upperNs(i);
+            *targets[next] = (upper < maxNs ? upper : maxNs) / 1000.0;
+            next++;
+        }
+    }
+}
+
+/**
+ * Summarize the recorded durations.
+ *
+ * This method:
+ * 1. Copies the bucket counts (one pass, no lock)
+ * 2. Walks the cumulative counts to the p50 / p95 / p99 ranks
+ * 3. Reports each percentile as its bucket's upper bound, capped at the max
+ */
+StageSummary LatencyHistogram::snapshot() const {
+    uint64_t counts[kBuckets];
+    uint64_t total = 0;
+    for (int i = 0; i < kBuckets; i++) {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    StageSummary summary;
+    if (total == 0) {
+        return summary;
+    }
+
+    const uint64_t maxValue = maxNs.load(std::memory_order_relaxed);
+    summary.count = total;
+    summary.meanUs = totalNs.load(std::memory_order_relaxed) / 1000.0 /
+                     count.load(std::memory_order_relaxed);
+    summary.maxUs = maxValue / 1000.0;
+    fillPercentiles(counts, kBuckets, total, maxValue, bucketUpperNs, &summary);
+    return summary;
+}
+
+/**
+ * Summarize the durations recorded since a mark, and move the mark.
+ *
+ * The same walk as snapshot() over the per-bucket differences. A concurrent
+ * reset() makes counts go backwards; the interval then restarts from zero.
+ */
+StageSummary LatencyHistogram::snapshotSince(HistogramMark* mark) const {
+    uint64_t counts[kBuckets];
+    uint64_t total = 0;
+    int slowest = 0;
+    for (int i = 0; i < kBuckets; i++) {
+        const uint64_t now = buckets[i].load(std::memory_order_relaxed);
+        counts[i] = now >= mark->buckets[i] ? now - mark->buckets[i] : now;
+        mark->buckets[i] = now;
+        total += counts[i];
+        if (counts[i] > 0) {
+            slowest = i;
+        }
+    }
+    const uint64_t nowNs = totalNs.load(std::memory_order_relaxed);
+    const uint64_t intervalNs = nowNs >= mark->totalNs ? nowNs - mark->totalNs : nowNs;
+    mark->totalNs = nowNs;
+
+    StageSummary summary;
+    if (total == 0) {
+        return summary;
+    }
+
+    const uint64_t maxValue = bucketUpperNs(slowest);
+    summary.count = total;
+    summary.meanUs = intervalNs / 1000.0 / total;
+    summary.maxUs = maxValue / 1000.0;
+    fillPercentiles(counts, kBuckets, total, maxValue, bucketUpperNs, &summary);
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    totalNs.store(0, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// STAGE STATISTICS IMPLEMENTATION
+// ============================================================================
+
+void StageStats::reset() {
+    for (auto& histogram : histograms) {
+        histogram.reset();
+    }
+}
+
+ScopedStage::ScopedStage(StageStats& stats, MLStage stage)
+        : stats(stats), stage(stage), traced(false) {
+#ifdef __ANDROID__
+    // ATrace_isEnabled is cheap and false unless a trace is being captured
+    if (stats.isTraceEnabled() && ATrace_isEnabled()) {
+        ATrace_beginSection(stageName(stage));
+        traced = true;
+    }
+#endif
+    start = std::chrono::steady_clock::now();
+}
+
+ScopedStage::~ScopedStage() {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    stats.record(stage, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+#ifdef __ANDROID__
+    if (traced) {
+        ATrace_endSection();
+    }
+#endif
+}
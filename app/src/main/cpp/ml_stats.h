@@ -0,0 +1,205 @@
+// ============================================================================
+// HOT-PATH STAGE STATISTICS - HEADER
+// ============================================================================
+//
+// Low-overhead latency instrumentation for the inference path.
+//
+// Key characteristics:
+// - Per stage: Input conversion, interpreter invoke, output read-back, the
+//   whole native call and the whole JNI call are timed separately
+// - Lock-free: Each stage is a histogram of atomic counters, so the audio
+//   thread records without locking while the UI thread reads a snapshot
+// - Monotonic: Durations come from std::chrono::steady_clock
+//   (CLOCK_MONOTONIC on Android and Linux)
+// - Perfetto: With tracing enabled, every timed stage is also emitted as an
+//   ATrace section (Android only; compiled out elsewhere)
+//
+// Histogram buckets are log-linear: four per power of two from 64 ns to
+// about 1 s, so reported percentiles are the upper bound of their bucket
+// and at most ~25% above the exact value.
+//
+// =============================================================================
+
+#ifndef ML_STATS_H
+#define ML_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// ============================================================================
+// STAGES
+// ============================================================================
+
+/**
+ * Timed sections of a classification. Input, Invoke and Output are nested
+ * inside Call, which is nested inside Jni for calls coming from Kotlin.
+ */
+enum class MLStage : int {
+    Input = 0,   // int16 -> tensor conversion / normalization / quantization
+    Invoke = 1,  // TfLiteInterpreterInvoke
+    Output = 2,  // Reading back / dequantizing / copying scores, decisions
+    Call = 3,    // One public MLProcessor call, end to end
+    Jni = 4,     // One JNI entry point, including array pinning and copies
+};
+
+// Number of MLStage values
+static const int kStageCount = 5;
+
+/**
+ * Stage name used in trace sections and reports ("input", "invoke", ...).
+ */
+const char* stageName(MLStage stage);
+
+// ============================================================================
+// LATENCY HISTOGRAM
+// ============================================================================
+
+/**
+ * Summary of one stage at the time of the snapshot (microseconds).
+ */
+struct StageSummary {
+    uint64_t count = 0;
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p95Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+// Buckets per LatencyHistogram. Bucket 0 holds everything below 64 ns; the
+// last bucket everything above ~1 s.
+static const int kHistogramBuckets = 96;
+
+/**
+ * A histogram's counters at one point in time, so an interval can be
+ * summarized on its own (see LatencyHistogram::snapshotSince).
+ */
+struct HistogramMark {
+    uint64_t buckets[kHistogramBuckets] = {};
+    uint64_t totalNs = 0;
+};
+
+/**
+ * Fixed-bucket latency histogram with lock-free recording.
+ */
+class LatencyHistogram {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    static const int kBuckets = kHistogramBuckets;
+
+    std::atomic<uint64_t> buckets[kBuckets] = {};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+
+    static int bucketFor(uint64_t ns);
+    static uint64_t bucketUpperNs(int bucket);
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    /**
+     * Add one duration. Safe to call concurrently with snapshot().
+     */
+    void record(uint64_t ns);
+
+    /**
+     * Summarize the recorded durations.
+     */
+    StageSummary snapshot() const;
+
+    /**
+     * Summarize only the durations recorded since `mark`, then move `mark`
+     * to now. For periodic monitoring without resetting the histogram.
+     *
+     * maxUs is the upper bound of the slowest bucket hit in the interval
+     * (exact maxima are only kept over the histogram's lifetime).
+     */
+    StageSummary snapshotSince(HistogramMark* mark) const;
+
+    /**
+     * Drop all recorded durations.
+     */
+    void reset();
+};
+
+// ============================================================================
+// STAGE STATISTICS
+// ============================================================================
+
+/**
+ * One histogram per MLStage, plus the ATrace switch.
+ */
+class StageStats {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    LatencyHistogram histograms[kStageCount];
+
+    // Emit ATrace sections for every timed stage
+    std::atomic<bool> trace{false};
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    void record(MLStage stage, uint64_t ns) {
+        histograms[static_cast<int>(stage)].record(ns);
+    }
+
+    StageSummary snapshot(MLStage stage) const {
+        return histograms[static_cast<int>(stage)].snapshot();
+    }
+
+    StageSummary snapshotSince(MLStage stage, HistogramMark* mark) const {
+        return histograms[static_cast<int>(stage)].snapshotSince(mark);
+    }
+
+    void reset();
+
+    /**
+     * Enable or disable ATrace sections (they are only emitted while a
+     * trace is being captured, e.g. by Perfetto).
+     */
+    void setTraceEnabled(bool enabled) { trace.store(enabled, std::memory_order_relaxed); }
+
+    bool isTraceEnabled() const { return trace.load(std::memory_order_relaxed); }
+};
+
+// ============================================================================
+// SCOPED STAGE TIMER
+// ============================================================================
+
+/**
+ * Times the enclosing scope into one stage (and an ATrace section when
+ * tracing is on).
+ *
+ * Usage:
+ *   {
+ *       ScopedStage timing(stats, MLStage::Invoke);
+ *       TfLiteInterpreterInvoke(interpreter);
+ *   }
+ */
+class ScopedStage {
+private:
+    StageStats& stats;
+    MLStage stage;
+    bool traced;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    ScopedStage(StageStats& stats, MLStage stage);
+    ~ScopedStage();
+
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+};
+
+#endif // ML_STATS_H
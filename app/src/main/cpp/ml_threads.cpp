@@ -0,0 +1,218 @@
+// ============================================================================
+// THREAD PLACEMENT - IMPLEMENTATION
+// ============================================================================
+
+#include "ml_threads.h"
+#include "ml_log.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ANDROID_PRIORITY_URGENT_AUDIO from system/thread_defs.h (not in the NDK)
+static const int kUrgentAudioNice = -19;
+
+// SCHED_FIFO priority for RealTime: the lowest levels, so the audio HAL
+// and AAudio callback threads (which run above them) keep precedence
+static const int kRealTimePriority = 2;
+
+const char* threadPriorityName(ThreadPriority priority) {
+    switch (priority) {
+        case ThreadPriority::Default: return "default";
+        case ThreadPriority::UrgentAudio: return "urgent-audio";
+        case ThreadPriority::RealTime: return "real-time";
+    }
+    return "unknown";
+}
+
+bool threadPriorityFromInt(int id, ThreadPriority* priority) {
+    if (id < static_cast<int>(ThreadPriority::Default) ||
+        id > static_cast<int>(ThreadPriority::RealTime)) {
+        return false;
+    }
+    *priority = static_cast<ThreadPriority>(id);
+    return true;
+}
+
+int cpuCount() {
+#if defined(__linux__)
+    const long count = sysconf(_SC_NPROCESSORS_CONF);
+    if (count <= 0) {
+        return 1;
+    }
+    return count < kMaxCpus ? static_cast<int>(count) : kMaxCpus;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Maximum frequency of one CPU in kHz, or -1 if cpufreq does not say.
+ */
+static long maxFrequencyKhz(int cpu) {
+    char path[96];
+    std::snprintf(path, sizeof(path),
+                  "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    long khz = -1;
+    if (std::fscanf(file, "%ld", &khz) != 1) {
+        khz = -1;
+    }
+    std::fclose(file);
+    return khz;
+}
+
+uint64_t performanceCores() {
+    static const uint64_t cores = [] {
+        const int count = cpuCount();
+        const uint64_t all = count >= 64 ? ~0ULL : (1ULL << count) - 1;
+
+        long frequencies[kMaxCpus];
+        long lowest = -1;
+        long highest = -1;
+        for (int cpu = 0; cpu < count; cpu++) {
+            frequencies[cpu] = maxFrequencyKhz(cpu);
+            if (frequencies[cpu] <= 0) {
+                continue;
+            }
+            if (lowest < 0 || frequencies[cpu] < lowest) lowest = frequencies[cpu];
+            if (frequencies[cpu] > highest) highest = frequencies[cpu];
+        }
+
+        // Single cluster (or no cpufreq): nothing to avoid
+        if (lowest < 0 || lowest == highest) {
+            LOG_INFO("CPU topology: %d cores, one cluster", count);
+            return all;
+        }
+
+        // Everything above the efficiency cluster (big, and prime if any).
+        // CPUs without cpufreq are left out, being unknown rather than fast.
+        uint64_t mask = 0;
+        for (int cpu = 0; cpu < count; cpu++) {
+            if (frequencies[cpu] > lowest) {
+                mask |= 1ULL << cpu;
+            }
+        }
+        LOG_INFO("CPU topology: %d cores, performance cluster 0x%llx (up to %ld MHz, "
+                 "efficiency cores up to %ld MHz)", count,
+                 static_cast<unsigned long long>(mask), highest / 1000, lowest / 1000);
+        return mask;
+    }();
+    return cores;
+}
+
+uint64_t currentThreadCores() {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return 0;
+    }
+    uint64_t mask = 0;
+    for (int cpu = 0; cpu < kMaxCpus; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            mask |= 1ULL << cpu;
+        }
+    }
+    return mask;
+#else
+    return 0;
+#endif
+}
+
+bool pinCurrentThread(uint64_t cores) {
+    if (cores == 0) {
+        return true;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < kMaxCpus; cpu++) {
+        if (cores & (1ULL << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        LOG_WARN("Cannot pin thread to cores 0x%llx (errno %d)",
+                 static_cast<unsigned long long>(cores), errno);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+ThreadPriority raiseCurrentThreadPriority(ThreadPriority priority) {
+#if defined(__linux__)
+    // ====================================================================
+    // STEP 1: SCHED_FIFO (RealTime only)
+    // ====================================================================
+    // Reset on fork: threads this one starts (e.g. inference workers) get
+    // normal scheduling back instead of inheriting the real-time class
+    if (priority == ThreadPriority::RealTime) {
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = kRealTimePriority;
+#if defined(SCHED_RESET_ON_FORK)
+        const int policy = SCHED_FIFO | SCHED_RESET_ON_FORK;
+#else
+        const int policy = SCHED_FIFO;
+#endif
+        if (sched_setscheduler(0, policy, &param) == 0) {
+            return ThreadPriority::RealTime;
+        }
+        LOG_INFO("SCHED_FIFO not permitted (errno %d), using urgent-audio priority", errno);
+    }
+
+    // ====================================================================
+    // STEP 2: Urgent Audio Nice Level
+    // ====================================================================
+    // Linux keeps the nice value per thread: PRIO_PROCESS with a thread id
+    // changes only that thread
+    if (priority != ThreadPriority::Default) {
+        const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, kUrgentAudioNice) == 0) {
+            return ThreadPriority::UrgentAudio;
+        }
+        LOG_WARN("Cannot raise thread priority (errno %d)", errno);
+    }
+#else
+    (void)priority;
+#endif
+    return ThreadPriority::Default;
+}
+
+int currentCpu() {
+#if defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+ScopedThreadPin::ScopedThreadPin(uint64_t cores) : previous(0) {
+    if (cores == 0) {
+        return;
+    }
+    previous = currentThreadCores();
+    if (previous != 0 && !pinCurrentThread(cores)) {
+        previous = 0;
+    }
+}
+
+ScopedThreadPin::~ScopedThreadPin() {
+    if (previous != 0) {
+        pinCurrentThread(previous);
+    }
+}
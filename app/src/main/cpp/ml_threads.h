@@ -0,0 +1,120 @@
+// ============================================================================
+// THREAD PLACEMENT - HEADER
+// ============================================================================
+//
+// CPU topology, affinity and scheduling priority for the threads that run
+// inference, so a real-time stream is not left on an efficiency core or
+// preempted by background work.
+//
+// Key characteristics:
+// - Topology: The performance cluster is every core whose maximum
+//   frequency (/sys/devices/system/cpu/cpuN/cpufreq) is above the lowest
+//   one; on a single-cluster device it is every core
+// - Inherited pinning: A new thread starts with its creator's affinity, so
+//   pinning the thread that builds and invokes an interpreter also places
+//   the worker threads TensorFlow Lite and its delegates start from it
+// - Priority: ANDROID_PRIORITY_URGENT_AUDIO (nice -19), or SCHED_FIFO where
+//   the process is allowed to use it, falling back to the nice level
+// - Best effort: Every call reports what it could apply instead of failing
+//   the caller; devices without the interfaces simply run unpinned
+//
+// =============================================================================
+
+#ifndef ML_THREADS_H
+#define ML_THREADS_H
+
+#include <cstdint>
+
+// Highest CPU count affinity masks (one bit per CPU) describe
+static const int kMaxCpus = 64;
+
+/**
+ * Scheduling of the threads that move audio through the stream.
+ *
+ * The numeric values are the ones exchanged over JNI (see
+ * NativeMLProcessor.ThreadPriority).
+ */
+enum class ThreadPriority {
+    Default = 0,      // Inherited priority, left unchanged
+    UrgentAudio = 1,  // nice -19 (ANDROID_PRIORITY_URGENT_AUDIO)
+    RealTime = 2      // SCHED_FIFO, falling back to UrgentAudio if not permitted
+};
+
+/** Human-readable name of a priority (for logs). */
+const char* threadPriorityName(ThreadPriority priority);
+
+/**
+ * Map a JNI priority id to a ThreadPriority.
+ *
+ * @return false if the id is unknown
+ */
+bool threadPriorityFromInt(int id, ThreadPriority* priority);
+
+/**
+ * Thread settings of a processor (see MLProcessorConfig::threadPolicy).
+ */
+struct ThreadPolicy {
+    // Build the interpreter (and so the TensorFlow Lite / delegate worker
+    // threads) on the performance cluster, and pin the stream threads
+    // that prepare themselves (MLProcessor::prepareStreamThread) there
+    bool pinPerformanceCores = false;
+
+    // Priority prepareStreamThread gives the capture / inference threads
+    ThreadPriority streamPriority = ThreadPriority::Default;
+};
+
+/**
+ * CPUs the kernel knows of (online or not), at most kMaxCpus.
+ */
+int cpuCount();
+
+/**
+ * Mask of the performance cluster (bit N = CPU N), detected once from
+ * cpufreq. Every CPU if the frequencies are unknown or all equal.
+ */
+uint64_t performanceCores();
+
+/**
+ * CPUs the calling thread may run on, or 0 if unknown.
+ */
+uint64_t currentThreadCores();
+
+/**
+ * Restrict the calling thread to `cores`. Threads it starts afterwards
+ * inherit the mask.
+ *
+ * @param cores CPU mask; 0 leaves the thread as it is
+ * @return false if the kernel rejected the mask
+ */
+bool pinCurrentThread(uint64_t cores);
+
+/**
+ * Raise the calling thread's scheduling priority.
+ *
+ * @return Priority actually applied (Default if none could be)
+ */
+ThreadPriority raiseCurrentThreadPriority(ThreadPriority priority);
+
+/**
+ * CPU the calling thread is running on, or -1 if unknown.
+ */
+int currentCpu();
+
+/**
+ * Pin the calling thread for the lifetime of the object, then restore its
+ * previous mask. Threads started meanwhile keep the pinned mask.
+ */
+class ScopedThreadPin {
+public:
+    /** @param cores CPU mask; 0 makes the object a no-op */
+    explicit ScopedThreadPin(uint64_t cores);
+    ~ScopedThreadPin();
+
+    ScopedThreadPin(const ScopedThreadPin&) = delete;
+    ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+private:
+    uint64_t previous;
+};
+
+#endif // ML_THREADS_H
@@ -0,0 +1,156 @@
+// ============================================================================
+// MEMORY-MAPPED MODEL BUFFER - IMPLEMENTATION
+// ============================================================================
+
+#include "model_buffer.h"
+#include "ml_log.h"
+#include "ml_memory.h"
+
+#include <utility>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// MODEL BUFFER CLASS IMPLEMENTATION
+// ============================================================================
+
+ModelBuffer::ModelBuffer(ModelBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+ModelBuffer& ModelBuffer::operator=(ModelBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(bytes, other.bytes);
+        std::swap(byteCount, other.byteCount);
+        std::swap(mapping, other.mapping);
+        std::swap(mappingSize, other.mappingSize);
+#if defined(__ANDROID__)
+        std::swap(asset, other.asset);
+#endif
+    }
+    return *this;
+}
+
+/**
+ * Map `length` bytes of `fd` starting at `offset`.
+ *
+ * This method:
+ * 1. Rounds the offset down to a page boundary (mmap requirement)
+ * 2. Maps the page-aligned range read-only
+ * 3. Points data() at the model inside the mapping
+ */
+bool ModelBuffer::mapFile(int fd, int64_t offset, int64_t length) {
+    release();
+
+#if defined(_WIN32)
+    (void)fd;
+    (void)offset;
+    (void)length;
+    LOG_ERROR("Memory-mapped models are not supported on this platform");
+    return false;
+#else
+    if (fd < 0 || offset < 0 || length <= 0) {
+        LOG_ERROR("Invalid model range (fd %d, offset %lld, length %lld)", fd,
+                  static_cast<long long>(offset), static_cast<long long>(length));
+        return false;
+    }
+
+    const int64_t pageSize = sysconf(_SC_PAGESIZE);
+    const int64_t alignedOffset = offset - (offset % pageSize);
+    const size_t delta = static_cast<size_t>(offset - alignedOffset);
+    const size_t size = delta + static_cast<size_t>(length);
+
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd,
+                         static_cast<off_t>(alignedOffset));
+    if (address == MAP_FAILED) {
+        LOG_ERROR("Failed to mmap model (offset %lld, length %lld)",
+                  static_cast<long long>(offset), static_cast<long long>(length));
+        return false;
+    }
+
+    // The interpreter reads the whole flatbuffer while building its graph;
+    // start the readahead now instead of faulting page by page
+    madvise(address, size, MADV_WILLNEED);
+
+    mapping = address;
+    mappingSize = size;
+    bytes = static_cast<const char*>(address) + delta;
+    byteCount = static_cast<size_t>(length);
+    return true;
+#endif
+}
+
+#if defined(__ANDROID__)
+/**
+ * Map a model stored in the APK's assets.
+ *
+ * This method:
+ * 1. Opens the asset and asks for its location inside the APK
+ * 2. Uncompressed: mmaps that range (the descriptor is closed right away)
+ * 3. Compressed: keeps the asset open and uses its in-memory buffer
+ */
+bool ModelBuffer::openAsset(AAssetManager* assetManager, const char* assetName) {
+    release();
+
+    AAsset* opened = AAssetManager_open(assetManager, assetName, AASSET_MODE_BUFFER);
+    if (!opened) {
+        LOG_ERROR("Asset %s not found", assetName);
+        return false;
+    }
+
+    // Returns a descriptor only for assets stored uncompressed in the APK
+    off64_t start = 0;
+    off64_t length = 0;
+    const int fd = AAsset_openFileDescriptor64(opened, &start, &length);
+    if (fd >= 0) {
+        const bool mapped = mapFile(fd, start, length);
+        close(fd);
+        AAsset_close(opened);
+        return mapped;
+    }
+
+    const void* buffer = AAsset_getBuffer(opened);
+    if (!buffer) {
+        LOG_ERROR("Failed to read asset %s", assetName);
+        AAsset_close(opened);
+        return false;
+    }
+
+    asset = opened;
+    bytes = buffer;
+    byteCount = static_cast<size_t>(AAsset_getLength64(opened));
+    return true;
+}
+#endif
+
+/**
+ * Bytes of the model in RAM: the resident pages of a mapping, or all of a
+ * heap copy or asset buffer.
+ */
+int64_t ModelBuffer::residentBytes() const {
+    if (mapping) {
+        return ::residentBytes(mapping, mappingSize);
+    }
+    return static_cast<int64_t>(byteCount);
+}
+
+/**
+ * Unmap / close and return to the empty state.
+ */
+void ModelBuffer::release() {
+#if !defined(_WIN32)
+    if (mapping) munmap(mapping, mappingSize);
+#endif
+#if defined(__ANDROID__)
+    if (asset) AAsset_close(asset);
+    asset = nullptr;
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    bytes = nullptr;
+    byteCount = 0;
+}
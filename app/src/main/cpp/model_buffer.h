@@ -0,0 +1,122 @@
+// ============================================================================
+// MEMORY-MAPPED MODEL BUFFER - HEADER
+// ============================================================================
+//
+// Read-only view of a .tflite flatbuffer that TfLiteModelCreate can build a
+// model over without copying it.
+//
+// Key characteristics:
+// - Zero-copy: Uncompressed APK assets are mmapped straight from the APK
+//   (AssetFileDescriptor fd + offset + length), so startup neither writes
+//   the model to filesDir nor reads it through a stream
+// - Lazy: Pages are faulted in by the kernel as TensorFlow Lite touches them
+//   and can be dropped again under memory pressure (they are file-backed)
+// - Owning: The buffer must outlive every TfLiteModel created over it;
+//   MLProcessor keeps it next to its model
+//
+// =============================================================================
+
+#ifndef MODEL_BUFFER_H
+#define MODEL_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__ANDROID__)
+#include <android/asset_manager.h>
+#endif
+
+// ============================================================================
+// MODEL BUFFER CLASS
+// ============================================================================
+/**
+ * Read-only model bytes backed by a file mapping (or an open AAsset).
+ *
+ * Movable, not copyable. An empty buffer has data() == nullptr.
+ */
+class ModelBuffer {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // Model bytes (inside `mapping`, or owned by `asset`)
+    const void* bytes = nullptr;
+    size_t byteCount = 0;
+
+    // Page-aligned mapping that contains `bytes` (nullptr if not mmapped)
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+
+#if defined(__ANDROID__)
+    // Asset kept open while its buffer is in use (compressed fallback)
+    AAsset* asset = nullptr;
+#endif
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    ModelBuffer() = default;
+    ~ModelBuffer() { release(); }
+
+    ModelBuffer(ModelBuffer&& other) noexcept;
+    ModelBuffer& operator=(ModelBuffer&& other) noexcept;
+
+    ModelBuffer(const ModelBuffer&) = delete;
+    ModelBuffer& operator=(const ModelBuffer&) = delete;
+
+    /**
+     * Map `length` bytes of `fd` starting at `offset`.
+     *
+     * The offset does not need to be page aligned (APK entries usually are
+     * only 4-byte aligned). The mapping stays valid after the caller closes
+     * the descriptor.
+     *
+     * @param fd Open, readable file descriptor
+     * @param offset Start of the model inside the file
+     * @param length Model size in bytes
+     * @return false if the range cannot be mapped
+     */
+    bool mapFile(int fd, int64_t offset, int64_t length);
+
+#if defined(__ANDROID__)
+    /**
+     * Map a model stored in the APK's assets.
+     *
+     * Uncompressed assets (noCompress "tflite") are mmapped from the APK
+     * through their file descriptor. Compressed assets fall back to the
+     * asset manager's own buffer, which inflates the model into memory
+     * once but still avoids the copy to disk.
+     *
+     * @param assetManager Asset manager from AAssetManager_fromJava
+     * @param assetName Asset path, e.g. "conv-classifier-model.tflite"
+     * @return false if the asset cannot be opened
+     */
+    bool openAsset(AAssetManager* assetManager, const char* assetName);
+#endif
+
+    /**
+     * Unmap / close and return to the empty state.
+     */
+    void release();
+
+    const void* data() const { return bytes; }
+    size_t size() const { return byteCount; }
+
+    /**
+     * true if the bytes are a file mapping (clean pages the kernel can
+     * drop and reload), false if they live in memory (compressed asset).
+     */
+    bool isMapped() const { return mapping != nullptr; }
+
+    /**
+     * Bytes of the model currently in RAM: the resident pages of the
+     * mapping, or the whole buffer if it is not mapped.
+     *
+     * @return Resident bytes, or -1 if they cannot be determined
+     */
+    int64_t residentBytes() const;
+};
+
+#endif // MODEL_BUFFER_H
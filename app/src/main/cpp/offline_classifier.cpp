@@ -0,0 +1,260 @@
+// ============================================================================
+// OFFLINE FILE CLASSIFIER - IMPLEMENTATION
+// ============================================================================
+
+#include "offline_classifier.h"
+#include "ml_log.h"
+
+#include <utility>
+
+static uint64_t packRange(uint64_t begin, uint64_t end) {
+    return (begin << 32) | end;
+}
+
+static int64_t rangeBegin(uint64_t packed) {
+    return static_cast<int64_t>(packed >> 32);
+}
+
+static int64_t rangeEnd(uint64_t packed) {
+    return static_cast<int64_t>(packed & 0xFFFFFFFFu);
+}
+
+// ============================================================================
+// OFFLINE CLASSIFIER CLASS IMPLEMENTATION
+// ============================================================================
+
+OfflineClassifier::OfflineClassifier(std::shared_ptr<SharedModel> model, int workerCount,
+                                     const MLProcessorConfig& config)
+        : pool(std::move(model), workerCount, config),
+          windowLength(pool.getWindowLength()) {
+    if (pool.size() > 0) {
+        ranges.reset(new WorkRange[pool.size()]);
+    }
+}
+
+OfflineClassifier::~OfflineClassifier() {
+    cancel();
+}
+
+/**
+ * Map out the windows and start the workers.
+ *
+ * This method:
+ * 1. Cancels and joins a previous run
+ * 2. Sizes the timeline and completion flags (the only allocations)
+ * 3. Gives every worker an equal contiguous range of chunks
+ * 4. Starts one thread per pooled processor
+ */
+bool OfflineClassifier::start(AudioFile&& audio, int hop, int audioChannel,
+                              float silenceRms, float confidence) {
+    cancel();
+
+    if (!isInitialized()) {
+        LOG_ERROR("Offline classifier not initialized");
+        return false;
+    }
+    if (!audio.isOpen() || hop < 1 || hop > windowLength ||
+        audioChannel < 0 || audioChannel >= audio.channels()) {
+        LOG_ERROR("Invalid offline run (hop %d, channel %d)", hop, audioChannel);
+        return false;
+    }
+
+    // ====================================================================
+    // STEP 1: Lay Out Windows and Chunks
+    // ====================================================================
+    file = std::move(audio);
+    hopSize = hop;
+    channel = audioChannel;
+    minRms = silenceRms;
+    minScore = confidence;
+
+    const int64_t frames = file.frames();
+    windowCount = frames >= windowLength ? (frames - windowLength) / hopSize + 1 : 0;
+    chunkCount = (windowCount + kChunkWindows - 1) / kChunkWindows;
+    if (chunkCount > 0xFFFFFFFFll) {
+        LOG_ERROR("Audio file too long (%lld windows)", static_cast<long long>(windowCount));
+        windowCount = chunkCount = 0;
+        return false;
+    }
+
+    timeline.assign(static_cast<size_t>(windowCount), TimelineEntry());
+    chunkDone.reset(new std::atomic<bool>[chunkCount > 0 ? chunkCount : 1]);
+    for (int64_t c = 0; c < chunkCount; c++) {
+        chunkDone[c].store(false, std::memory_order_relaxed);
+    }
+    nextWindow = 0;
+    completed.store(0, std::memory_order_relaxed);
+    cancelled.store(false, std::memory_order_relaxed);
+    failed.store(false, std::memory_order_relaxed);
+
+    // ====================================================================
+    // STEP 2: Initial Even Split
+    // ====================================================================
+    const int workerCount = pool.size();
+    for (int w = 0; w < workerCount; w++) {
+        const int64_t begin = chunkCount * w / workerCount;
+        const int64_t end = chunkCount * (w + 1) / workerCount;
+        ranges[w].packed.store(packRange(begin, end), std::memory_order_relaxed);
+    }
+
+    // ====================================================================
+    // STEP 3: Start the Workers
+    // ====================================================================
+    // Thread creation publishes everything above to the workers
+    LOG_INFO("Offline run: %lld windows (%lld chunks) on %d workers, %d Hz",
+             static_cast<long long>(windowCount), static_cast<long long>(chunkCount),
+             workerCount, file.sampleRate());
+    for (int w = 0; w < workerCount; w++) {
+        workers.emplace_back(&OfflineClassifier::runWorker, this, w);
+    }
+    return true;
+}
+
+/**
+ * Worker loop: classify own chunks, then steal until no work is left.
+ */
+void OfflineClassifier::runWorker(int worker) {
+    MLProcessorPool::Lease processor = pool.acquire();
+    processor->setDecisionThresholds(minRms, minScore);
+
+    // Window copy for files that cannot be read in place (multi-channel or
+    // unaligned); allocated once per run
+    std::vector<int16_t> scratch(file.monoData() ? 0 : windowLength);
+
+    int64_t chunk;
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        if (popChunk(worker, &chunk) || (stealChunks(worker) && popChunk(worker, &chunk))) {
+            classifyChunk(*processor, chunk, scratch.data());
+        } else {
+            break;  // Every range is empty
+        }
+    }
+}
+
+/**
+ * Take the next chunk from the front of this worker's own range.
+ */
+bool OfflineClassifier::popChunk(int worker, int64_t* chunk) {
+    std::atomic<uint64_t>& range = ranges[worker].packed;
+    uint64_t packed = range.load(std::memory_order_acquire);
+    for (;;) {
+        const int64_t begin = rangeBegin(packed);
+        const int64_t end = rangeEnd(packed);
+        if (begin >= end) {
+            return false;
+        }
+        if (range.compare_exchange_weak(packed, packRange(begin + 1, end),
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+            *chunk = begin;
+            return true;
+        }
+    }
+}
+
+/**
+ * Move the upper half of the largest other range into this worker's
+ * (empty) range.
+ *
+ * @return false if no other worker has chunks left
+ */
+bool OfflineClassifier::stealChunks(int worker) {
+    const int workerCount = pool.size();
+    for (;;) {
+        // Pick the victim with the most work left
+        int victim = -1;
+        uint64_t victimRange = 0;
+        int64_t victimSize = 0;
+        for (int w = 0; w < workerCount; w++) {
+            if (w == worker) continue;
+            const uint64_t packed = ranges[w].packed.load(std::memory_order_acquire);
+            const int64_t size = rangeEnd(packed) - rangeBegin(packed);
+            if (size > victimSize) {
+                victim = w;
+                victimRange = packed;
+                victimSize = size;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+
+        // The victim keeps [begin, mid); the thief takes [mid, end)
+        const int64_t begin = rangeBegin(victimRange);
+        const int64_t end = rangeEnd(victimRange);
+        const int64_t mid = begin + victimSize / 2;
+        if (ranges[victim].packed.compare_exchange_strong(victimRange, packRange(begin, mid),
+                                                          std::memory_order_acq_rel)) {
+            // Only the owner refills its own (empty) range
+            ranges[worker].packed.store(packRange(mid, end), std::memory_order_release);
+            return true;
+        }
+        // Lost a race with the owner or another thief: rescan
+    }
+}
+
+/**
+ * Classify every window of one chunk into the timeline.
+ */
+void OfflineClassifier::classifyChunk(MLProcessor& processor, int64_t chunk, int16_t* scratch) {
+    const int64_t first = chunk * kChunkWindows;
+    const int64_t last = first + kChunkWindows < windowCount ? first + kChunkWindows : windowCount;
+    const int16_t* mono = file.monoData();
+
+    for (int64_t w = first; w < last; w++) {
+        const int64_t start = w * hopSize;
+        const int16_t* window = mono ? mono + start : scratch;
+        if (!mono) {
+            file.copyFrames(start, windowLength, channel, scratch);
+        }
+
+        TimelineEntry& entry = timeline[w];
+        entry.startFrame = start;
+        entry.result = processor.classify(window, windowLength);
+        if (entry.result.windows < 0) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    completed.fetch_add(last - first, std::memory_order_relaxed);
+    // Release: the consumer sees the entries once it sees the flag
+    chunkDone[chunk].store(true, std::memory_order_release);
+}
+
+/**
+ * Collect the next in-order timeline entries that are done.
+ */
+int OfflineClassifier::poll(TimelineEntry* out, int maxEntries) {
+    int written = 0;
+    while (written < maxEntries && nextWindow < windowCount) {
+        const int64_t chunk = nextWindow / kChunkWindows;
+        if (!chunkDone[chunk].load(std::memory_order_acquire)) {
+            break;
+        }
+        const int64_t chunkEnd = (chunk + 1) * kChunkWindows < windowCount
+                ? (chunk + 1) * kChunkWindows : windowCount;
+        while (written < maxEntries && nextWindow < chunkEnd) {
+            out[written++] = timeline[nextWindow++];
+        }
+    }
+    return written;
+}
+
+void OfflineClassifier::cancel() {
+    cancelled.store(true, std::memory_order_relaxed);
+    join();
+}
+
+void OfflineClassifier::join() {
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+bool OfflineClassifier::isFinished() const {
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    return nextWindow >= windowCount;
+}
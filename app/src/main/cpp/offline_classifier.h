@@ -0,0 +1,178 @@
+// ============================================================================
+// OFFLINE FILE CLASSIFIER - HEADER
+// ============================================================================
+//
+// Batch classification of recorded audio archives on all cores.
+//
+// Key characteristics:
+// - Zero-copy input: The WAV / raw PCM file is memory-mapped (AudioFile);
+//   mono windows are classified straight out of the mapping
+// - Work stealing: The windows are split into chunks, and every worker
+//   starts with an equal contiguous range of them. A worker that runs dry
+//   steals the upper half of the largest remaining range, so slow cores and
+//   uneven silence gating do not leave other cores idle. Ranges are single
+//   atomic words updated with compare-and-swap; no lock is taken
+// - Shared weights: Workers lease interpreters from an MLProcessorPool over
+//   one SharedModel (one copy of the weights for all cores)
+// - Streaming timeline: Results land in a preallocated timeline; poll()
+//   hands back the next in-order entries as soon as their chunk is done, so
+//   the caller can consume hours of audio progressively
+//
+// =============================================================================
+
+#ifndef OFFLINE_CLASSIFIER_H
+#define OFFLINE_CLASSIFIER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "audio_file.h"
+#include "ml_pool.h"
+#include "ml_processor.h"
+
+// ============================================================================
+// TIMELINE ENTRY
+// ============================================================================
+/**
+ * Decision for one window of the file.
+ */
+struct TimelineEntry {
+    int64_t startFrame = 0;        // First frame of the window in the file
+    ClassificationResult result;   // windows == 0 if gated, -1 on failure
+};
+
+// ============================================================================
+// OFFLINE CLASSIFIER CLASS
+// ============================================================================
+/**
+ * Classifies a memory-mapped audio file window by window on a pool of
+ * worker threads.
+ *
+ * One run at a time: start() begins classifying in the background and
+ * poll() collects the timeline from a single consumer thread.
+ */
+class OfflineClassifier {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // One chunk index range [begin, end) per worker, packed into an atomic
+    // word (begin in the high 32 bits) so owner pops and steals are a
+    // single compare-and-swap. Padded against false sharing.
+    struct alignas(64) WorkRange {
+        std::atomic<uint64_t> packed{0};
+    };
+
+    MLProcessorPool pool;
+    int windowLength = 0;  // Samples per window, read from the model
+    std::vector<std::thread> workers;
+    std::unique_ptr<WorkRange[]> ranges;
+
+    // Current run
+    AudioFile file;
+    int hopSize = 0;
+    int channel = 0;
+    float minRms = 0.0f;
+    float minScore = 0.0f;
+    int64_t windowCount = 0;
+    int64_t chunkCount = 0;
+
+    // Timeline (one entry per window) and per-chunk completion flags
+    std::vector<TimelineEntry> timeline;
+    std::unique_ptr<std::atomic<bool>[]> chunkDone;
+
+    // Consumer cursor (only touched by poll)
+    int64_t nextWindow = 0;
+
+    std::atomic<int64_t> completed{0};
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> failed{false};
+
+    void runWorker(int worker);
+    bool popChunk(int worker, int64_t* chunk);
+    bool stealChunks(int worker);
+    void classifyChunk(MLProcessor& processor, int64_t chunk, int16_t* scratch);
+    void join();
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    // Windows per work unit: large enough to amortize the atomics, small
+    // enough to balance well and stream results early
+    static const int kChunkWindows = 32;
+
+    /**
+     * Constructor: Build `workerCount` interpreters over one model.
+     *
+     * @param model Loaded model (see SharedModel)
+     * @param workerCount Worker threads (and pooled processors), at least 1
+     * @param config Per-worker settings; numThreads = 1 scales best
+     */
+    OfflineClassifier(std::shared_ptr<SharedModel> model, int workerCount,
+                      const MLProcessorConfig& config = MLProcessorConfig());
+
+    /**
+     * Destructor: Cancels and joins a running classification.
+     */
+    ~OfflineClassifier();
+
+    OfflineClassifier(const OfflineClassifier&) = delete;
+    OfflineClassifier& operator=(const OfflineClassifier&) = delete;
+
+    bool isInitialized() const { return pool.isInitialized(); }
+    int getWorkerCount() const { return pool.size(); }
+    int getWindowLength() const { return windowLength; }
+
+    /**
+     * Map an audio file and start classifying it in the background.
+     *
+     * Any previous run is cancelled first. The file is split into
+     * model-length windows (getWindowLength()) every `hopSize` frames;
+     * trailing frames that do not fill a window are ignored.
+     *
+     * @param audio Opened audio file (ownership moves in)
+     * @param hopSize Frames between window starts (1..getWindowLength())
+     * @param channel Channel to classify for multi-channel files
+     * @param minRms Silence gate (see MLProcessor::setDecisionThresholds)
+     * @param minScore Confidence threshold
+     * @return false if the file or the parameters are invalid
+     */
+    bool start(AudioFile&& audio, int hopSize, int channel, float minRms, float minScore);
+
+    /**
+     * Collect the next in-order timeline entries that are done.
+     *
+     * Must only be called from one thread at a time.
+     *
+     * @param out Receives up to maxEntries entries
+     * @param maxEntries Capacity of out
+     * @return Number of entries written (0 if the next chunk is not done yet)
+     */
+    int poll(TimelineEntry* out, int maxEntries);
+
+    /**
+     * Stop the workers; windows not yet classified stay missing.
+     */
+    void cancel();
+
+    /**
+     * True once every window has been classified and returned by poll(),
+     * or the run was cancelled. Call from the poll() thread.
+     */
+    bool isFinished() const;
+
+    /**
+     * True if any window failed inference during the current run.
+     */
+    bool hasFailed() const { return failed.load(std::memory_order_relaxed); }
+
+    int64_t getWindowCount() const { return windowCount; }
+    int64_t getCompletedWindows() const { return completed.load(std::memory_order_relaxed); }
+    int getSampleRate() const { return file.sampleRate(); }
+};
+
+#endif // OFFLINE_CLASSIFIER_H
@@ -0,0 +1,135 @@
+// ============================================================================
+// LOCK-FREE SPSC RING BUFFER - HEADER
+// ============================================================================
+//
+// Single-producer / single-consumer ring buffer used to hand audio samples
+// from a capture thread to the inference thread.
+//
+// Key characteristics:
+// - Lock-free: One atomic index per side, no mutexes or syscalls
+// - Wait-free: write() and read() never block, they move what fits
+// - Allocation-free: Storage is sized once by reset()
+//
+// Exactly one thread may call write() and exactly one (other) thread may
+// call read()/discard(). reset() must not run concurrently with either.
+//
+// =============================================================================
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+class SpscRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpscRingBuffer elements are moved with memcpy");
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // Backing storage; size is always a power of two so that
+    // index & mask replaces a modulo.
+    std::vector<T> storage;
+    size_t mask = 0;
+
+    // Monotonic element counters. The difference is the fill level.
+    // Kept on separate cache lines so producer and consumer do not
+    // false-share.
+    alignas(64) std::atomic<size_t> writeIndex{0};
+    alignas(64) std::atomic<size_t> readIndex{0};
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    SpscRingBuffer() = default;
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    /**
+     * Allocate storage for at least `minCapacity` elements and empty the
+     * buffer. Not thread-safe: call before producer/consumer start.
+     */
+    void reset(size_t minCapacity) {
+        size_t capacity = 1;
+        while (capacity < minCapacity) capacity <<= 1;
+        storage.assign(capacity, T());
+        mask = capacity - 1;
+        writeIndex.store(0, std::memory_order_relaxed);
+        readIndex.store(0, std::memory_order_relaxed);
+    }
+
+    /** Total number of elements the buffer can hold. */
+    size_t capacity() const { return storage.size(); }
+
+    /** Elements ready to be read (exact on the consumer thread). */
+    size_t available() const {
+        return writeIndex.load(std::memory_order_acquire) -
+               readIndex.load(std::memory_order_relaxed);
+    }
+
+    /** Free slots (exact on the producer thread). */
+    size_t freeSpace() const {
+        return storage.size() - (writeIndex.load(std::memory_order_relaxed) -
+                                 readIndex.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Producer: copy up to `count` elements in.
+     * @return Number of elements written (less than count when full)
+     */
+    size_t write(const T* data, size_t count) {
+        const size_t w = writeIndex.load(std::memory_order_relaxed);
+        const size_t r = readIndex.load(std::memory_order_acquire);
+        const size_t n = std::min(count, storage.size() - (w - r));
+        if (n == 0) return 0;
+
+        const size_t start = w & mask;
+        const size_t first = std::min(n, storage.size() - start);
+        std::memcpy(storage.data() + start, data, first * sizeof(T));
+        std::memcpy(storage.data(), data + first, (n - first) * sizeof(T));
+
+        writeIndex.store(w + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Consumer: copy up to `count` elements out.
+     * @return Number of elements read (less than count when empty)
+     */
+    size_t read(T* data, size_t count) {
+        const size_t r = readIndex.load(std::memory_order_relaxed);
+        const size_t w = writeIndex.load(std::memory_order_acquire);
+        const size_t n = std::min(count, w - r);
+        if (n == 0) return 0;
+
+        const size_t start = r & mask;
+        const size_t first = std::min(n, storage.size() - start);
+        std::memcpy(data, storage.data() + start, first * sizeof(T));
+        std::memcpy(data + first, storage.data(), (n - first) * sizeof(T));
+
+        readIndex.store(r + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Consumer: drop up to `count` unread elements.
+     * @return Number of elements dropped
+     */
+    size_t discard(size_t count) {
+        const size_t r = readIndex.load(std::memory_order_relaxed);
+        const size_t w = writeIndex.load(std::memory_order_acquire);
+        const size_t n = std::min(count, w - r);
+        readIndex.store(r + n, std::memory_order_release);
+        return n;
+    }
+};
+
+#endif // RING_BUFFER_H
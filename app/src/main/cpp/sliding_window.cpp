@@ -0,0 +1,112 @@
+// ============================================================================
+// SLIDING WINDOW - IMPLEMENTATION
+// ============================================================================
+
+#include "sliding_window.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * Allocate storage and reset the window state.
+ */
+bool SlidingWindow::configure(int length, int hop) {
+    if (length <= 0 || hop <= 0 || hop > length) {
+        return false;
+    }
+
+    windowLength = length;
+    hopSize = hop;
+    history.assign(2 * length, 0);
+    peakIndex.assign(length, 0);
+    peakValue.assign(length, 0);
+    reset();
+    return true;
+}
+
+/**
+ * Forget all buffered samples.
+ */
+void SlidingWindow::reset() {
+    peakHead = 0;
+    peakCount = 0;
+    totalSamples = 0;
+    nextWindowStart = 0;
+}
+
+/**
+ * Change the hop, keeping the buffered samples.
+ */
+bool SlidingWindow::setHopSize(int hop) {
+    if (!isConfigured() || hop <= 0 || hop > windowLength) {
+        return false;
+    }
+    hopSize = hop;
+    return true;
+}
+
+/**
+ * Append samples to the mirrored history and update the running peak.
+ *
+ * Each sample is copied twice (once per mirror half) and pushed once
+ * through the monotonic queue; amortized O(1) per sample.
+ */
+void SlidingWindow::append(const int16_t* samples, int count) {
+    // ====================================================================
+    // STEP 1: Copy into both halves of the mirrored history
+    // ====================================================================
+    int done = 0;
+    while (done < count) {
+        const int pos = static_cast<int>((totalSamples + done) % windowLength);
+        const int run = std::min(count - done, windowLength - pos);
+        std::memcpy(&history[pos], samples + done, run * sizeof(int16_t));
+        std::memcpy(&history[pos + windowLength], samples + done, run * sizeof(int16_t));
+        done += run;
+    }
+
+    // ====================================================================
+    // STEP 2: Update the monotonic peak queue
+    // ====================================================================
+    for (int i = 0; i < count; i++) {
+        const int64_t index = totalSamples + i;
+        const int32_t value = samples[i] < 0 ? -static_cast<int32_t>(samples[i]) : samples[i];
+
+        // Drop entries that fell out of the last windowLength samples
+        while (peakCount > 0 && peakIndex[peakHead] <= index - windowLength) {
+            peakHead = (peakHead + 1) % windowLength;
+            peakCount--;
+        }
+
+        // Drop entries that can never be the peak again
+        while (peakCount > 0) {
+            const int back = (peakHead + peakCount - 1) % windowLength;
+            if (peakValue[back] > value) break;
+            peakCount--;
+        }
+
+        const int slot = (peakHead + peakCount) % windowLength;
+        peakIndex[slot] = index;
+        peakValue[slot] = value;
+        peakCount++;
+    }
+
+    totalSamples += count;
+}
+
+/**
+ * Contiguous view of the ready window.
+ */
+const int16_t* SlidingWindow::windowData() const {
+    return &history[nextWindowStart % windowLength];
+}
+
+/**
+ * Peak absolute value of the ready window.
+ */
+int32_t SlidingWindow::windowPeak() {
+    while (peakCount > 0 && peakIndex[peakHead] < nextWindowStart) {
+        peakHead = (peakHead + 1) % windowLength;
+        peakCount--;
+    }
+    return peakCount > 0 ? peakValue[peakHead] : 0;
+}
@@ -0,0 +1,118 @@
+// ============================================================================
+// SLIDING WINDOW - HEADER
+// ============================================================================
+//
+// Assembles a continuous stream of 16-bit samples into overlapping model
+// windows (window length L, hop H) for the streaming classifier.
+//
+// Key characteristics:
+// - Copy-free windows: A mirrored history buffer keeps every window
+//   contiguous in memory, so no samples are shifted between hops
+// - Incremental peak: The peak used for normalization is maintained with a
+//   monotonic queue, so each sample is inspected once no matter how many
+//   overlapping windows it belongs to
+// - Allocation-free: Storage is sized once by configure()
+//
+// Not thread-safe: owned by the consumer (inference) thread.
+//
+// =============================================================================
+
+#ifndef SLIDING_WINDOW_H
+#define SLIDING_WINDOW_H
+
+#include <cstdint>
+#include <vector>
+
+class SlidingWindow {
+
+// ========================================================================
+// PRIVATE MEMBER VARIABLES
+// ========================================================================
+private:
+    // Window geometry (samples)
+    int windowLength = 0;
+    int hopSize = 0;
+
+    // Mirrored history: sample k is stored at k % L and k % L + L, so the
+    // last L samples are always readable as one contiguous block.
+    std::vector<int16_t> history;
+
+    // Monotonic queue of (sample index, |sample|) with decreasing values.
+    // The front is the peak of the most recent L samples. Implemented as a
+    // ring of L entries (the queue never holds more than L).
+    std::vector<int64_t> peakIndex;
+    std::vector<int32_t> peakValue;
+    int peakHead = 0;
+    int peakCount = 0;
+
+    // Absolute sample counters
+    int64_t totalSamples = 0;
+    int64_t nextWindowStart = 0;
+
+// ========================================================================
+// PUBLIC METHODS
+// ========================================================================
+public:
+    /**
+     * Allocate storage and reset the window state.
+     *
+     * @param windowLength Samples per window (model input length)
+     * @param hopSize Samples between consecutive window starts (1..L)
+     * @return false if the geometry is invalid
+     */
+    bool configure(int windowLength, int hopSize);
+
+    /**
+     * Forget all buffered samples (e.g. after a gap in the audio).
+     * The next window starts with the next appended sample.
+     */
+    void reset();
+
+    /**
+     * Change the hop without discarding the history. The next window
+     * starts `hopSize` samples after the current one.
+     *
+     * @param hopSize Samples between consecutive window starts (1..L)
+     * @return false if the hop is invalid (the hop is unchanged)
+     */
+    bool setHopSize(int hopSize);
+
+    /** true once configure() succeeded. */
+    bool isConfigured() const { return windowLength > 0; }
+
+    /** Samples still missing before the next window is complete. */
+    int samplesNeeded() const {
+        return static_cast<int>(nextWindowStart + windowLength - totalSamples);
+    }
+
+    /** true if a complete window can be read. */
+    bool windowReady() const { return isConfigured() && samplesNeeded() == 0; }
+
+    /**
+     * Append samples to the history.
+     *
+     * @param samples Source samples
+     * @param count Number of samples; must not exceed samplesNeeded()
+     */
+    void append(const int16_t* samples, int count);
+
+    /** Contiguous view of the ready window (windowLength samples). */
+    const int16_t* windowData() const;
+
+    /** Peak absolute value of the ready window. */
+    int32_t windowPeak();
+
+    /** Absolute index of the first sample of the ready window. */
+    int64_t windowStart() const { return nextWindowStart; }
+
+    /** Samples appended since the last reset. */
+    int64_t samplesAppended() const { return totalSamples; }
+
+    /** Move on to the next window (hopSize samples later). */
+    void advance() { nextWindowStart += hopSize; }
+
+    int getWindowLength() const { return windowLength; }
+    int getHopSize() const { return hopSize; }
+};
+
+#endif // SLIDING_WINDOW_H
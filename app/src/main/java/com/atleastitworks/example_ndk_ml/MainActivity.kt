@@ -4,11 +4,16 @@ package com.atleastitworks.example_ndk_ml
 // Import statements: UI, Audio, Permissions, and Threading components
 // ============================================================================
 import android.Manifest
+import android.content.BroadcastReceiver
+import android.content.Context
+import android.content.Intent
+import android.content.IntentFilter
 import android.content.pm.PackageManager
 import android.media.AudioFormat
 import android.media.AudioRecord
 import android.media.MediaRecorder
 import android.os.Bundle
+import android.os.PowerManager
 import android.util.Log
 import android.widget.Button
 import android.widget.ImageView
@@ -47,10 +52,18 @@ import kotlin.concurrent.thread
 // These constants define the ML model's input requirements and classification
 // thresholds for determining when to consider a prediction as valid.
 object Constants {
-    // MODEL_INPUT_LEN: The audio buffer size expected by the TensorFlow Lite model.
-    // The model expects exactly 512 audio samples per inference. This is a fixed
-    // requirement of the trained ML model - it won't work with different sizes.
-    const val MODEL_INPUT_LEN = 512
+    // STREAM_HOP_LEN: Samples between the starts of two consecutive model windows.
+    // Every captured sample is classified in overlapping model windows (their
+    // length is read from the model, 512 samples for the bundled one); a hop
+    // of 256 means 50% overlap there, so short sounds that would straddle a
+    // window boundary are still seen whole by at least one window. Models
+    // with shorter windows use their window length as the hop.
+    const val STREAM_HOP_LEN = 256
+
+    // STREAM_BATCH_LEN: Windows classified together in one native model invocation.
+    // A capture buffer yields a dozen or so windows; batching them amortizes the
+    // per-invoke overhead. Models without a resizable batch fall back to 1.
+    const val STREAM_BATCH_LEN = 4
     
     // MIN_RMS_VAL: Minimum Root Mean Square (RMS) threshold for audio detection.
     // RMS is a measure of audio signal loudness/energy. Below 0.005, the audio
@@ -62,6 +75,29 @@ object Constants {
     // Only predictions with confidence > 0.75 are shown to the user.
     // This prevents false positives and noisy predictions.
     const val MIN_CLASSIFICATION_VAL = 0.75
+
+    // EVENT_SMOOTHING_LEN / EVENT_OFF_VAL: The display only changes on class
+    // events. Window scores are averaged over EVENT_SMOOTHING_LEN windows; a
+    // class appears once its average exceeds MIN_CLASSIFICATION_VAL and stays
+    // until it drops below EVENT_OFF_VAL (hysteresis against flicker).
+    const val EVENT_SMOOTHING_LEN = 4
+    const val EVENT_OFF_VAL = 0.5
+
+    // CASCADE_*: Cheap native first stage in front of the model. A window is
+    // only classified if it is CASCADE_SNR_DB above the adaptive noise floor
+    // and crosses zero at most CASCADE_MAX_CROSSING_RATE times per sample
+    // (dial tones stay below ~0.08 at 44.1 kHz; hiss is near 0.5), plus
+    // CASCADE_HANGOVER_LEN windows after each detection. Loud but steady
+    // background noise therefore stops waking the model.
+    const val CASCADE_SNR_DB = 6.0
+    const val CASCADE_MAX_CROSSING_RATE = 0.25
+    const val CASCADE_HANGOVER_LEN = 4
+
+    // THROTTLE_THERMAL_STATUS: From this thermal status on (2 = MODERATE,
+    // see PowerManager.THERMAL_STATUS_*), or when inference takes more than
+    // 60% of the time, the native scheduler trades overlap and threads for
+    // headroom; full quality returns once the device has cooled down.
+    const val THROTTLE_THERMAL_STATUS = 2
 }
 
 // ============================================================================
@@ -97,8 +133,25 @@ class MainActivity : AppCompatActivity() {
     
     // Flag that tracks whether audio recording is currently active.
     // Used to control the recording loop in the background thread.
+    @Volatile
     private var isRecording = false
 
+    // Background thread running the capture and classification loop, kept
+    // so onDestroy can wait for it before freeing the native processor
+    private var recordingThread: Thread? = null
+
+    // Adapts the stream to thermal and load pressure while recording (set
+    // by the recording thread, read by powerSaveReceiver)
+    @Volatile
+    private var scheduler: NativeInferenceScheduler? = null
+
+    // Forwards battery saver changes to the running scheduler
+    private val powerSaveReceiver = object : BroadcastReceiver() {
+        override fun onReceive(context: Context, intent: Intent) {
+            scheduler?.setPowerSaveMode(isPowerSaveMode())
+        }
+    }
+
     // ========================================================================
     // COMPANION OBJECT: Static initialization
     // ========================================================================
@@ -106,6 +159,23 @@ class MainActivity : AppCompatActivity() {
         // Request code for Android's permission dialog. Arbitrary number used
         // to identify which permission request completed in onRequestPermissionsResult().
         private const val REQUEST_RECORD_AUDIO_PERMISSION = 200
+
+        // Longest wait in startRecording / onDestroy for the recording
+        // thread to stop (its loops wake at least every 100 ms or audio
+        // buffer)
+        private const val RECORDING_STOP_TIMEOUT_MS = 2000L
+
+        // Rate the dial-tone model was trained at
+        private const val MODEL_SAMPLE_RATE = 44100
+
+        // Native stream buffer for AAudio capture: ~370 ms at 44.1 kHz
+        private const val NATIVE_STREAM_CAPACITY = 16384
+
+        // Silent invokes at startup, so the first window runs at full speed
+        private const val WARM_UP_INVOKES = 2
+
+        // Read buffers in flight for the AudioRecord fallback (triple buffering)
+        private const val ASYNC_SLOTS = 3
         
         // Static initializer: Loads the native C++ library at app startup.
         // This makes all JNI functions available via System.loadLibrary().
@@ -115,30 +185,6 @@ class MainActivity : AppCompatActivity() {
         }
     }
 
-    // ========================================================================
-    // ASSET MANAGEMENT
-    // ========================================================================
-    /**
-     * Copies a binary asset file from the app bundle to the internal storage.
-     * 
-     * Why this is needed: Android app assets are packed in the APK and can only
-     * be read sequentially. TensorFlow Lite requires random access to the model
-     * file, so we must copy it to internal storage (app cache) first.
-     * 
-     * @param assetName The name of the asset file in app/src/main/assets/
-     * @param destPath The destination path in internal app storage
-     */
-    private fun copyAssetToFile(assetName: String, destPath: String) {
-        // Open asset as input stream and destination file as output stream.
-        // The .use {} block ensures streams are closed automatically.
-        assets.open(assetName).use { input ->
-            java.io.File(destPath).outputStream().use { output ->
-                // Copy all bytes from asset to the destination file
-                input.copyTo(output)
-            }
-        }
-    }
-
     // ========================================================================
     // ACTIVITY LIFECYCLE: onCreate
     // ========================================================================
@@ -178,18 +224,35 @@ class MainActivity : AppCompatActivity() {
         // ====================================================================
         resultText.text = "Loading Model..."
 
-        // The model file "conv-classifier-model.tflite" is stored in the APK's
-        // assets folder. We copy it to internal storage so TensorFlow Lite can
-        // access it properly (assets are sequential-access only).
-        val modelPath = "${filesDir.absolutePath}/conv-classifier-model.tflite"
-        copyAssetToFile("conv-classifier-model.tflite", modelPath)
+        // The model file "conv-classifier-model.tflite" is stored uncompressed
+        // in the APK's assets folder, so the native side maps it straight out
+        // of the APK instead of copying it to internal storage first.
+        val modelSource = NativeMLProcessor.ModelSource.Asset(assets, "conv-classifier-model.tflite")
         
-        // Create the native ML processor and pass the model path.
+        // Create the native ML processor over the mapped model.
         // This initializes the TensorFlow Lite interpreter in the native C++ code.
+        // XNNPACK is requested; the native side falls back to the plain CPU
+        // kernels if it is unavailable or slower on this device.
+        // The thread count is tuned on first launch and cached in filesDir,
+        // next to XNNPACK's packed weights, and a short warm-up absorbs the
+        // remaining one-time costs before the first recording. Inference stays
+        // on the performance cores, and the threads that carry audio run at
+        // urgent-audio priority.
         // If initialization fails, NativeMLProcessor throws an exception.
-        mlProcessor = NativeMLProcessor(modelPath)
-
-        resultText.text = "Model loaded, classifier initialized!"
+        mlProcessor = NativeMLProcessor(
+            modelSource,
+            NativeMLProcessor.Delegate.XNNPACK,
+            autoTuneThreads = true,
+            cacheDir = filesDir.absolutePath,
+            frontEnd = NativeMLProcessor.FrontEnd(modelSampleRate = MODEL_SAMPLE_RATE),
+            warmUpInvokes = WARM_UP_INVOKES,
+            delegateCache = true,
+            threadPolicy = NativeMLProcessor.ThreadPolicy(pinPerformanceCores = true,
+                streamPriority = NativeMLProcessor.ThreadPriority.URGENT_AUDIO)
+        )
+
+        resultText.text = "Model loaded (${mlProcessor.activeDelegate}, " +
+            "${mlProcessor.numThreads} threads), classifier initialized!"
         // ====================================================================
         // UI EVENT LISTENERS
         // ====================================================================
@@ -207,6 +270,10 @@ class MainActivity : AppCompatActivity() {
 
         // Initially disable the stop button (only enable it during recording)
         stopButton.isEnabled = false
+
+        // Battery saver lowers the stream quality while recording
+        registerReceiver(powerSaveReceiver,
+            IntentFilter(PowerManager.ACTION_POWER_SAVE_MODE_CHANGED))
     }
 
     // ========================================================================
@@ -252,14 +319,27 @@ class MainActivity : AppCompatActivity() {
      * classification in a background thread.
      * 
      * This function:
-     * 1. Updates UI state (disable start button, enable stop button)
-     * 2. Launches a background thread for audio processing
-     * 3. Continuously reads audio from the microphone
-     * 4. Sends audio buffers to the native ML processor
+     * 1. Waits for the previous recording thread to finish its cleanup, as
+     *    both share the native processor
+     * 2. Updates UI state (disable start button, enable stop button)
+     * 3. Launches a background thread for audio processing
+     * 4. Captures and classifies audio natively with AAudio, or on devices
+     *    without it reads the microphone with AudioRecord and sends each
+     *    buffer to the native ML processor
      * 5. Updates the UI with classification results
      * 6. Runs until the stop button is pressed
      */
     private fun startRecording() {
+        // After a quick Stop -> Start the old thread may still be closing
+        // capture, async classifier and scheduler and releasing arenas
+        val previous = recordingThread
+        previous?.join(RECORDING_STOP_TIMEOUT_MS)
+        if (previous?.isAlive == true) {
+            Log.w("MAIN", "Previous recording thread still stopping, not starting")
+            resultText.text = "Still stopping, try again"
+            return
+        }
+
         // Set the recording flag to true; used to control the recording loop
         isRecording = true
         
@@ -274,14 +354,18 @@ class MainActivity : AppCompatActivity() {
 
         // Launch background thread to handle audio recording (non-blocking).
         // Running audio processing on the main thread would freeze the UI.
-        thread @androidx.annotation.RequiresPermission(android.Manifest.permission.RECORD_AUDIO) {
+        recordingThread = thread @androidx.annotation.RequiresPermission(android.Manifest.permission.RECORD_AUDIO) {
+            // This thread reads AudioRecord and feeds the stream in the
+            // fallback path: pin it and raise it like the native workers
+            Log.i("MAIN", "Recording thread at ${mlProcessor.prepareStreamThread()} priority")
+
             // ================================================================
             // AUDIO CONFIGURATION
             // ================================================================
             
             // Sample rate: 44100 Hz is a standard audio rate for Android.
             // Matches common MP3/AAC quality and the model's expectations.
-            val sampleRate = 44100
+            val sampleRate = MODEL_SAMPLE_RATE
             
             // Buffer size calculation: AudioRecord needs a minimum buffer to
             // efficiently capture audio. We request the minimum and multiply by 2
@@ -292,11 +376,12 @@ class MainActivity : AppCompatActivity() {
                 AudioFormat.ENCODING_PCM_16BIT
             ) * 2
 
-            // Ensure buffer is at least the size the ML model expects.
-            // The model requires exactly 512 samples per inference.
+            // Ensure buffer holds at least one model window (read from the
+            // model's input shape; 2 bytes per 16-bit sample).
             // If bufferSize is smaller, we can't provide valid input to the model.
-            if (bufferSize < Constants.MODEL_INPUT_LEN) {
-                bufferSize = Constants.MODEL_INPUT_LEN
+            val windowBytes = mlProcessor.windowLength * 2
+            if (bufferSize < windowBytes) {
+                bufferSize = windowBytes
             }
 
             // ================================================================
@@ -320,7 +405,49 @@ class MainActivity : AppCompatActivity() {
             }
 
             // ================================================================
-            // AUDIO RECORDING SETUP
+            // NATIVE CAPTURE (AAudio)
+            // ================================================================
+            // The silence gate, smoothing and hysteresis run natively, so
+            // only class changes come back (reused between calls).
+            mlProcessor.setDecisionThresholds(Constants.MIN_RMS_VAL.toFloat(),
+                Constants.MIN_CLASSIFICATION_VAL.toFloat())
+            mlProcessor.configureEvents(Constants.EVENT_SMOOTHING_LEN,
+                Constants.MIN_CLASSIFICATION_VAL.toFloat(), Constants.EVENT_OFF_VAL.toFloat())
+            mlProcessor.configureCascade(Constants.CASCADE_SNR_DB.toFloat(),
+                maxCrossingRate = Constants.CASCADE_MAX_CROSSING_RATE.toFloat(),
+                hangoverWindows = Constants.CASCADE_HANGOVER_LEN)
+            val events = NativeMLProcessor.Events()
+
+            // Preferred path: AAudio writes the microphone samples straight
+            // into the native stream and a native worker classifies them,
+            // so no audio crosses JNI. The stream buffer absorbs a few
+            // hundred milliseconds of inference hiccups. Capture runs at the
+            // device's native rate (no resampling inside AAudio, lowest
+            // latency) and the native front end resamples to the model rate.
+            mlProcessor.configureStream(streamHopSize(), NATIVE_STREAM_CAPACITY,
+                Constants.STREAM_BATCH_LEN)
+            val nativeScheduler = startScheduler()
+            val capture = NativeAudioCapture(mlProcessor)
+            if (capture.start()) {
+                Log.i("MAIN", "Native capture running (exclusive: ${capture.isExclusive})")
+                while (isRecording && capture.isRunning) {
+                    showEvents(events, capture.awaitEvents(events))
+                }
+                // Scheduler first: restoring full quality swaps the engine,
+                // which the still running capture worker adopts
+                stopScheduler(nativeScheduler)
+                Log.i("MAIN", "Native capture stopped (${capture.droppedSamples} samples dropped, " +
+                    "${capture.xRunCount} xruns), ${mlProcessor.getCascadeStats()}")
+                capture.close()
+                releaseInferenceMemory()
+                return@thread
+            }
+            capture.close()
+            stopScheduler(nativeScheduler)
+            Log.i("MAIN", "AAudio unavailable, falling back to AudioRecord")
+
+            // ================================================================
+            // AUDIO RECORDING SETUP (AudioRecord fallback)
             // ================================================================
             // Create AudioRecord object to capture audio from the microphone.
             // Parameters:
@@ -345,6 +472,24 @@ class MainActivity : AppCompatActivity() {
             // Size is bufferSize/2 because each short is 2 bytes.
             val audioBuffer = ShortArray(bufferSize / 2)
 
+            // ================================================================
+            // STREAMING CLASSIFIER SETUP
+            // ================================================================
+            // Every read is pushed into the native stream, which classifies
+            // each overlapping window of the model's window length. The stream
+            // buffer holds two reads so a full read always fits.
+            val streamCapacity = audioBuffer.size * 2
+            mlProcessor.configureStream(streamHopSize(), streamCapacity,
+                Constants.STREAM_BATCH_LEN)
+            val recordScheduler = startScheduler()
+
+            // Inference runs on a native worker with ASYNC_SLOTS read
+            // buffers, so the next read() overlaps classification of the
+            // previous one instead of waiting for it.
+            val async = NativeAsyncClassifier(mlProcessor)
+            async.start(ASYNC_SLOTS, audioBuffer.size)
+            val completion = NativeAsyncClassifier.Completion()
+
             // Log: mark the start of the classification loop
             Log.i("MAIN", "Entering classification loop")
             
@@ -359,82 +504,30 @@ class MainActivity : AppCompatActivity() {
 
                 // Only process if we successfully read audio samples
                 if (readSize > 0) {
-                    // ============================================================
-                    // STEP 1: Calculate audio loudness (RMS - Root Mean Square)
-                    // ============================================================
-                    val rmsValue = calculateRMS(audioBuffer)
-                    // Optional debug: Log the RMS value
-                    // Log.i("MAIN", "RMS Value: $rmsValue")
-
-                    // ============================================================
-                    // STEP 2: Check if audio is loud enough to process
-                    // ============================================================
-                    // If RMS is below threshold, it's likely silence.
-                    // Skip ML inference to save CPU power.
-                    if (rmsValue > Constants.MIN_RMS_VAL) {
-                        // ======================================================
-                        // STEP 3: Send audio to ML processor
-                        // ======================================================
-                        // Call the native C++ function to perform inference.
-                        // processAudio() returns an array of confidence scores
-                        // (one score per possible classification class).
-                        val result = mlProcessor.processAudio(audioBuffer)
-                        
-                        // Find the class with the highest confidence score
-                        val maxIndex = result.indices.maxByOrNull { result[it] }
-                        
-                        // If we found a valid result
-                        if (maxIndex != null) {
-                            // Log the prediction for debugging
-                            // Log.i("MAIN", "Classification Value: ${result[maxIndex]} ($maxIndex). RMS Value: $rmsValue")
-
-                            // ================================================
-                            // STEP 4: Check confidence threshold
-                            // ================================================
-                            // Only show predictions with high confidence to reduce
-                            // false positives and noisy classifications.
-                            if (result[maxIndex] > Constants.MIN_CLASSIFICATION_VAL) {
-                                // High confidence: show the prediction to user
-                                runOnUiThread {
-                                    // Show prediction data
-                                    resultText.text = "Classification Value: ${result[maxIndex]} (idx: $maxIndex). RMS Value: $rmsValue"
-                                    // Assign the corresponding image
-                                    when (maxIndex) {
-                                        0 -> numImage.setImageResource(R.drawable.icon_0)
-                                        1 -> numImage.setImageResource(R.drawable.icon_1)
-                                        2 -> numImage.setImageResource(R.drawable.icon_2)
-                                        3 -> numImage.setImageResource(R.drawable.icon_3)
-                                        4 -> numImage.setImageResource(R.drawable.icon_4)
-                                        5 -> numImage.setImageResource(R.drawable.icon_5)
-                                        6 -> numImage.setImageResource(R.drawable.icon_6)
-                                        7 -> numImage.setImageResource(R.drawable.icon_7)
-                                        8 -> numImage.setImageResource(R.drawable.icon_8)
-                                        9 -> numImage.setImageResource(R.drawable.icon_9)
-                                        10 -> numImage.setImageResource(R.drawable.icon_10)
-                                        11 -> numImage.setImageResource(R.drawable.icon_11)
-                                    }
-
-                                }
-                            } else {
-                                // Low confidence: don't confuse user with noise
-                                runOnUiThread {
-                                    resultText.text = "No confidence."
-                                    numImage.setImageResource(R.drawable.idle)
-                                }
-                            }
-                        }
-
-                    } else {
-                        // Audio is too quiet: show "No signal" message
-                        runOnUiThread {
-                            resultText.text = "No signal."
-                            numImage.setImageResource(R.drawable.idle)
+                    // The native side computes the RMS of the read, skips
+                    // inference (and resets the stream) if it is below
+                    // MIN_RMS_VAL, otherwise classifies every window the read
+                    // completes and reports the class changes they cause.
+                    // All slots busy means inference is slower than capture:
+                    // wait for the oldest read instead of dropping this one.
+                    while (async.submit(audioBuffer, readSize) < 0) {
+                        if (async.await(completion)) {
+                            showEvents(completion.events, completion.eventCount)
                         }
                     }
                 }
+                // Show whatever finished meanwhile, without blocking the reads
+                while (async.poll(completion)) {
+                    showEvents(completion.events, completion.eventCount)
+                }
             }
             // Log: mark the end of the classification loop
-            Log.i("MAIN", "Exiting classification loop")
+            Log.i("MAIN", "Exiting classification loop (${async.rejectedCount} reads waited " +
+                "for a free slot)")
+            stopScheduler(recordScheduler)
+            async.close()
+            Log.i("MAIN", mlProcessor.getCascadeStats().toString())
+            releaseInferenceMemory()
 
             // ================================================================
             // AUDIO RECORDING CLEANUP
@@ -447,41 +540,104 @@ class MainActivity : AppCompatActivity() {
         }
     }
 
-    // ========================================================================
-    // AUDIO ANALYSIS
-    // ========================================================================
     /**
-     * Calculates the Root Mean Square (RMS) of audio samples.
-     * 
-     * RMS is a measure of average audio signal loudness/energy.
-     * Values range from 0.0 (silence) to 1.0 (maximum loudness).
-     * 
-     * Formula:
-     *   RMS = sqrt(sum(samples[i]^2) / num_samples)
-     * 
-     * This is used to detect if there's meaningful audio (non-silence) before
-     * sending the buffer to the ML model, which saves CPU power.
-     * 
-     * @param audioData Array of 16-bit PCM audio samples
-     * @return RMS value between 0.0 and 1.0
+     * Start adapting the configured stream to thermal, load and battery
+     * pressure: under pressure the hop widens to the window length and
+     * inference drops to one thread, and both come back with headroom.
      */
-    private fun calculateRMS(audioData: ShortArray): Double {
-        // Accumulator for sum of squared samples
-        var sum = 0.0
-        
-        // Iterate through all audio samples
-        for (sample in audioData) {
-            // Normalize the 16-bit signed value to -1.0 to 1.0 range
-            // Java shorts are 16-bit signed integers: range -32768 to 32767
-            // Dividing by 32768.0 converts to float in [-1.0, 1.0]
-            val normalized = sample / 32768.0
-            
-            // Add the square of the normalized sample to accumulate
-            sum += normalized * normalized
+    private fun startScheduler(): NativeInferenceScheduler {
+        val started = NativeInferenceScheduler(mlProcessor,
+            throttleThermalStatus = Constants.THROTTLE_THERMAL_STATUS)
+        started.setPowerSaveMode(isPowerSaveMode())
+        started.start()
+        scheduler = started
+        return started
+    }
+
+    /**
+     * Stop the scheduler (restoring full quality) and log what it did.
+     */
+    private fun stopScheduler(stopped: NativeInferenceScheduler) {
+        scheduler = null
+        Log.i("MAIN", "Scheduler: ${stopped.getStatus()}")
+        stopped.close()
+    }
+
+    /**
+     * Nothing classifies until the next recording: log where inference ran,
+     * then give the interpreter's arenas and delegate buffers back (rebuilt
+     * on the first window).
+     */
+    private fun releaseInferenceMemory() {
+        Log.i("MAIN", mlProcessor.getCoreUsage().toString())
+        Log.i("MAIN", mlProcessor.getMemoryReport().toString())
+        mlProcessor.releaseMemory()
+    }
+
+    private fun isPowerSaveMode(): Boolean =
+        getSystemService(PowerManager::class.java)?.isPowerSaveMode ?: false
+
+    /**
+     * Stream hop for the loaded model: [Constants.STREAM_HOP_LEN], capped at
+     * the model's window length so shorter windows never leave gaps. A
+     * stateful model keeps the overlap itself and steps by its window length.
+     */
+    private fun streamHopSize(): Int =
+        if (mlProcessor.isStateful) mlProcessor.windowLength
+        else minOf(Constants.STREAM_HOP_LEN, mlProcessor.windowLength)
+
+    /**
+     * Show the state after the latest class event: the class image while a
+     * class is on, "Listening..." once it ended. Nothing is posted when
+     * [count] is 0, so the UI is only touched on class changes.
+     *
+     * Called from the recording thread; UI updates are posted to the main thread.
+     */
+    private fun showEvents(events: NativeMLProcessor.Events, count: Int) {
+        if (count <= 0) {
+            return
+        }
+        // Earlier events of the batch are already superseded
+        val last = count - 1
+        val maxIndex = events.classIndices[last]
+        val maxScore = events.scores[last]
+
+        // Optional debug: Log the event
+        // Log.i("MAIN", "Class $maxIndex ${if (events.isOnset(last)) "on" else "off"}: $maxScore")
+
+        if (!events.isOnset(last)) {
+            // ==============================================================
+            // STEP 1: The class ended (silence or low confidence)
+            // ==============================================================
+            runOnUiThread {
+                resultText.text = "Listening..."
+                numImage.setImageResource(R.drawable.idle)
+            }
+            return
+        }
+
+        // ==================================================================
+        // STEP 2: A class started: show the prediction to user
+        // ==================================================================
+        runOnUiThread {
+            // Show prediction data
+            resultText.text = "Classification Value: $maxScore (idx: $maxIndex)"
+            // Assign the corresponding image
+            when (maxIndex) {
+                0 -> numImage.setImageResource(R.drawable.icon_0)
+                1 -> numImage.setImageResource(R.drawable.icon_1)
+                2 -> numImage.setImageResource(R.drawable.icon_2)
+                3 -> numImage.setImageResource(R.drawable.icon_3)
+                4 -> numImage.setImageResource(R.drawable.icon_4)
+                5 -> numImage.setImageResource(R.drawable.icon_5)
+                6 -> numImage.setImageResource(R.drawable.icon_6)
+                7 -> numImage.setImageResource(R.drawable.icon_7)
+                8 -> numImage.setImageResource(R.drawable.icon_8)
+                9 -> numImage.setImageResource(R.drawable.icon_9)
+                10 -> numImage.setImageResource(R.drawable.icon_10)
+                11 -> numImage.setImageResource(R.drawable.icon_11)
+            }
         }
-        
-        // Return the square root of the mean (average) of squared values
-        return kotlin.math.sqrt(sum / audioData.size)
     }
 
     // ========================================================================
@@ -521,7 +677,23 @@ class MainActivity : AppCompatActivity() {
     override fun onDestroy() {
         // Call parent class cleanup first
         super.onDestroy()
-        
+
+        // Stop forwarding battery saver changes
+        unregisterReceiver(powerSaveReceiver)
+
+        // Stop the recording loop and wait for it: the native capture, the
+        // async workers and the scheduler all run on the native processor
+        // until the thread has closed them
+        isRecording = false
+        val recorder = recordingThread
+        recordingThread = null
+        recorder?.join(RECORDING_STOP_TIMEOUT_MS)
+        if (recorder?.isAlive == true) {
+            // Leaking the processor beats freeing it under a running stream
+            Log.e("MAIN", "Recording thread did not stop, native processor not released")
+            return
+        }
+
         // Clean up the native ML processor: releases TensorFlow Lite resources,
         // deallocates memory, and closes the model file handle.
         mlProcessor.close()
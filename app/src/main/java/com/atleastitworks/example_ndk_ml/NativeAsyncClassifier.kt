@@ -0,0 +1,190 @@
+package com.atleastitworks.example_ndk_ml
+
+// ============================================================================
+// NATIVE ASYNC CLASSIFIER: Overlap Capture and Inference
+// ============================================================================
+/**
+ * Submit / poll front end for a [NativeMLProcessor].
+ *
+ * [submit] copies a block into one of a few pre-allocated native slots and
+ * returns at once; a native worker classifies the slots in order. The
+ * caller can therefore read block N+1 from the microphone while block N is
+ * being inferred, and collects results with [await] / [poll] (future-like:
+ * each result carries the ticket [submit] returned).
+ *
+ * Do not use [processor] directly between [start] and [stop]: the worker
+ * owns it. The processor must stay open while this object is in use.
+ */
+class NativeAsyncClassifier(processor: NativeMLProcessor) {
+
+    /**
+     * Handle (pointer) to the native AsyncClassifier, 0 once closed.
+     */
+    private var nativeHandle: Long = nativeCreate(processor.handle)
+
+    // Native status layout: {ticket, eventCount}
+    private val statusValues = LongArray(2)
+
+    // Native result layout: {classIndex, score, rms, windows}
+    private val resultValues = FloatArray(4)
+
+    /**
+     * Result of one submitted block (reused between calls).
+     */
+    class Completion {
+        /** Ticket returned by [submit] for the block. */
+        var ticket: Long = -1
+            internal set
+        val classification = NativeMLProcessor.Classification()
+        /** Class events caused by the block (streamed blocks only). */
+        val events = NativeMLProcessor.Events(MAX_EVENTS)
+        var eventCount: Int = 0
+            internal set
+    }
+
+    // ========================================================================
+    // PUBLIC API
+    // ========================================================================
+
+    /**
+     * Allocate the slots and start the native worker.
+     *
+     * @param slots Blocks in flight at most: 2 = double, 3 = triple buffering
+     * @param slotSamples Largest block [submit] accepts
+     * @return false if already running or the parameters are invalid
+     * @throws IllegalStateException if the classifier is closed
+     */
+    fun start(slots: Int = 3, slotSamples: Int): Boolean {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native async classifier closed")
+        }
+        return nativeStart(nativeHandle, slots, slotSamples)
+    }
+
+    /**
+     * Hand a block to the worker without waiting for inference.
+     *
+     * @param audioData Array of 16-bit PCM audio samples (copied)
+     * @param length Number of valid samples at the start of [audioData]
+     * @param stream true: [NativeMLProcessor.classifyStream] (configure the
+     *        stream first); false: [NativeMLProcessor.classify] of one window
+     * @return Ticket of the block, or -1 if every slot is in flight
+     *         (collect a result first) or the block is larger than a slot
+     * @throws IllegalStateException if the classifier is closed
+     */
+    fun submit(audioData: ShortArray, length: Int = audioData.size, stream: Boolean = true): Long {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native async classifier closed")
+        }
+        return nativeSubmit(nativeHandle, audioData, length, stream)
+    }
+
+    /**
+     * Wait for the oldest outstanding block. Results arrive in submission
+     * order.
+     *
+     * @param completion Receives the result (reused between calls)
+     * @param timeoutMs Longest wait
+     * @return false on timeout, or if nothing is in flight
+     */
+    fun await(completion: Completion, timeoutMs: Int = 100): Boolean {
+        if (nativeHandle == 0L) {
+            return false
+        }
+        val events = completion.events
+        if (!nativeWait(nativeHandle, timeoutMs, statusValues, resultValues,
+                events.classIndices, events.scores, events.onsetSamples, events.offsetSamples)) {
+            return false
+        }
+        completion.ticket = statusValues[0]
+        completion.eventCount = statusValues[1].toInt()
+        completion.classification.classIndex = resultValues[0].toInt()
+        completion.classification.score = resultValues[1]
+        completion.classification.rms = resultValues[2]
+        completion.classification.windows = resultValues[3].toInt()
+        return true
+    }
+
+    /**
+     * Collect the oldest result if it is already done (never blocks).
+     */
+    fun poll(completion: Completion): Boolean = await(completion, 0)
+
+    /**
+     * Blocks submitted and not yet collected.
+     */
+    val inFlight: Int
+        get() = if (nativeHandle == 0L) 0 else nativeInFlight(nativeHandle)
+
+    /**
+     * [submit] calls refused because every slot was in flight.
+     */
+    val rejectedCount: Long
+        get() = if (nativeHandle == 0L) 0 else nativeGetRejected(nativeHandle)
+
+    /**
+     * Stop the worker; blocks not started yet are discarded and the
+     * processor can be used directly again.
+     */
+    fun stop() {
+        if (nativeHandle != 0L) {
+            nativeStop(nativeHandle)
+        }
+    }
+
+    /**
+     * Stop the worker and release the native classifier.
+     *
+     * Safe to call multiple times; subsequent calls are no-ops.
+     */
+    fun close() {
+        if (nativeHandle != 0L) {
+            nativeClose(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    protected fun finalize() {
+        close()
+    }
+
+    companion object {
+        // Events returned per block at most (AsyncResult::kMaxEvents)
+        const val MAX_EVENTS = 8
+    }
+
+    // ========================================================================
+    // JNI FUNCTION DECLARATIONS
+    // ========================================================================
+    // Implemented in jni_wrapper.cpp (NATIVE ASYNC CLASSIFIER section).
+
+    private external fun nativeCreate(processorHandle: Long): Long
+
+    private external fun nativeStart(handle: Long, slots: Int, slotSamples: Int): Boolean
+
+    private external fun nativeSubmit(
+        handle: Long,
+        audioData: ShortArray,
+        length: Int,
+        stream: Boolean
+    ): Long
+
+    private external fun nativeWait(
+        handle: Long,
+        timeoutMs: Int,
+        status: LongArray,
+        result: FloatArray,
+        classIndices: IntArray,
+        scores: FloatArray,
+        onsets: LongArray,
+        offsets: LongArray
+    ): Boolean
+
+    private external fun nativeInFlight(handle: Long): Int
+
+    private external fun nativeGetRejected(handle: Long): Long
+
+    private external fun nativeStop(handle: Long): Unit
+
+    private external fun nativeClose(handle: Long): Unit
+}
@@ -0,0 +1,190 @@
+package com.atleastitworks.example_ndk_ml
+
+// ============================================================================
+// NATIVE AUDIO CAPTURE: AAudio Microphone Input Classified Natively
+// ============================================================================
+/**
+ * Low-latency microphone capture that never hands audio to the JVM.
+ *
+ * An AAudio input stream (exclusive, low-latency mode where available)
+ * writes captured samples straight into [processor]'s native stream from
+ * its real-time callback, and a native worker thread classifies them.
+ * Kotlin only receives decisions through [awaitResult].
+ *
+ * Configure the processor first ([NativeMLProcessor.configureStream] and
+ * [NativeMLProcessor.setDecisionThresholds]) and do not use its streaming
+ * or decision API while capture runs. The processor must stay open while
+ * this object is in use.
+ *
+ * Use [isAvailable] / the return value of [start] to fall back to
+ * AudioRecord on devices without AAudio (before Android 8.0).
+ *
+ * The RECORD_AUDIO permission must be granted before [start].
+ */
+class NativeAudioCapture(processor: NativeMLProcessor) {
+
+    /**
+     * Handle (pointer) to the native AudioCapture, 0 if AAudio is missing
+     * or the capture was closed.
+     */
+    private var nativeHandle: Long = nativeCreate(processor.handle)
+
+    // Native result layout: {classIndex, score, rms, windows}
+    private val resultValues = FloatArray(4)
+
+    /**
+     * True if AAudio could be loaded on this device.
+     */
+    val isAvailable: Boolean
+        get() = nativeHandle != 0L
+
+    // ========================================================================
+    // PUBLIC API
+    // ========================================================================
+
+    /**
+     * Open the input stream and start classifying.
+     *
+     * @param sampleRate Capture rate, or 0 for the device's native rate
+     *        (lowest latency). Audio is resampled to the processor's
+     *        [NativeMLProcessor.FrontEnd.modelSampleRate] when one is set,
+     *        which native-rate capture requires.
+     * @param exclusive Request exclusive access to the input device
+     * @return false if AAudio is unavailable or the device cannot capture
+     *         at [sampleRate]
+     */
+    fun start(sampleRate: Int = 0, exclusive: Boolean = true): Boolean {
+        if (nativeHandle == 0L) {
+            return false
+        }
+        return nativeStart(nativeHandle, sampleRate, exclusive)
+    }
+
+    /**
+     * Wait for the next decision of the native worker.
+     *
+     * A decision arrives for every group of windows classified, and once
+     * when the audio turns silent ([NativeMLProcessor.Classification.windows]
+     * is 0). Only the latest decision is kept, so a slow caller skips
+     * intermediate ones instead of falling behind.
+     *
+     * @param result Receives the decision (reused between calls)
+     * @param timeoutMs Longest wait
+     * @return false on timeout, or once capture has stopped (see [isRunning])
+     */
+    fun awaitResult(result: NativeMLProcessor.Classification, timeoutMs: Int = 100): Boolean {
+        if (nativeHandle == 0L) {
+            return false
+        }
+        if (!nativeWaitForResult(nativeHandle, timeoutMs, resultValues)) {
+            return false
+        }
+        result.classIndex = resultValues[0].toInt()
+        result.score = resultValues[1]
+        result.rms = resultValues[2]
+        result.windows = resultValues[3].toInt()
+        return true
+    }
+
+    /**
+     * Wait for class events of the native worker (requires
+     * [NativeMLProcessor.configureEvents] before [start]).
+     *
+     * Events are queued, not overwritten, so every class change arrives
+     * (up to 64 pending ones), and nothing crosses JNI while the class
+     * stays the same.
+     *
+     * @param events Receives the events (reused between calls)
+     * @param timeoutMs Longest wait
+     * @return Number of events written, 0 on timeout or once capture stopped
+     */
+    fun awaitEvents(events: NativeMLProcessor.Events, timeoutMs: Int = 100): Int {
+        if (nativeHandle == 0L) {
+            return 0
+        }
+        return nativeWaitForEvents(nativeHandle, timeoutMs, events.classIndices, events.scores,
+            events.onsetSamples, events.offsetSamples)
+    }
+
+    /**
+     * True while the stream and the native worker run. Turns false after
+     * [stop], or if the input device disappeared and could not be reopened.
+     */
+    val isRunning: Boolean
+        get() = nativeHandle != 0L && nativeIsRunning(nativeHandle)
+
+    /**
+     * True if the stream got exclusive access to the input device.
+     */
+    val isExclusive: Boolean
+        get() = nativeHandle != 0L && nativeIsExclusive(nativeHandle)
+
+    /**
+     * Samples dropped since [start] because inference fell behind capture.
+     */
+    val droppedSamples: Long
+        get() = if (nativeHandle == 0L) 0 else nativeGetDroppedSamples(nativeHandle)
+
+    /**
+     * Overruns reported by AAudio for the current stream.
+     */
+    val xRunCount: Int
+        get() = if (nativeHandle == 0L) 0 else nativeGetXRunCount(nativeHandle)
+
+    /**
+     * Stop capturing; [awaitResult] returns false from now on.
+     */
+    fun stop() {
+        if (nativeHandle != 0L) {
+            nativeStop(nativeHandle)
+        }
+    }
+
+    /**
+     * Stop capturing and release the native engine.
+     *
+     * Safe to call multiple times; subsequent calls are no-ops.
+     */
+    fun close() {
+        if (nativeHandle != 0L) {
+            nativeClose(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    protected fun finalize() {
+        close()
+    }
+
+    // ========================================================================
+    // JNI FUNCTION DECLARATIONS
+    // ========================================================================
+    // Implemented in jni_wrapper.cpp (NATIVE AUDIO CAPTURE section).
+
+    private external fun nativeCreate(processorHandle: Long): Long
+
+    private external fun nativeStart(handle: Long, sampleRate: Int, exclusive: Boolean): Boolean
+
+    private external fun nativeWaitForResult(handle: Long, timeoutMs: Int, result: FloatArray): Boolean
+
+    private external fun nativeWaitForEvents(
+        handle: Long,
+        timeoutMs: Int,
+        classIndices: IntArray,
+        scores: FloatArray,
+        onsets: LongArray,
+        offsets: LongArray
+    ): Int
+
+    private external fun nativeIsRunning(handle: Long): Boolean
+
+    private external fun nativeIsExclusive(handle: Long): Boolean
+
+    private external fun nativeGetDroppedSamples(handle: Long): Long
+
+    private external fun nativeGetXRunCount(handle: Long): Int
+
+    private external fun nativeStop(handle: Long): Unit
+
+    private external fun nativeClose(handle: Long): Unit
+}
@@ -0,0 +1,191 @@
+package com.atleastitworks.example_ndk_ml
+
+// ============================================================================
+// NATIVE INFERENCE SCHEDULER: Thermal- and Load-Aware Quality
+// ============================================================================
+/**
+ * Keeps a [NativeMLProcessor] stream real-time on a throttling device.
+ *
+ * A native monitor thread samples, every [intervalMs], the device thermal
+ * status, the share of time the stream's consumer spends in inference and
+ * its p95 call latency. Under pressure it lowers the quality one
+ * [QualityLevel] at a time (wider stream hop, fewer threads, another
+ * delegate, a lighter model) and restores it after several calm intervals
+ * in a row. Engine changes are hot swaps built on the monitor thread, so
+ * the stream never stops.
+ *
+ * Create and [start] it after [NativeMLProcessor.configureStream] and
+ * before capture starts. While it runs, do not swap the processor's model
+ * directly. The processor must stay open while this object is in use.
+ *
+ * @param processor Processor whose stream is scheduled
+ * @param intervalMs How often the signals are sampled
+ * @param throttleThermalStatus Thermal status (PowerManager.THERMAL_STATUS_*)
+ *        from which the quality is reduced, one more step per status above
+ * @param maxLoad Consumer duty cycle above which the stream is falling behind
+ * @param recoverLoad Duty cycle below which the stream has headroom again
+ * @param maxLatencyMs p95 call latency above which the stream is falling
+ *        behind (0 disables the check)
+ * @param recoverIntervals Calm intervals in a row before one step is undone
+ * @param throttledHop Hop of [QualityLevel.WIDE_HOP] (0: window length)
+ * @param throttledThreads Threads of [QualityLevel.FEWER_THREADS]
+ * @param throttledDelegate Backend of [QualityLevel.DELEGATE] (null skips it)
+ * @param lightModelPath Model of [QualityLevel.LIGHT_MODEL], e.g. the int8
+ *        build of the same network (null skips it)
+ */
+class NativeInferenceScheduler(
+    processor: NativeMLProcessor,
+    intervalMs: Int = 1000,
+    throttleThermalStatus: Int = 2,
+    maxLoad: Float = 0.6f,
+    recoverLoad: Float = 0.3f,
+    maxLatencyMs: Float = 0.0f,
+    recoverIntervals: Int = 5,
+    throttledHop: Int = 0,
+    throttledThreads: Int = 1,
+    throttledDelegate: NativeMLProcessor.Delegate? = null,
+    lightModelPath: String? = null
+) {
+
+    /**
+     * Handle (pointer) to the native InferenceScheduler, 0 once closed.
+     */
+    private var nativeHandle: Long = nativeCreate(processor.handle, intervalMs,
+        throttleThermalStatus, maxLoad, recoverLoad, maxLatencyMs, recoverIntervals,
+        throttledHop, throttledThreads, throttledDelegate?.id ?: -1, lightModelPath)
+
+    // Native status layout:
+    // {level, thermalStatus, powerSave, load, p95Ms, throttles, restores}
+    private val statusValues = DoubleArray(7)
+
+    init {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Failed to create native inference scheduler")
+        }
+    }
+
+    /**
+     * Steps of the quality ladder (QualityLevel in inference_scheduler.h).
+     * Each level keeps the reductions of the levels before it.
+     */
+    enum class QualityLevel(val id: Int) {
+        FULL(0),           // Settings the processor and stream were set up with
+        WIDE_HOP(1),       // Fewer windows per second
+        FEWER_THREADS(2),  // Less parallel inference
+        DELEGATE(3),       // Another backend
+        LIGHT_MODEL(4);    // Lighter model
+
+        companion object {
+            fun fromId(id: Int): QualityLevel = values().firstOrNull { it.id == id } ?: FULL
+        }
+    }
+
+    /**
+     * What the scheduler saw and did on its last interval.
+     */
+    data class Status(
+        val level: QualityLevel,
+        val thermalStatus: Int,   // -1 if the thermal API is unavailable
+        val powerSave: Boolean,
+        val load: Float,          // Consumer duty cycle
+        val p95LatencyMs: Float,
+        val throttles: Long,      // Steps down since start
+        val restores: Long        // Steps back up since start
+    )
+
+    // ========================================================================
+    // PUBLIC API
+    // ========================================================================
+
+    /**
+     * Capture the current settings as full quality and start monitoring.
+     *
+     * @return false if already running or the stream is not configured
+     * @throws IllegalStateException if the scheduler is closed
+     */
+    fun start(): Boolean {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native inference scheduler closed")
+        }
+        return nativeStart(nativeHandle)
+    }
+
+    /**
+     * Battery hint (e.g. [android.os.PowerManager.isPowerSaveMode]): while
+     * set, the stream stays at [QualityLevel.WIDE_HOP] or lower quality.
+     */
+    fun setPowerSaveMode(enabled: Boolean) {
+        if (nativeHandle != 0L) {
+            nativeSetPowerSaveMode(nativeHandle, enabled)
+        }
+    }
+
+    /**
+     * Status of the last interval.
+     *
+     * @throws IllegalStateException if the scheduler is closed
+     */
+    fun getStatus(): Status {
+        if (nativeHandle == 0L || !nativeGetStatus(nativeHandle, statusValues)) {
+            throw IllegalStateException("Native inference scheduler closed")
+        }
+        return Status(QualityLevel.fromId(statusValues[0].toInt()), statusValues[1].toInt(),
+            statusValues[2] != 0.0, statusValues[3].toFloat(), statusValues[4].toFloat(),
+            statusValues[5].toLong(), statusValues[6].toLong())
+    }
+
+    /**
+     * Stop monitoring and restore full quality.
+     */
+    fun stop() {
+        if (nativeHandle != 0L) {
+            nativeStop(nativeHandle)
+        }
+    }
+
+    /**
+     * Stop monitoring, restore full quality and release the native
+     * scheduler.
+     *
+     * Safe to call multiple times; subsequent calls are no-ops.
+     */
+    fun close() {
+        if (nativeHandle != 0L) {
+            nativeClose(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    protected fun finalize() {
+        close()
+    }
+
+    // ========================================================================
+    // JNI FUNCTION DECLARATIONS
+    // ========================================================================
+    // Implemented in jni_wrapper.cpp (NATIVE INFERENCE SCHEDULER section).
+
+    private external fun nativeCreate(
+        processorHandle: Long,
+        intervalMs: Int,
+        throttleThermalStatus: Int,
+        maxLoad: Float,
+        recoverLoad: Float,
+        maxLatencyMs: Float,
+        recoverIntervals: Int,
+        throttledHop: Int,
+        throttledThreads: Int,
+        throttledDelegate: Int,
+        lightModelPath: String?
+    ): Long
+
+    private external fun nativeStart(handle: Long): Boolean
+
+    private external fun nativeSetPowerSaveMode(handle: Long, enabled: Boolean): Unit
+
+    private external fun nativeGetStatus(handle: Long, status: DoubleArray): Boolean
+
+    private external fun nativeStop(handle: Long): Unit
+
+    private external fun nativeClose(handle: Long): Unit
+}
@@ -1,5 +1,10 @@
 package com.atleastitworks.example_ndk_ml
 
+import android.content.res.AssetFileDescriptor
+import android.content.res.AssetManager
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
 // ============================================================================
 // NATIVE ML PROCESSOR: JNI Bridge to C++ TensorFlow Lite Implementation
 // ============================================================================
@@ -12,13 +17,183 @@ package com.atleastitworks.example_ndk_ml
  * provides a clean Kotlin API for audio classification.
  * 
  * The native library is compiled from app/src/main/cpp/example_ndk_ml.cpp
- * and provides three main functions:
- * - nativeInit: Create and initialize a TensorFlow Lite interpreter
+ * and provides these main functions:
+ * - nativeInit / nativeInitFromAsset / nativeInitFromFd: Create and
+ *   initialize a TensorFlow Lite interpreter (from a file, or mmapped
+ *   straight from the APK)
  * - nativeProcessAudio: Run inference on audio data
+ * - nativeConfigureStream / nativePushAudio / nativeProcessStream:
+ *   Continuous classification over overlapping windows
  * - nativeClose: Clean up resources
  */
-class NativeMLProcessor(modelPath: String) {
+class NativeMLProcessor(
+    model: ModelSource,
+    delegate: Delegate = Delegate.CPU,
+    numThreads: Int = 2,
+    autoTuneThreads: Boolean = false,
+    cacheDir: String? = null,
+    frontEnd: FrontEnd? = null,
+    warmUpInvokes: Int = 0,
+    delegateCache: Boolean = false,
+    threadPolicy: ThreadPolicy? = null
+) {
+
+    /**
+     * Load the model from a .tflite file on disk.
+     */
+    constructor(
+        modelPath: String,
+        delegate: Delegate = Delegate.CPU,
+        numThreads: Int = 2,
+        autoTuneThreads: Boolean = false,
+        cacheDir: String? = null,
+        frontEnd: FrontEnd? = null,
+        warmUpInvokes: Int = 0,
+        delegateCache: Boolean = false,
+        threadPolicy: ThreadPolicy? = null
+    ) : this(ModelSource.FilePath(modelPath), delegate, numThreads, autoTuneThreads, cacheDir,
+        frontEnd, warmUpInvokes, delegateCache, threadPolicy)
+
+    // ========================================================================
+    // MODEL SOURCES
+    // ========================================================================
+
+    /**
+     * Where the native side reads the .tflite model from.
+     *
+     * [Asset] and [Descriptor] build the model directly over the APK's bytes
+     * (mmap + TfLiteModelCreate), so no copy in filesDir is needed. This
+     * requires the asset to be stored uncompressed (noCompress "tflite" in
+     * build.gradle.kts); a compressed [Asset] is still loaded, but inflated
+     * into memory.
+     */
+    sealed class ModelSource {
+        /** Absolute path to a .tflite file. */
+        class FilePath(val path: String) : ModelSource()
+
+        /** Asset inside the APK, opened through the native AAssetManager. */
+        class Asset(val assets: AssetManager, val name: String) : ModelSource()
+
+        /**
+         * Region of an open file, e.g. from [AssetManager.openFd]. The
+         * descriptor is only needed during construction and may be closed
+         * afterwards.
+         */
+        class Descriptor(val descriptor: AssetFileDescriptor) : ModelSource()
+    }
+
+    // ========================================================================
+    // EXECUTION BACKENDS
+    // ========================================================================
+
+    /**
+     * Hardware backends the native interpreter can run on.
+     *
+     * The ids match DelegateType in ml_delegates.h. A requested delegate
+     * that is missing, fails its warm-up run, or is slower than the CPU
+     * kernels falls back automatically (GPU/NNAPI -> XNNPACK -> CPU);
+     * check [activeDelegate] for the backend that was actually selected.
+     */
+    enum class Delegate(val id: Int) {
+        CPU(0),      // Built-in TensorFlow Lite CPU kernels
+        XNNPACK(1),  // Optimized CPU kernels
+        GPU(2),      // GPU delegate
+        NNAPI(3);    // Android Neural Networks API accelerators
+
+        companion object {
+            fun fromId(id: Int): Delegate? = values().firstOrNull { it.id == id }
+        }
+    }
     
+    /**
+     * PCM sample formats accepted by the direct-buffer [processAudio].
+     *
+     * The ids are the android.media.AudioFormat encodings, so an
+     * AudioRecord's [android.media.AudioRecord.getAudioFormat] maps with
+     * [fromEncoding]. Every format is normalized natively straight into the
+     * model input; no 16-bit copy is made on either side.
+     */
+    enum class SampleFormat(val encoding: Int, val bytesPerSample: Int) {
+        PCM_16BIT(2, 2),   // AudioFormat.ENCODING_PCM_16BIT
+        PCM_FLOAT(4, 4),   // AudioFormat.ENCODING_PCM_FLOAT (full scale 1.0)
+        PCM_32BIT(22, 4);  // AudioFormat.ENCODING_PCM_32BIT (also 24-bit in 32-bit)
+
+        companion object {
+            fun fromEncoding(encoding: Int): SampleFormat? =
+                values().firstOrNull { it.encoding == encoding }
+        }
+    }
+
+    // ========================================================================
+    // FRONT END
+    // ========================================================================
+
+    /**
+     * Native signal processing in front of the model (FrontEndConfig in
+     * front_end.h).
+     *
+     * With [modelSampleRate] set, streamed audio captured at another rate
+     * ([inputSampleRate], or the device rate chosen by [NativeAudioCapture])
+     * is resampled natively with a polyphase filter. One-shot calls
+     * ([processAudio], [classify]) still take audio at the model rate.
+     *
+     * [logMel] feeds log-mel energies instead of samples; the model must
+     * then take float32 input of frames x [melBands] values per window.
+     */
+    class FrontEnd(
+        val modelSampleRate: Int,
+        val inputSampleRate: Int = 0,
+        val resamplerTaps: Int = 32,
+        val logMel: Boolean = false,
+        val fftSize: Int = 256,
+        val frameHop: Int = 128,
+        val melBands: Int = 40,
+        val minFrequencyHz: Int = 20,
+        val maxFrequencyHz: Int = 0
+    ) {
+        // Native layout (see kFrontEnd* in jni_wrapper.cpp)
+        internal fun toArray(): IntArray = intArrayOf(
+            modelSampleRate, inputSampleRate, resamplerTaps, if (logMel) 1 else 0,
+            fftSize, frameHop, melBands, minFrequencyHz, maxFrequencyHz
+        )
+    }
+
+    // ========================================================================
+    // THREAD POLICY
+    // ========================================================================
+
+    /**
+     * Scheduling of the threads that feed and classify the stream (see
+     * [prepareStreamThread]).
+     */
+    enum class ThreadPriority(val id: Int) {
+        DEFAULT(0),       // Left as the thread started
+        URGENT_AUDIO(1),  // ANDROID_PRIORITY_URGENT_AUDIO (nice -19)
+        REAL_TIME(2);     // SCHED_FIFO where permitted, else URGENT_AUDIO
+
+        companion object {
+            fun fromId(id: Int): ThreadPriority? = values().firstOrNull { it.id == id }
+        }
+    }
+
+    /**
+     * Core placement and priority natively (ThreadPolicy in ml_threads.h).
+     *
+     * [pinPerformanceCores] keeps inference off the efficiency cores: the
+     * interpreter is built on the performance cluster (detected from
+     * cpufreq), so the TensorFlow Lite worker threads start there, and
+     * every thread that calls [prepareStreamThread] is pinned there too.
+     * [streamPriority] is what those threads are raised to.
+     */
+    class ThreadPolicy(
+        val pinPerformanceCores: Boolean = false,
+        val streamPriority: ThreadPriority = ThreadPriority.DEFAULT
+    ) {
+        // Native layout (see kThreadPolicy* in jni_wrapper.cpp)
+        internal fun toArray(): IntArray =
+            intArrayOf(if (pinPerformanceCores) 1 else 0, streamPriority.id)
+    }
+
     // ========================================================================
     // INSTANCE STATE
     // ========================================================================
@@ -49,13 +224,41 @@ class NativeMLProcessor(modelPath: String) {
      * interpreter and load the ML model. Throws an exception if initialization
      * fails, so callers know immediately if something went wrong.
      * 
-     * @param modelPath Absolute path to the TensorFlow Lite model file (.tflite)
+     * @param model Model file or APK asset (see [ModelSource])
+     * @param delegate Preferred execution backend (falls back automatically)
+     * @param numThreads CPU threads for inference (-1 lets TensorFlow Lite decide)
+     * @param autoTuneThreads Benchmark 1..cores threads at startup and keep the
+     *        fastest (ignored for GPU/NNAPI); see [numThreads] for the result
+     * @param cacheDir Directory (e.g. filesDir) where the tuned thread count is
+     *        cached per device and model, so the sweep only runs once
+     * @param frontEnd Resampling / log-mel settings, or null for none
+     * @param warmUpInvokes Silent invokes run before the constructor returns,
+     *        so the first classified window does not pay one-time costs
+     * @param delegateCache Let the delegate keep its packed weights / compiled
+     *        programs in [cacheDir] (keyed by model and device), so later
+     *        launches start at steady-state latency
+     * @param threadPolicy Core pinning and stream-thread priority, or null for none
      * @throws RuntimeException if the native processor fails to initialize
      */
     init {
         // Call JNI function to create and initialize the native processor.
         // Returns a handle (pointer cast to Long) or 0 on failure.
-        nativeHandle = nativeInit(modelPath)
+        val frontEndValues = frontEnd?.toArray()
+        val threadValues = threadPolicy?.toArray()
+        nativeHandle = when (model) {
+            is ModelSource.FilePath ->
+                nativeInit(model.path, delegate.id, numThreads, autoTuneThreads, cacheDir,
+                    frontEndValues, warmUpInvokes, delegateCache, threadValues)
+            is ModelSource.Asset ->
+                nativeInitFromAsset(model.assets, model.name, delegate.id, numThreads,
+                    autoTuneThreads, cacheDir, frontEndValues, warmUpInvokes, delegateCache,
+                    threadValues)
+            is ModelSource.Descriptor ->
+                nativeInitFromFd(model.descriptor.parcelFileDescriptor.fd,
+                    model.descriptor.startOffset, model.descriptor.length, delegate.id,
+                    numThreads, autoTuneThreads, cacheDir, frontEndValues, warmUpInvokes,
+                    delegateCache, threadValues)
+        }
         
         // Verify initialization succeeded
         if (nativeHandle == 0L) {
@@ -90,6 +293,844 @@ class NativeMLProcessor(modelPath: String) {
         return nativeProcessAudio(nativeHandle, audioData)
     }
     
+    /**
+     * Process audio samples into a reusable output array.
+     *
+     * Same result as [processAudio], but nothing is allocated on either side
+     * of JNI: the input is pinned instead of copied and the scores are
+     * written into [output]. Prefer this on the audio thread.
+     *
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples at the start of [audioData]
+     * @param output Receives the scores; must hold at least [outputSize] floats
+     * @return Number of scores written
+     * @throws IllegalArgumentException if the native side rejects the arguments
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun processAudio(audioData: ShortArray, length: Int, output: FloatArray): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val written = nativeProcessAudioInto(nativeHandle, audioData, length, output)
+        if (written < 0) {
+            throw IllegalArgumentException("Inference failed ($length samples, output ${output.size})")
+        }
+        return written
+    }
+
+    /**
+     * Process float audio (ENCODING_PCM_FLOAT captures) into a reusable
+     * output array.
+     *
+     * The floats are pinned and normalized natively straight into the model
+     * input, so they are not converted to 16-bit first. Not available with
+     * the log-mel front end.
+     *
+     * @param audioData Float PCM samples (full scale 1.0)
+     * @param length Number of valid samples at the start of [audioData]
+     * @param output Receives the scores; must hold at least [outputSize] floats
+     * @return Number of scores written
+     * @throws IllegalArgumentException if the native side rejects the arguments
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun processAudio(audioData: FloatArray, length: Int, output: FloatArray): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val written = nativeProcessAudioFloatInto(nativeHandle, audioData, length, output)
+        if (written < 0) {
+            throw IllegalArgumentException("Inference failed ($length samples, output ${output.size})")
+        }
+        return written
+    }
+
+    /**
+     * Process audio held in direct buffers, zero-copy.
+     *
+     * Native code reads [audioData] and writes [output] in place. Both must
+     * be direct buffers in native byte order
+     * (`ByteBuffer.allocateDirect(n).order(ByteOrder.nativeOrder())`);
+     * positions and limits are ignored, data always starts at byte 0.
+     *
+     * @param audioData PCM samples in [format], starting at byte 0
+     * @param sampleCount Number of samples in [audioData]
+     * @param output Receives [outputSize] floats starting at byte 0
+     * @param format Sample format of [audioData] (16-bit, 32-bit or float;
+     *        only 16-bit with the log-mel front end)
+     * @return Number of scores written
+     * @throws IllegalArgumentException if a buffer is not direct / native order,
+     *         or the native side rejects the arguments
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun processAudio(
+        audioData: ByteBuffer,
+        sampleCount: Int,
+        output: ByteBuffer,
+        format: SampleFormat = SampleFormat.PCM_16BIT
+    ): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        require(audioData.isDirect && output.isDirect) { "Buffers must be direct" }
+        require(audioData.order() == ByteOrder.nativeOrder() &&
+            output.order() == ByteOrder.nativeOrder()) { "Buffers must use native byte order" }
+
+        val written = nativeProcessAudioDirect(nativeHandle, audioData, sampleCount,
+            format.encoding, output)
+        if (written < 0) {
+            throw IllegalArgumentException("Inference failed ($sampleCount samples)")
+        }
+        return written
+    }
+
+    /**
+     * Process several consecutive windows in a single native inference call.
+     *
+     * [audioData] is split into N = size / [windowLength] windows (trailing
+     * samples are ignored). Each window is normalized separately and all N
+     * run through the model in one invoke, which amortizes the per-invoke
+     * overhead when many windows are available at once.
+     *
+     * @param audioData N * [windowLength] 16-bit PCM samples
+     * @return N rows of [outputSize] scores, row-major (row i at i * outputSize)
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun processAudioBatch(audioData: ShortArray): FloatArray {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        return nativeProcessAudioBatch(nativeHandle, audioData)
+    }
+
+    /**
+     * Backend the native interpreter runs on after delegate fallback.
+     */
+    val activeDelegate: Delegate
+        get() {
+            if (nativeHandle == 0L) {
+                throw IllegalStateException("Native processor not initialized")
+            }
+            return Delegate.fromId(nativeGetActiveDelegate(nativeHandle)) ?: Delegate.CPU
+        }
+
+    /**
+     * CPU threads the native interpreter runs with (after auto-tuning).
+     */
+    val numThreads: Int
+        get() {
+            if (nativeHandle == 0L) {
+                throw IllegalStateException("Native processor not initialized")
+            }
+            return nativeGetNumThreads(nativeHandle)
+        }
+
+    /**
+     * Native MLProcessor handle, for wrappers that share its model
+     * (see [OfflineClassifier]).
+     */
+    internal val handle: Long
+        get() {
+            if (nativeHandle == 0L) {
+                throw IllegalStateException("Native processor not initialized")
+            }
+            return nativeHandle
+        }
+
+    /**
+     * Number of output values (class scores) produced per window.
+     *
+     * Use it to size the arrays passed to [processStream].
+     */
+    val outputSize: Int
+        get() {
+            if (nativeHandle == 0L) {
+                throw IllegalStateException("Native processor not initialized")
+            }
+            return nativeGetOutputSize(nativeHandle)
+        }
+
+    /**
+     * Samples per classification window, read from the model's input shape.
+     *
+     * Use it to size capture buffers and [processAudioBatch] input.
+     */
+    val windowLength: Int
+        get() {
+            if (nativeHandle == 0L) {
+                throw IllegalStateException("Native processor not initialized")
+            }
+            return nativeGetWindowLength(nativeHandle)
+        }
+
+    /**
+     * True for a stateful streaming model: each invoke takes only the newest
+     * [windowLength] samples and the model keeps what it computed for the
+     * earlier ones. The stream then steps by [windowLength] (any hop given
+     * to [configureStream] is ignored) and [configureCascade] is rejected.
+     */
+    val isStateful: Boolean
+        get() {
+            if (nativeHandle == 0L) {
+                throw IllegalStateException("Native processor not initialized")
+            }
+            return nativeIsStateful(nativeHandle)
+        }
+
+    /**
+     * Shape of the model's input tensor as loaded (batch dimension first).
+     */
+    val inputShape: IntArray
+        get() = tensorShape(true)
+
+    /**
+     * Shape of the model's output tensor as loaded (batch dimension first).
+     */
+    val outputShape: IntArray
+        get() = tensorShape(false)
+
+    private fun tensorShape(input: Boolean): IntArray {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val dims = IntArray(MAX_TENSOR_DIMS)
+        val rank = nativeGetTensorShape(nativeHandle, input, dims)
+        return dims.copyOf(minOf(rank, MAX_TENSOR_DIMS))
+    }
+
+    // ========================================================================
+    // STREAMING API
+    // ========================================================================
+
+    /**
+     * Configure the native streaming classifier.
+     *
+     * Audio pushed with [pushAudio] is split into overlapping windows of
+     * [windowLength] samples that start every [hopSize] samples, so the
+     * whole capture buffer gets classified instead of only its first window.
+     *
+     * @param hopSize Samples between window starts (1..[windowLength])
+     * @param bufferCapacity Samples that can be buffered between two
+     *        [processStream] calls (at least [windowLength])
+     * @param batchSize Windows classified per native invoke. With more than
+     *        one, [processStream] only returns whole batches; the remaining
+     *        windows wait for the next call.
+     * @throws IllegalArgumentException if the native side rejects the configuration
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun configureStream(hopSize: Int, bufferCapacity: Int, batchSize: Int = 1) {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        if (!nativeConfigureStream(nativeHandle, hopSize, bufferCapacity, batchSize)) {
+            throw IllegalArgumentException("Invalid stream configuration (hop $hopSize, capacity $bufferCapacity)")
+        }
+    }
+
+    /**
+     * Append captured samples to the stream.
+     *
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples at the start of [audioData]
+     * @return Number of samples accepted (fewer if the stream buffer is full)
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun pushAudio(audioData: ShortArray, length: Int = audioData.size): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        return nativePushAudio(nativeHandle, audioData, length)
+    }
+
+    /**
+     * Classify every complete window pushed so far.
+     *
+     * Row i of [scores] (offset i * [outputSize]) receives the scores of
+     * window i, and [windowStarts] its first sample index in the stream.
+     * The arrays are owned by the caller and can be reused across calls.
+     *
+     * @param scores Output array with room for N rows of [outputSize] values
+     * @param windowStarts Output array with room for N window start indices
+     * @return Number of windows classified (0 if none is complete yet)
+     * @throws IllegalStateException if the processor is not initialized or inference fails
+     */
+    fun processStream(scores: FloatArray, windowStarts: LongArray): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val windows = nativeProcessStream(nativeHandle, scores, windowStarts)
+        if (windows < 0) {
+            throw IllegalStateException("Stream inference failed")
+        }
+        return windows
+    }
+
+    /**
+     * Drop buffered stream samples, e.g. after a silent gap, so the next
+     * window does not straddle the gap.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun resetStream() {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        nativeResetStream(nativeHandle)
+    }
+
+    // ========================================================================
+    // DECISION API
+    // ========================================================================
+
+    /**
+     * Compact classification decision, filled in place by [classify] and
+     * [classifyStream] so the audio loop can reuse one instance.
+     *
+     * [rms] is always set. If the audio was at or below the silence gate no
+     * inference ran and [windows] is 0. Otherwise [score] is the best score
+     * over the classified windows and [classIndex] its class, or -1 if the
+     * score is not above the confidence threshold.
+     */
+    class Classification {
+        var classIndex: Int = -1
+            internal set
+        var score: Float = 0.0f
+            internal set
+        var rms: Float = 0.0f
+            internal set
+        var windows: Int = 0
+            internal set
+    }
+
+    // Native result layout: {classIndex, score, rms, windows}
+    private val resultValues = FloatArray(4)
+
+    /**
+     * Set the thresholds used by [classify] and [classifyStream].
+     *
+     * @param minRms Audio with RMS at or below this value is not classified
+     * @param minScore Classes scoring at or below this value are not reported
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun setDecisionThresholds(minRms: Float, minScore: Float) {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        nativeSetDecisionThresholds(nativeHandle, minRms, minScore)
+    }
+
+    /**
+     * Classify one window natively: silence gate, inference, argmax and
+     * confidence threshold in a single call, with only the decision coming
+     * back across JNI.
+     *
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples at the start of [audioData]
+     * @param result Receives the decision (reused between calls)
+     * @return [result]
+     * @throws IllegalArgumentException if inference fails
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun classify(audioData: ShortArray, length: Int, result: Classification): Classification =
+        classify(audioData, length, false, result)
+
+    /**
+     * Gate a captured block, push it into the stream (see [configureStream])
+     * and reduce every completed window to one decision. A silent block
+     * resets the stream.
+     *
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples at the start of [audioData]
+     * @param result Receives the decision (reused between calls)
+     * @return [result]
+     * @throws IllegalArgumentException if inference fails
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun classifyStream(audioData: ShortArray, length: Int, result: Classification): Classification =
+        classify(audioData, length, true, result)
+
+    private fun classify(
+        audioData: ShortArray,
+        length: Int,
+        stream: Boolean,
+        result: Classification
+    ): Classification {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        if (!nativeClassify(nativeHandle, audioData, length, stream, resultValues)) {
+            throw IllegalArgumentException("Classification failed ($length samples)")
+        }
+        result.classIndex = resultValues[0].toInt()
+        result.score = resultValues[1]
+        result.rms = resultValues[2]
+        result.windows = resultValues[3].toInt()
+        return result
+    }
+
+    // ========================================================================
+    // MULTI-CHANNEL
+    // ========================================================================
+
+    // Decisions of every channel, four values each (grown with the channels)
+    private var channelValues = FloatArray(0)
+
+    /**
+     * Classify the first window of every channel of interleaved audio
+     * (stereo or microphone-array capture) in one batched native call.
+     *
+     * Each channel gets its own decision, with the thresholds set by
+     * [setDecisionThresholds]. Silent channels are not classified.
+     *
+     * @param audioData Interleaved 16-bit PCM frames
+     * @param frames Number of valid frames at the start of [audioData]
+     * @param channels Samples per frame (1..[MAX_CHANNELS])
+     * @param results Receives one decision per channel (at least
+     *                [channels] entries, reused between calls)
+     * @return Channel with the highest reported score, or -1 if no channel
+     *         reported a class
+     * @throws IllegalArgumentException if the arguments are invalid or
+     *         inference fails
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun classifyChannels(
+        audioData: ShortArray,
+        frames: Int,
+        channels: Int,
+        results: Array<Classification>
+    ): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        require(channels in 1..MAX_CHANNELS && results.size >= channels) {
+            "Invalid channel count $channels (${results.size} results)"
+        }
+        if (channelValues.size < channels * 4) {
+            channelValues = FloatArray(channels * 4)
+        }
+
+        val best = nativeClassifyChannels(nativeHandle, audioData, frames, channels, channelValues)
+        if (best < -1) {
+            throw IllegalArgumentException("Classification failed ($frames frames, $channels channels)")
+        }
+        for (c in 0 until channels) {
+            val result = results[c]
+            result.classIndex = channelValues[c * 4].toInt()
+            result.score = channelValues[c * 4 + 1]
+            result.rms = channelValues[c * 4 + 2]
+            result.windows = channelValues[c * 4 + 3].toInt()
+        }
+        return best
+    }
+
+    // ========================================================================
+    // CLASS EVENTS
+    // ========================================================================
+
+    /**
+     * Reusable batch of class events filled by [classifyStreamEvents] (and
+     * [NativeAudioCapture.awaitEvents]).
+     *
+     * Event i concerns class [classIndices] [i]. An onset event (class
+     * started) has [offsetSamples] [i] == -1 and the smoothed score at
+     * onset; an offset event (class ended) repeats the onset and carries
+     * the peak smoothed score of the segment. Positions are stream samples
+     * at the model rate.
+     *
+     * @param capacity Events returned per call at most
+     */
+    class Events(capacity: Int = 16) {
+        val classIndices = IntArray(capacity)
+        val scores = FloatArray(capacity)
+        val onsetSamples = LongArray(capacity)
+        val offsetSamples = LongArray(capacity)
+
+        /** True if event [i] is an onset. */
+        fun isOnset(i: Int): Boolean = offsetSamples[i] < 0
+    }
+
+    /**
+     * Enable class events: the windows of [classifyStream] /
+     * [classifyStreamEvents] are smoothed over [smoothingWindows] windows,
+     * and a class starts above [onThreshold] and ends below [offThreshold]
+     * (hysteresis), so scores hovering around one threshold do not flicker.
+     *
+     * @return false if the parameters are invalid
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun configureEvents(smoothingWindows: Int, onThreshold: Float, offThreshold: Float): Boolean {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        return nativeConfigureEvents(nativeHandle, smoothingWindows, onThreshold, offThreshold)
+    }
+
+    /**
+     * Stream a captured block like [classifyStream], but return only the
+     * class changes it caused. Most blocks produce no event, so callers can
+     * update the UI per event instead of per block.
+     *
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples at the start of [audioData]
+     * @param events Receives the events (reused between calls)
+     * @return Number of events written to [events]
+     * @throws IllegalArgumentException if inference fails or events are not
+     *         configured ([configureEvents])
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun classifyStreamEvents(audioData: ShortArray, length: Int, events: Events): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val count = nativeClassifyStreamEvents(nativeHandle, audioData, length,
+            events.classIndices, events.scores, events.onsetSamples, events.offsetSamples)
+        if (count < 0) {
+            throw IllegalArgumentException("Classification failed ($length samples)")
+        }
+        return count
+    }
+
+    // ========================================================================
+    // CLASSIFICATION CASCADE
+    // ========================================================================
+
+    /**
+     * Per-stage counts of the cascade since [configureCascade] (or
+     * [resetCascadeStats]).
+     */
+    class CascadeStats(
+        /** Stream windows screened by the activity detector. */
+        val windows: Long,
+        /** Windows it accepted, i.e. classified by the model. */
+        val detected: Long,
+        /** Accepted windows the model scored above the confidence threshold. */
+        val confident: Long,
+        /** Interpreter invokes saved. */
+        val skippedInvokes: Long
+    ) {
+        /** Share of windows that reached the model (compute spent). */
+        val detectorRate: Double
+            get() = if (windows > 0) detected.toDouble() / windows else 0.0
+
+        /** Share of the model's windows it confirmed (first-stage precision). */
+        val modelRate: Double
+            get() = if (detected > 0) confident.toDouble() / detected else 0.0
+
+        override fun toString(): String =
+            "cascade: %d windows, %.1f%% to model, %.1f%% confirmed, %d invokes saved".format(
+                windows, detectorRate * 100, modelRate * 100, skippedInvokes)
+    }
+
+    /**
+     * Screen stream windows with a cheap native activity detector before the
+     * model: a window is classified only if its energy is [snrDb] above the
+     * tracked noise floor and its zero-crossing rate is within
+     * [minCrossingRate]..[maxCrossingRate]. Steady background noise stops
+     * costing invokes once the floor has adapted. Rejected windows score 0.
+     *
+     * @param hangoverWindows Windows still classified after each detection
+     * @return false if the parameters are invalid
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun configureCascade(
+        snrDb: Float = 6.0f,
+        minCrossingRate: Float = 0.0f,
+        maxCrossingRate: Float = 0.5f,
+        hangoverWindows: Int = 4
+    ): Boolean {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        return nativeConfigureCascade(nativeHandle, snrDb, minCrossingRate, maxCrossingRate,
+            hangoverWindows)
+    }
+
+    /**
+     * Snapshot the per-stage counts. Safe to call from any thread.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun getCascadeStats(): CascadeStats {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val values = LongArray(4)
+        if (!nativeGetCascadeStats(nativeHandle, values)) {
+            throw IllegalStateException("Failed to read cascade statistics")
+        }
+        return CascadeStats(values[0], values[1], values[2], values[3])
+    }
+
+    /**
+     * Clear the per-stage counts.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun resetCascadeStats() {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        nativeResetCascadeStats(nativeHandle)
+    }
+
+    // ========================================================================
+    // MODEL HOT SWAP
+    // ========================================================================
+
+    /**
+     * Replace the model without stopping classification.
+     *
+     * Blocks the calling thread while the replacement is loaded, built with
+     * this processor's settings (delegate, threads, caches) and warmed up;
+     * the stream keeps classifying on the old model meanwhile, so call it
+     * from a background thread, never from the one classifying. The stream
+     * switches over between two calls and the old model is freed here once
+     * it is no longer in use. Queued audio, thresholds, events and the
+     * cascade carry over.
+     *
+     * @param model Replacement model; it must produce [outputSize] scores
+     * @param timeoutMs Longest wait for the stream to switch over (an idle
+     *        stream switches on its next call)
+     * @return false, keeping the current model, if the replacement cannot be
+     *         loaded or does not fit
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun swapModel(model: ModelSource, timeoutMs: Int = 1000): Boolean {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        return when (model) {
+            is ModelSource.FilePath ->
+                nativeSwapModel(nativeHandle, model.path, timeoutMs)
+            is ModelSource.Asset ->
+                nativeSwapModelFromAsset(nativeHandle, model.assets, model.name, timeoutMs)
+            is ModelSource.Descriptor ->
+                nativeSwapModelFromFd(nativeHandle, model.descriptor.parcelFileDescriptor.fd,
+                    model.descriptor.startOffset, model.descriptor.length, timeoutMs)
+        }
+    }
+
+    // ========================================================================
+    // LATENCY STATISTICS
+    // ========================================================================
+
+    /**
+     * Latency distribution of one hot-path stage, in microseconds.
+     *
+     * Stages (see MLStage in ml_stats.h): "input" (int16 conversion into the
+     * input tensor), "invoke" (the interpreter), "output" (reading back
+     * scores and the decision), "call" (one native call end to end) and
+     * "jni" (one JNI call, including array pinning and copies). Percentiles
+     * come from log-linear histogram buckets and are within ~25% of exact.
+     */
+    class StageStats(
+        val stage: String,
+        val count: Long,
+        val meanUs: Double,
+        val p50Us: Double,
+        val p95Us: Double,
+        val p99Us: Double,
+        val maxUs: Double
+    ) {
+        override fun toString(): String =
+            "%s: n=%d mean=%.1f p50=%.1f p95=%.1f p99=%.1f max=%.1f us".format(
+                stage, count, meanUs, p50Us, p95Us, p99Us, maxUs)
+    }
+
+    /**
+     * Snapshot the on-device latency distribution of every stage since
+     * creation (or the last [resetStats]). Safe to call from any thread
+     * while audio is being classified.
+     *
+     * @return One entry per stage, in pipeline order
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun getStats(): List<StageStats> {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val values = DoubleArray(STAGE_NAMES.size * STATS_FIELDS)
+        val stages = nativeGetStats(nativeHandle, values)
+        if (stages < 0) {
+            throw IllegalStateException("Failed to read native statistics")
+        }
+        return (0 until stages).map { i ->
+            val row = i * STATS_FIELDS
+            StageStats(STAGE_NAMES[i], values[row].toLong(), values[row + 1],
+                values[row + 2], values[row + 3], values[row + 4], values[row + 5])
+        }
+    }
+
+    /**
+     * Clear the latency histograms, e.g. after warm-up.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun resetStats() {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        nativeResetStats(nativeHandle)
+    }
+
+    /**
+     * Emit every timed stage as an ATrace section, so it shows up in
+     * Perfetto / systrace captures. Sections are only written while a trace
+     * is being recorded.
+     *
+     * @param enabled true to emit trace sections
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun setTraceEnabled(enabled: Boolean) {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        nativeSetTraceEnabled(nativeHandle, enabled)
+    }
+
+    // ========================================================================
+    // THREAD PLACEMENT
+    // ========================================================================
+
+    /**
+     * Apply the [ThreadPolicy] to the calling thread: pin it to the
+     * performance cluster and raise its priority. Call it first thing on the
+     * thread that reads audio and feeds the stream; the native capture and
+     * async workers do it themselves.
+     *
+     * @return Priority actually applied (REAL_TIME falls back when the app
+     *         may not use SCHED_FIFO)
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun prepareStreamThread(): ThreadPriority {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        return ThreadPriority.fromId(nativePrepareStreamThread(nativeHandle))
+            ?: ThreadPriority.DEFAULT
+    }
+
+    /**
+     * Where the invokes ran since the processor was built: the CPU each
+     * invoke finished on, and the cluster masks (bit N = CPU N).
+     */
+    class CoreUsage(
+        /** Invokes per CPU, indexed by CPU number. */
+        val invokesPerCpu: LongArray,
+        /** Performance cluster detected on this device. */
+        val performanceCores: Long,
+        /** Cores inference is pinned to, 0 if not pinned. */
+        val pinnedCores: Long
+    ) {
+        /** Share of the invokes that ran on the performance cluster. */
+        val performanceShare: Double
+            get() {
+                var total = 0L
+                var fast = 0L
+                invokesPerCpu.forEachIndexed { cpu, count ->
+                    total += count
+                    if ((performanceCores and (1L shl cpu)) != 0L) fast += count
+                }
+                return if (total > 0) fast.toDouble() / total else 0.0
+            }
+
+        override fun toString(): String =
+            "cores: invokes per CPU %s, %.0f%% on performance cores 0x%x%s".format(
+                invokesPerCpu.contentToString(), performanceShare * 100, performanceCores,
+                if (pinnedCores != 0L) " (pinned)" else "")
+    }
+
+    /**
+     * Snapshot where the invokes ran. Safe to call from any thread.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun getCoreUsage(): CoreUsage {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val values = LongArray(CORE_USAGE_HEADER + MAX_CPUS)
+        val cpus = nativeGetCoreUsage(nativeHandle, values)
+        if (cpus < 0) {
+            throw IllegalStateException("Failed to read the core usage")
+        }
+        return CoreUsage(values.copyOfRange(CORE_USAGE_HEADER, CORE_USAGE_HEADER + cpus),
+            values[0], values[1])
+    }
+
+    // ========================================================================
+    // MEMORY
+    // ========================================================================
+
+    /**
+     * Memory this processor accounts for, in bytes (-1 where the device
+     * cannot measure it). Heap figures are the native allocator growth of
+     * each build step; memory a GPU / NNAPI driver keeps outside the process
+     * heap is not included.
+     */
+    class MemoryReport(
+        /** Size of the model; shared by every processor on the same model. */
+        val modelBytes: Long,
+        /** Part of the model currently in RAM. */
+        val modelResidentBytes: Long,
+        /** true if the model is a file mapping the kernel can page out. */
+        val modelMapped: Boolean,
+        val delegate: Delegate?,
+        /** Creating the delegate. */
+        val delegateBytes: Long,
+        /** Interpreter and delegate graph preparation. */
+        val interpreterBytes: Long,
+        /** Tensor arena at the current batch size. */
+        val arenaBytes: Long,
+        val batchSize: Int,
+        /** true after [releaseMemory], until the next inference call. */
+        val released: Boolean,
+        /** RSS of the whole process. */
+        val processResidentBytes: Long
+    ) {
+        override fun toString(): String =
+            ("memory: model %d B (%d resident, %s), %s delegate %d B, interpreter %d B, " +
+                "arena %d B (batch %d)%s, process RSS %d B").format(modelBytes,
+                modelResidentBytes, if (modelMapped) "mapped" else "heap", delegate,
+                delegateBytes, interpreterBytes, arenaBytes, batchSize,
+                if (released) ", released" else "", processResidentBytes)
+    }
+
+    /**
+     * Snapshot what the model, interpreter and delegate take. Call it from
+     * the thread that classifies, or while nothing is classified.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun getMemoryReport(): MemoryReport {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        val values = LongArray(MEMORY_FIELDS)
+        if (!nativeGetMemoryReport(nativeHandle, values)) {
+            throw IllegalStateException("Failed to read the memory report")
+        }
+        return MemoryReport(values[0], values[1], values[2] != 0L,
+            Delegate.fromId(values[3].toInt()), values[4], values[5], values[6],
+            values[7].toInt(), values[8] != 0L, values[9])
+    }
+
+    /**
+     * Give the interpreter's memory (tensor arenas, delegate buffers) back
+     * while idle, e.g. when recording stops. The model, settings and
+     * stream state are kept; the next call that classifies builds the
+     * interpreter again on the same backend, which makes that call slower.
+     *
+     * Call it only while nothing is being classified.
+     *
+     * @throws IllegalStateException if the processor is not initialized
+     */
+    fun releaseMemory() {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Native processor not initialized")
+        }
+        nativeReleaseArenas(nativeHandle)
+    }
+
     /**
      * Clean up and release native resources.
      * 
@@ -123,6 +1164,27 @@ class NativeMLProcessor(modelPath: String) {
         close()
     }
     
+    private companion object {
+        // Native stats layout: one row per MLStage of
+        // {count, mean, p50, p95, p99, max}
+        val STAGE_NAMES = arrayOf("input", "invoke", "output", "call", "jni")
+        const val STATS_FIELDS = 6
+
+        // Matches the native tensor rank limit (MLProcessor::kMaxTensorDims)
+        const val MAX_TENSOR_DIMS = 8
+
+        // Matches MLProcessor::kMaxChannels
+        const val MAX_CHANNELS = 32
+
+        // Native memory report layout (see MemoryReport)
+        const val MEMORY_FIELDS = 10
+
+        // Native core usage layout: two masks, then one count per CPU (at
+        // most kMaxCpus in ml_threads.h)
+        const val CORE_USAGE_HEADER = 2
+        const val MAX_CPUS = 64
+    }
+
     // ========================================================================
     // JNI FUNCTION DECLARATIONS
     // ========================================================================
@@ -135,14 +1197,90 @@ class NativeMLProcessor(modelPath: String) {
      * 
      * This function:
      * 1. Loads the TensorFlow Lite model from the given path
-     * 2. Creates a TensorFlow Lite interpreter
+     * 2. Creates the requested delegate (with fallback) and a TensorFlow Lite interpreter
      * 3. Allocates tensors for input and output
      * 4. Returns a pointer (as Long) to the MLProcessor object
      * 
      * @param modelPath Absolute path to the .tflite model file
+     * @param delegate Preferred backend id (see [Delegate])
+     * @param numThreads CPU threads (-1 = TensorFlow Lite default)
+     * @param autoTuneThreads Sweep thread counts and keep the fastest
+     * @param cacheDir Directory for the tuning cache, or null
+     * @param frontEnd [FrontEnd.toArray] values, or null
+     * @param threadPolicy [ThreadPolicy.toArray] values, or null
      * @return Handle (pointer cast to Long) to the native MLProcessor, or 0 on failure
      */
-    private external fun nativeInit(modelPath: String): Long
+    private external fun nativeInit(
+        modelPath: String,
+        delegate: Int,
+        numThreads: Int,
+        autoTuneThreads: Boolean,
+        cacheDir: String?,
+        frontEnd: IntArray?,
+        warmUpInvokes: Int,
+        delegateCache: Boolean,
+        threadPolicy: IntArray?
+    ): Long
+
+    /**
+     * JNI Function: Initialize the native ML processor over an APK asset.
+     *
+     * @param assets Asset manager holding the model
+     * @param assetName Asset path of the .tflite model
+     * @return Handle to the native MLProcessor, or 0 on failure
+     * @see nativeInit for the remaining parameters
+     */
+    private external fun nativeInitFromAsset(
+        assets: AssetManager,
+        assetName: String,
+        delegate: Int,
+        numThreads: Int,
+        autoTuneThreads: Boolean,
+        cacheDir: String?,
+        frontEnd: IntArray?,
+        warmUpInvokes: Int,
+        delegateCache: Boolean,
+        threadPolicy: IntArray?
+    ): Long
+
+    /**
+     * JNI Function: Initialize the native ML processor over a file region.
+     *
+     * @param fd Readable file descriptor (only used during the call)
+     * @param offset Start of the model inside the file
+     * @param length Model size in bytes
+     * @return Handle to the native MLProcessor, or 0 on failure
+     * @see nativeInit for the remaining parameters
+     */
+    private external fun nativeInitFromFd(
+        fd: Int,
+        offset: Long,
+        length: Long,
+        delegate: Int,
+        numThreads: Int,
+        autoTuneThreads: Boolean,
+        cacheDir: String?,
+        frontEnd: IntArray?,
+        warmUpInvokes: Int,
+        delegateCache: Boolean,
+        threadPolicy: IntArray?
+    ): Long
+
+    /**
+     * JNI Function: Thread count after auto-tuning.
+     *
+     * @param handle Handle to the native MLProcessor
+     * @return Thread count, or 0 if the handle is invalid
+     */
+    private external fun nativeGetNumThreads(handle: Long): Int
+
+    /**
+     * JNI Function: Backend selected after delegate fallback.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return Delegate id (see [Delegate]), or -1 if the handle is invalid
+     */
+    private external fun nativeGetActiveDelegate(handle: Long): Int
 
     /**
      * JNI Function: Process audio data through the ML model.
@@ -160,6 +1298,272 @@ class NativeMLProcessor(modelPath: String) {
      */
     private external fun nativeProcessAudio(handle: Long, audioData: ShortArray): FloatArray
 
+    /**
+     * JNI Function: Run inference into a caller-provided array.
+     *
+     * The input is pinned with GetPrimitiveArrayCritical for the duration of
+     * one inference; scores are copied into [output].
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples in [audioData]
+     * @param output Destination for the scores
+     * @return Number of scores written, or -1 on failure
+     */
+    private external fun nativeProcessAudioInto(
+        handle: Long,
+        audioData: ShortArray,
+        length: Int,
+        output: FloatArray
+    ): Int
+
+    /**
+     * JNI Function: Run inference on float samples into a caller-provided array.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData Array of float PCM samples
+     * @param length Number of valid samples in [audioData]
+     * @param output Destination for the scores
+     * @return Number of scores written, or -1 on failure
+     */
+    private external fun nativeProcessAudioFloatInto(
+        handle: Long,
+        audioData: FloatArray,
+        length: Int,
+        output: FloatArray
+    ): Int
+
+    /**
+     * JNI Function: Run inference between direct buffers (GetDirectBufferAddress).
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData Direct buffer of PCM samples (native order)
+     * @param length Number of samples in [audioData]
+     * @param encoding AudioFormat encoding of the samples (see [SampleFormat])
+     * @param output Direct buffer receiving the float scores (native order)
+     * @return Number of scores written, or -1 on failure
+     */
+    private external fun nativeProcessAudioDirect(
+        handle: Long,
+        audioData: ByteBuffer,
+        length: Int,
+        encoding: Int,
+        output: ByteBuffer
+    ): Int
+
+    /**
+     * JNI Function: Run N consecutive windows through the model in one invoke.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData N * window length 16-bit PCM samples
+     * @return N x output size scores (row-major), empty on failure
+     */
+    private external fun nativeProcessAudioBatch(handle: Long, audioData: ShortArray): FloatArray
+
+    /**
+     * JNI Function: Number of output values per inference.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return Output size, or 0 if the handle is invalid
+     */
+    private external fun nativeGetOutputSize(handle: Long): Int
+
+    /**
+     * JNI Function: Samples per classification window.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return Window length, or 0 if the handle is invalid
+     */
+    private external fun nativeGetWindowLength(handle: Long): Int
+
+    /**
+     * JNI Function: Whether the model carries state between invokes.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return true if stateful, false otherwise or if the handle is invalid
+     */
+    private external fun nativeIsStateful(handle: Long): Boolean
+
+    /**
+     * JNI Function: Shape of the input or output tensor.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param input true for the input tensor, false for the output tensor
+     * @param dims Receives up to dims.size dimensions
+     * @return Tensor rank, or 0 if the handle is invalid
+     */
+    private external fun nativeGetTensorShape(handle: Long, input: Boolean, dims: IntArray): Int
+
+    /**
+     * JNI Function: Configure the streaming classifier (hop size, ring buffer size).
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param hopSize Samples between window starts
+     * @param bufferCapacity Ring buffer capacity in samples
+     * @param batchSize Windows per native invoke
+     * @return true if the configuration was accepted
+     */
+    private external fun nativeConfigureStream(handle: Long, hopSize: Int, bufferCapacity: Int, batchSize: Int): Boolean
+
+    /**
+     * JNI Function: Push samples into the native ring buffer.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples
+     * @return Number of samples accepted
+     */
+    private external fun nativePushAudio(handle: Long, audioData: ShortArray, length: Int): Int
+
+    /**
+     * JNI Function: Classify complete windows into caller-provided arrays.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param scores Row-major score matrix (windows x output size)
+     * @param windowStarts First sample index of each window
+     * @return Number of windows classified, or -1 on failure
+     */
+    private external fun nativeProcessStream(handle: Long, scores: FloatArray, windowStarts: LongArray): Int
+
+    /**
+     * JNI Function: Drop buffered stream samples.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     */
+    private external fun nativeResetStream(handle: Long): Unit
+
+    /**
+     * JNI Function: Set the silence gate and confidence threshold.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param minRms RMS gate
+     * @param minScore Confidence threshold
+     */
+    private external fun nativeSetDecisionThresholds(handle: Long, minRms: Float, minScore: Float): Unit
+
+    /**
+     * JNI Function: Gate, classify and reduce to a decision natively.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData Array of 16-bit PCM audio samples
+     * @param length Number of valid samples in [audioData]
+     * @param stream Use the streaming classifier instead of a single window
+     * @param result Receives {classIndex, score, rms, windows}
+     * @return false if inference failed
+     */
+    private external fun nativeClassify(
+        handle: Long,
+        audioData: ShortArray,
+        length: Int,
+        stream: Boolean,
+        result: FloatArray
+    ): Boolean
+
+    /**
+     * JNI Function: Classify every channel of interleaved audio.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param audioData Interleaved 16-bit PCM frames
+     * @param frames Number of valid frames in [audioData]
+     * @param channels Samples per frame
+     * @param results Receives {classIndex, score, rms, windows} per channel
+     * @return Best channel, -1 if none reported a class, -2 on failure
+     */
+    private external fun nativeClassifyChannels(
+        handle: Long,
+        audioData: ShortArray,
+        frames: Int,
+        channels: Int,
+        results: FloatArray
+    ): Int
+
+    /**
+     * JNI Function: Enable class events.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return false if the parameters are invalid
+     */
+    private external fun nativeConfigureEvents(
+        handle: Long,
+        smoothingWindows: Int,
+        onThreshold: Float,
+        offThreshold: Float
+    ): Boolean
+
+    /**
+     * JNI Function: Enable the activity-detector cascade on stream windows.
+     */
+    private external fun nativeConfigureCascade(
+        handle: Long,
+        snrDb: Float,
+        minCrossingRate: Float,
+        maxCrossingRate: Float,
+        hangoverWindows: Int
+    ): Boolean
+
+    /**
+     * JNI Function: Per-stage cascade counts.
+     *
+     * @param stats Receives {windows, detected, confident, skippedInvokes}
+     */
+    private external fun nativeGetCascadeStats(handle: Long, stats: LongArray): Boolean
+
+    /**
+     * JNI Function: Clear the per-stage cascade counts.
+     */
+    private external fun nativeResetCascadeStats(handle: Long): Unit
+
+    /**
+     * JNI Function: Hot-swap the model from a .tflite file.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param modelPath Absolute path to the replacement model
+     * @param timeoutMs Longest wait for the stream to adopt it
+     * @return true if the replacement was published
+     */
+    private external fun nativeSwapModel(handle: Long, modelPath: String, timeoutMs: Int): Boolean
+
+    /**
+     * JNI Function: Hot-swap the model from an APK asset.
+     *
+     * @see nativeSwapModel
+     */
+    private external fun nativeSwapModelFromAsset(
+        handle: Long,
+        assets: AssetManager,
+        assetName: String,
+        timeoutMs: Int
+    ): Boolean
+
+    /**
+     * JNI Function: Hot-swap the model from a file region.
+     *
+     * @see nativeSwapModel
+     */
+    private external fun nativeSwapModelFromFd(
+        handle: Long,
+        fd: Int,
+        offset: Long,
+        length: Long,
+        timeoutMs: Int
+    ): Boolean
+
+    /**
+     * JNI Function: Stream a block and collect the class events.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return Events written to the arrays, or -1 on failure
+     */
+    private external fun nativeClassifyStreamEvents(
+        handle: Long,
+        audioData: ShortArray,
+        length: Int,
+        classIndices: IntArray,
+        scores: FloatArray,
+        onsets: LongArray,
+        offsets: LongArray
+    ): Int
+
     /**
      * JNI Function: Clean up and release native resources.
      * 
@@ -173,4 +1577,61 @@ class NativeMLProcessor(modelPath: String) {
      */
     private external fun nativeClose(handle: Long): Unit
 
+    /**
+     * JNI Function: Snapshot the per-stage latency histograms.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param stats Receives one row of {count, mean, p50, p95, p99, max} per stage
+     * @return Number of stages written, or -1 on failure
+     */
+    private external fun nativeGetStats(handle: Long, stats: DoubleArray): Int
+
+    /**
+     * JNI Function: Clear the per-stage latency histograms.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     */
+    private external fun nativeResetStats(handle: Long): Unit
+
+    /**
+     * JNI Function: Enable or disable ATrace sections for the timed stages.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param enabled Emit trace sections
+     */
+    private external fun nativeSetTraceEnabled(handle: Long, enabled: Boolean): Unit
+
+    /**
+     * JNI Function: Memory the processor accounts for.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param report Receives {modelBytes, modelResidentBytes, modelMapped,
+     *        delegate, delegateBytes, interpreterBytes, arenaBytes, batchSize,
+     *        released, processResidentBytes}
+     */
+    private external fun nativeGetMemoryReport(handle: Long, report: LongArray): Boolean
+
+    /**
+     * JNI Function: Release interpreter, arenas and delegate until the next call.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     */
+    private external fun nativeReleaseArenas(handle: Long): Unit
+
+    /**
+     * JNI Function: Pin and raise the calling thread per the thread policy.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @return Priority id applied, or -1 if the handle is invalid
+     */
+    private external fun nativePrepareStreamThread(handle: Long): Int
+
+    /**
+     * JNI Function: Where the invokes ran.
+     *
+     * @param handle Handle to the native MLProcessor object (from nativeInit)
+     * @param usage Receives {performanceCores, pinnedCores, invokes per CPU...}
+     * @return Number of CPUs reported, or -1 on failure
+     */
+    private external fun nativeGetCoreUsage(handle: Long, usage: LongArray): Int
 }
@@ -0,0 +1,237 @@
+package com.atleastitworks.example_ndk_ml
+
+import android.os.ParcelFileDescriptor
+
+// ============================================================================
+// OFFLINE CLASSIFIER: Parallel Classification of Recorded Audio Files
+// ============================================================================
+/**
+ * Classifies a recorded WAV / raw 16-bit PCM file on all cores.
+ *
+ * The file is memory-mapped natively, so the audio never passes through the
+ * JVM. Windows of [NativeMLProcessor.windowLength] frames every `hopSize`
+ * frames are classified by a pool of worker threads (each with its own
+ * interpreter over the processor's model) that steal work from each other,
+ * and the timeline
+ * comes back in order through [poll] while the run is still going.
+ *
+ * One run at a time; call [poll] from a single thread.
+ *
+ * @param processor Processor whose model (and CPU-side backend) is used;
+ *        must stay open while this classifier is in use
+ * @param workers Worker threads, by default one per core
+ * @throws RuntimeException if the native classifier fails to initialize
+ */
+class OfflineClassifier(
+    processor: NativeMLProcessor,
+    workers: Int = Runtime.getRuntime().availableProcessors()
+) {
+
+    /**
+     * Handle (pointer) to the native OfflineClassifier, 0 once closed.
+     */
+    private var nativeHandle: Long = nativeCreate(processor.handle, workers)
+
+    init {
+        if (nativeHandle == 0L) {
+            throw RuntimeException("Failed to initialize offline classifier")
+        }
+    }
+
+    // ========================================================================
+    // TIMELINE
+    // ========================================================================
+
+    /**
+     * Reusable batch of timeline entries filled by [poll].
+     *
+     * Entry i starts at frame [startFrames] [i]. [classIndices] [i] is the
+     * detected class, or -1 if the window was silent (see minRms) or not
+     * confident enough; [scores] and [rms] are its best score and RMS.
+     *
+     * @param capacity Entries returned per [poll] at most
+     */
+    class Timeline(capacity: Int = 1024) {
+        val startFrames = LongArray(capacity)
+        val classIndices = IntArray(capacity)
+        val scores = FloatArray(capacity)
+        val rms = FloatArray(capacity)
+    }
+
+    // ========================================================================
+    // PUBLIC API
+    // ========================================================================
+
+    /**
+     * Start classifying a file in the background (cancels a previous run).
+     *
+     * Trailing frames that do not fill a whole window are ignored.
+     *
+     * @param path WAV file, or headerless little-endian int16 PCM
+     * @param hopSize Frames between window starts (1..window length)
+     * @param channel Channel to classify in multi-channel files
+     * @param rawSampleRate Sample rate of raw PCM (ignored for WAV)
+     * @param rawChannels Interleaved channels of raw PCM (ignored for WAV)
+     * @param minRms Windows with RMS at or below this value are not classified
+     * @param minScore Classes scoring at or below this value are not reported
+     * @throws IllegalArgumentException if the file cannot be read or the
+     *         parameters are invalid
+     * @throws IllegalStateException if the classifier is closed
+     */
+    fun start(
+        path: String,
+        hopSize: Int,
+        channel: Int = 0,
+        rawSampleRate: Int = 16000,
+        rawChannels: Int = 1,
+        minRms: Float = 0.0f,
+        minScore: Float = 0.0f
+    ) {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Offline classifier closed")
+        }
+        if (!nativeStartFile(nativeHandle, path, hopSize, channel, rawSampleRate, rawChannels,
+                minRms, minScore)) {
+            throw IllegalArgumentException("Cannot classify $path (hop $hopSize, channel $channel)")
+        }
+    }
+
+    /**
+     * Start classifying a file region, e.g. a document opened through the
+     * storage access framework. The descriptor may be closed once this
+     * returns.
+     *
+     * @param descriptor Readable file
+     * @param offset Start of the audio file inside [descriptor]
+     * @param length Audio file size in bytes (by default up to the end)
+     * @see start for the remaining parameters
+     */
+    fun start(
+        descriptor: ParcelFileDescriptor,
+        hopSize: Int,
+        channel: Int = 0,
+        rawSampleRate: Int = 16000,
+        rawChannels: Int = 1,
+        minRms: Float = 0.0f,
+        minScore: Float = 0.0f,
+        offset: Long = 0,
+        length: Long = descriptor.statSize - offset
+    ) {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Offline classifier closed")
+        }
+        if (!nativeStartFd(nativeHandle, descriptor.fd, offset, length, hopSize, channel,
+                rawSampleRate, rawChannels, minRms, minScore)) {
+            throw IllegalArgumentException("Cannot classify descriptor (hop $hopSize, channel $channel)")
+        }
+    }
+
+    /**
+     * Collect the next finished timeline entries, in file order.
+     *
+     * @param timeline Receives up to its capacity entries (reused between calls)
+     * @return Entries written (0 if the next one is not classified yet), or
+     *         -1 once the run is finished and every entry has been returned
+     * @throws IllegalStateException if the classifier is closed
+     */
+    fun poll(timeline: Timeline): Int {
+        if (nativeHandle == 0L) {
+            throw IllegalStateException("Offline classifier closed")
+        }
+        return nativePoll(nativeHandle, timeline.startFrames, timeline.classIndices,
+            timeline.scores, timeline.rms)
+    }
+
+    /**
+     * Windows in the current run.
+     */
+    val windowCount: Long
+        get() = if (nativeHandle == 0L) 0 else nativeGetWindowCount(nativeHandle)
+
+    /**
+     * Windows classified so far in the current run (for progress bars).
+     */
+    val completedWindows: Long
+        get() = if (nativeHandle == 0L) 0 else nativeGetCompleted(nativeHandle)
+
+    /**
+     * True if inference failed for a window of the current run (its entry
+     * then has no class).
+     */
+    val hasFailed: Boolean
+        get() = nativeHandle == 0L || nativeHasFailed(nativeHandle)
+
+    /**
+     * Stop the current run; entries not classified yet are never returned.
+     */
+    fun cancel() {
+        if (nativeHandle != 0L) {
+            nativeCancel(nativeHandle)
+        }
+    }
+
+    /**
+     * Cancel any run and release the native workers.
+     *
+     * Safe to call multiple times; subsequent calls are no-ops.
+     */
+    fun close() {
+        if (nativeHandle != 0L) {
+            nativeClose(nativeHandle)
+            nativeHandle = 0
+        }
+    }
+
+    protected fun finalize() {
+        close()
+    }
+
+    // ========================================================================
+    // JNI FUNCTION DECLARATIONS
+    // ========================================================================
+    // Implemented in jni_wrapper.cpp (OFFLINE FILE CLASSIFICATION section).
+
+    private external fun nativeCreate(processorHandle: Long, workers: Int): Long
+
+    private external fun nativeStartFile(
+        handle: Long,
+        path: String,
+        hopSize: Int,
+        channel: Int,
+        rawSampleRate: Int,
+        rawChannels: Int,
+        minRms: Float,
+        minScore: Float
+    ): Boolean
+
+    private external fun nativeStartFd(
+        handle: Long,
+        fd: Int,
+        offset: Long,
+        length: Long,
+        hopSize: Int,
+        channel: Int,
+        rawSampleRate: Int,
+        rawChannels: Int,
+        minRms: Float,
+        minScore: Float
+    ): Boolean
+
+    private external fun nativePoll(
+        handle: Long,
+        startFrames: LongArray,
+        classIndices: IntArray,
+        scores: FloatArray,
+        rms: FloatArray
+    ): Int
+
+    private external fun nativeGetWindowCount(handle: Long): Long
+
+    private external fun nativeGetCompleted(handle: Long): Long
+
+    private external fun nativeHasFailed(handle: Long): Boolean
+
+    private external fun nativeCancel(handle: Long): Unit
+
+    private external fun nativeClose(handle: Long): Unit
+}